@@ -0,0 +1,14 @@
+# Add benchmark functions.
+
+function(lib_benchmark benchmark_file lib)
+    if (NOT ENABLE_BENCHMARK)
+        return()
+    endif()
+    get_filename_component(benchmark_target_name ${benchmark_file} NAME_WE)
+
+    add_executable(${benchmark_target_name} ${benchmark_file})
+    target_link_libraries(${benchmark_target_name}
+                          ${lib}
+                          benchmark
+                          benchmark_main)
+endfunction()
@@ -3,4 +3,83 @@
  * Date: 2021-03-27
  */
 
-#include "lib/algorithm/bit.h"
+#include "algorithm/bit.h"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace cg {
+
+int SelectInWord(uint64_t x, int k) {
+    if (k >= PopCount(x)) {
+        return 64;
+    }
+#if defined(__BMI2__)
+    return CountTrailingZeros(_pdep_u64(1ULL << k, x));
+#else
+    // skip whole bytes first, then drop the lowest set bits one by one
+    int base = 0;
+    while (true) {
+        int ones = PopCount(x & 0xff);
+        if (k < ones) {
+            break;
+        }
+        k -= ones;
+        x >>= 8;
+        base += 8;
+    }
+    for (; k > 0; --k) {
+        x &= x - 1;
+    }
+    return base + CountTrailingZeros(x);
+#endif
+}
+
+void RankSelectBitmap::Build() {
+    const std::size_t nwords = words_.size();
+    // one more entry so that Rank(Size()) needs no special case
+    blocks_.assign(nwords / kWordsPerBlock + 1, 0);
+    subblocks_.assign(nwords + 1, 0);
+    if (bits_ % 64) {
+        // bits past the end never count
+        words_.back() &= (1ULL << (bits_ % 64)) - 1;
+    }
+    std::size_t total = 0;
+    for (std::size_t w = 0; w <= nwords; ++w) {
+        if (w % kWordsPerBlock == 0) {
+            blocks_[w / kWordsPerBlock] = total;
+        }
+        subblocks_[w] = static_cast<uint16_t>(total - blocks_[w / kWordsPerBlock]);
+        if (w < nwords) {
+            total += PopCount(words_[w]);
+        }
+    }
+    ones_ = total;
+}
+
+std::size_t RankSelectBitmap::Select(std::size_t k) const {
+    if (k >= ones_) {
+        return bits_;
+    }
+    // last block whose absolute rank is <= k
+    std::size_t lo = 0;
+    std::size_t hi = blocks_.size() - 1;
+    while (lo < hi) {
+        std::size_t mid = (lo + hi + 1) / 2;
+        if (blocks_[mid] <= k) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    std::size_t w = lo * kWordsPerBlock;
+    k -= blocks_[lo];
+    while (w + 1 < words_.size() && (w + 1) % kWordsPerBlock != 0 && subblocks_[w + 1] <= k) {
+        ++w;
+    }
+    k -= subblocks_[w];
+    return w * 64 + SelectInWord(words_[w], static_cast<int>(k));
+}
+
+}  // end of namespace cg
@@ -4,8 +4,181 @@
  */
 #pragma once
 
+#include <stdint.h>
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
 namespace cg {
+namespace internal {
+
+// Portable versions, single expression so they stay constexpr under C++11.
+constexpr uint64_t popCountStep1(uint64_t x) {
+    return x - ((x >> 1) & 0x5555555555555555ULL);
+}
+
+constexpr uint64_t popCountStep2(uint64_t x) {
+    return (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+}
+
+constexpr uint64_t popCountStep3(uint64_t x) {
+    return (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+}
+
+constexpr int PopCount64Portable(uint64_t x) {
+    return static_cast<int>((popCountStep3(popCountStep2(popCountStep1(x)))
+                * 0x0101010101010101ULL) >> 56);
+}
+
+constexpr int CountTrailingZeros64Portable(uint64_t x) {
+    return x == 0 ? 64 : PopCount64Portable((x & (~x + 1)) - 1);
+}
+
+// set every bit below the highest set one
+constexpr uint64_t smearRight(uint64_t x, int shift) {
+    return shift > 32 ? x : smearRight(x | (x >> shift), shift * 2);
+}
+
+constexpr int CountLeadingZeros64Portable(uint64_t x) {
+    return 64 - PopCount64Portable(smearRight(x, 1));
+}
+
+constexpr int PopCount64(uint64_t x) {
+#if defined(__GNUC__) && defined(__POPCNT__)
+    return __builtin_popcountll(x);
+#else
+    // without the popcnt instruction the builtin is a libgcc table lookup
+    return PopCount64Portable(x);
+#endif
+}
+
+constexpr int CountTrailingZeros64(uint64_t x) {
+#if defined(__GNUC__)
+    return x == 0 ? 64 : __builtin_ctzll(x);
+#else
+    return CountTrailingZeros64Portable(x);
+#endif
+}
+
+constexpr int CountLeadingZeros64(uint64_t x) {
+#if defined(__GNUC__)
+    return x == 0 ? 64 : __builtin_clzll(x);
+#else
+    return CountLeadingZeros64Portable(x);
+#endif
+}
+
+}  // end of namespace internal
+
+// The functions below take any unsigned integer up to 64 bits, are constexpr
+// and so usable in templates and static_assert.
+
+template <typename T>
+constexpr int PopCount(T x) {
+    static_assert(std::is_unsigned<T>::value && sizeof(T) <= 8, "unsigned integer only");
+    return internal::PopCount64(x);
+}
+
+// Number of bits of T for 0.
+template <typename T>
+constexpr int CountTrailingZeros(T x) {
+    static_assert(std::is_unsigned<T>::value && sizeof(T) <= 8, "unsigned integer only");
+    return x == 0 ? static_cast<int>(8 * sizeof(T)) : internal::CountTrailingZeros64(x);
+}
+
+// Number of bits of T for 0.
+template <typename T>
+constexpr int CountLeadingZeros(T x) {
+    static_assert(std::is_unsigned<T>::value && sizeof(T) <= 8, "unsigned integer only");
+    return internal::CountLeadingZeros64(x) - static_cast<int>(64 - 8 * sizeof(T));
+}
+
+template <typename T>
+constexpr bool IsPowerOfTwo(T x) {
+    static_assert(std::is_unsigned<T>::value, "unsigned integer only");
+    return x != 0 && (x & (x - 1)) == 0;
+}
+
+// floor(log2(x)), -1 for 0.
+template <typename T>
+constexpr int Log2Floor(T x) {
+    return static_cast<int>(8 * sizeof(T)) - 1 - CountLeadingZeros(x);
+}
+
+// ceil(log2(x)), 0 for 0 and 1.
+template <typename T>
+constexpr int Log2Ceil(T x) {
+    return x <= 1 ? 0 : Log2Floor(static_cast<T>(x - 1)) + 1;
+}
+
+// Smallest power of two >= x, 1 for 0. x must not exceed the highest power of two of T.
+template <typename T>
+constexpr T NextPowerOfTwo(T x) {
+    return static_cast<T>(static_cast<T>(1) << Log2Ceil(x));
+}
+
+// Smallest power of two >= n, 1 for n == 0. n must not exceed 2^31.
+constexpr uint32_t LeastPowerOfTwo(uint32_t n) {
+    return NextPowerOfTwo(n);
+}
+
+// Position of the k-th (from 0) set bit of x, 64 if x has no more than k set bits.
+int SelectInWord(uint64_t x, int k);
+
+// Fixed size bitmap answering rank (set bits before a position) in O(1) and
+// select (position of the k-th set bit) in O(log n). Call Build after the
+// last Set/Clear and before Rank/Select.
+class RankSelectBitmap {
+public:
+    explicit RankSelectBitmap(std::size_t bits)
+        : bits_(bits), words_((bits + 63) / 64, 0), ones_(0) {}
+
+    std::size_t Size() const {
+        return bits_;
+    }
+
+    bool Get(std::size_t i) const {
+        return (words_[i / 64] >> (i % 64)) & 1;
+    }
+
+    void Set(std::size_t i) {
+        words_[i / 64] |= (1ULL << (i % 64));
+    }
+
+    void Clear(std::size_t i) {
+        words_[i / 64] &= ~(1ULL << (i % 64));
+    }
+
+    void Build();
+
+    // set bits in [0, i), i <= Size()
+    std::size_t Rank(std::size_t i) const {
+        const std::size_t w = i / 64;
+        std::size_t r = blocks_[w / kWordsPerBlock] + subblocks_[w];
+        if (i % 64) {
+            r += PopCount(words_[w] << (64 - i % 64));
+        }
+        return r;
+    }
+
+    // position of the k-th (from 0) set bit, Size() if k >= Ones()
+    std::size_t Select(std::size_t k) const;
+
+    std::size_t Ones() const {
+        return ones_;
+    }
+
+private:
+    // a block of 8 words (512 bits) stores the absolute rank in a 64 bit counter,
+    // each word the rank relative to its block in 16 bits
+    static const std::size_t kWordsPerBlock = 8;
 
-uint32_t LeastPowerOfTwo(uint32_t n);
+    std::size_t bits_;
+    std::vector<uint64_t> words_;
+    std::vector<uint64_t> blocks_;
+    std::vector<uint16_t> subblocks_;
+    std::size_t ones_;
+};
 
 }  // end of namespace cg
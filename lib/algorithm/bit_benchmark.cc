@@ -0,0 +1,141 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <random>
+#include <vector>
+
+#include "algorithm/bit.h"
+#include "benchmark/benchmark.h"
+
+namespace cg {
+namespace {
+
+std::vector<uint64_t> randomWords() {
+    std::mt19937_64 rng(1);
+    std::vector<uint64_t> words(4096);
+    for (auto& it : words) {
+        it = rng() >> (rng() % 64);
+    }
+    return words;
+}
+
+int naivePopCount(uint64_t x) {
+    int n = 0;
+    for (; x != 0; x >>= 1) {
+        n += x & 1;
+    }
+    return n;
+}
+
+int naiveCtz(uint64_t x) {
+    int n = 0;
+    for (; n < 64 && !((x >> n) & 1); ++n) {
+    }
+    return n;
+}
+
+int naiveClz(uint64_t x) {
+    int n = 0;
+    for (; n < 64 && !((x >> (63 - n)) & 1); ++n) {
+    }
+    return n;
+}
+
+uint64_t naiveNextPowerOfTwo(uint64_t x) {
+    uint64_t p = 1;
+    while (p < x) {
+        p <<= 1;
+    }
+    return p;
+}
+
+#define BIT_BENCHMARK(name, expr)                           \
+    void BM_##name(benchmark::State& state) {               \
+        std::vector<uint64_t> words = randomWords();        \
+        for (auto _ : state) {                              \
+            uint64_t sum = 0;                               \
+            for (uint64_t x : words) {                      \
+                sum += (expr);                              \
+            }                                               \
+            benchmark::DoNotOptimize(sum);                  \
+        }                                                   \
+        state.SetItemsProcessed(state.iterations() * words.size()); \
+    }                                                       \
+    BENCHMARK(BM_##name)
+
+BIT_BENCHMARK(NaivePopCount, naivePopCount(x));
+BIT_BENCHMARK(PopCount, PopCount(x));
+BIT_BENCHMARK(PopCountPortable, internal::PopCount64Portable(x));
+BIT_BENCHMARK(NaiveCountTrailingZeros, naiveCtz(x));
+BIT_BENCHMARK(CountTrailingZeros, CountTrailingZeros(x));
+BIT_BENCHMARK(CountTrailingZerosPortable, internal::CountTrailingZeros64Portable(x));
+BIT_BENCHMARK(NaiveCountLeadingZeros, naiveClz(x));
+BIT_BENCHMARK(CountLeadingZeros, CountLeadingZeros(x));
+BIT_BENCHMARK(CountLeadingZerosPortable, internal::CountLeadingZeros64Portable(x));
+BIT_BENCHMARK(NaiveNextPowerOfTwo, naiveNextPowerOfTwo(x >> 1));
+BIT_BENCHMARK(NextPowerOfTwo, NextPowerOfTwo(x >> 1));
+
+RankSelectBitmap randomBitmap(std::size_t bits) {
+    std::mt19937_64 rng(3);
+    RankSelectBitmap bitmap(bits);
+    for (std::size_t i = 0; i < bits; ++i) {
+        if (rng() & 1) {
+            bitmap.Set(i);
+        }
+    }
+    bitmap.Build();
+    return bitmap;
+}
+
+void BM_NaiveRank(benchmark::State& state) {
+    RankSelectBitmap bitmap = randomBitmap(state.range(0));
+    std::mt19937_64 rng(5);
+    for (auto _ : state) {
+        std::size_t i = rng() % bitmap.Size();
+        std::size_t r = 0;
+        for (std::size_t j = 0; j < i; ++j) {
+            r += bitmap.Get(j);
+        }
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+void BM_Rank(benchmark::State& state) {
+    RankSelectBitmap bitmap = randomBitmap(state.range(0));
+    std::mt19937_64 rng(5);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bitmap.Rank(rng() % bitmap.Size()));
+    }
+}
+
+void BM_NaiveSelect(benchmark::State& state) {
+    RankSelectBitmap bitmap = randomBitmap(state.range(0));
+    std::mt19937_64 rng(5);
+    for (auto _ : state) {
+        std::size_t k = rng() % bitmap.Ones();
+        std::size_t i = 0;
+        for (std::size_t seen = 0; i < bitmap.Size(); ++i) {
+            if (bitmap.Get(i) && seen++ == k) {
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(i);
+    }
+}
+
+void BM_Select(benchmark::State& state) {
+    RankSelectBitmap bitmap = randomBitmap(state.range(0));
+    std::mt19937_64 rng(5);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bitmap.Select(rng() % bitmap.Ones()));
+    }
+}
+
+BENCHMARK(BM_NaiveRank)->Arg(1 << 12)->Arg(1 << 16);
+BENCHMARK(BM_Rank)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK(BM_NaiveSelect)->Arg(1 << 12)->Arg(1 << 16);
+BENCHMARK(BM_Select)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 24);
+
+}  // end of anonymous namespace
+}  // end of namespace cg
@@ -0,0 +1,197 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "algorithm/bit.h"
+
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+// usable at compile time
+static_assert(PopCount(0xf0f0U) == 8, "PopCount");
+static_assert(PopCount(~0ULL) == 64, "PopCount");
+static_assert(CountTrailingZeros(0x80U) == 7, "CountTrailingZeros");
+static_assert(CountTrailingZeros(uint32_t(0)) == 32, "CountTrailingZeros");
+static_assert(CountTrailingZeros(uint64_t(0)) == 64, "CountTrailingZeros");
+static_assert(CountLeadingZeros(1U) == 31, "CountLeadingZeros");
+static_assert(CountLeadingZeros(uint64_t(1)) == 63, "CountLeadingZeros");
+static_assert(CountLeadingZeros(uint8_t(1)) == 7, "CountLeadingZeros");
+static_assert(Log2Floor(1U) == 0 && Log2Floor(1023U) == 9 && Log2Floor(0U) == -1, "Log2Floor");
+static_assert(Log2Ceil(1U) == 0 && Log2Ceil(1025U) == 11 && Log2Ceil(1024U) == 10, "Log2Ceil");
+static_assert(NextPowerOfTwo(uint64_t(1) << 40 | 1) == uint64_t(1) << 41, "NextPowerOfTwo");
+static_assert(LeastPowerOfTwo(100) == 128, "LeastPowerOfTwo");
+static_assert(IsPowerOfTwo(64U) && !IsPowerOfTwo(0U) && !IsPowerOfTwo(6U), "IsPowerOfTwo");
+static_assert(internal::PopCount64Portable(0x123456789abcdefULL) == 32, "PopCount64Portable");
+static_assert(internal::CountLeadingZeros64Portable(0) == 64, "CountLeadingZeros64Portable");
+
+template <uint32_t N>
+struct Buckets {
+    static const uint32_t value = NextPowerOfTwo(N);
+};
+static_assert(Buckets<1000>::value == 1024, "usable as template argument");
+
+class BitTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    static int naivePopCount(uint64_t x) {
+        int n = 0;
+        for (int i = 0; i < 64; ++i) {
+            n += (x >> i) & 1;
+        }
+        return n;
+    }
+
+    static int naiveCtz(uint64_t x, int bits) {
+        for (int i = 0; i < bits; ++i) {
+            if ((x >> i) & 1) {
+                return i;
+            }
+        }
+        return bits;
+    }
+
+    static int naiveClz(uint64_t x, int bits) {
+        for (int i = bits - 1; i >= 0; --i) {
+            if ((x >> i) & 1) {
+                return bits - 1 - i;
+            }
+        }
+        return bits;
+    }
+
+    static void check64(uint64_t x) {
+        ASSERT_EQ(naivePopCount(x), PopCount(x)) << x;
+        ASSERT_EQ(naivePopCount(x), internal::PopCount64Portable(x)) << x;
+        ASSERT_EQ(naiveCtz(x, 64), CountTrailingZeros(x)) << x;
+        ASSERT_EQ(naiveCtz(x, 64), internal::CountTrailingZeros64Portable(x)) << x;
+        ASSERT_EQ(naiveClz(x, 64), CountLeadingZeros(x)) << x;
+        ASSERT_EQ(naiveClz(x, 64), internal::CountLeadingZeros64Portable(x)) << x;
+        ASSERT_EQ(63 - naiveClz(x, 64), Log2Floor(x)) << x;
+        if (x > 0 && x <= (1ULL << 63)) {
+            uint64_t p = NextPowerOfTwo(x);
+            ASSERT_TRUE(IsPowerOfTwo(p)) << x;
+            ASSERT_GE(p, x);
+            ASSERT_LT(p / 2, x);
+            ASSERT_EQ(Log2Ceil(x), Log2Floor(p)) << x;
+        }
+    }
+
+    static void check32(uint32_t x) {
+        ASSERT_EQ(naivePopCount(x), PopCount(x)) << x;
+        ASSERT_EQ(naiveCtz(x, 32), CountTrailingZeros(x)) << x;
+        ASSERT_EQ(naiveClz(x, 32), CountLeadingZeros(x)) << x;
+        ASSERT_EQ(31 - naiveClz(x, 32), Log2Floor(x)) << x;
+        if (x > 0 && x <= (1U << 31)) {
+            uint32_t p = LeastPowerOfTwo(x);
+            ASSERT_TRUE(IsPowerOfTwo(p)) << x;
+            ASSERT_GE(p, x);
+            ASSERT_LT(p / 2, x);
+            ASSERT_EQ(Log2Ceil(x), Log2Floor(p)) << x;
+        }
+    }
+};
+
+TEST_F(BitTest, LeastPowerOfTwo) {
+    EXPECT_EQ(1U, LeastPowerOfTwo(0));
+    EXPECT_EQ(1U, LeastPowerOfTwo(1));
+    EXPECT_EQ(2U, LeastPowerOfTwo(2));
+    EXPECT_EQ(4U, LeastPowerOfTwo(3));
+    EXPECT_EQ(1024U, LeastPowerOfTwo(513));
+    EXPECT_EQ(1U << 31, LeastPowerOfTwo((1U << 30) + 1));
+    EXPECT_EQ(1U << 31, LeastPowerOfTwo(1U << 31));
+}
+
+// every 16 bit value, then every power of two and its neighbours
+TEST_F(BitTest, Exhaustive) {
+    for (uint32_t x = 0; x <= 0xffff; ++x) {
+        check32(x);
+        check64(x);
+        check64(static_cast<uint64_t>(x) << 48);
+    }
+    for (int i = 0; i < 64; ++i) {
+        uint64_t p = 1ULL << i;
+        check64(p - 1);
+        check64(p);
+        check64(p + 1);
+        check64(~p);
+        if (i < 32) {
+            check32(static_cast<uint32_t>(p - 1));
+            check32(static_cast<uint32_t>(p));
+            check32(static_cast<uint32_t>(p + 1));
+            check32(static_cast<uint32_t>(~p));
+        }
+    }
+}
+
+TEST_F(BitTest, Random) {
+    std::mt19937_64 rng(42);
+    for (int i = 0; i < 200000; ++i) {
+        uint64_t x = rng() >> (i % 64);
+        check64(x);
+        check32(static_cast<uint32_t>(x));
+    }
+}
+
+TEST_F(BitTest, SelectInWord) {
+    std::mt19937_64 rng(7);
+    for (int i = 0; i < 20000; ++i) {
+        uint64_t x = rng() & rng();
+        int k = 0;
+        for (int pos = 0; pos < 64; ++pos) {
+            if ((x >> pos) & 1) {
+                ASSERT_EQ(pos, SelectInWord(x, k++)) << x;
+            }
+        }
+        ASSERT_EQ(64, SelectInWord(x, k));
+    }
+    EXPECT_EQ(64, SelectInWord(0, 0));
+}
+
+TEST_F(BitTest, RankSelectBitmap) {
+    std::mt19937_64 rng(13);
+    for (std::size_t bits : {0, 1, 63, 64, 65, 511, 512, 513, 5000, 100003}) {
+        for (int density : {0, 1, 50, 99, 100}) {
+            RankSelectBitmap bitmap(bits);
+            std::vector<std::size_t> ones;
+            for (std::size_t i = 0; i < bits; ++i) {
+                if (static_cast<int>(rng() % 100) < density) {
+                    bitmap.Set(i);
+                    ones.push_back(i);
+                }
+            }
+            bitmap.Build();
+            ASSERT_EQ(bits, bitmap.Size());
+            ASSERT_EQ(ones.size(), bitmap.Ones());
+            std::size_t rank = 0;
+            for (std::size_t i = 0; i <= bits; ++i) {
+                ASSERT_EQ(rank, bitmap.Rank(i)) << bits << " " << i;
+                if (i < bits && bitmap.Get(i)) {
+                    ++rank;
+                }
+            }
+            for (std::size_t k = 0; k < ones.size(); ++k) {
+                ASSERT_EQ(ones[k], bitmap.Select(k)) << bits << " " << k;
+            }
+            ASSERT_EQ(bits, bitmap.Select(ones.size()));
+        }
+    }
+
+    RankSelectBitmap bitmap(10);
+    bitmap.Set(3);
+    bitmap.Set(5);
+    bitmap.Clear(3);
+    bitmap.Build();
+    EXPECT_EQ(false, bitmap.Get(3));
+    EXPECT_EQ(1U, bitmap.Ones());
+    EXPECT_EQ(5U, bitmap.Select(0));
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
@@ -0,0 +1,94 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "base/common_prefix.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "base/cpu.h"
+
+namespace cg {
+namespace internal {
+namespace {
+
+typedef std::size_t (*CommonPrefixFunc)(const char*, const char*, std::size_t);
+
+CommonPrefixFunc pickKernel() {
+#if defined(__x86_64__)
+    if (CpuSupportsAVX2()) {
+        return CommonPrefixAVX2;
+    }
+    return CommonPrefixSSE2;
+#else
+    return CommonPrefixWord;
+#endif
+}
+
+}  // end of anonymous namespace
+
+std::size_t CommonPrefixBytewise(const char* a, const char* b, std::size_t n) {
+    std::size_t off = 0;
+    for (; off < n; ++off) {
+        if (a[off] != b[off]) {
+            break;
+        }
+    }
+    return off;
+}
+
+std::size_t CommonPrefixWord(const char* a, const char* b, std::size_t n) {
+    std::size_t off = 0;
+    for (; off + 8 <= n; off += 8) {
+        uint64_t x;
+        uint64_t y;
+        memcpy(&x, a + off, 8);
+        memcpy(&y, b + off, 8);
+        if (x != y) {
+            return off + firstDiffByte(x ^ y);
+        }
+    }
+    return off + CommonPrefixBytewise(a + off, b + off, n - off);
+}
+
+#if defined(__x86_64__)
+std::size_t CommonPrefixSSE2(const char* a, const char* b, std::size_t n) {
+    std::size_t off = 0;
+    for (; off + 16 <= n; off += 16) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + off));
+        const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + off));
+        const unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)))
+                & 0xffff;
+        if (mask) {
+            return off + __builtin_ctz(mask);
+        }
+    }
+    return off + CommonPrefixWord(a + off, b + off, n - off);
+}
+
+__attribute__((target("avx2")))
+std::size_t CommonPrefixAVX2(const char* a, const char* b, std::size_t n) {
+    std::size_t off = 0;
+    for (; off + 32 <= n; off += 32) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + off));
+        const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + off));
+        const unsigned mask = ~static_cast<unsigned>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+        if (mask) {
+            return off + __builtin_ctz(mask);
+        }
+    }
+    return off + CommonPrefixSSE2(a + off, b + off, n - off);
+}
+#endif
+
+std::size_t CommonPrefixLong(const char* a, const char* b, std::size_t n) {
+    static const CommonPrefixFunc kernel = pickKernel();
+    return kernel(a, b, n);
+}
+
+}  // end of namespace internal
+}  // end of namespace cg
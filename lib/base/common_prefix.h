@@ -0,0 +1,91 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <cstddef>
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#endif
+
+namespace cg {
+namespace internal {
+
+// Length of the common prefix of a[0, n) and b[0, n), one kernel per width.
+// The simd versions must only be called when the cpu supports them.
+std::size_t CommonPrefixBytewise(const char* a, const char* b, std::size_t n);
+std::size_t CommonPrefixWord(const char* a, const char* b, std::size_t n);
+
+#if defined(__x86_64__)
+std::size_t CommonPrefixSSE2(const char* a, const char* b, std::size_t n);
+std::size_t CommonPrefixAVX2(const char* a, const char* b, std::size_t n);
+#endif
+
+// Picked by cpuid at first use, used once the first kCommonPrefixInline bytes
+// matched and kCommonPrefixLong bytes or more are left.
+std::size_t CommonPrefixLong(const char* a, const char* b, std::size_t n);
+
+static const std::size_t kCommonPrefixInline = 32;
+static const std::size_t kCommonPrefixLong = 64;
+
+// index of the first differing byte in a non zero xor of two 8 byte loads
+inline std::size_t firstDiffByte(uint64_t diff) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return static_cast<std::size_t>(__builtin_ctzll(diff)) >> 3;
+#else
+    return static_cast<std::size_t>(__builtin_clzll(diff)) >> 3;
+#endif
+}
+
+}  // end of namespace internal
+
+// Return the length of the common prefix of a[0, n) and b[0, n).
+// The head is compared inline 16/8 bytes at a time, long shared prefixes go
+// on with the widest simd kernel the cpu supports.
+inline std::size_t CommonPrefix(const char* a, const char* b, std::size_t n) {
+    std::size_t off = 0;
+#if defined(__x86_64__)
+    for (; off + 16 <= n; off += 16) {
+        if (off == internal::kCommonPrefixInline && n - off >= internal::kCommonPrefixLong) {
+            return off + internal::CommonPrefixLong(a + off, b + off, n - off);
+        }
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + off));
+        const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + off));
+        const unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)))
+                & 0xffff;
+        if (mask) {
+            return off + __builtin_ctz(mask);
+        }
+    }
+#endif
+    for (; off + 8 <= n; off += 8) {
+        uint64_t x;
+        uint64_t y;
+        memcpy(&x, a + off, 8);
+        memcpy(&y, b + off, 8);
+        if (x != y) {
+            return off + internal::firstDiffByte(x ^ y);
+        }
+    }
+    if (off < n && n >= 8) {
+        // the last word overlaps bytes already known to be equal
+        uint64_t x;
+        uint64_t y;
+        memcpy(&x, a + n - 8, 8);
+        memcpy(&y, b + n - 8, 8);
+        return (x == y) ? n : n - 8 + internal::firstDiffByte(x ^ y);
+    }
+    for (; off < n; ++off) {
+        if (a[off] != b[off]) {
+            break;
+        }
+    }
+    return off;
+}
+
+}  // end of namespace cg
@@ -0,0 +1,67 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "base/common_prefix.h"
+
+#include <string>
+
+#include "base/cpu.h"
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+typedef std::size_t (*CommonPrefixFunc)(const char*, const char*, std::size_t);
+
+class CommonPrefixTest : public ::testing::Test {
+protected:
+    // mismatch at every position of every length, plus the no mismatch case
+    void checkKernel(CommonPrefixFunc func) {
+        for (std::size_t n = 0; n <= 160; ++n) {
+            std::string a(n, 'k');
+            std::string b = a;
+            ASSERT_EQ(n, func(a.data(), b.data(), n)) << "n=" << n;
+            for (std::size_t pos = 0; pos < n; ++pos) {
+                b[pos] = '\xff';
+                ASSERT_EQ(pos, func(a.data(), b.data(), n)) << "n=" << n << ", pos=" << pos;
+                // a later mismatch must not hide the first one
+                if (pos + 1 < n) {
+                    b[n - 1] = 'x';
+                    ASSERT_EQ(pos, func(a.data(), b.data(), n)) << "n=" << n << ", pos=" << pos;
+                    b[n - 1] = 'k';
+                }
+                b[pos] = 'k';
+            }
+        }
+    }
+};
+
+TEST_F(CommonPrefixTest, Bytewise) {
+    checkKernel(internal::CommonPrefixBytewise);
+}
+
+TEST_F(CommonPrefixTest, Word) {
+    checkKernel(internal::CommonPrefixWord);
+}
+
+#if defined(__x86_64__)
+TEST_F(CommonPrefixTest, SSE2) {
+    checkKernel(internal::CommonPrefixSSE2);
+}
+
+TEST_F(CommonPrefixTest, AVX2) {
+    if (!internal::CpuSupportsAVX2()) {
+        return;
+    }
+    checkKernel(internal::CommonPrefixAVX2);
+}
+#endif
+
+TEST_F(CommonPrefixTest, Dispatch) {
+    checkKernel(internal::CommonPrefixLong);
+    checkKernel(CommonPrefix);
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
@@ -0,0 +1,19 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "base/cpu.h"
+
+namespace cg {
+namespace internal {
+
+#if defined(__x86_64__)
+bool CpuSupportsAVX2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+#endif
+
+}  // end of namespace internal
+}  // end of namespace cg
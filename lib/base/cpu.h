@@ -0,0 +1,31 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <thread>
+
+#include "algorithm/bit.h"
+
+namespace cg {
+
+// The cpus rounded up to a power of two, at most max: how many stripes or
+// shards a structure written from every cpu gets.
+inline uint32_t PerCpuShards(uint32_t max = 64) {
+    const uint32_t cpus = std::max(1U, std::thread::hardware_concurrency());
+    return NextPowerOfTwo(std::min(cpus, max));
+}
+
+namespace internal {
+
+#if defined(__x86_64__)
+// What the simd kernels of base and string pick from at runtime, by cpuid.
+bool CpuSupportsAVX2();
+#endif
+
+}  // end of namespace internal
+}  // end of namespace cg
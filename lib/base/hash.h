@@ -0,0 +1,125 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <cstddef>
+
+#include "include/slice.h"
+
+namespace cg {
+namespace internal {
+
+static const uint64_t kHashSecret0 = 0xa0761d6478bd642fULL;
+static const uint64_t kHashSecret1 = 0xe7037ed1a0b428dbULL;
+static const uint64_t kHashSecret2 = 0x8ebc6af09c88c6e3ULL;
+static const uint64_t kHashSecret3 = 0x589965cc75374cc3ULL;
+
+// the 128 bit product of *a and *b, low half to *a, high half to *b
+inline void hashMultiply(uint64_t* a, uint64_t* b) {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 r = static_cast<unsigned __int128>(*a) * *b;
+    *a = static_cast<uint64_t>(r);
+    *b = static_cast<uint64_t>(r >> 64);
+#else
+    const uint64_t ha = *a >> 32, la = *a & 0xffffffff, hb = *b >> 32, lb = *b & 0xffffffff;
+    const uint64_t hh = ha * hb, hl = ha * lb, lh = la * hb, ll = la * lb;
+    const uint64_t mid = (ll >> 32) + (hl & 0xffffffff) + (lh & 0xffffffff);
+    *a = (mid << 32) | (ll & 0xffffffff);
+    *b = hh + (hl >> 32) + (lh >> 32) + (mid >> 32);
+#endif
+}
+
+// the product folded to 64 bits
+inline uint64_t hashMix(uint64_t a, uint64_t b) {
+    hashMultiply(&a, &b);
+    return a ^ b;
+}
+
+inline uint64_t hashRead64(const char* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+inline uint64_t hashRead32(const char* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+}  // end of namespace internal
+
+// Fast non-cryptographic hash of n bytes, after wyhash: keys up to 16 bytes
+// are two or four loads and two multiplies, longer ones take 16 or 48 bytes
+// a multiply. Good enough for hash tables, no defense against an attacker
+// who picks the keys. The value depends on the byte order of the machine.
+inline uint64_t Hash(const char* data, std::size_t n, uint64_t seed = 0) {
+    const unsigned char* u = reinterpret_cast<const unsigned char*>(data);
+    seed ^= internal::hashMix(seed ^ internal::kHashSecret0, internal::kHashSecret1);
+    uint64_t a;
+    uint64_t b;
+    if (n <= 16) {
+        if (n >= 4) {
+            // the first and last 4 bytes, and 4 more from the middle from n = 8
+            const std::size_t off = (n >> 3) << 2;
+            a = (internal::hashRead32(data) << 32) | internal::hashRead32(data + off);
+            b = (internal::hashRead32(data + n - 4) << 32)
+                | internal::hashRead32(data + n - 4 - off);
+        } else if (n > 0) {
+            a = (static_cast<uint64_t>(u[0]) << 16) | (static_cast<uint64_t>(u[n >> 1]) << 8)
+                | u[n - 1];
+            b = 0;
+        } else {
+            a = 0;
+            b = 0;
+        }
+    } else {
+        const char* p = data;
+        std::size_t left = n;
+        if (left > 48) {
+            uint64_t seed1 = seed;
+            uint64_t seed2 = seed;
+            do {
+                seed = internal::hashMix(internal::hashRead64(p) ^ internal::kHashSecret1,
+                                         internal::hashRead64(p + 8) ^ seed);
+                seed1 = internal::hashMix(internal::hashRead64(p + 16) ^ internal::kHashSecret2,
+                                          internal::hashRead64(p + 24) ^ seed1);
+                seed2 = internal::hashMix(internal::hashRead64(p + 32) ^ internal::kHashSecret3,
+                                          internal::hashRead64(p + 40) ^ seed2);
+                p += 48;
+                left -= 48;
+            } while (left > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (left > 16) {
+            seed = internal::hashMix(internal::hashRead64(p) ^ internal::kHashSecret1,
+                                     internal::hashRead64(p + 8) ^ seed);
+            p += 16;
+            left -= 16;
+        }
+        // the last 16 bytes, overlapping bytes already hashed
+        a = internal::hashRead64(p + left - 16);
+        b = internal::hashRead64(p + left - 8);
+    }
+    a ^= internal::kHashSecret1;
+    b ^= seed;
+    internal::hashMultiply(&a, &b);
+    return internal::hashMix(a ^ internal::kHashSecret0 ^ n, b ^ internal::kHashSecret1);
+}
+
+inline uint64_t Hash(const Slice& s, uint64_t seed = 0) {
+    return Hash(s.Data(), s.Size(), seed);
+}
+
+struct SliceHash {
+    std::size_t operator()(const Slice& s) const {
+        return static_cast<std::size_t>(Hash(s));
+    }
+};
+
+}  // end of namespace cg
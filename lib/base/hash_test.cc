@@ -0,0 +1,85 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "base/hash.h"
+
+#include <stdint.h>
+
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class HashTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+TEST_F(HashTest, Deterministic) {
+    const std::string s = "the quick brown fox jumps over the lazy dog";
+    EXPECT_EQ(Hash(s.data(), s.size()), Hash(Slice(s)));
+    EXPECT_EQ(Hash(Slice(s)), Hash(Slice(std::string(s))));
+    EXPECT_NE(Hash(Slice(s)), Hash(Slice(s), 1));
+    EXPECT_EQ(Hash(Slice(s)), SliceHash()(Slice(s)));
+}
+
+// every length through every branch: the prefixes of one string and
+// strings of one byte repeated must all differ
+TEST_F(HashTest, Lengths) {
+    std::string data;
+    for (int i = 0; i < 300; ++i) {
+        data.push_back(static_cast<char>(i * 7 + 1));
+    }
+    std::set<uint64_t> seen;
+    for (std::size_t n = 0; n <= data.size(); ++n) {
+        EXPECT_TRUE(seen.insert(Hash(data.data(), n)).second) << n;
+    }
+    for (std::size_t n = 1; n <= 100; ++n) {
+        EXPECT_TRUE(seen.insert(Hash(std::string(n, '\0').data(), n)).second) << n;
+    }
+}
+
+// one bit flipped anywhere changes about half the bits of the hash
+TEST_F(HashTest, Avalanche) {
+    const std::size_t kLengths[] = {3, 8, 15, 16, 17, 40, 100};
+    for (std::size_t n : kLengths) {
+        std::string s(n, 'a');
+        const uint64_t base = Hash(s.data(), n);
+        int total = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            for (int bit = 0; bit < 8; ++bit) {
+                s[i] = static_cast<char>(s[i] ^ (1 << bit));
+                const int changed = __builtin_popcountll(base ^ Hash(s.data(), n));
+                s[i] = static_cast<char>(s[i] ^ (1 << bit));
+                EXPECT_GT(changed, 8) << n << " " << i << " " << bit;
+                total += changed;
+            }
+        }
+        const double mean = static_cast<double>(total) / (8 * n);
+        EXPECT_GT(mean, 28.0) << n;
+        EXPECT_LT(mean, 36.0) << n;
+    }
+}
+
+// the 7 low bits, the control byte of FlatHashMap, spread evenly too
+TEST_F(HashTest, LowBits) {
+    int buckets[128] = {0};
+    const int kKeys = 128 * 200;
+    for (int i = 0; i < kKeys; ++i) {
+        const std::string key = "key" + std::to_string(i);
+        ++buckets[Hash(Slice(key)) & 127];
+    }
+    for (int it : buckets) {
+        EXPECT_GT(it, 120);
+        EXPECT_LT(it, 280);
+    }
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
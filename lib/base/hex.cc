@@ -0,0 +1,248 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "base/hex.h"
+
+#include <stdint.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "base/cpu.h"
+
+namespace cg {
+namespace {
+
+struct HexTable {
+    char enc[256][2];
+    int8_t dec[256];
+
+    HexTable() {
+        static const char* digits = "0123456789ABCDEF";
+        for (int i = 0; i < 256; ++i) {
+            enc[i][0] = digits[i >> 4];
+            enc[i][1] = digits[i & 0xf];
+            dec[i] = -1;
+        }
+        for (int i = 0; i < 10; ++i) {
+            dec['0' + i] = static_cast<int8_t>(i);
+        }
+        for (int i = 0; i < 6; ++i) {
+            dec['A' + i] = static_cast<int8_t>(10 + i);
+            dec['a' + i] = static_cast<int8_t>(10 + i);
+        }
+    }
+};
+
+const HexTable& hexTable() {
+    static const HexTable table;
+    return table;
+}
+
+typedef void (*HexEncodeFunc)(const char*, std::size_t, char*);
+typedef bool (*HexDecodeFunc)(const char*, std::size_t, char*);
+
+struct HexKernel {
+    const char* name;
+    HexEncodeFunc encode;
+    HexDecodeFunc decode;
+};
+
+HexKernel pickKernel() {
+#if defined(__x86_64__)
+    if (internal::CpuSupportsAVX2()) {
+        return HexKernel{"avx2", internal::HexEncodeAVX2, internal::HexDecodeAVX2};
+    }
+    return HexKernel{"sse2", internal::HexEncodeSSE2, internal::HexDecodeSSE2};
+#else
+    return HexKernel{"scalar", internal::HexEncodeScalar, internal::HexDecodeScalar};
+#endif
+}
+
+const HexKernel& hexKernel() {
+    static const HexKernel kernel = pickKernel();
+    return kernel;
+}
+
+#if defined(__x86_64__)
+// nibble(0~15) -> '0'~'9', 'A'~'F'
+inline __m128i nibbleToHex(__m128i n) {
+    const __m128i gap = _mm_and_si128(_mm_cmpgt_epi8(n, _mm_set1_epi8(9)),
+                                      _mm_set1_epi8('A' - '0' - 10));
+    return _mm_add_epi8(_mm_add_epi8(n, _mm_set1_epi8('0')), gap);
+}
+
+// hex char -> nibble, lanes holding a non hex char are cleared in *valid
+inline __m128i hexToNibble(__m128i c, __m128i* valid) {
+    const __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                                           _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+    const __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    const __m128i is_alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                           _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    const __m128i digit = _mm_and_si128(is_digit, _mm_sub_epi8(c, _mm_set1_epi8('0')));
+    const __m128i alpha = _mm_and_si128(is_alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
+    *valid = _mm_and_si128(*valid, _mm_or_si128(is_digit, is_alpha));
+    return _mm_or_si128(digit, alpha);
+}
+
+// [h0, l0, h1, l1, ...] -> 16 bit lanes of (h << 4 | l)
+inline __m128i joinNibbles(__m128i v) {
+    return _mm_or_si128(_mm_and_si128(_mm_slli_epi16(v, 4), _mm_set1_epi16(0x00f0)),
+                        _mm_srli_epi16(v, 8));
+}
+
+__attribute__((target("avx2")))
+inline __m256i nibbleToHex256(__m256i n) {
+    const __m256i lut = _mm256_setr_epi8(
+            '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F',
+            '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+    return _mm256_shuffle_epi8(lut, n);
+}
+
+__attribute__((target("avx2")))
+inline __m256i hexToNibble256(__m256i c, __m256i* valid) {
+    const __m256i is_digit = _mm256_and_si256(
+            _mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+    const __m256i lower = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+    const __m256i is_alpha = _mm256_and_si256(
+            _mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+    const __m256i digit = _mm256_and_si256(is_digit, _mm256_sub_epi8(c, _mm256_set1_epi8('0')));
+    const __m256i alpha = _mm256_and_si256(is_alpha,
+                                           _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10)));
+    *valid = _mm256_and_si256(*valid, _mm256_or_si256(is_digit, is_alpha));
+    return _mm256_or_si256(digit, alpha);
+}
+
+__attribute__((target("avx2")))
+inline __m256i joinNibbles256(__m256i v) {
+    return _mm256_or_si256(
+            _mm256_and_si256(_mm256_slli_epi16(v, 4), _mm256_set1_epi16(0x00f0)),
+            _mm256_srli_epi16(v, 8));
+}
+#endif
+
+}  // end of anonymous namespace
+
+void HexEncode(const char* src, std::size_t n, char* dst) {
+    hexKernel().encode(src, n, dst);
+}
+
+bool HexDecode(const char* src, std::size_t n, char* dst) {
+    return hexKernel().decode(src, n, dst);
+}
+
+const char* HexKernelName() {
+    return hexKernel().name;
+}
+
+namespace internal {
+
+void HexEncodeScalar(const char* src, std::size_t n, char* dst) {
+    const HexTable& table = hexTable();
+    for (std::size_t i = 0; i < n; ++i) {
+        const char* pair = table.enc[static_cast<uint8_t>(src[i])];
+        dst[2 * i] = pair[0];
+        dst[2 * i + 1] = pair[1];
+    }
+}
+
+bool HexDecodeScalar(const char* src, std::size_t n, char* dst) {
+    if (n % 2) {
+        return false;
+    }
+    const HexTable& table = hexTable();
+    for (std::size_t i = 0; i < n / 2; ++i) {
+        int h = table.dec[static_cast<uint8_t>(src[2 * i])];
+        int l = table.dec[static_cast<uint8_t>(src[2 * i + 1])];
+        if ((h | l) < 0) {
+            return false;
+        }
+        dst[i] = static_cast<char>(h << 4 | l);
+    }
+    return true;
+}
+
+#if defined(__x86_64__)
+void HexEncodeSSE2(const char* src, std::size_t n, char* dst) {
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i hi = nibbleToHex(_mm_and_si128(_mm_srli_epi16(x, 4), mask));
+        const __m128i lo = nibbleToHex(_mm_and_si128(x, mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    HexEncodeScalar(src + i, n - i, dst + 2 * i);
+}
+
+bool HexDecodeSSE2(const char* src, std::size_t n, char* dst) {
+    if (n % 2) {
+        return false;
+    }
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m128i valid = _mm_set1_epi8(-1);
+        const __m128i v0 = hexToNibble(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), &valid);
+        const __m128i v1 = hexToNibble(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16)), &valid);
+        if (_mm_movemask_epi8(valid) != 0xffff) {
+            return false;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i / 2),
+                         _mm_packus_epi16(joinNibbles(v0), joinNibbles(v1)));
+    }
+    return HexDecodeScalar(src + i, n - i, dst + i / 2);
+}
+
+__attribute__((target("avx2")))
+void HexEncodeAVX2(const char* src, std::size_t n, char* dst) {
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i hi = nibbleToHex256(_mm256_and_si256(_mm256_srli_epi16(x, 4), mask));
+        const __m256i lo = nibbleToHex256(_mm256_and_si256(x, mask));
+        // unpack works inside each 128 bit lane, swap the halves back into order
+        const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+        const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i),
+                            _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i + 32),
+                            _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    HexEncodeSSE2(src + i, n - i, dst + 2 * i);
+}
+
+__attribute__((target("avx2")))
+bool HexDecodeAVX2(const char* src, std::size_t n, char* dst) {
+    if (n % 2) {
+        return false;
+    }
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m256i valid = _mm256_set1_epi8(-1);
+        const __m256i v0 = hexToNibble256(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), &valid);
+        const __m256i v1 = hexToNibble256(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32)), &valid);
+        if (_mm256_movemask_epi8(valid) != -1) {
+            return false;
+        }
+        // pack works inside each 128 bit lane, restore the qword order
+        const __m256i packed = _mm256_packus_epi16(joinNibbles256(v0), joinNibbles256(v1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i / 2),
+                            _mm256_permute4x64_epi64(packed, 0xd8));
+    }
+    return HexDecodeSSE2(src + i, n - i, dst + i / 2);
+}
+#endif
+
+}  // end of namespace internal
+}  // end of namespace cg
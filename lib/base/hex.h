@@ -0,0 +1,39 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <cstddef>
+
+namespace cg {
+
+// Encode n bytes of src into 2 * n upper case hex chars at dst.
+// dst must have room for 2 * n chars, no terminating '\0' is written.
+void HexEncode(const char* src, std::size_t n, char* dst);
+
+// Decode n hex chars (upper or lower case) of src into n / 2 bytes at dst.
+// Return false if n is odd or src contains a non hex char, the content of
+// dst is unspecified in that case.
+bool HexDecode(const char* src, std::size_t n, char* dst);
+
+// Name of the kernel picked by cpuid at runtime: "avx2", "sse2" or "scalar".
+const char* HexKernelName();
+
+namespace internal {
+
+// The kernels HexEncode/HexDecode dispatch to, exposed for test and benchmark.
+// The simd versions must only be called when the cpu supports them.
+void HexEncodeScalar(const char* src, std::size_t n, char* dst);
+bool HexDecodeScalar(const char* src, std::size_t n, char* dst);
+
+#if defined(__x86_64__)
+void HexEncodeSSE2(const char* src, std::size_t n, char* dst);
+bool HexDecodeSSE2(const char* src, std::size_t n, char* dst);
+
+void HexEncodeAVX2(const char* src, std::size_t n, char* dst);
+bool HexDecodeAVX2(const char* src, std::size_t n, char* dst);
+#endif
+
+}  // end of namespace internal
+}  // end of namespace cg
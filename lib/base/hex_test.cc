@@ -0,0 +1,96 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "base/hex.h"
+
+#include <stdlib.h>
+
+#include <string>
+
+#include "base/cpu.h"
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+typedef void (*EncodeFunc)(const char*, std::size_t, char*);
+typedef bool (*DecodeFunc)(const char*, std::size_t, char*);
+
+class HexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        srand(0);
+        for (int i = 0; i < 1024; ++i) {
+            data_.push_back(static_cast<char>(rand() & 0xff));
+        }
+    }
+
+    void TearDown() override {}
+
+    // every length, so that the scalar tail of the simd kernels is covered
+    void checkKernel(EncodeFunc encode, DecodeFunc decode) {
+        for (std::size_t n = 0; n <= 200; ++n) {
+            std::string expect(2 * n, '\0');
+            internal::HexEncodeScalar(data_.data(), n, &expect[0]);
+            std::string hex(2 * n, '\0');
+            encode(data_.data(), n, &hex[0]);
+            ASSERT_EQ(expect, hex) << "n=" << n;
+
+            std::string raw(n, '\0');
+            ASSERT_TRUE(decode(hex.data(), hex.size(), &raw[0])) << "n=" << n;
+            ASSERT_EQ(data_.substr(0, n), raw) << "n=" << n;
+
+            if (n == 0) {
+                continue;
+            }
+            for (std::size_t pos = 0; pos < hex.size(); pos += 7) {
+                std::string bad = hex;
+                bad[pos] = 'g';
+                EXPECT_FALSE(decode(bad.data(), bad.size(), &raw[0])) << "n=" << n;
+                bad[pos] = static_cast<char>(0xc1);
+                EXPECT_FALSE(decode(bad.data(), bad.size(), &raw[0])) << "n=" << n;
+            }
+        }
+    }
+
+    std::string data_;
+};
+
+TEST_F(HexTest, Scalar) {
+    char buf[8];
+    internal::HexEncodeScalar("\x01\xab\xff\x00", 4, buf);
+    EXPECT_EQ("01ABFF00", std::string(buf, 8));
+
+    char raw[4];
+    EXPECT_TRUE(internal::HexDecodeScalar("01abFF00", 8, raw));
+    EXPECT_EQ(std::string("\x01\xab\xff\x00", 4), std::string(raw, 4));
+    EXPECT_FALSE(internal::HexDecodeScalar("01a", 3, raw));
+    EXPECT_FALSE(internal::HexDecodeScalar("0G", 2, raw));
+    EXPECT_FALSE(internal::HexDecodeScalar("@0", 2, raw));
+    EXPECT_FALSE(internal::HexDecodeScalar("0`", 2, raw));
+
+    checkKernel(internal::HexEncodeScalar, internal::HexDecodeScalar);
+}
+
+#if defined(__x86_64__)
+TEST_F(HexTest, SSE2) {
+    checkKernel(internal::HexEncodeSSE2, internal::HexDecodeSSE2);
+}
+
+TEST_F(HexTest, AVX2) {
+    if (!internal::CpuSupportsAVX2()) {
+        return;
+    }
+    checkKernel(internal::HexEncodeAVX2, internal::HexDecodeAVX2);
+}
+#endif
+
+TEST_F(HexTest, Dispatch) {
+    std::string name = HexKernelName();
+    EXPECT_TRUE(name == "avx2" || name == "sse2" || name == "scalar");
+    checkKernel(HexEncode, HexDecode);
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
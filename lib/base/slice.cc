@@ -5,37 +5,15 @@
 
 #include "include/slice.h"
 
-namespace cg {
-
-char toHex(unsigned char v) {
-    if (v <= 9) {
-        return '0' + v;
-    }
-    return 'A' + v - 10;
-}
+#include "base/hex.h"
 
-int fromHex(char c) {
-    if (c >= 'a' && c <= 'f') {
-        c -= ('a' - 'A');
-    }
-    if (c < '0' || (c > '9' && (c < 'A' || c > 'F'))) {
-        return -1;
-    }
-    if (c <= '9') {
-        return c - '0';
-    }
-    return c - '0' + 10;
-}
+namespace cg {
 
 std::string Slice::ToString(bool hex) const {
     std::string result;
     if (hex) {
-        result.reserve(2 * size_);
-        for (std::size_t i = 0; i < size_; ++i) {
-            unsigned char c = data_[i];
-            result.push_back(toHex(c >> 4));
-            result.push_back(toHex(c & 0xf));
-        }
+        result.resize(2 * size_);
+        HexEncode(data_, size_, &result[0]);
     } else {
         result.assign(data_, size_);
     }
@@ -43,27 +21,58 @@ std::string Slice::ToString(bool hex) const {
 }
 
 bool Slice::DecodeHex(std::string* result) const {
-    std::string::size_type len = size_;
-    if (len % 2) {
+    if (size_ % 2) {
         return false;
     }
     if (!result) {
         return false;
     }
-    result->clear();
-    result->reserve(len / 2);
-    for (std::size_t i = 0; i < len;) {
-        int h1 = fromHex(data_[i++]);
-        if (h1 < 0) {
-            return false;
-        }
-        int h2 = fromHex(data_[i++]);
-        if (h2 < 0) {
-            return false;
-        }
-        result->push_back(h1 << 4 | h2);
+    result->resize(size_ / 2);
+    if (!HexDecode(data_, size_, &(*result)[0])) {
+        result->clear();
+        return false;
     }
     return true;
 }
 
+std::size_t Slice::ToHex(char* buf, std::size_t cap) const {
+    if (buf == nullptr || cap < 2 * size_) {
+        return 2 * size_;
+    }
+    HexEncode(data_, size_, buf);
+    return 2 * size_;
+}
+
+bool Slice::DecodeHex(char* buf, std::size_t cap, std::size_t* len) const {
+    if (size_ % 2) {
+        return false;
+    }
+    if (buf == nullptr || len == nullptr || cap < size_ / 2) {
+        return false;
+    }
+    if (!HexDecode(data_, size_, buf)) {
+        return false;
+    }
+    *len = size_ / 2;
+    return true;
+}
+
+void SharedPrefixLengths(const Slice* keys, std::size_t n, std::size_t* shared) {
+    if (n == 0) {
+        return;
+    }
+    shared[0] = 0;
+    for (std::size_t i = 1; i < n; ++i) {
+        shared[i] = keys[i - 1].DifferenceOffset(keys[i]);
+    }
+}
+
+std::size_t SortedCommonPrefix(const Slice* keys, std::size_t n) {
+    if (n == 0) {
+        return 0;
+    }
+    // every key lies between the first and the last one, so they bound the prefix
+    return keys[0].DifferenceOffset(keys[n - 1]);
+}
+
 }  // end of namespace cg
@@ -0,0 +1,263 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include "base/common_prefix.h"
+#include "base/cpu.h"
+#include "base/hex.h"
+#include "benchmark/benchmark.h"
+#include "include/slice.h"
+
+namespace cg {
+namespace {
+
+// The nibble at a time implementation Slice::ToString(true) and
+// Slice::DecodeHex used before the table/simd kernels, kept as the baseline.
+char legacyToHex(unsigned char v) {
+    if (v <= 9) {
+        return '0' + v;
+    }
+    return 'A' + v - 10;
+}
+
+int legacyFromHex(char c) {
+    if (c >= 'a' && c <= 'f') {
+        c -= ('a' - 'A');
+    }
+    if (c < '0' || (c > '9' && (c < 'A' || c > 'F'))) {
+        return -1;
+    }
+    if (c <= '9') {
+        return c - '0';
+    }
+    return c - 'A' + 10;
+}
+
+std::string legacyEncode(const Slice& s) {
+    std::string result;
+    result.reserve(2 * s.Size());
+    for (std::size_t i = 0; i < s.Size(); ++i) {
+        unsigned char c = s.Data()[i];
+        result.push_back(legacyToHex(c >> 4));
+        result.push_back(legacyToHex(c & 0xf));
+    }
+    return result;
+}
+
+bool legacyDecode(const Slice& s, std::string* result) {
+    result->clear();
+    result->reserve(s.Size() / 2);
+    for (std::size_t i = 0; i < s.Size();) {
+        int h1 = legacyFromHex(s.Data()[i++]);
+        int h2 = legacyFromHex(s.Data()[i++]);
+        if (h1 < 0 || h2 < 0) {
+            return false;
+        }
+        result->push_back(h1 << 4 | h2);
+    }
+    return true;
+}
+
+std::string randomBytes(std::size_t n) {
+    std::string data(n, '\0');
+    srand(n);
+    for (auto& c : data) {
+        c = static_cast<char>(rand() & 0xff);
+    }
+    return data;
+}
+
+void setBytes(benchmark::State& state) {
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void BM_LegacyEncode(benchmark::State& state) {
+    std::string data = randomBytes(state.range(0));
+    Slice slice(data);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(legacyEncode(slice));
+    }
+    setBytes(state);
+}
+
+void BM_ToStringHex(benchmark::State& state) {
+    std::string data = randomBytes(state.range(0));
+    Slice slice(data);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(slice.ToString(true));
+    }
+    setBytes(state);
+}
+
+void BM_ToHexBuffer(benchmark::State& state) {
+    std::string data = randomBytes(state.range(0));
+    std::string buf(2 * data.size(), '\0');
+    Slice slice(data);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(slice.ToHex(&buf[0], buf.size()));
+        benchmark::ClobberMemory();
+    }
+    setBytes(state);
+}
+
+template <void (*Encode)(const char*, std::size_t, char*)>
+void BM_EncodeKernel(benchmark::State& state) {
+    std::string data = randomBytes(state.range(0));
+    std::string buf(2 * data.size(), '\0');
+    for (auto _ : state) {
+        Encode(data.data(), data.size(), &buf[0]);
+        benchmark::ClobberMemory();
+    }
+    setBytes(state);
+}
+
+void BM_LegacyDecode(benchmark::State& state) {
+    std::string hex = Slice(randomBytes(state.range(0))).ToString(true);
+    Slice slice(hex);
+    std::string out;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(legacyDecode(slice, &out));
+    }
+    setBytes(state);
+}
+
+void BM_DecodeHex(benchmark::State& state) {
+    std::string hex = Slice(randomBytes(state.range(0))).ToString(true);
+    Slice slice(hex);
+    std::string out;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(slice.DecodeHex(&out));
+    }
+    setBytes(state);
+}
+
+void BM_DecodeHexBuffer(benchmark::State& state) {
+    std::string hex = Slice(randomBytes(state.range(0))).ToString(true);
+    std::string buf(hex.size() / 2, '\0');
+    Slice slice(hex);
+    std::size_t len = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(slice.DecodeHex(&buf[0], buf.size(), &len));
+        benchmark::ClobberMemory();
+    }
+    setBytes(state);
+}
+
+template <bool (*Decode)(const char*, std::size_t, char*)>
+void BM_DecodeKernel(benchmark::State& state) {
+    std::string hex = Slice(randomBytes(state.range(0))).ToString(true);
+    std::string buf(hex.size() / 2, '\0');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Decode(hex.data(), hex.size(), &buf[0]));
+        benchmark::ClobberMemory();
+    }
+    setBytes(state);
+}
+
+#define HEX_SIZES Arg(16)->Arg(1 << 10)->Arg(1 << 20)
+
+BENCHMARK(BM_LegacyEncode)->HEX_SIZES;
+BENCHMARK(BM_ToStringHex)->HEX_SIZES;
+BENCHMARK(BM_ToHexBuffer)->HEX_SIZES;
+BENCHMARK_TEMPLATE(BM_EncodeKernel, internal::HexEncodeScalar)->HEX_SIZES;
+BENCHMARK(BM_LegacyDecode)->HEX_SIZES;
+BENCHMARK(BM_DecodeHex)->HEX_SIZES;
+BENCHMARK(BM_DecodeHexBuffer)->HEX_SIZES;
+BENCHMARK_TEMPLATE(BM_DecodeKernel, internal::HexDecodeScalar)->HEX_SIZES;
+#if defined(__x86_64__)
+BENCHMARK_TEMPLATE(BM_EncodeKernel, internal::HexEncodeSSE2)->HEX_SIZES;
+BENCHMARK_TEMPLATE(BM_DecodeKernel, internal::HexDecodeSSE2)->HEX_SIZES;
+#endif
+
+// A run of keys of state.range(0) bytes where each key shares
+// state.range(1) percent of its bytes with the previous one.
+std::vector<std::string> sortedKeys(benchmark::State& state) {
+    const std::size_t len = state.range(0);
+    const std::size_t shared = len * state.range(1) / 100;
+    std::vector<std::string> keys(1024, std::string(len, 'a'));
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        if (shared < len) {
+            // neighbours differ right after the shared prefix
+            keys[i][shared] = static_cast<char>('a' + i % 26);
+        }
+    }
+    return keys;
+}
+
+std::size_t legacyDifferenceOffset(const Slice& a, const Slice& b) {
+    std::size_t off = 0;
+    const std::size_t len = (a.Size() < b.Size()) ? a.Size() : b.Size();
+    for (; off < len; ++off) {
+        if (a.Data()[off] != b.Data()[off]) {
+            break;
+        }
+    }
+    return off;
+}
+
+void BM_LegacySharedPrefix(benchmark::State& state) {
+    std::vector<std::string> data = sortedKeys(state);
+    std::vector<Slice> keys(data.begin(), data.end());
+    std::vector<std::size_t> shared(keys.size());
+    for (auto _ : state) {
+        shared[0] = 0;
+        for (std::size_t i = 1; i < keys.size(); ++i) {
+            shared[i] = legacyDifferenceOffset(keys[i - 1], keys[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+void BM_SharedPrefixLengths(benchmark::State& state) {
+    std::vector<std::string> data = sortedKeys(state);
+    std::vector<Slice> keys(data.begin(), data.end());
+    std::vector<std::size_t> shared(keys.size());
+    for (auto _ : state) {
+        SharedPrefixLengths(keys.data(), keys.size(), shared.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <std::size_t (*Func)(const char*, const char*, std::size_t)>
+void BM_CommonPrefixKernel(benchmark::State& state) {
+    std::vector<std::string> keys = sortedKeys(state);
+    for (auto _ : state) {
+        for (std::size_t i = 1; i < keys.size(); ++i) {
+            benchmark::DoNotOptimize(Func(keys[i - 1].data(), keys[i].data(), keys[i].size()));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+#define PREFIX_ARGS ArgsProduct({{8, 16, 32, 64, 256, 1024}, {0, 50, 90, 100}})
+
+BENCHMARK(BM_LegacySharedPrefix)->PREFIX_ARGS;
+BENCHMARK(BM_SharedPrefixLengths)->PREFIX_ARGS;
+BENCHMARK_TEMPLATE(BM_CommonPrefixKernel, internal::CommonPrefixWord)->PREFIX_ARGS;
+#if defined(__x86_64__)
+BENCHMARK_TEMPLATE(BM_CommonPrefixKernel, internal::CommonPrefixSSE2)->PREFIX_ARGS;
+
+// the avx2 kernels are only registered on cpus supporting them
+int registerAVX2() {
+    if (internal::CpuSupportsAVX2()) {
+        benchmark::RegisterBenchmark("BM_EncodeKernel<internal::HexEncodeAVX2>",
+                BM_EncodeKernel<internal::HexEncodeAVX2>)->HEX_SIZES;
+        benchmark::RegisterBenchmark("BM_DecodeKernel<internal::HexDecodeAVX2>",
+                BM_DecodeKernel<internal::HexDecodeAVX2>)->HEX_SIZES;
+        benchmark::RegisterBenchmark("BM_CommonPrefixKernel<internal::CommonPrefixAVX2>",
+                BM_CommonPrefixKernel<internal::CommonPrefixAVX2>)->PREFIX_ARGS;
+    }
+    return 0;
+}
+const int kAVX2Registered = registerAVX2();
+#endif
+
+}  // end of anonymous namespace
+}  // end of namespace cg
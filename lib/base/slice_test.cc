@@ -3,6 +3,11 @@
  * Date:2021-03-12
  */
 #include "include/slice.h"
+
+#include <string.h>
+
+#include <vector>
+
 #include "gtest/gtest.h"
 
 namespace cg {
@@ -70,5 +75,66 @@ TEST_F(SliceTest, RemoveSuffix) {
     EXPECT_EQ(0, slice.Compare(slice2));
 }
 
+TEST_F(SliceTest, Hex) {
+    std::string data("\x00\x01\x7f\x80\xfe\xff", 6);
+    Slice slice(data);
+    EXPECT_EQ("00017F80FEFF", slice.ToString(true));
+    EXPECT_EQ("", Slice().ToString(true));
+
+    std::string raw;
+    EXPECT_EQ(true, Slice("00017F80FEFF").DecodeHex(&raw));
+    EXPECT_EQ(data, raw);
+    EXPECT_EQ(true, Slice("00017f80feff").DecodeHex(&raw));
+    EXPECT_EQ(data, raw);
+    EXPECT_EQ(false, Slice("0001F").DecodeHex(&raw));
+    EXPECT_EQ(false, Slice("0X").DecodeHex(&raw));
+    EXPECT_EQ(false, Slice("00").DecodeHex(nullptr));
+
+    char buf[16];
+    EXPECT_EQ(12U, slice.ToHex(buf, sizeof(buf)));
+    EXPECT_EQ("00017F80FEFF", std::string(buf, 12));
+    // too small: the size needed, the buffer untouched
+    memset(buf, 'x', sizeof(buf));
+    EXPECT_EQ(12U, slice.ToHex(buf, 11));
+    EXPECT_EQ('x', buf[0]);
+    EXPECT_EQ(12U, slice.ToHex(nullptr, 0));
+    EXPECT_EQ(0U, Slice().ToHex(buf, 0));
+
+    std::size_t len = 0;
+    EXPECT_EQ(true, Slice("00017F80FEFF").DecodeHex(buf, sizeof(buf), &len));
+    EXPECT_EQ(data, std::string(buf, len));
+    EXPECT_EQ(false, Slice("00017F80FEFF").DecodeHex(buf, 5, &len));
+    EXPECT_EQ(false, Slice("0G").DecodeHex(buf, sizeof(buf), &len));
+}
+
+TEST_F(SliceTest, DifferenceOffset) {
+    std::string a = "user:00000000000000000000000000000000000000001:profile:name";
+    for (std::size_t pos = 0; pos < a.size(); ++pos) {
+        std::string b = a;
+        b[pos] = '#';
+        EXPECT_EQ(pos, Slice(a).DifferenceOffset(Slice(b)));
+        EXPECT_EQ(pos, Slice(a).DifferenceOffset(Slice(a.substr(0, pos))));
+    }
+}
+
+TEST_F(SliceTest, SharedPrefixLengths) {
+    std::vector<std::string> data = {"apple", "application", "apply", "apt", "apt", "aptitude", "b"};
+    std::vector<Slice> keys;
+    for (const auto& it : data) {
+        keys.emplace_back(it);
+    }
+    std::vector<std::size_t> shared(keys.size());
+    SharedPrefixLengths(keys.data(), keys.size(), shared.data());
+    std::vector<std::size_t> expect = {0, 4, 4, 2, 3, 3, 0};
+    EXPECT_EQ(expect, shared);
+
+    EXPECT_EQ(0U, SortedCommonPrefix(keys.data(), keys.size()));
+    EXPECT_EQ(2U, SortedCommonPrefix(keys.data(), keys.size() - 1));
+    EXPECT_EQ(4U, SortedCommonPrefix(keys.data(), 3));
+    EXPECT_EQ(5U, SortedCommonPrefix(keys.data(), 1));
+    EXPECT_EQ(0U, SortedCommonPrefix(keys.data(), 0));
+    SharedPrefixLengths(keys.data(), 0, nullptr);
+}
+
 }  // end of namespace unittest
 }  // end of namespace cg
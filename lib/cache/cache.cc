@@ -0,0 +1,462 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "cache/cache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <thread>
+
+#include "algorithm/bit.h"
+#include "base/hash.h"
+#include "concurrent/mutex.h"
+#include "concurrent/rw_lock.h"
+#include "concurrent/scop_lock.h"
+#include "container/flat_hash_map.h"
+
+namespace cg {
+
+struct Cache::Handle {
+    void* value;
+    Cache::Deleter deleter;
+    std::size_t charge;
+    uint64_t hash;
+    std::atomic<uint32_t> refs;     // one for the cache while in it, one per pin
+    std::atomic<bool> referenced;   // clock: hit since the hand last passed
+    bool in_cache;
+    Handle* next;                   // in the lists of the shard
+    Handle* prev;
+    std::size_t key_size;
+    char key_data[1];               // allocated to the key size
+
+    Handle() : value(nullptr), deleter(nullptr), charge(0), hash(0), refs(0), referenced(false),
+               in_cache(false), next(this), prev(this), key_size(0) {}
+
+    Slice Key() const {
+        return Slice(key_data, key_size);
+    }
+};
+
+namespace internal {
+namespace {
+
+typedef Cache::Handle Entry;
+
+void freeEntry(Entry* e) {
+    if (e->deleter != nullptr) {
+        e->deleter(e->Key(), e->value);
+    }
+    e->~Entry();
+    free(e);
+}
+
+// entries chained by next, freed once the lock is released
+void freeAll(Entry* garbage) {
+    while (garbage != nullptr) {
+        Entry* next = garbage->next;
+        freeEntry(garbage);
+        garbage = next;
+    }
+}
+
+void unlinkEntry(Entry* e) {
+    e->next->prev = e->prev;
+    e->prev->next = e->next;
+}
+
+// before pos in a circular list
+void linkBefore(Entry* pos, Entry* e) {
+    e->next = pos;
+    e->prev = pos->prev;
+    e->prev->next = e;
+    e->next->prev = e;
+}
+
+}  // end of anonymous namespace
+
+// The part of the cache one lock guards. The table points at the key bytes
+// of its entries, an entry leaves the table before it may be freed.
+class CacheShard {
+public:
+    CacheShard(std::size_t capacity, StripedCounter* evictions)
+        : capacity_(capacity), usage_(0), evictions_(evictions) {}
+
+    virtual ~CacheShard() {}
+
+    // e has the cache's ref and the caller's
+    virtual Entry* Insert(Entry* e) = 0;
+
+    virtual Entry* Lookup(const Slice& key) = 0;
+
+    virtual void Release(Entry* e) = 0;
+
+    virtual bool Erase(const Slice& key) = 0;
+
+    virtual void Prune() = 0;
+
+    std::size_t Usage() const {
+        return usage_.load(std::memory_order_relaxed);
+    }
+
+protected:
+    // out of the lists of the policy
+    virtual void unlink(Entry* e) = 0;
+
+    // Takes e out of the cache under the lock; e goes to *garbage if that
+    // was the last ref.
+    void detach(Entry* e, Entry** garbage) {
+        table_.Erase(e->Key());
+        unlink(e);
+        e->in_cache = false;
+        usage_.store(Usage() - e->charge, std::memory_order_relaxed);
+        if (e->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            e->next = *garbage;
+            *garbage = e;
+        }
+    }
+
+    // Puts e in the table, taking out an entry of the same key; false when
+    // the shard caches nothing, e is then only the caller's.
+    bool add(Entry* e, Entry** garbage) {
+        if (capacity_ == 0) {
+            e->in_cache = false;
+            e->refs.store(1, std::memory_order_relaxed);
+            return false;
+        }
+        Entry** old = table_.Find(e->Key());
+        if (old != nullptr) {
+            detach(*old, garbage);
+        }
+        table_.Insert(e->Key(), e);
+        usage_.store(Usage() + e->charge, std::memory_order_relaxed);
+        return true;
+    }
+
+    void evicted() {
+        evictions_->Increment();
+    }
+
+protected:
+    const std::size_t capacity_;
+    std::atomic<std::size_t> usage_;  // written under the lock
+    SliceHashMap<Entry*> table_;
+    StripedCounter* evictions_;
+};
+
+namespace {
+
+// Two lists: entries only the cache refers to, least recently used first,
+// and pinned ones, which are not candidates. All under one mutex.
+class LruShard : public CacheShard {
+public:
+    LruShard(std::size_t capacity, StripedCounter* evictions)
+        : CacheShard(capacity, evictions) {}
+
+    ~LruShard() override {
+        dropList(&lru_);
+        dropList(&in_use_);
+    }
+
+    Entry* Insert(Entry* e) override {
+        Entry* garbage = nullptr;
+        {
+            ScopLock<Mutex> guard(&mu_);
+            if (add(e, &garbage)) {
+                linkBefore(&in_use_, e);
+                while (Usage() > capacity_ && lru_.next != &lru_) {
+                    detach(lru_.next, &garbage);
+                    evicted();
+                }
+            }
+        }
+        freeAll(garbage);
+        return e;
+    }
+
+    Entry* Lookup(const Slice& key) override {
+        ScopLock<Mutex> guard(&mu_);
+        Entry** found = table_.Find(key);
+        if (found == nullptr) {
+            return nullptr;
+        }
+        Entry* e = *found;
+        if (e->refs.load(std::memory_order_relaxed) == 1) {
+            unlinkEntry(e);
+            linkBefore(&in_use_, e);
+        }
+        e->refs.fetch_add(1, std::memory_order_relaxed);
+        return e;
+    }
+
+    void Release(Entry* e) override {
+        bool last;
+        {
+            ScopLock<Mutex> guard(&mu_);
+            const uint32_t refs = e->refs.fetch_sub(1, std::memory_order_acq_rel) - 1;
+            last = refs == 0;
+            if (refs == 1 && e->in_cache) {
+                // the most recently used of the candidates
+                unlinkEntry(e);
+                linkBefore(&lru_, e);
+            }
+        }
+        if (last) {
+            freeEntry(e);
+        }
+    }
+
+    bool Erase(const Slice& key) override {
+        Entry* garbage = nullptr;
+        {
+            ScopLock<Mutex> guard(&mu_);
+            Entry** found = table_.Find(key);
+            if (found == nullptr) {
+                return false;
+            }
+            detach(*found, &garbage);
+        }
+        freeAll(garbage);
+        return true;
+    }
+
+    void Prune() override {
+        Entry* garbage = nullptr;
+        {
+            ScopLock<Mutex> guard(&mu_);
+            while (lru_.next != &lru_) {
+                detach(lru_.next, &garbage);
+            }
+        }
+        freeAll(garbage);
+    }
+
+protected:
+    void unlink(Entry* e) override {
+        unlinkEntry(e);
+    }
+
+private:
+    void dropList(Entry* head) {
+        while (head->next != head) {
+            Entry* e = head->next;
+            unlinkEntry(e);
+            freeEntry(e);
+        }
+    }
+
+private:
+    Mutex mu_;
+    Entry lru_;     // refs 1, oldest next
+    Entry in_use_;  // pinned
+};
+
+// One ring and a hand. A hit sets the referenced bit of its entry under the
+// read lock; Insert, under the write lock, moves the hand over the ring,
+// clearing set bits, and evicts the first unpinned entry with a clear bit.
+// Release is a decrement, without the lock.
+class ClockShard : public CacheShard {
+public:
+    ClockShard(std::size_t capacity, StripedCounter* evictions)
+        : CacheShard(capacity, evictions), hand_(&ring_) {}
+
+    ~ClockShard() override {
+        while (ring_.next != &ring_) {
+            Entry* e = ring_.next;
+            unlinkEntry(e);
+            freeEntry(e);
+        }
+    }
+
+    Entry* Insert(Entry* e) override {
+        Entry* garbage = nullptr;
+        {
+            ScopLock<RWLock> guard(&lock_);
+            if (add(e, &garbage)) {
+                // the last the hand reaches
+                linkBefore(hand_, e);
+                evict(&garbage);
+            }
+        }
+        freeAll(garbage);
+        return e;
+    }
+
+    Entry* Lookup(const Slice& key) override {
+        ReadScopLock<RWLock> guard(&lock_);
+        Entry** found = table_.Find(key);
+        if (found == nullptr) {
+            return nullptr;
+        }
+        Entry* e = *found;
+        e->refs.fetch_add(1, std::memory_order_relaxed);
+        // a store only when the bit changes: hot entries stay shared in caches
+        if (!e->referenced.load(std::memory_order_relaxed)) {
+            e->referenced.store(true, std::memory_order_relaxed);
+        }
+        return e;
+    }
+
+    void Release(Entry* e) override {
+        // the hand evicts under the write lock, only entries with the
+        // cache's ref alone: no Lookup or Release runs on them meanwhile
+        if (e->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            freeEntry(e);
+        }
+    }
+
+    bool Erase(const Slice& key) override {
+        Entry* garbage = nullptr;
+        {
+            ScopLock<RWLock> guard(&lock_);
+            Entry** found = table_.Find(key);
+            if (found == nullptr) {
+                return false;
+            }
+            detach(*found, &garbage);
+        }
+        freeAll(garbage);
+        return true;
+    }
+
+    void Prune() override {
+        Entry* garbage = nullptr;
+        {
+            ScopLock<RWLock> guard(&lock_);
+            for (Entry* e = ring_.next; e != &ring_;) {
+                Entry* next = e->next;
+                if (e->refs.load(std::memory_order_acquire) == 1) {
+                    detach(e, &garbage);
+                }
+                e = next;
+            }
+        }
+        freeAll(garbage);
+    }
+
+protected:
+    void unlink(Entry* e) override {
+        if (hand_ == e) {
+            hand_ = e->next;
+        }
+        unlinkEntry(e);
+    }
+
+private:
+    void evict(Entry** garbage) {
+        // two turns at most: the first may only clear bits
+        std::size_t steps = 2 * (table_.Size() + 1);
+        while (Usage() > capacity_ && steps-- > 0) {
+            Entry* e = hand_;
+            hand_ = e->next;
+            if (e == &ring_ || e->refs.load(std::memory_order_acquire) > 1) {
+                continue;
+            }
+            if (e->referenced.load(std::memory_order_relaxed)) {
+                e->referenced.store(false, std::memory_order_relaxed);
+                continue;
+            }
+            detach(e, garbage);
+            evicted();
+        }
+    }
+
+private:
+    RWLock lock_;
+    Entry ring_;  // the head, not an entry
+    Entry* hand_;
+};
+
+}  // end of anonymous namespace
+}  // end of namespace internal
+
+Cache::Cache(const CacheOptions& options)
+    : capacity_(options.capacity), policy_(options.policy) {
+    uint32_t shards = options.shards > 0
+        ? static_cast<uint32_t>(options.shards)
+        : 4 * std::max(1U, std::thread::hardware_concurrency());
+    shards = NextPowerOfTwo(std::min<uint32_t>(shards, 1U << 16));
+    shard_shift_ = 64 - Log2Floor(shards);
+    const std::size_t per_shard = (capacity_ + shards - 1) / shards;
+    for (uint32_t i = 0; i < shards; ++i) {
+        if (policy_ == CACHE_POLICY_CLOCK) {
+            shards_.emplace_back(new internal::ClockShard(per_shard, &evictions_));
+        } else {
+            shards_.emplace_back(new internal::LruShard(per_shard, &evictions_));
+        }
+    }
+}
+
+Cache::~Cache() {}
+
+Cache::Handle* Cache::Insert(const Slice& key, void* value, std::size_t charge,
+                             Deleter deleter) {
+    void* mem = malloc(sizeof(Handle) - 1 + key.Size());
+    Handle* e = new (mem) Handle;
+    e->value = value;
+    e->deleter = deleter;
+    e->charge = charge;
+    e->hash = Hash(key);
+    e->refs.store(2, std::memory_order_relaxed);
+    e->in_cache = true;
+    e->key_size = key.Size();
+    memcpy(e->key_data, key.Data(), key.Size());
+    inserts_.Increment();
+    return shardOf(e->hash)->Insert(e);
+}
+
+Cache::Handle* Cache::Lookup(const Slice& key) {
+    Handle* e = shardOf(Hash(key))->Lookup(key);
+    if (e != nullptr) {
+        hits_.Increment();
+    } else {
+        misses_.Increment();
+    }
+    return e;
+}
+
+void Cache::Release(Handle* handle) {
+    shardOf(handle->hash)->Release(handle);
+}
+
+void* Cache::Value(Handle* handle) {
+    return handle->value;
+}
+
+Slice Cache::Key(Handle* handle) {
+    return handle->Key();
+}
+
+bool Cache::Erase(const Slice& key) {
+    return shardOf(Hash(key))->Erase(key);
+}
+
+void Cache::Prune() {
+    for (auto& it : shards_) {
+        it->Prune();
+    }
+}
+
+std::size_t Cache::TotalCharge() const {
+    std::size_t total = 0;
+    for (const auto& it : shards_) {
+        total += it->Usage();
+    }
+    return total;
+}
+
+CacheStats Cache::Stats() const {
+    CacheStats stats;
+    stats.hits = static_cast<uint64_t>(hits_.Sum());
+    stats.misses = static_cast<uint64_t>(misses_.Sum());
+    stats.inserts = static_cast<uint64_t>(inserts_.Sum());
+    stats.evictions = static_cast<uint64_t>(evictions_.Sum());
+    return stats;
+}
+
+}  // end of namespace cg
@@ -0,0 +1,133 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "include/atomic.h"
+#include "include/slice.h"
+
+namespace cg {
+
+// How a shard picks the entry to evict.
+enum CachePolicy {
+    // least recently used: every hit relinks the entry, under the shard lock
+    CACHE_POLICY_LRU = 0,
+    // second chance: a hit sets a bit under the read side of the shard lock,
+    // hits on one shard do not serialize; the clock hand evicts the first
+    // unpinned entry whose bit is clear, clearing the bits it passes
+    CACHE_POLICY_CLOCK,
+};
+
+struct CacheOptions {
+    std::size_t capacity;  // in charge, summed over the shards
+    int shards;            // rounded up to a power of two, 0 for 4 per cpu
+    CachePolicy policy;
+
+    explicit CacheOptions(std::size_t cap = 0)
+        : capacity(cap), shards(0), policy(CACHE_POLICY_LRU) {}
+};
+
+struct CacheStats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t inserts;
+    uint64_t evictions;  // dropped for room, not by Erase or a new value
+};
+
+namespace internal {
+class CacheShard;
+}  // end of namespace internal
+
+// A cache from Slice keys to opaque values, in the manner of LevelDB's.
+// Every entry has a charge, the bytes it stands for say; a shard evicts
+// unpinned entries while the charges it holds exceed its part of the
+// capacity. Lookup and Insert pin the entry through the Handle they return
+// until Release; a pinned entry is never evicted, an entry erased or
+// replaced while pinned lives until its last Release. The deleter of an
+// entry runs once nothing refers to it any more, outside the shard lock.
+//
+// Keys are spread over a power of two of shards by the high bits of their
+// hash, each with its own lock and its own share of the capacity.
+//
+//   Cache::Handle* h = cache.Lookup(key);
+//   if (h == nullptr) {
+//       h = cache.Insert(key, decode(blob), size, &deleteBlob);
+//   }
+//   use(cache.Value(h));
+//   cache.Release(h);
+class Cache {
+public:
+    struct Handle;
+
+    typedef void (*Deleter)(const Slice& key, void* value);
+
+    explicit Cache(const CacheOptions& options);
+
+    // Every handle must be released before.
+    ~Cache();
+
+    Cache(const Cache&) = delete;
+
+    Cache& operator=(const Cache&) = delete;
+
+    // Adds key, replacing an entry of the same key, and returns it pinned.
+    // deleter(key, value) runs when the entry goes, nullptr for none.
+    Handle* Insert(const Slice& key, void* value, std::size_t charge, Deleter deleter);
+
+    // The entry of key pinned, nullptr on a miss.
+    Handle* Lookup(const Slice& key);
+
+    void Release(Handle* handle);
+
+    static void* Value(Handle* handle);
+
+    static Slice Key(Handle* handle);
+
+    // Drops the entry of key, false if there is none.
+    bool Erase(const Slice& key);
+
+    // Drops every entry not pinned.
+    void Prune();
+
+    // charges held, pinned entries included
+    std::size_t TotalCharge() const;
+
+    std::size_t Capacity() const {
+        return capacity_;
+    }
+
+    int Shards() const {
+        return static_cast<int>(shards_.size());
+    }
+
+    CachePolicy Policy() const {
+        return policy_;
+    }
+
+    CacheStats Stats() const;
+
+private:
+    internal::CacheShard* shardOf(uint64_t hash) const {
+        return shards_[shard_shift_ == 64 ? 0 : hash >> shard_shift_].get();
+    }
+
+private:
+    const std::size_t capacity_;
+    const CachePolicy policy_;
+    int shard_shift_;  // the shard is the top bits of the hash
+    std::vector<std::unique_ptr<internal::CacheShard>> shards_;
+    // striped: clock hits under read locks would fight over one counter
+    StripedCounter hits_;
+    StripedCounter misses_;
+    StripedCounter inserts_;
+    StripedCounter evictions_;
+};
+
+}  // end of namespace cg
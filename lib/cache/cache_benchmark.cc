@@ -0,0 +1,132 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "cache/cache.h"
+
+namespace cg {
+namespace {
+
+const int kKeys = 1 << 20;
+const int kTrace = 1 << 20;
+const std::size_t kCapacity = 1 << 16;
+
+// The keys, and a trace of kTrace key indexes drawn from a Zipfian
+// distribution of exponent 0.99 over them, key 0 the most popular.
+// Drawn once, to keep the generator out of the timings.
+struct Workload {
+    std::vector<std::string> keys;
+    std::vector<int> trace;
+
+    Workload() {
+        for (int i = 0; i < kKeys; ++i) {
+            keys.push_back("block/" + std::to_string(i * 2654435761U));
+        }
+        std::vector<double> cdf(kKeys);
+        double sum = 0;
+        for (int i = 0; i < kKeys; ++i) {
+            sum += 1.0 / std::pow(i + 1.0, 0.99);
+            cdf[i] = sum;
+        }
+        std::mt19937_64 rng(7);
+        std::uniform_real_distribution<double> uniform(0, sum);
+        for (int i = 0; i < kTrace; ++i) {
+            const auto it = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng));
+            trace.push_back(static_cast<int>(std::min<std::ptrdiff_t>(it - cdf.begin(),
+                                                                      kKeys - 1)));
+        }
+    }
+};
+
+const Workload& workload() {
+    static const Workload workload;
+    return workload;
+}
+
+// what a miss would have read
+char g_block;
+
+// Every thread looks keys of the trace up, from its own offset, and inserts
+// on a miss, as a block cache in front of a disk does. range(0) shards.
+template <CachePolicy kPolicy>
+void BM_Zipf(benchmark::State& state) {
+    static std::unique_ptr<Cache> cache;
+    const Workload& w = workload();
+    if (state.thread_index() == 0) {
+        CacheOptions options(kCapacity);
+        options.shards = static_cast<int>(state.range(0));
+        options.policy = kPolicy;
+        cache.reset(new Cache(options));
+    }
+    int i = (state.thread_index() * 7919) & (kTrace - 1);
+    int64_t hits = 0;
+    for (auto _ : state) {
+        const Slice key(w.keys[w.trace[i]]);
+        Cache::Handle* h = cache->Lookup(key);
+        if (h != nullptr) {
+            ++hits;
+        } else {
+            h = cache->Insert(key, &g_block, 1, nullptr);
+        }
+        benchmark::DoNotOptimize(Cache::Value(h));
+        cache->Release(h);
+        i = (i + 1) & (kTrace - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["hit_rate"] = benchmark::Counter(
+        static_cast<double>(hits) / static_cast<double>(std::max<int64_t>(state.iterations(), 1)),
+        benchmark::Counter::kAvgThreads);
+    if (state.thread_index() == 0) {
+        cache.reset();
+    }
+}
+
+// lookups of keys always cached, no inserts: the cost of a hit alone
+template <CachePolicy kPolicy>
+void BM_Hit(benchmark::State& state) {
+    static std::unique_ptr<Cache> cache;
+    const Workload& w = workload();
+    const int hot = 1024;
+    if (state.thread_index() == 0) {
+        CacheOptions options(kCapacity);
+        options.shards = static_cast<int>(state.range(0));
+        options.policy = kPolicy;
+        cache.reset(new Cache(options));
+        for (int k = 0; k < hot; ++k) {
+            cache->Release(cache->Insert(Slice(w.keys[k]), &g_block, 1, nullptr));
+        }
+    }
+    int i = state.thread_index() * 31;
+    for (auto _ : state) {
+        Cache::Handle* h = cache->Lookup(Slice(w.keys[i & (hot - 1)]));
+        benchmark::DoNotOptimize(Cache::Value(h));
+        cache->Release(h);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        cache.reset();
+    }
+}
+
+void shardArgs(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("shards")->Arg(1)->Arg(16)->ThreadRange(1, 32)->UseRealTime();
+}
+
+BENCHMARK_TEMPLATE(BM_Zipf, CACHE_POLICY_LRU)->Apply(shardArgs);
+BENCHMARK_TEMPLATE(BM_Zipf, CACHE_POLICY_CLOCK)->Apply(shardArgs);
+BENCHMARK_TEMPLATE(BM_Hit, CACHE_POLICY_LRU)->Apply(shardArgs);
+BENCHMARK_TEMPLATE(BM_Hit, CACHE_POLICY_CLOCK)->Apply(shardArgs);
+
+}  // end of anonymous namespace
+}  // end of namespace cg
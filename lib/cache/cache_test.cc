@@ -0,0 +1,278 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "cache/cache.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+// values are new ints, the deleter counts them back
+std::atomic<int> g_deleted(0);
+
+void deleteInt(const Slice& key, void* value) {
+    EXPECT_FALSE(key.Empty());
+    delete static_cast<int*>(value);
+    g_deleted.fetch_add(1);
+}
+
+class CacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        g_deleted.store(0);
+    }
+
+    void TearDown() override {}
+
+    static CacheOptions options(std::size_t capacity, CachePolicy policy, int shards = 1) {
+        CacheOptions options(capacity);
+        options.shards = shards;
+        options.policy = policy;
+        return options;
+    }
+
+    static Cache::Handle* insert(Cache* cache, const std::string& key, int value,
+                                 std::size_t charge = 1) {
+        return cache->Insert(Slice(key), new int(value), charge, &deleteInt);
+    }
+
+    // the value of key, -1 on a miss
+    static int lookup(Cache* cache, const std::string& key) {
+        Cache::Handle* h = cache->Lookup(Slice(key));
+        if (h == nullptr) {
+            return -1;
+        }
+        const int value = *static_cast<int*>(Cache::Value(h));
+        cache->Release(h);
+        return value;
+    }
+
+    static const CachePolicy kPolicies[2];
+};
+
+const CachePolicy CacheTest::kPolicies[2] = {CACHE_POLICY_LRU, CACHE_POLICY_CLOCK};
+
+TEST_F(CacheTest, Shards) {
+    CacheOptions opts(1000);
+    opts.shards = 5;
+    EXPECT_EQ(8, Cache(opts).Shards());
+    opts.shards = 1;
+    EXPECT_EQ(1, Cache(opts).Shards());
+    opts.shards = 0;
+    const int shards = Cache(opts).Shards();
+    EXPECT_GE(shards, 4);
+    EXPECT_EQ(0, shards & (shards - 1));
+}
+
+TEST_F(CacheTest, HitAndMiss) {
+    for (CachePolicy policy : kPolicies) {
+        Cache cache(options(100, policy, 4));
+        EXPECT_EQ(policy, cache.Policy());
+        EXPECT_EQ(-1, lookup(&cache, "a"));
+        cache.Release(insert(&cache, "a", 1));
+        cache.Release(insert(&cache, "b", 2));
+        EXPECT_EQ(1, lookup(&cache, "a"));
+        EXPECT_EQ(2, lookup(&cache, "b"));
+        EXPECT_EQ(-1, lookup(&cache, "c"));
+
+        Cache::Handle* h = cache.Lookup(Slice("a"));
+        ASSERT_NE(nullptr, h);
+        EXPECT_EQ("a", Cache::Key(h).ToString());
+        cache.Release(h);
+
+        const CacheStats stats = cache.Stats();
+        EXPECT_EQ(3U, stats.hits);
+        EXPECT_EQ(2U, stats.misses);
+        EXPECT_EQ(2U, stats.inserts);
+        EXPECT_EQ(0U, stats.evictions);
+        EXPECT_EQ(2U, cache.TotalCharge());
+    }
+    EXPECT_EQ(4, g_deleted.load());
+}
+
+TEST_F(CacheTest, Replace) {
+    for (CachePolicy policy : kPolicies) {
+        g_deleted.store(0);
+        Cache cache(options(100, policy));
+        Cache::Handle* old = insert(&cache, "a", 1, 10);
+        cache.Release(insert(&cache, "a", 2, 20));
+        EXPECT_EQ(2, lookup(&cache, "a"));
+        EXPECT_EQ(20U, cache.TotalCharge());
+        // the old value lives while pinned
+        EXPECT_EQ(0, g_deleted.load());
+        EXPECT_EQ(1, *static_cast<int*>(Cache::Value(old)));
+        cache.Release(old);
+        EXPECT_EQ(1, g_deleted.load());
+    }
+}
+
+TEST_F(CacheTest, Erase) {
+    for (CachePolicy policy : kPolicies) {
+        g_deleted.store(0);
+        Cache cache(options(100, policy));
+        cache.Release(insert(&cache, "a", 1));
+        EXPECT_TRUE(cache.Erase(Slice("a")));
+        EXPECT_FALSE(cache.Erase(Slice("a")));
+        EXPECT_EQ(1, g_deleted.load());
+        EXPECT_EQ(-1, lookup(&cache, "a"));
+
+        Cache::Handle* h = insert(&cache, "b", 2);
+        EXPECT_TRUE(cache.Erase(Slice("b")));
+        EXPECT_EQ(-1, lookup(&cache, "b"));
+        EXPECT_EQ(1, g_deleted.load());
+        cache.Release(h);
+        EXPECT_EQ(2, g_deleted.load());
+        EXPECT_EQ(0U, cache.TotalCharge());
+    }
+}
+
+TEST_F(CacheTest, EvictByCharge) {
+    for (CachePolicy policy : kPolicies) {
+        g_deleted.store(0);
+        Cache cache(options(100, policy));
+        for (int i = 0; i < 10; ++i) {
+            cache.Release(insert(&cache, std::to_string(i), i, 20));
+            EXPECT_LE(cache.TotalCharge(), 100U);
+        }
+        EXPECT_EQ(5U, cache.Stats().evictions);
+        EXPECT_EQ(5, g_deleted.load());
+        // one big entry pushes out all others
+        cache.Release(insert(&cache, "big", 0, 100));
+        EXPECT_EQ(100U, cache.TotalCharge());
+        EXPECT_EQ(0, lookup(&cache, "big"));
+    }
+}
+
+TEST_F(CacheTest, LeastRecentlyUsed) {
+    Cache cache(options(3, CACHE_POLICY_LRU));
+    cache.Release(insert(&cache, "a", 1));
+    cache.Release(insert(&cache, "b", 2));
+    cache.Release(insert(&cache, "c", 3));
+    EXPECT_EQ(1, lookup(&cache, "a"));
+    cache.Release(insert(&cache, "d", 4));
+    EXPECT_EQ(-1, lookup(&cache, "b"));
+    EXPECT_EQ(1, lookup(&cache, "a"));
+    EXPECT_EQ(3, lookup(&cache, "c"));
+    EXPECT_EQ(4, lookup(&cache, "d"));
+}
+
+TEST_F(CacheTest, SecondChance) {
+    Cache cache(options(3, CACHE_POLICY_CLOCK));
+    cache.Release(insert(&cache, "a", 1));
+    cache.Release(insert(&cache, "b", 2));
+    cache.Release(insert(&cache, "c", 3));
+    // a has its bit set: the hand clears it and takes b
+    EXPECT_EQ(1, lookup(&cache, "a"));
+    cache.Release(insert(&cache, "d", 4));
+    EXPECT_EQ(-1, lookup(&cache, "b"));
+    EXPECT_EQ(3, lookup(&cache, "c"));
+    // a lost its bit, c and d got one since: a goes
+    EXPECT_EQ(4, lookup(&cache, "d"));
+    cache.Release(insert(&cache, "e", 5));
+    EXPECT_EQ(-1, lookup(&cache, "a"));
+    EXPECT_EQ(5, lookup(&cache, "e"));
+}
+
+TEST_F(CacheTest, PinnedStay) {
+    for (CachePolicy policy : kPolicies) {
+        g_deleted.store(0);
+        Cache cache(options(2, policy));
+        std::vector<Cache::Handle*> pinned;
+        for (int i = 0; i < 4; ++i) {
+            pinned.push_back(insert(&cache, std::to_string(i), i));
+        }
+        // over capacity while everything is pinned
+        EXPECT_EQ(4U, cache.TotalCharge());
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_EQ(i, lookup(&cache, std::to_string(i)));
+        }
+        for (auto it : pinned) {
+            cache.Release(it);
+        }
+        cache.Release(insert(&cache, "x", 9));
+        EXPECT_LE(cache.TotalCharge(), 2U);
+        EXPECT_EQ(9, lookup(&cache, "x"));
+    }
+}
+
+TEST_F(CacheTest, ZeroCapacity) {
+    for (CachePolicy policy : kPolicies) {
+        g_deleted.store(0);
+        Cache cache(options(0, policy));
+        Cache::Handle* h = insert(&cache, "a", 1);
+        EXPECT_EQ(1, *static_cast<int*>(Cache::Value(h)));
+        EXPECT_EQ(-1, lookup(&cache, "a"));
+        cache.Release(h);
+        EXPECT_EQ(1, g_deleted.load());
+    }
+}
+
+TEST_F(CacheTest, Prune) {
+    for (CachePolicy policy : kPolicies) {
+        g_deleted.store(0);
+        Cache cache(options(100, policy, 4));
+        Cache::Handle* h = insert(&cache, "pinned", 0);
+        for (int i = 0; i < 10; ++i) {
+            cache.Release(insert(&cache, std::to_string(i), i));
+        }
+        cache.Prune();
+        EXPECT_EQ(10, g_deleted.load());
+        EXPECT_EQ(1U, cache.TotalCharge());
+        EXPECT_EQ(0, lookup(&cache, "pinned"));
+        cache.Release(h);
+    }
+}
+
+// threads looking up, inserting and erasing over a small key space; every
+// value must be deleted exactly once by the time the cache is gone
+TEST_F(CacheTest, Concurrent) {
+    for (CachePolicy policy : kPolicies) {
+        g_deleted.store(0);
+        std::atomic<int> created(0);
+        {
+            Cache cache(options(64, policy, 4));
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([&cache, &created, t] {
+                    std::mt19937 rng(t);
+                    for (int i = 0; i < 20000; ++i) {
+                        const std::string key = std::to_string(rng() % 200);
+                        const int op = rng() % 10;
+                        if (op < 7) {
+                            Cache::Handle* h = cache.Lookup(Slice(key));
+                            if (h != nullptr) {
+                                EXPECT_EQ(key, std::to_string(*static_cast<int*>(
+                                    Cache::Value(h))));
+                                cache.Release(h);
+                            }
+                        } else if (op < 9) {
+                            created.fetch_add(1);
+                            cache.Release(cache.Insert(Slice(key), new int(std::stoi(key)), 1,
+                                                       &deleteInt));
+                        } else {
+                            cache.Erase(Slice(key));
+                        }
+                    }
+                });
+            }
+            for (auto& it : threads) {
+                it.join();
+            }
+            EXPECT_LE(cache.TotalCharge(), 64U);
+        }
+        EXPECT_EQ(created.load(), g_deleted.load());
+    }
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
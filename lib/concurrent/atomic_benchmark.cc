@@ -0,0 +1,72 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <atomic>
+
+#include "benchmark/benchmark.h"
+#include "include/atomic.h"
+
+namespace cg {
+namespace {
+
+// Counters bumped by every thread, the way statistics are.
+
+void BM_SharedAtomic(benchmark::State& state) {
+    static Atomic<int64_t> counter;
+    for (auto _ : state) {
+        counter.FetchAdd(1, std::memory_order_relaxed);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// one atomic per thread, adjacent: the lines bounce as for a shared one
+void BM_FalseSharedAtomics(benchmark::State& state) {
+    static std::atomic<int64_t> counters[64];
+    std::atomic<int64_t>& counter = counters[state.thread_index() % 64];
+    for (auto _ : state) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_PaddedAtomics(benchmark::State& state) {
+    static CacheLinePadded<std::atomic<int64_t>> counters[64];
+    std::atomic<int64_t>& counter = counters[state.thread_index() % 64].value;
+    for (auto _ : state) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_StripedCounter(benchmark::State& state) {
+    static StripedCounter* counter = nullptr;
+    if (state.thread_index() == 0) {
+        counter = new StripedCounter;
+    }
+    for (auto _ : state) {
+        counter->Increment();
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        benchmark::DoNotOptimize(counter->Sum());
+        delete counter;
+    }
+}
+
+void BM_StripedCounterSum(benchmark::State& state) {
+    StripedCounter counter;
+    counter.Increment();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(counter.Sum());
+    }
+}
+
+BENCHMARK(BM_SharedAtomic)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_FalseSharedAtomics)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_PaddedAtomics)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_StripedCounter)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_StripedCounterSum);
+
+}  // end of anonymous namespace
+}  // end of namespace cg
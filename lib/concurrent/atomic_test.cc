@@ -0,0 +1,138 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "include/atomic.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class AtomicTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+TEST_F(AtomicTest, Simple) {
+    Atomic<int> a;
+    EXPECT_EQ(0, a());
+    a.Store(5, std::memory_order_release);
+    EXPECT_EQ(5, a.Load(std::memory_order_acquire));
+    EXPECT_EQ(6, ++a);
+    EXPECT_EQ(6, a++);
+    EXPECT_EQ(6, --a);
+    EXPECT_EQ(6, a--);
+    EXPECT_EQ(5, a.Exchange(12, std::memory_order_acq_rel));
+    EXPECT_EQ(12, a.FetchAdd(3, std::memory_order_relaxed));
+    EXPECT_EQ(15, a.FetchSub(5));
+    EXPECT_EQ(10, a.FetchOr(5));
+    EXPECT_EQ(15, a.FetchAnd(6));
+    EXPECT_EQ(6, a.FetchXor(3));
+    EXPECT_EQ(5, a.Load());
+}
+
+TEST_F(AtomicTest, CompareExchange) {
+    Atomic<uint64_t> a(7);
+    uint64_t expected = 8;
+    EXPECT_FALSE(a.CompareExchange(&expected, 9, std::memory_order_acq_rel));
+    EXPECT_EQ(7U, expected);
+    EXPECT_TRUE(a.CompareExchange(&expected, 9, std::memory_order_release));
+    EXPECT_EQ(9U, a.Load());
+    while (!a.CompareExchangeWeak(&expected, 10, std::memory_order_relaxed)) {
+    }
+    EXPECT_EQ(10U, a.Load());
+
+    int x = 0;
+    int y = 0;
+    Atomic<int*> p(&x);
+    int* old = &x;
+    EXPECT_TRUE(p.CompareExchange(&old, &y));
+    EXPECT_EQ(&y, p.Load());
+}
+
+TEST_F(AtomicTest, FetchUpdate) {
+    Atomic<int64_t> a(10);
+    EXPECT_EQ(10, a.FetchUpdate([](int64_t v) { return v * 3; }));
+    EXPECT_EQ(30, a.Load());
+    EXPECT_EQ(30, a.FetchMax(20));
+    EXPECT_EQ(30, a.FetchMax(40));
+    EXPECT_EQ(40, a.FetchMin(50));
+    EXPECT_EQ(40, a.FetchMin(-1));
+    EXPECT_EQ(-1, a.Load());
+
+    Atomic<double> d(1.5);
+    EXPECT_EQ(1.5, d.FetchUpdate([](double v) { return v + 1; }));
+    EXPECT_EQ(2.5, d.Load());
+}
+
+// the CAS loops lose no update against each other
+TEST_F(AtomicTest, Concurrent) {
+    const int kThreads = 8;
+    const int kLoops = 10000;
+    Atomic<int64_t> sum;
+    Atomic<int64_t> max(-1);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&, i] {
+            for (int j = 0; j < kLoops; ++j) {
+                sum.FetchUpdate([](int64_t v) { return v + 1; }, std::memory_order_relaxed);
+                max.FetchMax(i * kLoops + j, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& it : threads) {
+        it.join();
+    }
+    EXPECT_EQ(kThreads * kLoops, sum.Load());
+    EXPECT_EQ(kThreads * kLoops - 1, max.Load());
+}
+
+TEST_F(AtomicTest, CacheLinePadded) {
+    EXPECT_EQ(kCacheLineSize, sizeof(CacheLinePadded<char>));
+    EXPECT_EQ(kCacheLineSize, sizeof(CacheLinePadded<std::atomic<uint64_t>>));
+    EXPECT_EQ(2 * kCacheLineSize, sizeof(CacheLinePadded<char[100]>));
+    CacheLinePadded<int> padded(3);
+    EXPECT_EQ(3, padded.value);
+}
+
+TEST_F(AtomicTest, StripedCounter) {
+    const int kThreads = 8;
+    const int kLoops = 10000;
+    StripedCounter counter;
+    EXPECT_EQ(0, counter.Sum());
+    counter.Add(5);
+    counter.Increment();
+    EXPECT_EQ(6, counter.Sum());
+    counter.Reset();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&counter] {
+            for (int j = 0; j < kLoops; ++j) {
+                counter.Increment();
+            }
+            counter.Add(-kLoops / 2);
+        });
+    }
+    for (auto& it : threads) {
+        it.join();
+    }
+    EXPECT_EQ(kThreads * kLoops / 2, counter.Sum());
+}
+
+TEST_F(AtomicTest, ThreadSlot) {
+    const uint32_t slot = internal::ThreadSlot();
+    EXPECT_EQ(slot, internal::ThreadSlot());
+    uint32_t other = slot;
+    std::thread t([&other] { other = internal::ThreadSlot(); });
+    t.join();
+    EXPECT_NE(slot, other);
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
@@ -0,0 +1,97 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "concurrent/conditionvar.h"
+
+#include <time.h>
+
+namespace cg {
+namespace {
+
+// the futex deadline of deadline_ns, nullptr for none
+const struct timespec* toTimespec(int64_t deadline_ns, struct timespec* ts) {
+    if (deadline_ns < 0) {
+        return nullptr;
+    }
+    ts->tv_sec = static_cast<time_t>(deadline_ns / 1000000000);
+    ts->tv_nsec = static_cast<long>(deadline_ns % 1000000000);
+    return ts;
+}
+
+bool passed(int64_t deadline_ns) {
+    return deadline_ns >= 0 && MonotonicNs() >= deadline_ns;
+}
+
+}  // end of anonymous namespace
+
+bool ConditionVar::WaitUntil(Mutex* mu, int64_t deadline_ns) {
+    struct timespec ts;
+    const struct timespec* deadline = toTimespec(deadline_ns, &ts);
+    // read under mu: a notify after the caller tested its condition changes it
+    const uint32_t seq = seq_.load(std::memory_order_relaxed);
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    mu->Unlock();
+    internal::FutexWait(&seq_, seq, deadline);
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+    mu->Lock();
+    return !passed(deadline_ns);
+}
+
+void CountDownLatch::CountDown(uint32_t n) {
+    if (count_.fetch_sub(n, std::memory_order_acq_rel) == n) {
+        internal::FutexWake(&count_, INT32_MAX);
+    }
+}
+
+bool CountDownLatch::WaitUntil(int64_t deadline_ns) {
+    struct timespec ts;
+    const struct timespec* deadline = toTimespec(deadline_ns, &ts);
+    for (;;) {
+        const uint32_t count = count_.load(std::memory_order_acquire);
+        if (count == 0) {
+            return true;
+        }
+        if (passed(deadline_ns)) {
+            return false;
+        }
+        internal::FutexWait(&count_, count, deadline);
+    }
+}
+
+bool Barrier::Wait() {
+    const uint32_t generation = generation_.load(std::memory_order_acquire);
+    if (arrived_.fetch_add(1, std::memory_order_acq_rel) + 1 == count_) {
+        // the next round starts at the generation change, after the reset
+        arrived_.store(0, std::memory_order_relaxed);
+        generation_.fetch_add(1, std::memory_order_release);
+        internal::FutexWake(&generation_, INT32_MAX);
+        return true;
+    }
+    while (generation_.load(std::memory_order_acquire) == generation) {
+        internal::FutexWait(&generation_, generation);
+    }
+    return false;
+}
+
+bool Event::WaitUntil(int64_t deadline_ns) {
+    if (TryWait()) {
+        return true;
+    }
+    struct timespec ts;
+    const struct timespec* deadline = toTimespec(deadline_ns, &ts);
+    for (;;) {
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        internal::FutexWait(&state_, 0, deadline);
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        if (TryWait()) {
+            return true;
+        }
+        if (passed(deadline_ns)) {
+            return false;
+        }
+    }
+}
+
+}  // end of namespace cg
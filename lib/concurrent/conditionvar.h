@@ -4,9 +4,184 @@
  */
 #pragma once
 
+#include <stdint.h>
+
+#include <atomic>
+
+#include "concurrent/mutex.h"
+#include "system/timestamp.h"
+
+// Waiting on futexes. Timed waits take a deadline in the ns of MonotonicNs()
+// (system/timestamp.h) and sleep on CLOCK_MONOTONIC, so setting the wall
+// clock moves no deadline. The WaitFor versions take a timeout in ns.
+
 namespace cg {
 
+// Condition variable of a Mutex. A wait reads a sequence number, unlocks
+// and sleeps while the number is unchanged; a notify increments it and
+// makes a syscall only when there are waiters. Waits may return spuriously,
+// test the condition in a loop or use the versions taking a predicate.
 class ConditionVar {
+public:
+    ConditionVar() : seq_(0), waiters_(0) {}
+
+    ConditionVar(const ConditionVar&) = delete;
+
+    ConditionVar& operator=(const ConditionVar&) = delete;
+
+    // mu is locked by the caller, unlocked during the wait and locked again
+    // before it returns.
+    void Wait(Mutex* mu) {
+        WaitUntil(mu, -1);
+    }
+
+    // false when it returned because of the deadline; -1 for none
+    bool WaitUntil(Mutex* mu, int64_t deadline_ns);
+
+    bool WaitFor(Mutex* mu, int64_t timeout_ns) {
+        return WaitUntil(mu, MonotonicNs() + timeout_ns);
+    }
+
+    template <typename Predicate>
+    void Wait(Mutex* mu, Predicate pred) {
+        while (!pred()) {
+            Wait(mu);
+        }
+    }
+
+    // pred() at the return, false after the deadline passed
+    template <typename Predicate>
+    bool WaitUntil(Mutex* mu, int64_t deadline_ns, Predicate pred) {
+        while (!pred()) {
+            if (!WaitUntil(mu, deadline_ns)) {
+                return pred();
+            }
+        }
+        return true;
+    }
+
+    template <typename Predicate>
+    bool WaitFor(Mutex* mu, int64_t timeout_ns, Predicate pred) {
+        return WaitUntil(mu, MonotonicNs() + timeout_ns, pred);
+    }
+
+    void NotifyOne() {
+        notify(1);
+    }
+
+    void NotifyAll() {
+        notify(INT32_MAX);
+    }
+
+private:
+    void notify(int count) {
+        // seq_cst: against the waiters_ increment of a thread about to sleep
+        seq_.fetch_add(1, std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_seq_cst) != 0) {
+            internal::FutexWake(&seq_, count);
+        }
+    }
+
+private:
+    std::atomic<uint32_t> seq_;
+    std::atomic<uint32_t> waiters_;
+};
+
+// Waits until CountDown was called count times.
+class CountDownLatch {
+public:
+    explicit CountDownLatch(uint32_t count) : count_(count) {}
+
+    CountDownLatch(const CountDownLatch&) = delete;
+
+    CountDownLatch& operator=(const CountDownLatch&) = delete;
+
+    // Counting below 0 is a bug.
+    void CountDown(uint32_t n = 1);
+
+    uint32_t Count() const {
+        return count_.load(std::memory_order_acquire);
+    }
+
+    void Wait() {
+        WaitUntil(-1);
+    }
+
+    // false when the count was not 0 by the deadline
+    bool WaitUntil(int64_t deadline_ns);
+
+    bool WaitFor(int64_t timeout_ns) {
+        return WaitUntil(MonotonicNs() + timeout_ns);
+    }
+
+private:
+    std::atomic<uint32_t> count_;
+};
+
+// Lets count threads wait for each other, again and again.
+class Barrier {
+public:
+    explicit Barrier(uint32_t count) : count_(count), arrived_(0), generation_(0) {}
+
+    Barrier(const Barrier&) = delete;
+
+    Barrier& operator=(const Barrier&) = delete;
+
+    // Returns once count threads called it in this round. Returns true in
+    // exactly one of them, the last to arrive.
+    bool Wait();
+
+private:
+    const uint32_t count_;
+    std::atomic<uint32_t> arrived_;
+    std::atomic<uint32_t> generation_;
+};
+
+// Auto-reset event: Set lets one Wait through, in the waiting thread or the
+// next one to wait. Sets before a Wait count once.
+//
+// A thread sleeping until a time or an earlier change:
+//
+//   while (event.WaitUntil(next_fire_ns)) {
+//       next_fire_ns = recompute();
+//   }
+class Event {
+public:
+    Event() : state_(0), waiters_(0) {}
+
+    Event(const Event&) = delete;
+
+    Event& operator=(const Event&) = delete;
+
+    void Set() {
+        // seq_cst: against the waiters_ increment of a thread about to sleep
+        state_.store(1, std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_seq_cst) != 0) {
+            internal::FutexWake(&state_, 1);
+        }
+    }
+
+    // Consumes a Set without waiting, false if there was none.
+    bool TryWait() {
+        uint32_t set = 1;
+        return state_.compare_exchange_strong(set, 0, std::memory_order_acquire,
+                                              std::memory_order_relaxed);
+    }
+
+    void Wait() {
+        WaitUntil(-1);
+    }
+
+    // true when it consumed a Set, false after the deadline
+    bool WaitUntil(int64_t deadline_ns);
+
+    bool WaitFor(int64_t timeout_ns) {
+        return WaitUntil(MonotonicNs() + timeout_ns);
+    }
+
+private:
+    std::atomic<uint32_t> state_;  // 1 when set
+    std::atomic<uint32_t> waiters_;
 };
 
 }  // end of namespace cg
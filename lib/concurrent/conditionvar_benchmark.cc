@@ -0,0 +1,154 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "benchmark/benchmark.h"
+#include "concurrent/conditionvar.h"
+#include "system/timestamp.h"
+
+namespace cg {
+namespace {
+
+// A turn passed between two threads under a mutex, each waiting for the
+// other to hand it back: an iteration is a round trip, two wake-ups.
+template <typename Lock, typename Cond>
+class PingPong {
+public:
+    typedef std::unique_lock<Lock> Guard;
+
+    PingPong() : turn_(0), stop_(false) {}
+
+    // the other thread, waits for turn 1 and hands back turn 0
+    void Serve() {
+        Guard guard(lock_);
+        for (;;) {
+            cond_.wait(guard, [this] { return turn_ == 1 || stop_; });
+            if (stop_) {
+                return;
+            }
+            turn_ = 0;
+            cond_.notify_one();
+        }
+    }
+
+    void RoundTrip() {
+        Guard guard(lock_);
+        turn_ = 1;
+        cond_.notify_one();
+        cond_.wait(guard, [this] { return turn_ == 0; });
+    }
+
+    void Stop() {
+        Guard guard(lock_);
+        stop_ = true;
+        cond_.notify_one();
+    }
+
+private:
+    Lock lock_;
+    Cond cond_;
+    int turn_;
+    bool stop_;
+};
+
+// ConditionVar and Mutex behind the names std::condition_variable uses
+class CgCond {
+public:
+    void notify_one() {
+        cv_.NotifyOne();
+    }
+
+    template <typename Predicate>
+    void wait(std::unique_lock<Mutex>& guard, Predicate pred) {
+        cv_.Wait(guard.mutex(), pred);
+    }
+
+private:
+    ConditionVar cv_;
+};
+
+template <typename Game>
+void pingPongBenchmark(benchmark::State& state) {
+    Game game;
+    std::thread server(&Game::Serve, &game);
+    for (auto _ : state) {
+        game.RoundTrip();
+    }
+    game.Stop();
+    server.join();
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ConditionVarPingPong(benchmark::State& state) {
+    pingPongBenchmark<PingPong<Mutex, CgCond>>(state);
+}
+
+void BM_StdConditionVariablePingPong(benchmark::State& state) {
+    pingPongBenchmark<PingPong<std::mutex, std::condition_variable>>(state);
+}
+
+// two auto-reset events, no mutex
+void BM_EventPingPong(benchmark::State& state) {
+    Event ping;
+    Event pong;
+    std::atomic<bool> stop(false);
+    std::thread server([&] {
+        for (;;) {
+            ping.Wait();
+            if (stop.load(std::memory_order_relaxed)) {
+                return;
+            }
+            pong.Set();
+        }
+    });
+    for (auto _ : state) {
+        ping.Set();
+        pong.Wait();
+    }
+    stop.store(true, std::memory_order_relaxed);
+    ping.Set();
+    server.join();
+    state.SetItemsProcessed(state.iterations());
+}
+
+// how late a timed wait returns after its deadline
+void BM_EventOversleep(benchmark::State& state) {
+    Event event;
+    int64_t late = 0;
+    for (auto _ : state) {
+        const int64_t deadline = MonotonicNs() + state.range(0) * 1000;
+        event.WaitUntil(deadline);
+        late += MonotonicNs() - deadline;
+    }
+    state.counters["late_us"] = late / 1000.0 / state.iterations();
+}
+
+void BM_StdConditionVariableOversleep(benchmark::State& state) {
+    std::mutex mu;
+    std::condition_variable cv;
+    int64_t late = 0;
+    for (auto _ : state) {
+        const int64_t deadline = MonotonicNs() + state.range(0) * 1000;
+        std::unique_lock<std::mutex> guard(mu);
+        cv.wait_until(guard, std::chrono::steady_clock::time_point(
+                std::chrono::nanoseconds(deadline)));
+        late += MonotonicNs() - deadline;
+    }
+    state.counters["late_us"] = late / 1000.0 / state.iterations();
+}
+
+BENCHMARK(BM_ConditionVarPingPong)->UseRealTime();
+BENCHMARK(BM_StdConditionVariablePingPong)->UseRealTime();
+BENCHMARK(BM_EventPingPong)->UseRealTime();
+// sleeps of 100us and 1ms
+BENCHMARK(BM_EventOversleep)->Arg(100)->Arg(1000)->UseRealTime();
+BENCHMARK(BM_StdConditionVariableOversleep)->Arg(100)->Arg(1000)->UseRealTime();
+
+}  // end of anonymous namespace
+}  // end of namespace cg
@@ -0,0 +1,178 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "concurrent/conditionvar.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "concurrent/scop_lock.h"
+#include "gtest/gtest.h"
+#include "system/timestamp.h"
+
+namespace cg {
+namespace unittest {
+
+class ConditionVarTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+TEST_F(ConditionVarTest, Notify) {
+    Mutex mu;
+    ConditionVar cv;
+    int stage = 0;
+    std::thread other([&] {
+        ScopLock<Mutex> guard(&mu);
+        cv.Wait(&mu, [&stage] { return stage == 1; });
+        stage = 2;
+        cv.NotifyOne();
+    });
+    {
+        ScopLock<Mutex> guard(&mu);
+        stage = 1;
+        cv.NotifyOne();
+        cv.Wait(&mu, [&stage] { return stage == 2; });
+    }
+    other.join();
+    EXPECT_EQ(2, stage);
+}
+
+TEST_F(ConditionVarTest, NotifyAll) {
+    Mutex mu;
+    ConditionVar cv;
+    bool go = false;
+    int woken = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&] {
+            ScopLock<Mutex> guard(&mu);
+            cv.Wait(&mu, [&go] { return go; });
+            ++woken;
+        });
+    }
+    {
+        ScopLock<Mutex> guard(&mu);
+        go = true;
+    }
+    cv.NotifyAll();
+    for (auto& it : threads) {
+        it.join();
+    }
+    EXPECT_EQ(8, woken);
+}
+
+TEST_F(ConditionVarTest, Timeout) {
+    Mutex mu;
+    ConditionVar cv;
+    ScopLock<Mutex> guard(&mu);
+    const int64_t begin = MonotonicNs();
+    EXPECT_FALSE(cv.WaitFor(&mu, 20000000, [] { return false; }));
+    EXPECT_GE(MonotonicNs() - begin, 20000000);
+    EXPECT_FALSE(mu.TryLock());
+    // a deadline in the past returns at once
+    EXPECT_FALSE(cv.WaitUntil(&mu, MonotonicNs() - 1));
+    EXPECT_TRUE(cv.WaitFor(&mu, 1000, [] { return true; }));
+}
+
+TEST_F(ConditionVarTest, CountDownLatch) {
+    CountDownLatch latch(4);
+    EXPECT_FALSE(latch.WaitFor(1000000));
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 3; ++i) {
+        threads.emplace_back([&latch] { latch.CountDown(); });
+    }
+    for (auto& it : threads) {
+        it.join();
+    }
+    EXPECT_EQ(1U, latch.Count());
+    std::thread last([&latch] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        latch.CountDown();
+    });
+    latch.Wait();
+    EXPECT_EQ(0U, latch.Count());
+    EXPECT_TRUE(latch.WaitFor(0));
+    last.join();
+}
+
+// No thread passes a round before all arrived, one per round is the last.
+TEST_F(ConditionVarTest, Barrier) {
+    const int kThreads = 4;
+    const int kRounds = 200;
+    Barrier barrier(kThreads);
+    std::atomic<int> arrived(0);
+    std::atomic<int> last(0);
+    std::atomic<int> errors(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int round = 1; round <= kRounds; ++round) {
+                arrived.fetch_add(1);
+                if (barrier.Wait()) {
+                    last.fetch_add(1);
+                }
+                if (arrived.load() < round * kThreads) {
+                    errors.fetch_add(1);
+                }
+                // nobody arrives for the next round before all left this one
+                barrier.Wait();
+            }
+        });
+    }
+    for (auto& it : threads) {
+        it.join();
+    }
+    EXPECT_EQ(0, errors.load());
+    EXPECT_EQ(kRounds, last.load());
+}
+
+TEST_F(ConditionVarTest, Event) {
+    Event event;
+    EXPECT_FALSE(event.TryWait());
+    event.Set();
+    event.Set();
+    // sets count once
+    EXPECT_TRUE(event.TryWait());
+    EXPECT_FALSE(event.TryWait());
+
+    const int64_t begin = MonotonicNs();
+    EXPECT_FALSE(event.WaitFor(20000000));
+    EXPECT_GE(MonotonicNs() - begin, 20000000);
+
+    std::thread setter([&event] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        event.Set();
+    });
+    EXPECT_TRUE(event.WaitFor(10000000000LL));
+    setter.join();
+    EXPECT_FALSE(event.TryWait());
+}
+
+// Every Set of a ping-pong wakes the other side.
+TEST_F(ConditionVarTest, EventPingPong) {
+    Event ping;
+    Event pong;
+    const int kRounds = 10000;
+    std::thread other([&] {
+        for (int i = 0; i < kRounds; ++i) {
+            ping.Wait();
+            pong.Set();
+        }
+    });
+    for (int i = 0; i < kRounds; ++i) {
+        ping.Set();
+        pong.Wait();
+    }
+    other.join();
+    EXPECT_FALSE(ping.TryWait());
+    EXPECT_FALSE(pong.TryWait());
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
@@ -0,0 +1,87 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <thread>
+
+#include "concurrent/futex.h"
+
+namespace cg {
+
+// Sleeping until a lock-free condition holds, as the event counts of folly
+// and Eigen. The thread that makes the condition true calls Notify, which is
+// a fence and a load unless a thread sleeps. A waiter counts itself in, then
+// tests the condition once more before it sleeps; the notifier changed the
+// condition before it looks for waiters: one of the two sees the other.
+//
+//   // consumer
+//   events.Wait([&] { return queue.TryPop(&v); });
+//   // producer
+//   queue.TryPush(v);
+//   events.NotifyOne();
+class EventCount {
+public:
+    EventCount() : epoch_(0), waiters_(0) {}
+
+    EventCount(const EventCount&) = delete;
+
+    EventCount& operator=(const EventCount&) = delete;
+
+    // Returns once ready() returned true. ready may be the operation waited
+    // for itself, a TryPop say; it is tried a few times with a yield in
+    // between before the thread sleeps.
+    template <typename Ready>
+    void Wait(Ready ready) {
+        for (int i = 0; i < kYields; ++i) {
+            if (ready()) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+        for (;;) {
+            const uint32_t epoch = epoch_.load(std::memory_order_acquire);
+            waiters_.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (ready()) {
+                waiters_.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            // a Notify since the epoch was read makes this return at once
+            internal::FutexWait(&epoch_, epoch);
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+            if (ready()) {
+                return;
+            }
+        }
+    }
+
+    void NotifyOne() {
+        notify(1);
+    }
+
+    void NotifyAll() {
+        notify(INT32_MAX);
+    }
+
+private:
+    static const int kYields = 16;
+
+    void notify(int count) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) != 0) {
+            epoch_.fetch_add(1, std::memory_order_release);
+            internal::FutexWake(&epoch_, count);
+        }
+    }
+
+private:
+    std::atomic<uint32_t> epoch_;    // futex, bumped by a Notify that wakes
+    std::atomic<uint32_t> waiters_;  // counted in before the last test
+};
+
+}  // end of namespace cg
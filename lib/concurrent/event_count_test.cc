@@ -0,0 +1,84 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "concurrent/event_count.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class EventCountTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+TEST_F(EventCountTest, ReadyAlready) {
+    EventCount events;
+    int calls = 0;
+    events.Wait([&calls] { return ++calls == 1; });
+    EXPECT_EQ(1, calls);
+}
+
+TEST_F(EventCountTest, NotifyOne) {
+    EventCount events;
+    std::atomic<bool> go(false);
+    std::thread waiter([&] { events.Wait([&go] { return go.load(); }); });
+    // long enough for the waiter to sleep, it must be woken
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    go.store(true);
+    events.NotifyOne();
+    waiter.join();
+}
+
+TEST_F(EventCountTest, NotifyAll) {
+    EventCount events;
+    std::atomic<bool> go(false);
+    std::atomic<int> woken(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&] {
+            events.Wait([&go] { return go.load(); });
+            woken.fetch_add(1);
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    go.store(true);
+    events.NotifyAll();
+    for (auto& it : threads) {
+        it.join();
+    }
+    EXPECT_EQ(8, woken.load());
+}
+
+// a token passed back and forth: a lost wakeup hangs the test
+TEST_F(EventCountTest, PingPong) {
+    const int kRounds = 20000;
+    EventCount events;
+    std::atomic<int> turn(0);
+    std::thread other([&] {
+        for (int i = 0; i < kRounds; ++i) {
+            events.Wait([&turn, i] { return turn.load() == 2 * i + 1; });
+            turn.store(2 * i + 2);
+            events.NotifyAll();
+        }
+    });
+    for (int i = 0; i < kRounds; ++i) {
+        events.Wait([&turn, i] { return turn.load() == 2 * i; });
+        turn.store(2 * i + 1);
+        events.NotifyAll();
+    }
+    other.join();
+    EXPECT_EQ(2 * kRounds, turn.load());
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
@@ -0,0 +1,36 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <linux/futex.h>
+#include <stdint.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+
+namespace cg {
+namespace internal {
+
+// The futex syscalls on a 32 bit atomic, private to the process.
+
+// Sleeps while *addr is value, until woken or until the absolute
+// CLOCK_MONOTONIC deadline if there is one. May return spuriously.
+inline void FutexWait(std::atomic<uint32_t>* addr, uint32_t value,
+                      const struct timespec* deadline = nullptr) {
+    // FUTEX_WAIT_BITSET takes an absolute time, FUTEX_WAIT a relative one
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAIT_BITSET_PRIVATE, value,
+            deadline, nullptr, FUTEX_BITSET_MATCH_ANY);
+}
+
+// Wakes up to count threads waiting on addr, returns how many it woke.
+inline int FutexWake(std::atomic<uint32_t>* addr, int count) {
+    return static_cast<int>(syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr),
+                                    FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0));
+}
+
+}  // end of namespace internal
+}  // end of namespace cg
@@ -1 +1,160 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
 #pragma once
+
+#include <sched.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <thread>
+
+namespace cg {
+
+// What a lock went through, counted by the thread holding it.
+struct LockStats {
+    uint64_t acquisitions;
+    uint64_t contended;  // acquisitions that found the lock held
+    uint64_t spins;      // pause rounds waiting for it
+    uint64_t parks;      // futex waits, sched_yield calls for LiteLock
+    uint64_t parked_ns;  // in futex waits
+};
+
+namespace internal {
+
+// tells the cpu this is a spin loop: the sibling hyperthread gets the core
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+// The counters of LockStats, written only while the lock is held: plain
+// loads and stores, atomic for the threads reading them.
+class LockCounters {
+public:
+    LockCounters() : acquisitions_(0), contended_(0), spins_(0), parks_(0), parked_ns_(0) {}
+
+    void Acquired() {
+        add(&acquisitions_, 1);
+    }
+
+    void Contended(uint64_t spins, uint64_t parks, uint64_t parked_ns) {
+        add(&acquisitions_, 1);
+        add(&contended_, 1);
+        add(&spins_, spins);
+        add(&parks_, parks);
+        add(&parked_ns_, parked_ns);
+    }
+
+    LockStats Get() const {
+        LockStats stats;
+        stats.acquisitions = acquisitions_.load(std::memory_order_relaxed);
+        stats.contended = contended_.load(std::memory_order_relaxed);
+        stats.spins = spins_.load(std::memory_order_relaxed);
+        stats.parks = parks_.load(std::memory_order_relaxed);
+        stats.parked_ns = parked_ns_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    static void add(std::atomic<uint64_t>* counter, uint64_t n) {
+        counter->store(counter->load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> acquisitions_;
+    std::atomic<uint64_t> contended_;
+    std::atomic<uint64_t> spins_;
+    std::atomic<uint64_t> parks_;
+    std::atomic<uint64_t> parked_ns_;
+};
+
+}  // end of namespace internal
+
+// Test and test-and-set spin lock for critical sections of a few dozen
+// instructions. Waiters read the cached lock word until it looks free and
+// back off exponentially between reads; past kYieldAfter rounds, or at once
+// on a single cpu, they yield the cpu, so that a preempted holder gets to run.
+class LiteLock {
+public:
+    static const uint32_t kYieldAfter = 64;
+
+    LiteLock() : locked_(false) {}
+
+    LiteLock(const LiteLock&) = delete;
+
+    LiteLock& operator=(const LiteLock&) = delete;
+
+    void Lock() {
+        if (!locked_.exchange(true, std::memory_order_acquire)) {
+            counters_.Acquired();
+            return;
+        }
+        lockSlow();
+    }
+
+    bool TryLock() {
+        if (!locked_.load(std::memory_order_relaxed)
+            && !locked_.exchange(true, std::memory_order_acquire)) {
+            counters_.Acquired();
+            return true;
+        }
+        return false;
+    }
+
+    void Unlock() {
+        locked_.store(false, std::memory_order_release);
+    }
+
+    // for std::lock_guard and std::unique_lock
+    void lock() {
+        Lock();
+    }
+
+    bool try_lock() {
+        return TryLock();
+    }
+
+    void unlock() {
+        Unlock();
+    }
+
+    LockStats Stats() const {
+        return counters_.Get();
+    }
+
+private:
+    void lockSlow() {
+        static const uint32_t yield_after =
+            std::thread::hardware_concurrency() > 1 ? kYieldAfter : 1;
+        uint64_t spins = 0;
+        uint64_t yields = 0;
+        uint32_t backoff = 1;
+        for (;;) {
+            while (locked_.load(std::memory_order_relaxed)) {
+                for (uint32_t i = 0; i < backoff; ++i) {
+                    internal::CpuRelax();
+                }
+                if (++spins % yield_after == 0) {
+                    sched_yield();
+                    ++yields;
+                }
+                backoff = backoff < 64 ? backoff * 2 : 64;
+            }
+            if (!locked_.exchange(true, std::memory_order_acquire)) {
+                counters_.Contended(spins, yields, 0);
+                return;
+            }
+        }
+    }
+
+private:
+    std::atomic<bool> locked_;
+    internal::LockCounters counters_;
+};
+
+}  // end of namespace cg
@@ -0,0 +1,78 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "concurrent/lite_lock.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "concurrent/scop_lock.h"
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class LiteLockTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+TEST_F(LiteLockTest, Simple) {
+    LiteLock lock;
+    EXPECT_TRUE(lock.TryLock());
+    EXPECT_FALSE(lock.TryLock());
+    lock.Unlock();
+    {
+        ScopLock<LiteLock> guard(&lock);
+        EXPECT_FALSE(lock.TryLock());
+    }
+    {
+        std::lock_guard<LiteLock> guard(lock);
+    }
+    EXPECT_EQ(3U, lock.Stats().acquisitions);
+}
+
+TEST_F(LiteLockTest, Counter) {
+    LiteLock lock;
+    const int kThreads = 8;
+    const int kLoops = 20000;
+    int64_t counter = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kLoops; ++j) {
+                ScopLock<LiteLock> guard(&lock);
+                ++counter;
+            }
+        });
+    }
+    for (auto& it : threads) {
+        it.join();
+    }
+    EXPECT_EQ(kThreads * kLoops, counter);
+    EXPECT_EQ(static_cast<uint64_t>(kThreads * kLoops), lock.Stats().acquisitions);
+}
+
+// A waiter spins, then yields, while the holder sleeps.
+TEST_F(LiteLockTest, Yields) {
+    LiteLock lock;
+    lock.Lock();
+    std::thread waiter([&lock] {
+        ScopLock<LiteLock> guard(&lock);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    lock.Unlock();
+    waiter.join();
+    const LockStats stats = lock.Stats();
+    EXPECT_EQ(1U, stats.contended);
+    EXPECT_GT(stats.spins, 0U);
+    EXPECT_GT(stats.parks, 0U);
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
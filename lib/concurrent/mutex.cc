@@ -0,0 +1,62 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "concurrent/mutex.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "system/timestamp.h"
+
+namespace cg {
+namespace {
+
+// an eighth of the way from the estimate to the spins just taken
+uint32_t adapt(uint32_t estimate, uint32_t spins) {
+    const int32_t e = static_cast<int32_t>(estimate);
+    return static_cast<uint32_t>(e + (static_cast<int32_t>(spins) - e) / 8);
+}
+
+}  // end of anonymous namespace
+
+const uint32_t Mutex::kMaxSpins;
+
+void Mutex::lockSlow() {
+    static const bool kSpin = std::thread::hardware_concurrency() > 1;
+    uint64_t spins = 0;
+    if (kSpin) {
+        const uint32_t estimate = spin_limit_.load(std::memory_order_relaxed);
+        const uint32_t limit = std::min(kMaxSpins, 2 * estimate + 10);
+        uint32_t backoff = 1;
+        for (uint32_t n = 0; n < limit; ++n) {
+            uint32_t c = state_.load(std::memory_order_relaxed);
+            if (c == UNLOCKED && state_.compare_exchange_weak(c, LOCKED,
+                                                              std::memory_order_acquire,
+                                                              std::memory_order_relaxed)) {
+                spin_limit_.store(adapt(estimate, n), std::memory_order_relaxed);
+                counters_.Contended(n, 0, 0);
+                return;
+            }
+            for (uint32_t i = 0; i < backoff; ++i) {
+                internal::CpuRelax();
+            }
+            backoff = std::min<uint32_t>(backoff * 2, 16);
+        }
+        spins = limit;
+        spin_limit_.store(adapt(estimate, limit), std::memory_order_relaxed);
+    }
+    // taken as LOCKED_WAITERS: there may be others parked, Unlock must wake
+    uint64_t parks = 0;
+    int64_t parked_ns = 0;
+    while (state_.exchange(LOCKED_WAITERS, std::memory_order_acquire) != UNLOCKED) {
+        const int64_t begin = MonotonicNs();
+        internal::FutexWait(&state_, LOCKED_WAITERS);
+        parked_ns += MonotonicNs() - begin;
+        ++parks;
+    }
+    counters_.Contended(spins, parks, parked_ns);
+}
+
+}  // end of namespace cg
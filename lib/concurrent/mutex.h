@@ -1 +1,89 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
 #pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "concurrent/futex.h"
+#include "concurrent/lite_lock.h"
+
+namespace cg {
+
+// Futex mutex for short critical sections. An uncontended Lock is one CAS.
+// A contended one spins a while, reading the lock word with backoff, then
+// parks in the kernel. How long it spins adapts: it follows the spins the
+// lock took recently, as glibc's adaptive mutex does. There is no spinning
+// on a single cpu, where the holder cannot run meanwhile.
+class Mutex {
+public:
+    static const uint32_t kMaxSpins = 100;
+
+    Mutex() : state_(UNLOCKED), spin_limit_(kMaxSpins / 4) {}
+
+    Mutex(const Mutex&) = delete;
+
+    Mutex& operator=(const Mutex&) = delete;
+
+    void Lock() {
+        uint32_t c = UNLOCKED;
+        if (state_.compare_exchange_strong(c, LOCKED, std::memory_order_acquire,
+                                           std::memory_order_relaxed)) {
+            counters_.Acquired();
+            return;
+        }
+        lockSlow();
+    }
+
+    bool TryLock() {
+        uint32_t c = UNLOCKED;
+        if (state_.compare_exchange_strong(c, LOCKED, std::memory_order_acquire,
+                                           std::memory_order_relaxed)) {
+            counters_.Acquired();
+            return true;
+        }
+        return false;
+    }
+
+    void Unlock() {
+        if (state_.exchange(UNLOCKED, std::memory_order_release) == LOCKED_WAITERS) {
+            internal::FutexWake(&state_, 1);
+        }
+    }
+
+    // for std::lock_guard and std::unique_lock
+    void lock() {
+        Lock();
+    }
+
+    bool try_lock() {
+        return TryLock();
+    }
+
+    void unlock() {
+        Unlock();
+    }
+
+    LockStats Stats() const {
+        return counters_.Get();
+    }
+
+private:
+    enum State : uint32_t {
+        UNLOCKED = 0,
+        LOCKED,
+        LOCKED_WAITERS,  // maybe, Unlock wakes one
+    };
+
+    void lockSlow();
+
+private:
+    std::atomic<uint32_t> state_;
+    std::atomic<uint32_t> spin_limit_;  // spins that got the lock lately
+    internal::LockCounters counters_;
+};
+
+}  // end of namespace cg
@@ -0,0 +1,115 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <pthread.h>
+
+#include <mutex>
+
+#include "benchmark/benchmark.h"
+#include "concurrent/lite_lock.h"
+#include "concurrent/mutex.h"
+
+namespace cg {
+namespace {
+
+class PthreadSpinLock {
+public:
+    PthreadSpinLock() {
+        pthread_spin_init(&lock_, PTHREAD_PROCESS_PRIVATE);
+    }
+
+    ~PthreadSpinLock() {
+        pthread_spin_destroy(&lock_);
+    }
+
+    void lock() {
+        pthread_spin_lock(&lock_);
+    }
+
+    void unlock() {
+        pthread_spin_unlock(&lock_);
+    }
+
+private:
+    pthread_spinlock_t lock_;
+};
+
+// work of about range(0) ns inside the lock, as much again outside of it
+void work(int64_t n, uint64_t* x) {
+    for (int64_t i = 0; i < n; ++i) {
+        *x = *x * 6364136223846793005ULL + 1442695040888963407ULL;
+        benchmark::DoNotOptimize(*x);
+    }
+}
+
+void reportStats(benchmark::State& state, const LockStats& stats) {
+    if (stats.acquisitions != 0) {
+        const double acquisitions = static_cast<double>(stats.acquisitions);
+        state.counters["contended_pct"] = 100.0 * stats.contended / acquisitions;
+        state.counters["spins_per_lock"] = stats.spins / acquisitions;
+        state.counters["parks_per_lock"] = stats.parks / acquisitions;
+    }
+}
+
+// the cg locks report what their stats saw
+template <typename Lock>
+void reportStats(benchmark::State&, const Lock&) {}
+
+void reportStats(benchmark::State& state, const Mutex& lock) {
+    reportStats(state, lock.Stats());
+}
+
+void reportStats(benchmark::State& state, const LiteLock& lock) {
+    reportStats(state, lock.Stats());
+}
+
+template <typename Lock>
+void lockBenchmark(benchmark::State& state) {
+    static Lock* lock = nullptr;
+    static uint64_t shared = 0;
+    if (state.thread_index() == 0) {
+        lock = new Lock;
+    }
+    const int64_t n = state.range(0);
+    uint64_t local = state.thread_index();
+    for (auto _ : state) {
+        lock->lock();
+        work(n, &shared);
+        lock->unlock();
+        work(n, &local);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        reportStats(state, *lock);
+        delete lock;
+    }
+}
+
+void BM_Mutex(benchmark::State& state) {
+    lockBenchmark<Mutex>(state);
+}
+
+void BM_LiteLock(benchmark::State& state) {
+    lockBenchmark<LiteLock>(state);
+}
+
+void BM_StdMutex(benchmark::State& state) {
+    lockBenchmark<std::mutex>(state);
+}
+
+void BM_PthreadSpinLock(benchmark::State& state) {
+    lockBenchmark<PthreadSpinLock>(state);
+}
+
+// critical sections of nothing, ~20 and ~200 multiply-adds
+#define LOCK_BENCHMARK(name) \
+    BENCHMARK(name)->Arg(0)->Arg(20)->Arg(200)->ThreadRange(1, 64)->UseRealTime()
+
+LOCK_BENCHMARK(BM_Mutex);
+LOCK_BENCHMARK(BM_LiteLock);
+LOCK_BENCHMARK(BM_StdMutex);
+LOCK_BENCHMARK(BM_PthreadSpinLock);
+
+}  // end of anonymous namespace
+}  // end of namespace cg
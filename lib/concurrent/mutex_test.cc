@@ -0,0 +1,86 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "concurrent/mutex.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "concurrent/scop_lock.h"
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class MutexTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+TEST_F(MutexTest, Simple) {
+    Mutex mu;
+    EXPECT_TRUE(mu.TryLock());
+    EXPECT_FALSE(mu.TryLock());
+    mu.Unlock();
+    {
+        ScopLock<Mutex> guard(&mu);
+        EXPECT_FALSE(mu.TryLock());
+    }
+    {
+        std::lock_guard<Mutex> guard(mu);
+        EXPECT_FALSE(mu.TryLock());
+    }
+    EXPECT_TRUE(mu.TryLock());
+    mu.Unlock();
+    const LockStats stats = mu.Stats();
+    EXPECT_EQ(4U, stats.acquisitions);
+    EXPECT_EQ(0U, stats.contended);
+}
+
+TEST_F(MutexTest, Counter) {
+    Mutex mu;
+    const int kThreads = 8;
+    const int kLoops = 20000;
+    int64_t counter = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kLoops; ++j) {
+                ScopLock<Mutex> guard(&mu);
+                ++counter;
+            }
+        });
+    }
+    for (auto& it : threads) {
+        it.join();
+    }
+    EXPECT_EQ(kThreads * kLoops, counter);
+    const LockStats stats = mu.Stats();
+    EXPECT_EQ(static_cast<uint64_t>(kThreads * kLoops), stats.acquisitions);
+    EXPECT_LE(stats.contended, stats.acquisitions);
+}
+
+// A waiter parks while the holder sleeps, and the park time is counted.
+TEST_F(MutexTest, Parks) {
+    Mutex mu;
+    mu.Lock();
+    std::thread waiter([&mu] {
+        ScopLock<Mutex> guard(&mu);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    mu.Unlock();
+    waiter.join();
+    const LockStats stats = mu.Stats();
+    EXPECT_EQ(2U, stats.acquisitions);
+    EXPECT_EQ(1U, stats.contended);
+    EXPECT_GE(stats.parks, 1U);
+    EXPECT_GT(stats.parked_ns, 10000000U);
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
@@ -0,0 +1,96 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "concurrent/rw_lock.h"
+
+#include <sched.h>
+
+#include <climits>
+#include <new>
+
+#include "base/cpu.h"
+#include "concurrent/lite_lock.h"
+
+namespace cg {
+RWLock::RWLock(RWLockPolicy policy) : policy_(policy), state_(0) {
+    const uint32_t shards = PerCpuShards();
+    shard_mask_ = shards - 1;
+    memory_.reset(new char[shards * sizeof(Shard) + kCacheLineSize]);
+    const uintptr_t p = reinterpret_cast<uintptr_t>(memory_.get());
+    shards_ = reinterpret_cast<Shard*>((p + kCacheLineSize - 1)
+                                       & ~static_cast<uintptr_t>(kCacheLineSize - 1));
+    for (uint32_t i = 0; i < shards; ++i) {
+        new (&shards_[i]) Shard;
+        shards_[i].value.store(0, std::memory_order_relaxed);
+    }
+}
+
+void RWLock::readLockSlow(std::atomic<int32_t>* readers) {
+    for (;;) {
+        uint32_t state = state_.load(std::memory_order_seq_cst);
+        if (!blocks(state)) {
+            return;
+        }
+        // out of the way of the writer, back in once it is done
+        readers->fetch_sub(1, std::memory_order_release);
+        while (blocks(state)) {
+            if ((state & READERS_PARKED) != 0
+                || state_.compare_exchange_weak(state, state | READERS_PARKED,
+                                                std::memory_order_relaxed)) {
+                internal::FutexWait(&state_, state | READERS_PARKED);
+            }
+            state = state_.load(std::memory_order_seq_cst);
+        }
+        readers->fetch_add(1, std::memory_order_seq_cst);
+    }
+}
+
+bool RWLock::drained() const {
+    for (uint32_t i = 0; i <= shard_mask_; ++i) {
+        if (shards_[i].value.load(std::memory_order_seq_cst) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void RWLock::Lock() {
+    writer_mu_.Lock();
+    state_.fetch_or(WRITER_PENDING, std::memory_order_seq_cst);
+    uint32_t spins = 0;
+    for (;;) {
+        // read sections are short: spin, then let the readers run
+        while (!drained()) {
+            if (++spins % LiteLock::kYieldAfter == 0) {
+                sched_yield();
+            } else {
+                internal::CpuRelax();
+            }
+        }
+        if (policy_ == RW_LOCK_PREFER_WRITER) {
+            // no reader gets in while WRITER_PENDING is set
+            break;
+        }
+        // readers still get in while the writer is pending: check again
+        // once they no longer can
+        state_.fetch_or(WRITER_ACTIVE, std::memory_order_seq_cst);
+        if (drained()) {
+            break;
+        }
+        const uint32_t active = WRITER_ACTIVE | READERS_PARKED;
+        if (state_.fetch_and(~active, std::memory_order_seq_cst) & READERS_PARKED) {
+            internal::FutexWake(&state_, INT_MAX);
+        }
+    }
+}
+
+void RWLock::Unlock() {
+    if (state_.exchange(0, std::memory_order_seq_cst) & READERS_PARKED) {
+        internal::FutexWake(&state_, INT_MAX);
+    }
+    writer_mu_.Unlock();
+}
+
+}  // end of namespace cg
@@ -0,0 +1,106 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "concurrent/futex.h"
+#include "concurrent/mutex.h"
+#include "include/atomic.h"
+#include "include/macros.h"
+
+namespace cg {
+
+// Who waits when both readers and a writer want the lock.
+enum RWLockPolicy {
+    // readers coming after a waiting writer wait for it: writers are never
+    // starved, readers wait at most one write
+    RW_LOCK_PREFER_WRITER = 0,
+    // a writer waits for a moment without readers: the fastest reads, but
+    // a writer may wait as long as readers keep coming
+    RW_LOCK_PREFER_READER,
+};
+
+// Reader-writer lock for data read all the time and written rarely. Readers
+// count themselves in one of a few shards, each on a cache line of its own,
+// chosen by thread: read locks of different threads touch different lines,
+// unless a writer wants the lock. A writer announces itself in the state
+// word, waits for every shard to drain, then runs alone. Read locks are not
+// reentrant: a thread holding one must not ask again while a writer waits.
+class RWLock {
+public:
+    explicit RWLock(RWLockPolicy policy = RW_LOCK_PREFER_WRITER);
+
+    RWLock(const RWLock&) = delete;
+
+    RWLock& operator=(const RWLock&) = delete;
+
+    void ReadLock() {
+        std::atomic<int32_t>* readers = shard();
+        readers->fetch_add(1, std::memory_order_seq_cst);
+        // seq_cst against the writer announcing itself then reading the shards
+        if (LIKELY(state_.load(std::memory_order_seq_cst) == 0)) {
+            return;
+        }
+        readLockSlow(readers);
+    }
+
+    void ReadUnlock() {
+        shard()->fetch_sub(1, std::memory_order_release);
+    }
+
+    void Lock();
+
+    void Unlock();
+
+    // for std::lock_guard and std::unique_lock
+    void lock() {
+        Lock();
+    }
+
+    void unlock() {
+        Unlock();
+    }
+
+    RWLockPolicy Policy() const {
+        return policy_;
+    }
+
+private:
+    // the bits of state_
+    enum State : uint32_t {
+        WRITER_PENDING = 1,  // waits for the readers to drain
+        WRITER_ACTIVE = 2,
+        READERS_PARKED = 4,  // Unlock wakes them
+    };
+
+    typedef CacheLinePadded<std::atomic<int32_t>> Shard;
+
+    std::atomic<int32_t>* shard() {
+        return &shards_[internal::ThreadSlot() & shard_mask_].value;
+    }
+
+    void readLockSlow(std::atomic<int32_t>* readers);
+
+    bool drained() const;
+
+    // whether a reader that found state has to back out
+    bool blocks(uint32_t state) const {
+        return policy_ == RW_LOCK_PREFER_WRITER ? state != 0 : (state & WRITER_ACTIVE) != 0;
+    }
+
+private:
+    const RWLockPolicy policy_;
+    std::atomic<uint32_t> state_;
+    Mutex writer_mu_;  // one writer at a time
+    uint32_t shard_mask_;
+    std::unique_ptr<char[]> memory_;
+    Shard* shards_;  // aligned in memory_
+};
+
+}  // end of namespace cg
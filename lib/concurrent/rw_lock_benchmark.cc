@@ -0,0 +1,140 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <pthread.h>
+
+#include <mutex>
+
+#include "benchmark/benchmark.h"
+#include "concurrent/rw_lock.h"
+#include "concurrent/seq_lock.h"
+
+namespace cg {
+namespace {
+
+// What a read copies: a routing entry or a config header.
+struct Config {
+    uint64_t version;
+    uint64_t values[5];
+};
+
+class PthreadRWLock {
+public:
+    PthreadRWLock() {
+        pthread_rwlock_init(&lock_, nullptr);
+    }
+
+    ~PthreadRWLock() {
+        pthread_rwlock_destroy(&lock_);
+    }
+
+    void ReadLock() {
+        pthread_rwlock_rdlock(&lock_);
+    }
+
+    void ReadUnlock() {
+        pthread_rwlock_unlock(&lock_);
+    }
+
+    void Lock() {
+        pthread_rwlock_wrlock(&lock_);
+    }
+
+    void Unlock() {
+        pthread_rwlock_unlock(&lock_);
+    }
+
+private:
+    pthread_rwlock_t lock_;
+};
+
+class WriterPreferred : public RWLock {
+public:
+    WriterPreferred() : RWLock(RW_LOCK_PREFER_WRITER) {}
+};
+
+class ReaderPreferred : public RWLock {
+public:
+    ReaderPreferred() : RWLock(RW_LOCK_PREFER_READER) {}
+};
+
+// One write every range(0) operations, 0 for reads only.
+template <typename Lock>
+void rwBenchmark(benchmark::State& state) {
+    static Lock* lock = nullptr;
+    static Config config;
+    if (state.thread_index() == 0) {
+        lock = new Lock;
+    }
+    const int64_t every = state.range(0);
+    int64_t i = state.thread_index();
+    uint64_t sum = 0;
+    for (auto _ : state) {
+        if (every != 0 && ++i % every == 0) {
+            lock->Lock();
+            ++config.version;
+            config.values[0] = config.version;
+            lock->Unlock();
+        } else {
+            lock->ReadLock();
+            sum += config.values[0] + config.values[4];
+            lock->ReadUnlock();
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        delete lock;
+    }
+}
+
+void BM_RWLockPreferWriter(benchmark::State& state) {
+    rwBenchmark<WriterPreferred>(state);
+}
+
+void BM_RWLockPreferReader(benchmark::State& state) {
+    rwBenchmark<ReaderPreferred>(state);
+}
+
+void BM_PthreadRWLock(benchmark::State& state) {
+    rwBenchmark<PthreadRWLock>(state);
+}
+
+void BM_SeqLock(benchmark::State& state) {
+    static SeqLock<Config>* lock = nullptr;
+    if (state.thread_index() == 0) {
+        lock = new SeqLock<Config>;
+    }
+    const int64_t every = state.range(0);
+    int64_t i = state.thread_index();
+    uint64_t sum = 0;
+    for (auto _ : state) {
+        if (every != 0 && ++i % every == 0) {
+            Config config = lock->Load();
+            ++config.version;
+            config.values[0] = config.version;
+            lock->Store(config);
+        } else {
+            const Config config = lock->Load();
+            sum += config.values[0] + config.values[4];
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        delete lock;
+    }
+}
+
+// reads only, then a write per 10000, 100 and 10 operations
+#define RW_BENCHMARK(name) \
+    BENCHMARK(name)->Arg(0)->Arg(10000)->Arg(100)->Arg(10)->ThreadRange(1, 64)->UseRealTime()
+
+RW_BENCHMARK(BM_RWLockPreferWriter);
+RW_BENCHMARK(BM_RWLockPreferReader);
+RW_BENCHMARK(BM_PthreadRWLock);
+RW_BENCHMARK(BM_SeqLock);
+
+}  // end of anonymous namespace
+}  // end of namespace cg
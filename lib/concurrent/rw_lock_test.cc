@@ -0,0 +1,115 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "concurrent/rw_lock.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "concurrent/scop_lock.h"
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class RWLockTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    static void exclusion(RWLockPolicy policy);
+
+    static void policy(RWLockPolicy policy);
+};
+
+// Readers see the two halves of a pair a writer changes together, and the
+// writers do not lose increments.
+void RWLockTest::exclusion(RWLockPolicy policy) {
+    RWLock lock(policy);
+    int64_t a = 0;
+    int64_t b = 0;
+    std::atomic<bool> stop(false);
+    std::atomic<int> torn(0);
+    std::atomic<int> concurrent_readers(0);
+    std::atomic<int> max_readers(0);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                ReadScopLock<RWLock> guard(&lock);
+                const int n = concurrent_readers.fetch_add(1) + 1;
+                int prev = max_readers.load();
+                while (n > prev && !max_readers.compare_exchange_weak(prev, n)) {
+                }
+                if (a != b) {
+                    torn.fetch_add(1);
+                }
+                concurrent_readers.fetch_sub(1);
+            }
+        });
+    }
+    std::vector<std::thread> writers;
+    for (int i = 0; i < 2; ++i) {
+        writers.emplace_back([&] {
+            for (int j = 0; j < 1000; ++j) {
+                ScopLock<RWLock> guard(&lock);
+                EXPECT_EQ(0, concurrent_readers.load());
+                ++a;
+                ++b;
+            }
+        });
+    }
+    for (auto& it : writers) {
+        it.join();
+    }
+    stop = true;
+    for (auto& it : readers) {
+        it.join();
+    }
+    EXPECT_EQ(0, torn.load());
+    EXPECT_EQ(2000, a);
+    EXPECT_EQ(policy, lock.Policy());
+}
+
+// A writer waiting for a long reader holds back the readers after it only
+// when writers are preferred.
+void RWLockTest::policy(RWLockPolicy policy) {
+    RWLock lock(policy);
+    lock.ReadLock();
+    std::atomic<bool> written(false);
+    std::thread writer([&] {
+        ScopLock<RWLock> guard(&lock);
+        written = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::atomic<bool> read(false);
+    std::thread reader([&] {
+        ReadScopLock<RWLock> guard(&lock);
+        read = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(policy == RW_LOCK_PREFER_READER, read.load());
+    EXPECT_FALSE(written.load());
+    lock.ReadUnlock();
+    writer.join();
+    reader.join();
+    EXPECT_TRUE(written.load());
+    EXPECT_TRUE(read.load());
+}
+
+TEST_F(RWLockTest, Exclusion) {
+    exclusion(RW_LOCK_PREFER_WRITER);
+    exclusion(RW_LOCK_PREFER_READER);
+}
+
+TEST_F(RWLockTest, Policy) {
+    policy(RW_LOCK_PREFER_WRITER);
+    policy(RW_LOCK_PREFER_READER);
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
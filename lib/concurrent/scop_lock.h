@@ -1,8 +1,51 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
 #pragma once
 
 namespace cg {
 
+// Holds a Mutex or LiteLock, or any lock with Lock and Unlock, for a scope:
+//
+//   ScopLock<Mutex> guard(&mu_);
+template <typename Lock>
 class ScopLock {
+public:
+    explicit ScopLock(Lock* lock) : lock_(lock) {
+        lock_->Lock();
+    }
+
+    ~ScopLock() {
+        lock_->Unlock();
+    }
+
+    ScopLock(const ScopLock&) = delete;
+
+    ScopLock& operator=(const ScopLock&) = delete;
+
+private:
+    Lock* lock_;
+};
+
+// Holds the read side of a RWLock for a scope.
+template <typename Lock>
+class ReadScopLock {
+public:
+    explicit ReadScopLock(Lock* lock) : lock_(lock) {
+        lock_->ReadLock();
+    }
+
+    ~ReadScopLock() {
+        lock_->ReadUnlock();
+    }
+
+    ReadScopLock(const ReadScopLock&) = delete;
+
+    ReadScopLock& operator=(const ReadScopLock&) = delete;
+
+private:
+    Lock* lock_;
 };
 
 }  // end of namespace cg
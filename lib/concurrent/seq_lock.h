@@ -0,0 +1,95 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <sched.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <type_traits>
+
+#include "concurrent/lite_lock.h"
+
+namespace cg {
+
+// A small trivially copyable T that readers copy without writing anything
+// shared: the copy is retried when a write ran meanwhile, seen by the
+// sequence number being odd or having changed. For data read far more
+// often than written, a config snapshot or a rule table header, up to a few
+// cache lines; writers are serialized by a LiteLock.
+template <typename T>
+class SeqLock {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock copies T as bytes");
+
+    SeqLock() : seq_(0) {
+        Store(T());
+    }
+
+    explicit SeqLock(const T& v) : seq_(0) {
+        Store(v);
+    }
+
+    SeqLock(const SeqLock&) = delete;
+
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    T Load() const {
+        uint64_t buf[kWords];
+        uint32_t spins = 0;
+        for (;;) {
+            const uint32_t seq = seq_.load(std::memory_order_acquire);
+            if (!(seq & 1)) {
+                for (std::size_t i = 0; i < kWords; ++i) {
+                    buf[i] = words_[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (seq_.load(std::memory_order_relaxed) == seq) {
+                    break;
+                }
+            }
+            // a writer preempted in the middle has to run
+            if (++spins % LiteLock::kYieldAfter == 0) {
+                sched_yield();
+            } else {
+                internal::CpuRelax();
+            }
+        }
+        T v;
+        memcpy(&v, buf, sizeof(T));
+        return v;
+    }
+
+    void Store(const T& v) {
+        uint64_t buf[kWords] = {};
+        memcpy(buf, &v, sizeof(T));
+        lock_.Lock();
+        const uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < kWords; ++i) {
+            words_[i].store(buf[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+        lock_.Unlock();
+    }
+
+    // writes since the construction
+    uint32_t Version() const {
+        return seq_.load(std::memory_order_acquire) / 2 - 1;
+    }
+
+private:
+    // the bytes of T as relaxed atomic words: a read racing a write is no
+    // data race, only a copy to throw away
+    static const std::size_t kWords = (sizeof(T) + 7) / 8;
+
+    std::atomic<uint32_t> seq_;
+    LiteLock lock_;
+    std::atomic<uint64_t> words_[kWords];
+};
+
+}  // end of namespace cg
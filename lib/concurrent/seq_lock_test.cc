@@ -0,0 +1,102 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "concurrent/seq_lock.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class SeqLockTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    // every field the same: a torn copy mixes two writes
+    struct Snapshot {
+        uint64_t a;
+        uint64_t b;
+        uint32_t c;
+        uint16_t d[7];
+    };
+
+    static Snapshot make(uint64_t v) {
+        Snapshot s;
+        s.a = v;
+        s.b = v;
+        s.c = static_cast<uint32_t>(v);
+        for (auto& it : s.d) {
+            it = static_cast<uint16_t>(v);
+        }
+        return s;
+    }
+
+    static bool consistent(const Snapshot& s) {
+        for (auto it : s.d) {
+            if (it != static_cast<uint16_t>(s.a)) {
+                return false;
+            }
+        }
+        return s.a == s.b && s.c == static_cast<uint32_t>(s.a);
+    }
+};
+
+TEST_F(SeqLockTest, Simple) {
+    SeqLock<int> empty;
+    EXPECT_EQ(0, empty.Load());
+    SeqLock<Snapshot> lock(make(7));
+    EXPECT_EQ(0U, lock.Version());
+    EXPECT_EQ(7U, lock.Load().a);
+    lock.Store(make(9));
+    EXPECT_EQ(1U, lock.Version());
+    EXPECT_TRUE(consistent(lock.Load()));
+    EXPECT_EQ(9U, lock.Load().b);
+}
+
+TEST_F(SeqLockTest, NoTornReads) {
+    SeqLock<Snapshot> lock(make(0));
+    std::atomic<bool> stop(false);
+    std::atomic<int> torn(0);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            uint64_t last = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const Snapshot s = lock.Load();
+                if (!consistent(s) || s.a < last) {
+                    torn.fetch_add(1);
+                }
+                last = s.a;
+            }
+        });
+    }
+    std::vector<std::thread> writers;
+    std::atomic<uint64_t> next(1);
+    for (int i = 0; i < 2; ++i) {
+        writers.emplace_back([&] {
+            for (int j = 0; j < 50000; ++j) {
+                // the lock serializes writers, next keeps their values growing
+                lock.Store(make(next.fetch_add(1)));
+            }
+        });
+    }
+    for (auto& it : writers) {
+        it.join();
+    }
+    stop = true;
+    for (auto& it : readers) {
+        it.join();
+    }
+    EXPECT_EQ(0, torn.load());
+    EXPECT_EQ(100000U, lock.Version());
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
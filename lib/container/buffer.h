@@ -0,0 +1,139 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <string.h>
+
+#include <cstddef>
+#include <string>
+
+#include "container/small_vector.h"
+#include "include/slice.h"
+
+namespace cg {
+
+// Owned bytes, the counterpart of Slice: up to N bytes are kept inside the
+// object, longer contents go to the heap. A Buffer is what to keep when a
+// Slice would dangle, without the allocation of a std::string for short
+// keys, tokens and names. Not NUL terminated.
+//
+//   Buffer name(token);          // a copy of the bytes of a Slice
+//   table.Find(name.AsSlice());  // and a view of them again
+template <std::size_t N>
+class BasicBuffer {
+public:
+    BasicBuffer() {}
+
+    BasicBuffer(const char* data, std::size_t n) : bytes_(data, data + n) {}
+
+    explicit BasicBuffer(const Slice& s) : bytes_(s.Data(), s.Data() + s.Size()) {}
+
+    explicit BasicBuffer(const std::string& s) : bytes_(s.data(), s.data() + s.size()) {}
+
+    const char* Data() const {
+        return bytes_.data();
+    }
+
+    char* MutableData() {
+        return bytes_.data();
+    }
+
+    std::size_t Size() const {
+        return bytes_.size();
+    }
+
+    bool Empty() const {
+        return bytes_.empty();
+    }
+
+    std::size_t Capacity() const {
+        return bytes_.capacity();
+    }
+
+    // the bytes are still in the object
+    bool IsInline() const {
+        return bytes_.is_inline();
+    }
+
+    char operator[](std::size_t n) const {
+        return bytes_[n];
+    }
+
+    char& operator[](std::size_t n) {
+        return bytes_[n];
+    }
+
+    // valid until the buffer changes
+    Slice AsSlice() const {
+        return Slice(bytes_.data(), bytes_.size());
+    }
+
+    std::string ToString() const {
+        return std::string(bytes_.data(), bytes_.size());
+    }
+
+    void Assign(const Slice& s) {
+        Clear();
+        Append(s.Data(), s.Size());
+    }
+
+    void Append(const Slice& s) {
+        Append(s.Data(), s.Size());
+    }
+
+    // data may point into the buffer
+    void Append(const char* data, std::size_t n) {
+        const std::ptrdiff_t offset = in(data) ? data - Data() : -1;
+        char* dst = Extend(n);
+        memmove(dst, offset >= 0 ? Data() + offset : data, n);
+    }
+
+    void PushBack(char c) {
+        bytes_.push_back(c);
+    }
+
+    // n more zero bytes for the caller to write, where they start
+    char* Extend(std::size_t n) {
+        const std::size_t size = bytes_.size();
+        bytes_.resize(size + n);
+        return bytes_.data() + size;
+    }
+
+    void Resize(std::size_t n) {
+        bytes_.resize(n);
+    }
+
+    void Reserve(std::size_t n) {
+        bytes_.reserve(n);
+    }
+
+    // keeps the capacity
+    void Clear() {
+        bytes_.clear();
+    }
+
+private:
+    bool in(const char* p) const {
+        return p >= Data() && p < Data() + Size();
+    }
+
+private:
+    SmallVector<char, N> bytes_;
+};
+
+// one cache line
+typedef BasicBuffer<40> Buffer;
+
+template <std::size_t N>
+bool operator==(const BasicBuffer<N>& a, const Slice& b) {
+    return a.AsSlice() == b;
+}
+
+template <std::size_t N>
+bool operator!=(const BasicBuffer<N>& a, const Slice& b) {
+    return !(a == b);
+}
+
+}  // end of namespace cg
@@ -0,0 +1,95 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "container/buffer.h"
+
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class BufferTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+TEST_F(BufferTest, Inline) {
+    EXPECT_EQ(64U, sizeof(Buffer));
+    Buffer b;
+    EXPECT_TRUE(b.Empty());
+    EXPECT_TRUE(b.IsInline());
+    b.Append(Slice("hello"));
+    b.PushBack(' ');
+    b.Append("world", 5);
+    EXPECT_EQ("hello world", b.ToString());
+    EXPECT_TRUE(b == Slice("hello world"));
+    EXPECT_TRUE(b.IsInline());
+    EXPECT_EQ('w', b[6]);
+}
+
+TEST_F(BufferTest, Heap) {
+    const std::string long_text(1000, 'x');
+    Buffer b(long_text);
+    EXPECT_FALSE(b.IsInline());
+    EXPECT_EQ(1000U, b.Size());
+    EXPECT_TRUE(b.AsSlice() == Slice(long_text));
+    b.Clear();
+    EXPECT_TRUE(b.Empty());
+    b.Assign(Slice("short"));
+    EXPECT_EQ("short", b.ToString());
+}
+
+TEST_F(BufferTest, Bytes) {
+    const char bytes[] = {'a', '\0', 'b'};
+    BasicBuffer<2> b(bytes, 3);
+    EXPECT_EQ(3U, b.Size());
+    EXPECT_TRUE(b.AsSlice() == Slice(bytes, 3));
+    b[1] = '-';
+    EXPECT_EQ("a-b", b.ToString());
+    b.Resize(1);
+    EXPECT_EQ("a", b.ToString());
+}
+
+TEST_F(BufferTest, AppendSelf) {
+    Buffer b(Slice("abc"));
+    for (int i = 0; i < 6; ++i) {
+        b.Append(b.AsSlice());
+    }
+    EXPECT_EQ(3U << 6, b.Size());
+    EXPECT_TRUE(b.AsSlice().StartWith(Slice("abcabcabc")));
+    b.Assign(Slice(b.Data() + 3, 3));
+    EXPECT_EQ("abc", b.ToString());
+}
+
+TEST_F(BufferTest, Extend) {
+    Buffer b(Slice("n="));
+    char* p = b.Extend(3);
+    p[0] = '4';
+    p[1] = '2';
+    p[2] = ';';
+    EXPECT_EQ("n=42;", b.ToString());
+}
+
+TEST_F(BufferTest, CopyAndMove) {
+    for (std::size_t n : {8, 100}) {
+        const std::string text(n, 'm');
+        Buffer a(text);
+        Buffer copy(a);
+        EXPECT_TRUE(copy == a.AsSlice());
+        Buffer moved(std::move(a));
+        EXPECT_TRUE(a.Empty());
+        EXPECT_TRUE(moved == Slice(text));
+        a = std::move(moved);
+        EXPECT_TRUE(a == Slice(text));
+        EXPECT_TRUE(moved != Slice(text));
+    }
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
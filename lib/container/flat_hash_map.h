@@ -0,0 +1,435 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <string>
+#include <utility>
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#endif
+
+#include "algorithm/bit.h"
+#include "base/hash.h"
+#include "include/slice.h"
+
+namespace cg {
+namespace internal {
+
+// the control byte of a slot: the low 7 bits of the hash of its key when
+// full, else one of these, which have the sign bit
+static const int8_t kCtrlEmpty = -128;
+static const int8_t kCtrlDeleted = -2;
+
+// 16 control bytes tested at once, bit i of a result for byte i
+class CtrlGroup {
+public:
+    static const std::size_t kWidth = 16;
+
+#if defined(__x86_64__)
+    explicit CtrlGroup(const int8_t* ctrl)
+        : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+    uint32_t Match(int8_t h2) const {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+    }
+
+    // empty or deleted
+    uint32_t MatchFree() const {
+        return static_cast<uint32_t>(_mm_movemask_epi8(ctrl_));
+    }
+#else
+    explicit CtrlGroup(const int8_t* ctrl) : ctrl_(ctrl) {}
+
+    uint32_t Match(int8_t h2) const {
+        uint32_t mask = 0;
+        for (std::size_t i = 0; i < kWidth; ++i) {
+            mask |= static_cast<uint32_t>(ctrl_[i] == h2) << i;
+        }
+        return mask;
+    }
+
+    uint32_t MatchFree() const {
+        uint32_t mask = 0;
+        for (std::size_t i = 0; i < kWidth; ++i) {
+            mask |= static_cast<uint32_t>(ctrl_[i] < 0) << i;
+        }
+        return mask;
+    }
+#endif
+
+    uint32_t MatchEmpty() const {
+        return Match(kCtrlEmpty);
+    }
+
+private:
+#if defined(__x86_64__)
+    __m128i ctrl_;
+#else
+    const int8_t* ctrl_;
+#endif
+};
+
+// A key the map keeps a copy of: up to kInline bytes in the slot, a longer
+// one in an allocation of its own.
+class InlineKey {
+public:
+    static const std::size_t kInline = 16;
+
+    explicit InlineKey(const Slice& key) : size_(key.Size()) {
+        char* dst = size_ <= kInline ? inline_ : (heap_ = new char[size_]);
+        memcpy(dst, key.Data(), size_);
+    }
+
+    InlineKey(InlineKey&& other) : size_(other.size_) {
+        // the bytes or the pointer, whichever it holds
+        memcpy(inline_, other.inline_, kInline);
+        other.size_ = 0;
+    }
+
+    ~InlineKey() {
+        if (size_ > kInline) {
+            delete[] heap_;
+        }
+    }
+
+    InlineKey(const InlineKey&) = delete;
+
+    InlineKey& operator=(const InlineKey&) = delete;
+
+    Slice Get() const {
+        return Slice(size_ <= kInline ? inline_ : heap_, size_);
+    }
+
+private:
+    std::size_t size_;
+    union {
+        char* heap_;
+        char inline_[kInline];
+    };
+};
+
+// A key the map only points to, its bytes must outlive the map.
+class SliceKey {
+public:
+    explicit SliceKey(const Slice& key) : key_(key) {}
+
+    Slice Get() const {
+        return key_;
+    }
+
+private:
+    Slice key_;
+};
+
+}  // end of namespace internal
+
+// What the map takes for a key: a Slice, a C string or a std::string, looked
+// at in place. Implicit, so that no std::string is made for a lookup.
+class KeyView {
+public:
+    KeyView(const Slice& key) : key_(key) {}  // NOLINT
+
+    KeyView(const char* key) : key_(key) {}  // NOLINT
+
+    KeyView(const std::string& key) : key_(key) {}  // NOLINT
+
+    const Slice& Get() const {
+        return key_;
+    }
+
+private:
+    Slice key_;
+};
+
+// Open addressing hash map from byte strings to V, after the Swiss tables of
+// abseil. Keys and values live in one flat array of slots, with no
+// allocation per entry. A control byte per slot holds 7 bits of the hash of
+// its key; a lookup tests the 16 control bytes of a group with one SSE2
+// compare and looks at the keys of the matches only, mostly one. Groups are
+// probed in triangular steps until a group with an empty slot. The table
+// doubles at a load of 7/8; erase leaves a tombstone only in a group that
+// has no empty slot, a probe may have passed through it.
+//
+// KeyStore is internal::InlineKey, a copy of the key, or internal::SliceKey,
+// see SliceHashMap. Not thread safe.
+template <typename V, typename KeyStore = internal::InlineKey>
+class FlatHashMap {
+public:
+    FlatHashMap() : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), deleted_(0) {}
+
+    // room for n entries without growing
+    explicit FlatHashMap(std::size_t n) : FlatHashMap() {
+        Reserve(n);
+    }
+
+    ~FlatHashMap() {
+        destroy();
+    }
+
+    FlatHashMap(FlatHashMap&& other) : FlatHashMap() {
+        swap(other);
+    }
+
+    FlatHashMap& operator=(FlatHashMap&& other) {
+        if (this != &other) {
+            destroy();
+            ctrl_ = nullptr;
+            slots_ = nullptr;
+            capacity_ = size_ = deleted_ = 0;
+            swap(other);
+        }
+        return *this;
+    }
+
+    FlatHashMap(const FlatHashMap&) = delete;
+
+    FlatHashMap& operator=(const FlatHashMap&) = delete;
+
+    std::size_t Size() const {
+        return size_;
+    }
+
+    bool Empty() const {
+        return size_ == 0;
+    }
+
+    // slots, a power of two
+    std::size_t Capacity() const {
+        return capacity_;
+    }
+
+    // nullptr when the key is not there
+    V* Find(KeyView key) {
+        const std::size_t i = findIndex(key.Get(), Hash(key.Get()));
+        return i == kNotFound ? nullptr : &slots_[i].value;
+    }
+
+    const V* Find(KeyView key) const {
+        const std::size_t i = findIndex(key.Get(), Hash(key.Get()));
+        return i == kNotFound ? nullptr : &slots_[i].value;
+    }
+
+    bool Contains(KeyView key) const {
+        return Find(key) != nullptr;
+    }
+
+    // Constructs the value from args if the key is not there. Returns the
+    // value of the key and whether it was inserted.
+    template <typename... Args>
+    std::pair<V*, bool> Emplace(KeyView key, Args&&... args) {
+        const Slice& k = key.Get();
+        const uint64_t hash = Hash(k);
+        std::size_t i = findIndex(k, hash);
+        if (i != kNotFound) {
+            return std::make_pair(&slots_[i].value, false);
+        }
+        if (size_ + deleted_ >= maxLoad(capacity_)) {
+            // double, unless tombstones fill the table: then rehash in place
+            rehash(size_ * 2 < maxLoad(capacity_) ? capacity_
+                   : capacity_ == 0 ? internal::CtrlGroup::kWidth : 2 * capacity_);
+        }
+        i = findFree(hash);
+        new (&slots_[i]) Slot(k, std::forward<Args>(args)...);
+        if (ctrl_[i] == internal::kCtrlDeleted) {
+            --deleted_;
+        }
+        ctrl_[i] = h2(hash);
+        ++size_;
+        return std::make_pair(&slots_[i].value, true);
+    }
+
+    // false, and the value untouched, when the key is there
+    bool Insert(KeyView key, const V& value) {
+        return Emplace(key, value).second;
+    }
+
+    bool Insert(KeyView key, V&& value) {
+        return Emplace(key, std::move(value)).second;
+    }
+
+    // the value of key, default constructed if the key was not there
+    V& operator[](KeyView key) {
+        return *Emplace(key).first;
+    }
+
+    bool Erase(KeyView key) {
+        const std::size_t i = findIndex(key.Get(), Hash(key.Get()));
+        if (i == kNotFound) {
+            return false;
+        }
+        slots_[i].~Slot();
+        const std::size_t group = i & ~(internal::CtrlGroup::kWidth - 1);
+        if (internal::CtrlGroup(ctrl_ + group).MatchEmpty() != 0) {
+            // probes stop at this group anyway
+            ctrl_[i] = internal::kCtrlEmpty;
+        } else {
+            ctrl_[i] = internal::kCtrlDeleted;
+            ++deleted_;
+        }
+        --size_;
+        return true;
+    }
+
+    // keeps the capacity
+    void Clear() {
+        destroySlots();
+        if (capacity_ != 0) {
+            memset(ctrl_, internal::kCtrlEmpty, capacity_);
+        }
+        size_ = 0;
+        deleted_ = 0;
+    }
+
+    void Reserve(std::size_t n) {
+        std::size_t capacity = internal::CtrlGroup::kWidth;
+        while (maxLoad(capacity) < n) {
+            capacity *= 2;
+        }
+        if (capacity > capacity_) {
+            rehash(capacity);
+        }
+    }
+
+    // func(Slice key, V& value) for every entry, in no order
+    template <typename Func>
+    void ForEach(Func func) {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                func(slots_[i].key.Get(), slots_[i].value);
+            }
+        }
+    }
+
+    template <typename Func>
+    void ForEach(Func func) const {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                func(slots_[i].key.Get(), static_cast<const V&>(slots_[i].value));
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        KeyStore key;
+        V value;
+
+        template <typename... Args>
+        explicit Slot(const Slice& k, Args&&... args)
+            : key(k), value(std::forward<Args>(args)...) {}
+    };
+
+    static const std::size_t kNotFound = static_cast<std::size_t>(-1);
+
+    static int8_t h2(uint64_t hash) {
+        return static_cast<int8_t>(hash & 0x7f);
+    }
+
+    static std::size_t maxLoad(std::size_t capacity) {
+        return capacity - capacity / 8;
+    }
+
+    std::size_t findIndex(const Slice& key, uint64_t hash) const {
+        if (capacity_ == 0) {
+            return kNotFound;
+        }
+        const std::size_t kWidth = internal::CtrlGroup::kWidth;
+        const std::size_t mask = capacity_ / kWidth - 1;
+        std::size_t group = (hash >> 7) & mask;
+        for (std::size_t step = 1;; ++step) {
+            const internal::CtrlGroup ctrl(ctrl_ + group * kWidth);
+            for (uint32_t match = ctrl.Match(h2(hash)); match != 0; match &= match - 1) {
+                const std::size_t i = group * kWidth + CountTrailingZeros(match);
+                if (slots_[i].key.Get() == key) {
+                    return i;
+                }
+            }
+            if (ctrl.MatchEmpty() != 0) {
+                return kNotFound;
+            }
+            // triangular steps visit every group of a power of two
+            group = (group + step) & mask;
+        }
+    }
+
+    // the first empty or deleted slot on the probe path of hash
+    std::size_t findFree(uint64_t hash) const {
+        const std::size_t kWidth = internal::CtrlGroup::kWidth;
+        const std::size_t mask = capacity_ / kWidth - 1;
+        std::size_t group = (hash >> 7) & mask;
+        for (std::size_t step = 1;; ++step) {
+            const uint32_t free = internal::CtrlGroup(ctrl_ + group * kWidth).MatchFree();
+            if (free != 0) {
+                return group * kWidth + CountTrailingZeros(free);
+            }
+            group = (group + step) & mask;
+        }
+    }
+
+    void rehash(std::size_t capacity) {
+        int8_t* old_ctrl = ctrl_;
+        Slot* old_slots = slots_;
+        const std::size_t old_capacity = capacity_;
+        ctrl_ = new int8_t[capacity];
+        memset(ctrl_, internal::kCtrlEmpty, capacity);
+        slots_ = static_cast<Slot*>(::operator new(sizeof(Slot) * capacity));
+        capacity_ = capacity;
+        deleted_ = 0;
+        for (std::size_t i = 0; i < old_capacity; ++i) {
+            if (old_ctrl[i] >= 0) {
+                const uint64_t hash = Hash(old_slots[i].key.Get());
+                const std::size_t j = findFree(hash);
+                new (&slots_[j]) Slot(std::move(old_slots[i]));
+                ctrl_[j] = h2(hash);
+                old_slots[i].~Slot();
+            }
+        }
+        delete[] old_ctrl;
+        ::operator delete(old_slots);
+    }
+
+    void destroySlots() {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                slots_[i].~Slot();
+            }
+        }
+    }
+
+    void destroy() {
+        destroySlots();
+        delete[] ctrl_;
+        ::operator delete(slots_);
+    }
+
+    void swap(FlatHashMap& other) {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(deleted_, other.deleted_);
+    }
+
+private:
+    int8_t* ctrl_;
+    Slot* slots_;
+    std::size_t capacity_;
+    std::size_t size_;
+    std::size_t deleted_;  // tombstones
+};
+
+// A FlatHashMap that does not copy its keys, as SkipList: the bytes of a key
+// must outlive the map, typically they come from an Arena.
+template <typename V>
+using SliceHashMap = FlatHashMap<V, internal::SliceKey>;
+
+}  // end of namespace cg
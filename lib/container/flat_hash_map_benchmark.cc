@@ -0,0 +1,225 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <stdint.h>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "base/hash.h"
+#include "container/flat_hash_map.h"
+
+namespace cg {
+namespace {
+
+const int kKeys = 1 << 20;
+
+// 1M distinct keys of 8 to 24 bytes, and as many that are not among them
+struct Keys {
+    std::vector<std::string> hit;
+    std::vector<std::string> miss;
+
+    Keys() {
+        std::mt19937_64 rng(3);
+        for (int i = 0; i < kKeys; ++i) {
+            const std::string tail(rng() % 17, 'x');
+            hit.push_back("k" + std::to_string(i) + "/" + tail);
+            miss.push_back("m" + std::to_string(i) + "/" + tail);
+        }
+        std::shuffle(hit.begin(), hit.end(), rng);
+    }
+};
+
+const Keys& keys() {
+    static const Keys keys;
+    return keys;
+}
+
+// the maps behind one interface
+struct FlatMap {
+    FlatHashMap<int> map;
+
+    void Insert(const std::string& key, int value) {
+        map.Insert(key, value);
+    }
+
+    bool Find(const std::string& key) const {
+        return map.Find(key) != nullptr;
+    }
+
+    bool Find(const char* key) const {
+        return map.Find(key) != nullptr;
+    }
+
+    void Erase(const std::string& key) {
+        map.Erase(key);
+    }
+};
+
+// keys pointing into keys(), not copied
+struct FlatSliceMap {
+    SliceHashMap<int> map;
+
+    void Insert(const std::string& key, int value) {
+        map.Insert(Slice(key), value);
+    }
+
+    bool Find(const std::string& key) const {
+        return map.Find(key) != nullptr;
+    }
+
+    bool Find(const char* key) const {
+        return map.Find(key) != nullptr;
+    }
+
+    void Erase(const std::string& key) {
+        map.Erase(key);
+    }
+};
+
+struct StdMap {
+    std::unordered_map<std::string, int> map;
+
+    void Insert(const std::string& key, int value) {
+        map.emplace(key, value);
+    }
+
+    bool Find(const std::string& key) const {
+        return map.find(key) != map.end();
+    }
+
+    // a std::string is made for the lookup
+    bool Find(const char* key) const {
+        return map.find(key) != map.end();
+    }
+
+    void Erase(const std::string& key) {
+        map.erase(key);
+    }
+};
+
+template <typename Map>
+void fill(Map* map) {
+    const std::vector<std::string>& hit = keys().hit;
+    for (int i = 0; i < kKeys; ++i) {
+        map->Insert(hit[i], i);
+    }
+}
+
+template <typename Map>
+void BM_Insert(benchmark::State& state) {
+    keys();
+    for (auto _ : state) {
+        Map map;
+        fill(&map);
+        benchmark::DoNotOptimize(&map);
+        state.PauseTiming();
+        {
+            Map dead(std::move(map));
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * kKeys);
+}
+
+template <typename Map>
+void BM_LookupHit(benchmark::State& state) {
+    Map map;
+    fill(&map);
+    const std::vector<std::string>& hit = keys().hit;
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.Find(hit[i]));
+        i = (i + 1) & (kKeys - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Map>
+void BM_LookupMiss(benchmark::State& state) {
+    Map map;
+    fill(&map);
+    const std::vector<std::string>& miss = keys().miss;
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.Find(miss[i]));
+        i = (i + 1) & (kKeys - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// looked up by const char*
+template <typename Map>
+void BM_LookupCString(benchmark::State& state) {
+    Map map;
+    fill(&map);
+    const std::vector<std::string>& hit = keys().hit;
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.Find(hit[i].c_str()));
+        i = (i + 1) & (kKeys - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Map>
+void BM_Erase(benchmark::State& state) {
+    const std::vector<std::string>& hit = keys().hit;
+    for (auto _ : state) {
+        state.PauseTiming();
+        Map map;
+        fill(&map);
+        state.ResumeTiming();
+        for (int i = 0; i < kKeys; ++i) {
+            map.Erase(hit[i]);
+        }
+        state.PauseTiming();
+        {
+            Map dead(std::move(map));
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * kKeys);
+}
+
+void BM_Hash(benchmark::State& state) {
+    const std::string s(state.range(0), 'h');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Hash(s.data(), s.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_StdHash(benchmark::State& state) {
+    const std::string s(state.range(0), 'h');
+    std::hash<std::string> hash;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hash(s));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_Insert, FlatMap)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Insert, FlatSliceMap)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Insert, StdMap)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_LookupHit, FlatMap);
+BENCHMARK_TEMPLATE(BM_LookupHit, FlatSliceMap);
+BENCHMARK_TEMPLATE(BM_LookupHit, StdMap);
+BENCHMARK_TEMPLATE(BM_LookupMiss, FlatMap);
+BENCHMARK_TEMPLATE(BM_LookupMiss, StdMap);
+BENCHMARK_TEMPLATE(BM_LookupCString, FlatMap);
+BENCHMARK_TEMPLATE(BM_LookupCString, StdMap);
+BENCHMARK_TEMPLATE(BM_Erase, FlatMap)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Erase, StdMap)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_Hash)->Arg(8)->Arg(16)->Arg(64)->Arg(1024);
+BENCHMARK(BM_StdHash)->Arg(8)->Arg(16)->Arg(64)->Arg(1024);
+
+}  // end of anonymous namespace
+}  // end of namespace cg
@@ -0,0 +1,241 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "container/flat_hash_map.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class FlatHashMapTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    // every entry of map is in expect and the other way round
+    template <typename Map>
+    void checkSame(const Map& map, const std::unordered_map<std::string, int>& expect) {
+        ASSERT_EQ(expect.size(), map.Size());
+        for (const auto& it : expect) {
+            const int* value = map.Find(it.first);
+            ASSERT_NE(nullptr, value) << it.first;
+            ASSERT_EQ(it.second, *value) << it.first;
+        }
+        std::size_t seen = 0;
+        map.ForEach([&](const Slice& key, const int& value) {
+            auto it = expect.find(key.ToString());
+            ASSERT_TRUE(it != expect.end());
+            ASSERT_EQ(it->second, value);
+            ++seen;
+        });
+        ASSERT_EQ(expect.size(), seen);
+    }
+};
+
+// counts the live values, to see that the map destroys what it holds
+struct Counted {
+    static int live;
+
+    int value;
+
+    explicit Counted(int v = 0) : value(v) {
+        ++live;
+    }
+
+    Counted(const Counted& other) : value(other.value) {
+        ++live;
+    }
+
+    ~Counted() {
+        --live;
+    }
+};
+
+int Counted::live = 0;
+
+TEST_F(FlatHashMapTest, Empty) {
+    FlatHashMap<int> map;
+    EXPECT_TRUE(map.Empty());
+    EXPECT_EQ(0U, map.Capacity());
+    EXPECT_EQ(nullptr, map.Find("a"));
+    EXPECT_FALSE(map.Erase("a"));
+    map.ForEach([](const Slice&, int&) { FAIL(); });
+}
+
+TEST_F(FlatHashMapTest, InsertFindErase) {
+    FlatHashMap<int> map;
+    EXPECT_TRUE(map.Insert("one", 1));
+    EXPECT_TRUE(map.Insert("two", 2));
+    EXPECT_FALSE(map.Insert("one", 10));
+    EXPECT_EQ(2U, map.Size());
+    EXPECT_EQ(1, *map.Find("one"));
+    EXPECT_EQ(2, *map.Find("two"));
+    EXPECT_EQ(nullptr, map.Find("three"));
+
+    map["three"] = 3;
+    map["one"] += 10;
+    EXPECT_EQ(11, *map.Find("one"));
+    EXPECT_EQ(3, *map.Find("three"));
+    EXPECT_EQ(0, map["four"]);
+    EXPECT_EQ(4U, map.Size());
+
+    EXPECT_TRUE(map.Erase("one"));
+    EXPECT_FALSE(map.Erase("one"));
+    EXPECT_FALSE(map.Contains("one"));
+    EXPECT_TRUE(map.Contains("two"));
+    EXPECT_EQ(3U, map.Size());
+
+    map.Clear();
+    EXPECT_TRUE(map.Empty());
+    EXPECT_FALSE(map.Contains("two"));
+    EXPECT_NE(0U, map.Capacity());
+}
+
+TEST_F(FlatHashMapTest, KeyKinds) {
+    FlatHashMap<int> map;
+    const std::string key = "string key";
+    map.Insert(key, 1);
+    EXPECT_EQ(1, *map.Find("string key"));
+    EXPECT_EQ(1, *map.Find(Slice(key)));
+    EXPECT_EQ(1, *map.Find(key));
+    const char bytes[] = {'a', '\0', 'b'};
+    map.Insert(Slice(bytes, 3), 2);
+    EXPECT_EQ(2, *map.Find(Slice(bytes, 3)));
+    EXPECT_EQ(nullptr, map.Find("a"));
+    map.Insert("", 3);
+    EXPECT_EQ(3, *map.Find(""));
+}
+
+// keys around the inline size, and the map keeps its own copy
+TEST_F(FlatHashMapTest, KeyLengths) {
+    FlatHashMap<int> map;
+    std::string key;
+    for (int n = 0; n < 100; ++n) {
+        map.Insert(key, n);
+        key.push_back(static_cast<char>('a' + n % 26));
+    }
+    key.clear();
+    for (int n = 0; n < 100; ++n) {
+        ASSERT_EQ(n, *map.Find(key));
+        key.push_back(static_cast<char>('a' + n % 26));
+    }
+    // moved through a rehash
+    map.Reserve(10000);
+    key.clear();
+    for (int n = 0; n < 100; ++n) {
+        ASSERT_EQ(n, *map.Find(key));
+        key.push_back(static_cast<char>('a' + n % 26));
+    }
+}
+
+TEST_F(FlatHashMapTest, SliceKeys) {
+    std::vector<std::string> keys;
+    for (int i = 0; i < 1000; ++i) {
+        keys.push_back("slice key " + std::to_string(i));
+    }
+    SliceHashMap<int> map;
+    for (int i = 0; i < 1000; ++i) {
+        map.Insert(Slice(keys[i]), i);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(i, *map.Find(keys[i]));
+    }
+    EXPECT_EQ(1000U, map.Size());
+}
+
+TEST_F(FlatHashMapTest, MoveOnlyValues) {
+    FlatHashMap<std::unique_ptr<int>> map;
+    for (int i = 0; i < 100; ++i) {
+        map.Emplace(std::to_string(i), new int(i));
+    }
+    std::unique_ptr<int> extra(new int(-1));
+    EXPECT_FALSE(map.Insert("7", std::move(extra)));
+    ASSERT_NE(nullptr, extra);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(i, **map.Find(std::to_string(i)));
+    }
+
+    FlatHashMap<std::unique_ptr<int>> other(std::move(map));
+    EXPECT_EQ(0U, map.Size());
+    EXPECT_EQ(100U, other.Size());
+    map = std::move(other);
+    EXPECT_EQ(100U, map.Size());
+    EXPECT_EQ(42, **map.Find("42"));
+}
+
+TEST_F(FlatHashMapTest, DestroysValues) {
+    Counted::live = 0;
+    {
+        FlatHashMap<Counted> map;
+        for (int i = 0; i < 1000; ++i) {
+            map.Emplace(std::to_string(i), i);
+        }
+        for (int i = 0; i < 1000; i += 2) {
+            map.Erase(std::to_string(i));
+        }
+        EXPECT_EQ(500, Counted::live);
+        map.Clear();
+        EXPECT_EQ(0, Counted::live);
+        map.Emplace("x", 1);
+    }
+    EXPECT_EQ(0, Counted::live);
+}
+
+TEST_F(FlatHashMapTest, Reserve) {
+    FlatHashMap<int> map(1000);
+    const std::size_t capacity = map.Capacity();
+    EXPECT_GE(capacity - capacity / 8, 1000U);
+    for (int i = 0; i < 1000; ++i) {
+        map.Insert(std::to_string(i), i);
+    }
+    EXPECT_EQ(capacity, map.Capacity());
+}
+
+// random inserts and erases against std::unordered_map, few keys so that
+// tombstones pile up and the table is rehashed in place
+TEST_F(FlatHashMapTest, Churn) {
+    FlatHashMap<int> map;
+    std::unordered_map<std::string, int> expect;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 200000; ++i) {
+        const std::string key = "k" + std::to_string(rng() % 300);
+        if (rng() % 2 == 0) {
+            ASSERT_EQ(expect.emplace(key, i).second, map.Insert(key, i));
+        } else {
+            ASSERT_EQ(expect.erase(key) == 1, map.Erase(key));
+        }
+    }
+    checkSame(map, expect);
+    EXPECT_LE(map.Capacity(), 1024U);
+}
+
+TEST_F(FlatHashMapTest, Grow) {
+    FlatHashMap<int> map;
+    std::unordered_map<std::string, int> expect;
+    for (int i = 0; i < 100000; ++i) {
+        const std::string key = "grow/" + std::to_string(i * 7919);
+        map.Insert(key, i);
+        expect.emplace(key, i);
+    }
+    checkSame(map, expect);
+    for (int i = 0; i < 100000; i += 3) {
+        const std::string key = "grow/" + std::to_string(i * 7919);
+        ASSERT_TRUE(map.Erase(key));
+        expect.erase(key);
+    }
+    checkSame(map, expect);
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
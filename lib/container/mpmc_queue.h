@@ -0,0 +1,179 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "algorithm/bit.h"
+#include "concurrent/event_count.h"
+#include "include/atomic.h"
+
+namespace cg {
+
+// Bounded queue of any number of producer and consumer threads, Dmitry
+// Vyukov's: a ring of a power of two slots, each with a sequence number
+// that says whose turn it is. A producer claims the slot at enqueue_pos_ by
+// a CAS when its sequence equals the position, fills it and sets the
+// sequence to position + 1; a consumer claims the slot at dequeue_pos_ when
+// the sequence is position + 1, empties it and sets it to position +
+// capacity, the producer's turn of the next lap. Producers and consumers
+// meet only on the slots, not on a lock or each other's index.
+//
+// Try calls never block; a Try may fail while a slot is being filled or
+// emptied by a thread that claimed it. Push blocks while the ring is full,
+// Pop while it is empty; they yield a while, then sleep on a futex.
+template <typename T>
+class MpmcQueue {
+public:
+    // capacity rounded up to a power of two, at least 2: with one slot a
+    // full and an empty ring have the same sequence
+    explicit MpmcQueue(std::size_t capacity)
+        : mask_(NextPowerOfTwo<uint64_t>(std::max<std::size_t>(capacity, 2)) - 1),
+          slots_(new Slot[mask_ + 1]),
+          enqueue_pos_(0), dequeue_pos_(0) {
+        for (uint64_t i = 0; i <= mask_; ++i) {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpmcQueue() {
+        for (uint64_t i = dequeue_pos_.load(std::memory_order_relaxed);
+             i != enqueue_pos_.load(std::memory_order_relaxed); ++i) {
+            slots_[i & mask_].Item()->~T();
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    std::size_t Capacity() const {
+        return static_cast<std::size_t>(mask_ + 1);
+    }
+
+    // approximate while threads run: claimed pushes less claimed pops
+    std::size_t Size() const {
+        const uint64_t dequeue = dequeue_pos_.load(std::memory_order_acquire);
+        const uint64_t enqueue = enqueue_pos_.load(std::memory_order_acquire);
+        return enqueue > dequeue ? static_cast<std::size_t>(enqueue - dequeue) : 0;
+    }
+
+    bool Empty() const {
+        return Size() == 0;
+    }
+
+    // false when full, args untouched then
+    template <typename... Args>
+    bool TryEmplace(Args&&... args) {
+        uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots_[pos & mask_];
+            const uint64_t seq = slot->seq.load(std::memory_order_acquire);
+            const int64_t diff = static_cast<int64_t>(seq - pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                       std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // the item of the last lap is still there
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        new (slot->Item()) T(std::forward<Args>(args)...);
+        slot->seq.store(pos + 1, std::memory_order_release);
+        not_empty_.NotifyOne();
+        return true;
+    }
+
+    bool TryPush(const T& item) {
+        return TryEmplace(item);
+    }
+
+    // item is moved from only when pushed
+    bool TryPush(T&& item) {
+        return TryEmplace(std::move(item));
+    }
+
+    void Push(const T& item) {
+        if (!TryPush(item)) {
+            not_full_.Wait([&] { return TryPush(item); });
+        }
+    }
+
+    void Push(T&& item) {
+        if (!TryPush(std::move(item))) {
+            not_full_.Wait([&] { return TryPush(std::move(item)); });
+        }
+    }
+
+    // false when empty
+    bool TryPop(T* item) {
+        uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots_[pos & mask_];
+            const uint64_t seq = slot->seq.load(std::memory_order_acquire);
+            const int64_t diff = static_cast<int64_t>(seq - (pos + 1));
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                       std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // empty, or the producer of the slot has not filled it yet
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        T* stored = slot->Item();
+        *item = std::move(*stored);
+        stored->~T();
+        slot->seq.store(pos + mask_ + 1, std::memory_order_release);
+        not_full_.NotifyOne();
+        return true;
+    }
+
+    void Pop(T* item) {
+        if (!TryPop(item)) {
+            not_empty_.Wait([&] { return TryPop(item); });
+        }
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        T* Item() {
+            return reinterpret_cast<T*>(&storage);
+        }
+    };
+
+private:
+    // read by all, written by none
+    const uint64_t mask_;
+    const std::unique_ptr<Slot[]> slots_;
+    char pad0_[kCacheLineSize];
+    std::atomic<uint64_t> enqueue_pos_;
+    char pad1_[kCacheLineSize];
+    std::atomic<uint64_t> dequeue_pos_;
+    char pad2_[kCacheLineSize];
+    EventCount not_empty_;  // consumers sleep on it
+    EventCount not_full_;   // producers sleep on it
+};
+
+}  // end of namespace cg
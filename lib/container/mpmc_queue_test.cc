@@ -0,0 +1,152 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "container/mpmc_queue.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class MpmcQueueTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    // producers push (producer << 32 | i), consumers check that the items of
+    // every producer come in order and that none is lost or doubled
+    void Run(int producers, int consumers, std::size_t capacity, uint64_t per_producer) {
+        MpmcQueue<uint64_t> queue(capacity);
+        const uint64_t total = per_producer * producers;
+        std::atomic<uint64_t> popped(0);
+        std::atomic<uint64_t> sum(0);
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&queue, p, per_producer] {
+                for (uint64_t i = 0; i < per_producer; ++i) {
+                    queue.Push(static_cast<uint64_t>(p) << 32 | i);
+                }
+            });
+        }
+        std::atomic<bool> ordered(true);
+        for (int c = 0; c < consumers; ++c) {
+            threads.emplace_back([&, producers] {
+                std::vector<int64_t> last(producers, -1);
+                uint64_t local = 0;
+                while (popped.fetch_add(1) < total) {
+                    uint64_t item;
+                    queue.Pop(&item);
+                    const int p = static_cast<int>(item >> 32);
+                    const int64_t i = static_cast<int64_t>(item & 0xffffffff);
+                    if (i <= last[p]) {
+                        ordered.store(false);
+                    }
+                    last[p] = i;
+                    local += i;
+                }
+                sum.fetch_add(local);
+            });
+        }
+        for (auto& it : threads) {
+            it.join();
+        }
+        EXPECT_TRUE(ordered.load());
+        EXPECT_EQ(producers * per_producer * (per_producer - 1) / 2, sum.load());
+        EXPECT_TRUE(queue.Empty());
+    }
+};
+
+TEST_F(MpmcQueueTest, Capacity) {
+    EXPECT_EQ(2U, MpmcQueue<int>(1).Capacity());
+    EXPECT_EQ(8U, MpmcQueue<int>(5).Capacity());
+    EXPECT_EQ(1024U, MpmcQueue<int>(1024).Capacity());
+}
+
+TEST_F(MpmcQueueTest, Fifo) {
+    MpmcQueue<int> queue(4);
+    int item = 0;
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_FALSE(queue.TryPop(&item));
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.TryPush(i));
+    }
+    EXPECT_FALSE(queue.TryPush(4));
+    EXPECT_EQ(4U, queue.Size());
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.TryPop(&item));
+        EXPECT_EQ(i, item);
+    }
+    EXPECT_FALSE(queue.TryPop(&item));
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(queue.TryPush(i));
+        EXPECT_TRUE(queue.TryPop(&item));
+        EXPECT_EQ(i, item);
+    }
+}
+
+TEST_F(MpmcQueueTest, TwoSlots) {
+    MpmcQueue<int> queue(2);
+    int item = 0;
+    EXPECT_TRUE(queue.TryPush(1));
+    EXPECT_TRUE(queue.TryPush(2));
+    EXPECT_FALSE(queue.TryPush(3));
+    EXPECT_TRUE(queue.TryPop(&item));
+    EXPECT_EQ(1, item);
+    EXPECT_TRUE(queue.TryPush(3));
+    EXPECT_FALSE(queue.TryPush(4));
+    EXPECT_TRUE(queue.TryPop(&item));
+    EXPECT_EQ(2, item);
+    EXPECT_TRUE(queue.TryPop(&item));
+    EXPECT_EQ(3, item);
+    EXPECT_FALSE(queue.TryPop(&item));
+}
+
+TEST_F(MpmcQueueTest, MoveOnlyWhenPushed) {
+    MpmcQueue<std::unique_ptr<int>> queue(2);
+    EXPECT_TRUE(queue.TryEmplace(new int(1)));
+    EXPECT_TRUE(queue.TryEmplace(new int(2)));
+    std::unique_ptr<int> b(new int(3));
+    EXPECT_FALSE(queue.TryPush(std::move(b)));
+    ASSERT_NE(nullptr, b);
+
+    std::unique_ptr<int> out;
+    EXPECT_TRUE(queue.TryPop(&out));
+    EXPECT_EQ(1, *out);
+    EXPECT_TRUE(queue.TryPush(std::move(b)));
+    EXPECT_EQ(nullptr, b);
+    // the one left is freed by the queue
+}
+
+TEST_F(MpmcQueueTest, OneToOne) {
+    Run(1, 1, 16, 200000);
+}
+
+TEST_F(MpmcQueueTest, ManyToOne) {
+    Run(4, 1, 16, 50000);
+}
+
+TEST_F(MpmcQueueTest, OneToMany) {
+    Run(1, 4, 16, 200000);
+}
+
+TEST_F(MpmcQueueTest, ManyToMany) {
+    Run(4, 4, 64, 50000);
+}
+
+// more threads than slots: most of them sleep most of the time
+TEST_F(MpmcQueueTest, Crowded) {
+    Run(8, 8, 2, 10000);
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
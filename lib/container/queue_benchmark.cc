@@ -0,0 +1,202 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <stdint.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "container/mpmc_queue.h"
+#include "container/spsc_queue.h"
+
+namespace cg {
+namespace {
+
+// messages an iteration passes through a queue
+const int64_t kMessages = 1 << 16;
+const std::size_t kCapacity = 1024;
+
+// The queue one writes first: a std::deque under a mutex, two condition
+// variables, bounded as the others.
+template <typename T>
+class MutexQueue {
+public:
+    explicit MutexQueue(std::size_t capacity) : capacity_(capacity) {}
+
+    bool TryPush(const T& item) {
+        {
+            std::lock_guard<std::mutex> guard(mu_);
+            if (queue_.size() >= capacity_) {
+                return false;
+            }
+            queue_.push_back(item);
+        }
+        not_empty_.notify_one();
+        return true;
+    }
+
+    void Push(const T& item) {
+        {
+            std::unique_lock<std::mutex> lock(mu_);
+            not_full_.wait(lock, [this] { return queue_.size() < capacity_; });
+            queue_.push_back(item);
+        }
+        not_empty_.notify_one();
+    }
+
+    bool TryPop(T* item) {
+        {
+            std::lock_guard<std::mutex> guard(mu_);
+            if (queue_.empty()) {
+                return false;
+            }
+            *item = queue_.front();
+            queue_.pop_front();
+        }
+        not_full_.notify_one();
+        return true;
+    }
+
+    void Pop(T* item) {
+        {
+            std::unique_lock<std::mutex> lock(mu_);
+            not_empty_.wait(lock, [this] { return !queue_.empty(); });
+            *item = queue_.front();
+            queue_.pop_front();
+        }
+        not_full_.notify_one();
+    }
+
+private:
+    const std::size_t capacity_;
+    std::mutex mu_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<T> queue_;
+};
+
+// throughput: range(0) producers and range(1) consumers pass kMessages
+// through the queue with the blocking calls
+template <typename Queue>
+void BM_Throughput(benchmark::State& state) {
+    const int producers = static_cast<int>(state.range(0));
+    const int consumers = static_cast<int>(state.range(1));
+    for (auto _ : state) {
+        Queue queue(kCapacity);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < producers; ++i) {
+            threads.emplace_back([&queue, producers] {
+                for (int64_t n = kMessages / producers; n > 0; --n) {
+                    queue.Push(static_cast<uint64_t>(n));
+                }
+            });
+        }
+        for (int i = 0; i < consumers; ++i) {
+            threads.emplace_back([&queue, consumers] {
+                uint64_t item = 0;
+                for (int64_t n = kMessages / consumers; n > 0; --n) {
+                    queue.Pop(&item);
+                }
+                benchmark::DoNotOptimize(item);
+            });
+        }
+        for (auto& it : threads) {
+            it.join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kMessages);
+}
+
+// the same with the batch calls of SpscQueue, range(0) items a batch
+void BM_ThroughputSpscBatch(benchmark::State& state) {
+    const std::size_t batch = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        SpscQueue<uint64_t> queue(kCapacity);
+        std::thread producer([&queue, batch] {
+            std::vector<uint64_t> items(batch, 1);
+            for (int64_t n = kMessages; n > 0;) {
+                const std::size_t pushed =
+                    queue.TryPushBatch(items.begin(), std::min<int64_t>(batch, n));
+                if (pushed == 0) {
+                    std::this_thread::yield();
+                }
+                n -= pushed;
+            }
+        });
+        std::vector<uint64_t> items(batch);
+        for (int64_t n = kMessages; n > 0;) {
+            n -= queue.PopBatch(items.data(), batch);
+        }
+        producer.join();
+    }
+    state.SetItemsProcessed(state.iterations() * kMessages);
+}
+
+// latency: a message sent through one queue and echoed back through
+// another, an iteration is a round trip; with spinning TryPop, and with the
+// blocking Pop that may sleep
+template <typename Queue, bool kSpin>
+void BM_RoundTrip(benchmark::State& state) {
+    Queue request(kCapacity);
+    Queue reply(kCapacity);
+    std::thread echo([&] {
+        uint64_t item;
+        for (;;) {
+            if (kSpin) {
+                while (!request.TryPop(&item)) {
+                    std::this_thread::yield();
+                }
+            } else {
+                request.Pop(&item);
+            }
+            reply.Push(item);
+            if (item == 0) {
+                return;
+            }
+        }
+    });
+    uint64_t item = 0;
+    for (auto _ : state) {
+        request.Push(1);
+        if (kSpin) {
+            while (!reply.TryPop(&item)) {
+                std::this_thread::yield();
+            }
+        } else {
+            reply.Pop(&item);
+        }
+    }
+    request.Push(0);
+    reply.Pop(&item);
+    echo.join();
+}
+
+void throughputArgs(benchmark::internal::Benchmark* bench) {
+    const int counts[] = {1, 2, 4};
+    for (int producers : counts) {
+        for (int consumers : counts) {
+            bench->Args({producers, consumers});
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_Throughput, SpscQueue<uint64_t>)->Args({1, 1})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Throughput, MpmcQueue<uint64_t>)->Apply(throughputArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Throughput, MutexQueue<uint64_t>)->Apply(throughputArgs)->UseRealTime();
+BENCHMARK(BM_ThroughputSpscBatch)->Arg(16)->Arg(256)->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_RoundTrip, SpscQueue<uint64_t>, true)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_RoundTrip, MpmcQueue<uint64_t>, true)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_RoundTrip, MutexQueue<uint64_t>, true)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_RoundTrip, SpscQueue<uint64_t>, false)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_RoundTrip, MpmcQueue<uint64_t>, false)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_RoundTrip, MutexQueue<uint64_t>, false)->UseRealTime();
+
+}  // end of anonymous namespace
+}  // end of namespace cg
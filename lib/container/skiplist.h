@@ -1 +1,361 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
 #pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+#include "include/slice.h"
+#include "mem/arena.h"
+
+namespace cg {
+
+struct SliceComparator {
+    int operator()(const Slice& a, const Slice& b) const {
+        return a.Compare(b);
+    }
+};
+
+// Ordered set in the style of a memtable index. Nodes live in an Arena and are
+// never removed, each node carries a tower of exactly its own height.
+//
+// Thread safety:
+//  - readers (Contains, Iterator) need no lock and may run alongside writers;
+//  - Insert must be externally synchronized with other writers;
+//  - InsertConcurrently may be called from many threads at once (CAS based),
+//    it must not be mixed with Insert at the same time.
+// The bytes a Slice key points to must outlive the list, typically they are
+// allocated from the same arena.
+template <typename Key = Slice, class Comparator = SliceComparator>
+class SkipList {
+private:
+    struct Node;
+
+public:
+    static const int kMaxHeight = 12;
+
+    explicit SkipList(Arena* arena, Comparator cmp = Comparator());
+
+    SkipList(const SkipList&) = delete;
+    SkipList& operator=(const SkipList&) = delete;
+
+    // Return false if an equal key is already in the list.
+    bool Insert(const Key& key);
+
+    bool InsertConcurrently(const Key& key);
+
+    bool Contains(const Key& key) const;
+
+    // Number of keys, approximate while writers are running.
+    std::size_t Size() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    class Iterator {
+    public:
+        explicit Iterator(const SkipList* list) : list_(list), node_(nullptr) {}
+
+        bool Valid() const {
+            return node_ != nullptr;
+        }
+
+        const Key& key() const {
+            return node_->key;
+        }
+
+        void Next() {
+            node_ = node_->Next(0);
+        }
+
+        // O(log n), nodes have no backward link
+        void Prev() {
+            node_ = list_->findLessThan(node_->key);
+            if (node_ == list_->head_) {
+                node_ = nullptr;
+            }
+        }
+
+        // Position at the first key >= target.
+        void Seek(const Key& target) {
+            node_ = list_->findGreaterOrEqual(target, nullptr);
+        }
+
+        // Position at the last key <= target.
+        void SeekForPrev(const Key& target) {
+            Seek(target);
+            if (!Valid()) {
+                SeekToLast();
+            }
+            while (Valid() && list_->compare_(node_->key, target) > 0) {
+                Prev();
+            }
+        }
+
+        void SeekToFirst() {
+            node_ = list_->head_->Next(0);
+        }
+
+        void SeekToLast() {
+            node_ = list_->findLast();
+            if (node_ == list_->head_) {
+                node_ = nullptr;
+            }
+        }
+
+    private:
+        const SkipList* list_;
+        Node* node_;
+    };
+
+private:
+    struct Node {
+        explicit Node(const Key& k) : key(k) {}
+
+        Node* Next(int n) {
+            return next_[n].load(std::memory_order_acquire);
+        }
+
+        void SetNext(int n, Node* x) {
+            next_[n].store(x, std::memory_order_release);
+        }
+
+        Node* NoBarrierNext(int n) {
+            return next_[n].load(std::memory_order_relaxed);
+        }
+
+        void NoBarrierSetNext(int n, Node* x) {
+            next_[n].store(x, std::memory_order_relaxed);
+        }
+
+        bool CASNext(int n, Node* expected, Node* x) {
+            return next_[n].compare_exchange_strong(expected, x);
+        }
+
+        Key const key;
+
+    private:
+        // the tower, next_[0] is the lowest level, allocated to the node height
+        std::atomic<Node*> next_[1];
+    };
+
+    Node* newNode(const Key& key, int height, bool concurrent);
+
+    int randomHeight();
+
+    int maxHeight() const {
+        return max_height_.load(std::memory_order_relaxed);
+    }
+
+    bool keyIsAfterNode(const Key& key, Node* n) const {
+        return (n != nullptr) && (compare_(n->key, key) < 0);
+    }
+
+    // First node >= key, fill prev[level] with the last node < key at each level.
+    Node* findGreaterOrEqual(const Key& key, Node** prev) const;
+
+    Node* findLessThan(const Key& key) const;
+
+    Node* findLast() const;
+
+    // Starting at before, find the pair (prev, next) at level with prev < key <= next.
+    void findSpliceForLevel(const Key& key, Node* before, int level,
+                            Node** out_prev, Node** out_next) const;
+
+private:
+    Comparator const compare_;
+    Arena* const arena_;
+    Node* const head_;
+    std::atomic<int> max_height_;
+    std::atomic<std::size_t> size_;
+};
+
+template <typename Key, class Comparator>
+SkipList<Key, Comparator>::SkipList(Arena* arena, Comparator cmp)
+    : compare_(cmp),
+      arena_(arena),
+      head_(newNode(Key(), kMaxHeight, false)),
+      max_height_(1),
+      size_(0) {
+    for (int i = 0; i < kMaxHeight; ++i) {
+        head_->NoBarrierSetNext(i, nullptr);
+    }
+}
+
+template <typename Key, class Comparator>
+typename SkipList<Key, Comparator>::Node*
+SkipList<Key, Comparator>::newNode(const Key& key, int height, bool concurrent) {
+    const std::size_t size = sizeof(Node) + sizeof(std::atomic<Node*>) * (height - 1);
+    char* mem = concurrent ? arena_->AllocateConcurrently(size) : arena_->AllocateAligned(size);
+    return new (mem) Node(key);
+}
+
+template <typename Key, class Comparator>
+int SkipList<Key, Comparator>::randomHeight() {
+    // xorshift per thread, increase the height with probability 1/4
+    static thread_local uint64_t seed = 0;
+    if (UNLIKELY(seed == 0)) {
+        seed = reinterpret_cast<uintptr_t>(&seed) | 1;
+    }
+    int height = 1;
+    while (height < kMaxHeight) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        if ((seed & 3) != 0) {
+            break;
+        }
+        ++height;
+    }
+    return height;
+}
+
+template <typename Key, class Comparator>
+typename SkipList<Key, Comparator>::Node*
+SkipList<Key, Comparator>::findGreaterOrEqual(const Key& key, Node** prev) const {
+    Node* x = head_;
+    int level = maxHeight() - 1;
+    while (true) {
+        Node* next = x->Next(level);
+        if (keyIsAfterNode(key, next)) {
+            x = next;
+        } else {
+            if (prev != nullptr) {
+                prev[level] = x;
+            }
+            if (level == 0) {
+                return next;
+            }
+            --level;
+        }
+    }
+}
+
+template <typename Key, class Comparator>
+typename SkipList<Key, Comparator>::Node*
+SkipList<Key, Comparator>::findLessThan(const Key& key) const {
+    Node* x = head_;
+    int level = maxHeight() - 1;
+    while (true) {
+        Node* next = x->Next(level);
+        if (next == nullptr || compare_(next->key, key) >= 0) {
+            if (level == 0) {
+                return x;
+            }
+            --level;
+        } else {
+            x = next;
+        }
+    }
+}
+
+template <typename Key, class Comparator>
+typename SkipList<Key, Comparator>::Node* SkipList<Key, Comparator>::findLast() const {
+    Node* x = head_;
+    int level = maxHeight() - 1;
+    while (true) {
+        Node* next = x->Next(level);
+        if (next == nullptr) {
+            if (level == 0) {
+                return x;
+            }
+            --level;
+        } else {
+            x = next;
+        }
+    }
+}
+
+template <typename Key, class Comparator>
+void SkipList<Key, Comparator>::findSpliceForLevel(const Key& key, Node* before, int level,
+                                                   Node** out_prev, Node** out_next) const {
+    while (true) {
+        Node* next = before->Next(level);
+        if (!keyIsAfterNode(key, next)) {
+            *out_prev = before;
+            *out_next = next;
+            return;
+        }
+        before = next;
+    }
+}
+
+template <typename Key, class Comparator>
+bool SkipList<Key, Comparator>::Insert(const Key& key) {
+    Node* prev[kMaxHeight];
+    Node* x = findGreaterOrEqual(key, prev);
+    if (x != nullptr && compare_(x->key, key) == 0) {
+        return false;
+    }
+
+    int height = randomHeight();
+    if (height > maxHeight()) {
+        for (int i = maxHeight(); i < height; ++i) {
+            prev[i] = head_;
+        }
+        // readers seeing the new height before the node is linked just
+        // find nullptr from head_ at the new levels
+        max_height_.store(height, std::memory_order_relaxed);
+    }
+
+    x = newNode(key, height, false);
+    for (int i = 0; i < height; ++i) {
+        x->NoBarrierSetNext(i, prev[i]->NoBarrierNext(i));
+        prev[i]->SetNext(i, x);
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename Key, class Comparator>
+bool SkipList<Key, Comparator>::InsertConcurrently(const Key& key) {
+    const int height = randomHeight();
+    int max_height = maxHeight();
+    while (height > max_height) {
+        if (max_height_.compare_exchange_weak(max_height, height)) {
+            max_height = height;
+            break;
+        }
+    }
+
+    Node* prev[kMaxHeight + 1];
+    Node* next[kMaxHeight + 1];
+    prev[max_height] = head_;
+    next[max_height] = nullptr;
+    for (int i = max_height - 1; i >= 0; --i) {
+        findSpliceForLevel(key, prev[i + 1], i, &prev[i], &next[i]);
+    }
+    if (next[0] != nullptr && compare_(next[0]->key, key) == 0) {
+        return false;
+    }
+
+    Node* x = newNode(key, height, true);
+    for (int i = 0; i < height; ++i) {
+        while (true) {
+            if (i == 0 && next[0] != nullptr && compare_(next[0]->key, key) == 0) {
+                // lost the race against an equal key, the node stays unused in the arena
+                return false;
+            }
+            x->NoBarrierSetNext(i, next[i]);
+            if (prev[i]->CASNext(i, next[i], x)) {
+                break;
+            }
+            // prev[i] got a new successor, the splice moves forward from it
+            findSpliceForLevel(key, prev[i], i, &prev[i], &next[i]);
+        }
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename Key, class Comparator>
+bool SkipList<Key, Comparator>::Contains(const Key& key) const {
+    Node* x = findGreaterOrEqual(key, nullptr);
+    return x != nullptr && compare_(x->key, key) == 0;
+}
+
+}  // end of namespace cg
@@ -0,0 +1,118 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "container/skiplist.h"
+
+namespace cg {
+namespace {
+
+const int kPrefill = 1 << 20;
+
+// 8 byte big endian keys, byte order matches numeric order
+void encodeKey(uint64_t n, char* buf) {
+    for (int i = 7; i >= 0; --i) {
+        buf[i] = static_cast<char>(n & 0xff);
+        n >>= 8;
+    }
+}
+
+uint64_t nextRandom(uint64_t* seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 7;
+    *seed ^= *seed << 17;
+    return *seed;
+}
+
+struct SkipListFixture {
+    Arena arena;
+    SkipList<> list;
+
+    SkipListFixture() : arena(1 << 20), list(&arena) {}
+
+    void Insert(uint64_t n) {
+        char* buf = arena.AllocateConcurrently(8);
+        encodeKey(n, buf);
+        list.InsertConcurrently(Slice(buf, 8));
+    }
+
+    bool Contains(uint64_t n) {
+        char buf[8];
+        encodeKey(n, buf);
+        return list.Contains(Slice(buf, 8));
+    }
+};
+
+struct LockedMapFixture {
+    std::mutex mu;
+    std::map<std::string, int> map;
+
+    void Insert(uint64_t n) {
+        std::string key(8, '\0');
+        encodeKey(n, &key[0]);
+        std::lock_guard<std::mutex> guard(mu);
+        map.emplace(std::move(key), 0);
+    }
+
+    bool Contains(uint64_t n) {
+        std::string key(8, '\0');
+        encodeKey(n, &key[0]);
+        std::lock_guard<std::mutex> guard(mu);
+        return map.count(key) != 0;
+    }
+};
+
+template <typename Fixture>
+void BM_Insert(benchmark::State& state) {
+    static std::unique_ptr<Fixture> fixture;
+    if (state.thread_index() == 0) {
+        fixture.reset(new Fixture);
+    }
+    uint64_t seed = state.thread_index() * 0x9e3779b97f4a7c15ULL + 1;
+    for (auto _ : state) {
+        fixture->Insert(nextRandom(&seed));
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        fixture.reset();
+    }
+}
+
+template <typename Fixture>
+void BM_Lookup(benchmark::State& state) {
+    static std::unique_ptr<Fixture> fixture;
+    if (state.thread_index() == 0) {
+        fixture.reset(new Fixture);
+        for (int i = 0; i < kPrefill; ++i) {
+            fixture->Insert(i * 2);
+        }
+    }
+    uint64_t seed = state.thread_index() * 0x9e3779b97f4a7c15ULL + 1;
+    int64_t found = 0;
+    for (auto _ : state) {
+        // half of the probes hit
+        found += fixture->Contains(nextRandom(&seed) % (2 * kPrefill));
+    }
+    benchmark::DoNotOptimize(found);
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        fixture.reset();
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_Insert, SkipListFixture)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Insert, LockedMapFixture)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Lookup, SkipListFixture)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Lookup, LockedMapFixture)->ThreadRange(1, 32)->UseRealTime();
+
+}  // end of anonymous namespace
+}  // end of namespace cg
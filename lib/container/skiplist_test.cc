@@ -0,0 +1,210 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "container/skiplist.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class SkipListTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    // fixed width so that the byte order matches the numeric order
+    Slice makeKey(uint32_t n) {
+        char* buf = arena_.Allocate(10);
+        snprintf(buf, 11, "%010u", n);
+        return Slice(buf, 10);
+    }
+
+    Slice makeKeyConcurrently(uint32_t n) {
+        char buf[11];
+        snprintf(buf, sizeof(buf), "%010u", n);
+        char* mem = arena_.AllocateConcurrently(10);
+        memcpy(mem, buf, 10);
+        return Slice(mem, 10);
+    }
+
+    Arena arena_;
+};
+
+TEST_F(SkipListTest, Empty) {
+    SkipList<> list(&arena_);
+    EXPECT_EQ(false, list.Contains(Slice("a")));
+    EXPECT_EQ(0U, list.Size());
+
+    SkipList<>::Iterator iter(&list);
+    EXPECT_EQ(false, iter.Valid());
+    iter.SeekToFirst();
+    EXPECT_EQ(false, iter.Valid());
+    iter.Seek(Slice("a"));
+    EXPECT_EQ(false, iter.Valid());
+    iter.SeekToLast();
+    EXPECT_EQ(false, iter.Valid());
+    iter.SeekForPrev(Slice("a"));
+    EXPECT_EQ(false, iter.Valid());
+}
+
+TEST_F(SkipListTest, InsertAndLookup) {
+    const int N = 2000;
+    const int R = 5000;
+    srand(301);
+    std::set<uint32_t> keys;
+    SkipList<> list(&arena_);
+    for (int i = 0; i < N; ++i) {
+        uint32_t key = rand() % R;
+        bool inserted = keys.insert(key).second;
+        EXPECT_EQ(inserted, list.Insert(makeKey(key)));
+    }
+    EXPECT_EQ(keys.size(), list.Size());
+
+    for (int i = 0; i < R; ++i) {
+        EXPECT_EQ(keys.count(i) == 1, list.Contains(makeKey(i))) << i;
+    }
+
+    // forward iteration
+    SkipList<>::Iterator iter(&list);
+    iter.SeekToFirst();
+    for (auto it = keys.begin(); it != keys.end(); ++it) {
+        ASSERT_EQ(true, iter.Valid());
+        EXPECT_EQ(0, iter.key().Compare(makeKey(*it)));
+        iter.Next();
+    }
+    EXPECT_EQ(false, iter.Valid());
+
+    // backward iteration
+    iter.SeekToLast();
+    for (auto it = keys.rbegin(); it != keys.rend(); ++it) {
+        ASSERT_EQ(true, iter.Valid());
+        EXPECT_EQ(0, iter.key().Compare(makeKey(*it)));
+        iter.Prev();
+    }
+    EXPECT_EQ(false, iter.Valid());
+
+    // seek
+    for (int i = 0; i < R; ++i) {
+        auto lower = keys.lower_bound(i);
+        iter.Seek(makeKey(i));
+        if (lower == keys.end()) {
+            EXPECT_EQ(false, iter.Valid());
+        } else {
+            ASSERT_EQ(true, iter.Valid());
+            EXPECT_EQ(0, iter.key().Compare(makeKey(*lower)));
+        }
+
+        auto upper = keys.upper_bound(i);
+        iter.SeekForPrev(makeKey(i));
+        if (upper == keys.begin()) {
+            EXPECT_EQ(false, iter.Valid());
+        } else {
+            ASSERT_EQ(true, iter.Valid());
+            EXPECT_EQ(0, iter.key().Compare(makeKey(*--upper)));
+        }
+    }
+}
+
+struct ReverseComparator {
+    int operator()(const Slice& a, const Slice& b) const {
+        return b.Compare(a);
+    }
+};
+
+TEST_F(SkipListTest, Comparator) {
+    SkipList<Slice, ReverseComparator> list(&arena_);
+    for (uint32_t i = 0; i < 100; ++i) {
+        list.Insert(makeKey(i));
+    }
+    SkipList<Slice, ReverseComparator>::Iterator iter(&list);
+    iter.SeekToFirst();
+    for (int i = 99; i >= 0; --i) {
+        ASSERT_EQ(true, iter.Valid());
+        EXPECT_EQ(0, iter.key().Compare(makeKey(i)));
+        iter.Next();
+    }
+    EXPECT_EQ(false, iter.Valid());
+}
+
+TEST_F(SkipListTest, ConcurrentInsert) {
+    const int thread_num = 4;
+    const uint32_t count = 20000;
+    SkipList<> list(&arena_);
+    std::atomic<bool> done(false);
+    std::vector<std::thread> writers;
+    for (int t = 0; t < thread_num; ++t) {
+        writers.emplace_back([this, &list, t, count]() {
+            // every key is inserted by two threads, only one of them wins
+            for (uint32_t i = 0; i < count; ++i) {
+                list.InsertConcurrently(makeKeyConcurrently(i * thread_num / 2 + t / 2));
+            }
+        });
+    }
+    // a reader checking order while the writers run
+    std::thread reader([&list, &done]() {
+        while (!done.load()) {
+            SkipList<>::Iterator iter(&list);
+            iter.SeekToFirst();
+            Slice prev;
+            while (iter.Valid()) {
+                ASSERT_LT(prev.Compare(iter.key()), 0);
+                prev = iter.key();
+                iter.Next();
+            }
+        }
+    });
+    for (auto& it : writers) {
+        it.join();
+    }
+    done.store(true);
+    reader.join();
+
+    const uint32_t total = count * thread_num / 2;
+    EXPECT_EQ(total, list.Size());
+    SkipList<>::Iterator iter(&list);
+    iter.SeekToFirst();
+    for (uint32_t i = 0; i < total; ++i) {
+        ASSERT_EQ(true, iter.Valid());
+        EXPECT_EQ(0, iter.key().Compare(makeKey(i)));
+        iter.Next();
+    }
+    EXPECT_EQ(false, iter.Valid());
+}
+
+TEST_F(SkipListTest, ConcurrentReadWithSingleWriter) {
+    const uint32_t count = 50000;
+    SkipList<> list(&arena_);
+    std::atomic<uint32_t> written(0);
+    std::thread writer([this, &list, &written, count]() {
+        for (uint32_t i = 0; i < count; ++i) {
+            list.Insert(makeKey(i));
+            written.store(i + 1, std::memory_order_release);
+        }
+    });
+    // the writer allocates from arena_ without synchronization, keep the probes on the stack
+    uint32_t checked = 0;
+    char buf[11];
+    while (checked < count) {
+        uint32_t n = written.load(std::memory_order_acquire);
+        for (; checked < n; ++checked) {
+            snprintf(buf, sizeof(buf), "%010u", checked);
+            ASSERT_EQ(true, list.Contains(Slice(buf, 10)));
+        }
+    }
+    writer.join();
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
@@ -0,0 +1,373 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <string.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cg {
+
+// A vector whose first N elements live inside the object: no allocation
+// until it grows past N, then it moves to the heap like std::vector and
+// stays there. Moving a heap vector steals the pointer, moving an inline
+// one moves its elements. Iterators and pointers are invalidated by any
+// growth, and by moves of an inline vector.
+//
+// The member names are std::vector's, so that it drops in where one was:
+// range for, algorithms, and the templates of include/strings.h.
+//
+//   SmallVector<Slice, 8> fields;
+//   StringSplit(Slice(" "), Slice(line), &fields);  // no allocation up to 8
+template <typename T, std::size_t N>
+class SmallVector {
+public:
+    static_assert(N > 0, "use std::vector for no inline storage");
+
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    SmallVector() : data_(inlineData()), size_(0), capacity_(N) {}
+
+    SmallVector(size_type n, const T& value) : SmallVector() {
+        assign(n, value);
+    }
+
+    explicit SmallVector(size_type n) : SmallVector() {
+        resize(n);
+    }
+
+    template <typename Iter, typename = typename std::enable_if<
+        !std::is_integral<Iter>::value>::type>
+    SmallVector(Iter first, Iter last) : SmallVector() {
+        assign(first, last);
+    }
+
+    SmallVector(std::initializer_list<T> list) : SmallVector() {
+        assign(list.begin(), list.end());
+    }
+
+    SmallVector(const SmallVector& other) : SmallVector() {
+        assign(other.begin(), other.end());
+    }
+
+    SmallVector(SmallVector&& other) noexcept : SmallVector() {
+        take(&other);
+    }
+
+    ~SmallVector() {
+        destroy(data_, data_ + size_);
+        if (!is_inline()) {
+            ::operator delete(data_);
+        }
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            clear();
+            take(&other);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(std::initializer_list<T> list) {
+        assign(list.begin(), list.end());
+        return *this;
+    }
+
+    void assign(size_type n, const T& value) {
+        clear();
+        reserve(n);
+        std::uninitialized_fill_n(data_, n, value);
+        size_ = n;
+    }
+
+    template <typename Iter, typename = typename std::enable_if<
+        !std::is_integral<Iter>::value>::type>
+    void assign(Iter first, Iter last) {
+        clear();
+        append(first, last);
+    }
+
+    iterator begin() {
+        return data_;
+    }
+
+    const_iterator begin() const {
+        return data_;
+    }
+
+    iterator end() {
+        return data_ + size_;
+    }
+
+    const_iterator end() const {
+        return data_ + size_;
+    }
+
+    T* data() {
+        return data_;
+    }
+
+    const T* data() const {
+        return data_;
+    }
+
+    size_type size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    size_type capacity() const {
+        return capacity_;
+    }
+
+    // the elements are still in the object
+    bool is_inline() const {
+        return data_ == inlineData();
+    }
+
+    T& operator[](size_type i) {
+        return data_[i];
+    }
+
+    const T& operator[](size_type i) const {
+        return data_[i];
+    }
+
+    T& front() {
+        return data_[0];
+    }
+
+    const T& front() const {
+        return data_[0];
+    }
+
+    T& back() {
+        return data_[size_ - 1];
+    }
+
+    const T& back() const {
+        return data_[size_ - 1];
+    }
+
+    void reserve(size_type n) {
+        if (n > capacity_) {
+            grow(n);
+        }
+    }
+
+    void resize(size_type n) {
+        if (n > size_) {
+            reserve(n);
+            for (T* p = data_ + size_; p != data_ + n; ++p) {
+                new (p) T();
+            }
+        } else {
+            destroy(data_ + n, data_ + size_);
+        }
+        size_ = n;
+    }
+
+    void resize(size_type n, const T& value) {
+        if (n > size_) {
+            reserve(n);
+            std::uninitialized_fill(data_ + size_, data_ + n, value);
+        } else {
+            destroy(data_ + n, data_ + size_);
+        }
+        size_ = n;
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            return growAndEmplace(std::forward<Args>(args)...);
+        }
+        T* p = new (data_ + size_) T(std::forward<Args>(args)...);
+        ++size_;
+        return *p;
+    }
+
+    template <typename Iter>
+    void append(Iter first, Iter last) {
+        appendRange(first, last, typename std::iterator_traits<Iter>::iterator_category());
+    }
+
+    void pop_back() {
+        --size_;
+        data_[size_].~T();
+    }
+
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        T* p = data_ + (first - data_);
+        T* q = data_ + (last - data_);
+        if (p != q) {
+            T* new_end = std::move(q, end(), p);
+            destroy(new_end, end());
+            size_ = static_cast<size_type>(new_end - data_);
+        }
+        return p;
+    }
+
+    // keeps the capacity
+    void clear() {
+        destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+private:
+    // trivially copyable elements move by memcpy
+    static const bool kRelocateBytes = std::is_trivially_copyable<T>::value;
+
+    T* inlineData() {
+        return reinterpret_cast<T*>(&inline_);
+    }
+
+    const T* inlineData() const {
+        return reinterpret_cast<const T*>(&inline_);
+    }
+
+    static void destroy(T* first, T* last) {
+        if (!std::is_trivially_destructible<T>::value) {
+            for (; first != last; ++first) {
+                first->~T();
+            }
+        }
+    }
+
+    // moves n elements to uninitialized dst and destroys them at src
+    static void relocate(T* src, std::size_t n, T* dst) {
+        if (kRelocateBytes) {
+            if (n != 0) {
+                memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+            }
+        } else {
+            for (std::size_t i = 0; i < n; ++i) {
+                new (dst + i) T(std::move(src[i]));
+                src[i].~T();
+            }
+        }
+    }
+
+    static T* allocate(size_type n) {
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    size_type grownCapacity(size_type n) const {
+        return std::max(n, 2 * capacity_);
+    }
+
+    void adopt(T* data, size_type capacity) {
+        if (!is_inline()) {
+            ::operator delete(data_);
+        }
+        data_ = data;
+        capacity_ = capacity;
+    }
+
+    void grow(size_type n) {
+        const size_type capacity = grownCapacity(n);
+        T* data = allocate(capacity);
+        relocate(data_, size_, data);
+        adopt(data, capacity);
+    }
+
+    // args may refer into the vector: the new element is built first
+    template <typename... Args>
+    T& growAndEmplace(Args&&... args) {
+        const size_type capacity = grownCapacity(size_ + 1);
+        T* data = allocate(capacity);
+        T* p = new (data + size_) T(std::forward<Args>(args)...);
+        relocate(data_, size_, data);
+        adopt(data, capacity);
+        ++size_;
+        return *p;
+    }
+
+    // other is left empty, on its inline storage
+    void take(SmallVector* other) {
+        if (other->is_inline()) {
+            reserve(other->size_);
+            relocate(other->data_, other->size_, data_);
+            size_ = other->size_;
+        } else {
+            adopt(other->data_, other->capacity_);
+            size_ = other->size_;
+            other->data_ = other->inlineData();
+            other->capacity_ = N;
+        }
+        other->size_ = 0;
+    }
+
+    template <typename Iter>
+    void appendRange(Iter first, Iter last, std::forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(std::distance(first, last));
+        reserve(size_ + n);
+        std::uninitialized_copy(first, last, data_ + size_);
+        size_ += n;
+    }
+
+    template <typename Iter>
+    void appendRange(Iter first, Iter last, std::input_iterator_tag) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+private:
+    T* data_;
+    size_type size_;
+    size_type capacity_;
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type inline_;
+};
+
+template <typename T, std::size_t N>
+bool operator==(const SmallVector<T, N>& a, const SmallVector<T, N>& b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+template <typename T, std::size_t N>
+bool operator!=(const SmallVector<T, N>& a, const SmallVector<T, N>& b) {
+    return !(a == b);
+}
+
+}  // end of namespace cg
@@ -0,0 +1,145 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "container/buffer.h"
+#include "container/small_vector.h"
+#include "include/strings.h"
+
+// every allocation of the binary, for the allocs_per_item counters
+static uint64_t g_allocs = 0;
+
+void* operator new(std::size_t size) {
+    ++g_allocs;
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+namespace cg {
+namespace {
+
+// Lines of 3 to 8 words of 1 to 12 chars: crontab lines, log fields, the
+// arguments of a command.
+std::vector<std::string> makeLines() {
+    std::mt19937 rng(42);
+    std::vector<std::string> lines;
+    for (int i = 0; i < 1024; ++i) {
+        std::string line;
+        for (int words = 3 + rng() % 6; words > 0; --words) {
+            for (int n = 1 + rng() % 12; n > 0; --n) {
+                line.push_back(static_cast<char>('a' + rng() % 26));
+            }
+            line.push_back(' ');
+        }
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// the allocations an item took, over the timed loop
+void countAllocs(benchmark::State& state, uint64_t before, int64_t items) {
+    state.counters["allocs_per_item"] = static_cast<double>(g_allocs - before)
+        / static_cast<double>(items);
+    state.SetItemsProcessed(items);
+}
+
+// Each line split into a fresh local, as a parser does with a line it
+// keeps nothing of: Slices, or copies that outlive the line.
+template <typename Vector>
+void BM_SplitSlices(benchmark::State& state) {
+    const std::vector<std::string> lines = makeLines();
+    const uint64_t before = g_allocs;
+    for (auto _ : state) {
+        for (const auto& it : lines) {
+            Vector v;
+            StringSplit(Slice(" "), Slice(it), &v);
+            benchmark::DoNotOptimize(v.data());
+        }
+    }
+    countAllocs(state, before, state.iterations() * lines.size());
+}
+
+template <typename Vector>
+void BM_SplitCopies(benchmark::State& state) {
+    const std::vector<std::string> lines = makeLines();
+    const uint64_t before = g_allocs;
+    for (auto _ : state) {
+        for (const auto& it : lines) {
+            Vector v;
+            StringSplit(" ", it, &v);
+            benchmark::DoNotOptimize(v.data());
+        }
+    }
+    countAllocs(state, before, state.iterations() * lines.size());
+}
+
+// a vector of range(0) bytes built, moved once and dropped
+template <typename Vector>
+void BM_PushBack(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    const uint64_t before = g_allocs;
+    for (auto _ : state) {
+        Vector v;
+        for (int i = 0; i < n; ++i) {
+            v.push_back(static_cast<uint8_t>(i));
+        }
+        Vector moved(std::move(v));
+        benchmark::DoNotOptimize(moved.data());
+    }
+    countAllocs(state, before, state.iterations());
+}
+
+// keys of range(0) bytes copied out of a Slice and viewed again
+template <typename Owned>
+void BM_OwnKey(benchmark::State& state) {
+    const std::string key(state.range(0), 'k');
+    const Slice view(key);
+    const uint64_t before = g_allocs;
+    for (auto _ : state) {
+        Owned owned(view.Data(), view.Size());
+        benchmark::DoNotOptimize(owned.data());
+    }
+    countAllocs(state, before, state.iterations());
+}
+
+// Buffer with the std::string interface BM_OwnKey uses
+struct OwnedBuffer {
+    Buffer buffer;
+
+    OwnedBuffer(const char* data, std::size_t n) : buffer(data, n) {}
+
+    const char* data() const {
+        return buffer.Data();
+    }
+};
+
+BENCHMARK_TEMPLATE(BM_SplitSlices, std::vector<Slice>);
+BENCHMARK_TEMPLATE(BM_SplitSlices, SmallVector<Slice, 8>);
+BENCHMARK_TEMPLATE(BM_SplitCopies, std::vector<std::string>);
+BENCHMARK_TEMPLATE(BM_SplitCopies, std::vector<Buffer>);
+BENCHMARK_TEMPLATE(BM_SplitCopies, SmallVector<Buffer, 8>);
+
+BENCHMARK_TEMPLATE(BM_PushBack, std::vector<uint8_t>)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_PushBack, SmallVector<uint8_t, 16>)->Arg(4)->Arg(16)->Arg(64);
+
+BENCHMARK_TEMPLATE(BM_OwnKey, std::string)->Arg(8)->Arg(32)->Arg(64);
+BENCHMARK_TEMPLATE(BM_OwnKey, OwnedBuffer)->Arg(8)->Arg(32)->Arg(64);
+
+}  // end of anonymous namespace
+}  // end of namespace cg
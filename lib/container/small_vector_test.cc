@@ -0,0 +1,193 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "container/small_vector.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class SmallVectorTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+// counts the live values, to see that the vector destroys what it holds
+struct Tracked {
+    static int live;
+
+    std::string value;
+
+    explicit Tracked(const std::string& v = "") : value(v) {
+        ++live;
+    }
+
+    Tracked(const Tracked& other) : value(other.value) {
+        ++live;
+    }
+
+    Tracked(Tracked&& other) : value(std::move(other.value)) {
+        ++live;
+    }
+
+    Tracked& operator=(const Tracked& other) = default;
+
+    Tracked& operator=(Tracked&& other) = default;
+
+    ~Tracked() {
+        --live;
+    }
+};
+
+int Tracked::live = 0;
+
+TEST_F(SmallVectorTest, Inline) {
+    SmallVector<int, 4> v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(4U, v.capacity());
+    for (int i = 0; i < 4; ++i) {
+        v.push_back(i);
+    }
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(4U, v.size());
+    EXPECT_EQ(0, v.front());
+    EXPECT_EQ(3, v.back());
+    v.pop_back();
+    EXPECT_EQ(3U, v.size());
+    int sum = 0;
+    for (int it : v) {
+        sum += it;
+    }
+    EXPECT_EQ(3, sum);
+}
+
+TEST_F(SmallVectorTest, Grow) {
+    SmallVector<int, 4> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(i);
+    }
+    EXPECT_FALSE(v.is_inline());
+    EXPECT_GE(v.capacity(), 1000U);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(i, v[i]);
+    }
+    v.clear();
+    EXPECT_TRUE(v.empty());
+    EXPECT_FALSE(v.is_inline());
+}
+
+TEST_F(SmallVectorTest, Construct) {
+    SmallVector<int, 4> a = {1, 2, 3};
+    EXPECT_EQ(3U, a.size());
+    EXPECT_EQ(2, a[1]);
+    SmallVector<uint8_t, 4> b(3, 7);
+    EXPECT_EQ(3U, b.size());
+    EXPECT_EQ(7, b[2]);
+    const std::vector<int> source = {5, 6, 7, 8, 9};
+    SmallVector<int, 4> c(source.begin(), source.end());
+    EXPECT_EQ(5U, c.size());
+    EXPECT_FALSE(c.is_inline());
+    EXPECT_EQ(9, c.back());
+    SmallVector<int, 4> d(6);
+    EXPECT_EQ(6U, d.size());
+    EXPECT_EQ(0, d[5]);
+}
+
+TEST_F(SmallVectorTest, CopyAndMove) {
+    for (int n : {2, 100}) {
+        SmallVector<std::string, 4> v;
+        for (int i = 0; i < n; ++i) {
+            v.push_back(std::to_string(i));
+        }
+        SmallVector<std::string, 4> copy(v);
+        EXPECT_TRUE(copy == v);
+
+        const std::string* heap = v.data();
+        SmallVector<std::string, 4> moved(std::move(v));
+        EXPECT_TRUE(v.empty());
+        EXPECT_TRUE(v.is_inline());
+        EXPECT_TRUE(moved == copy);
+        // a heap vector hands its storage over
+        EXPECT_EQ(n > 4, moved.data() == heap);
+
+        SmallVector<std::string, 4> assigned = {"x"};
+        assigned = std::move(moved);
+        EXPECT_TRUE(assigned == copy);
+        assigned = copy;
+        EXPECT_TRUE(assigned == copy);
+        v.push_back("reused");
+        EXPECT_EQ("reused", v[0]);
+    }
+}
+
+TEST_F(SmallVectorTest, MoveOnly) {
+    SmallVector<std::unique_ptr<int>, 2> v;
+    for (int i = 0; i < 10; ++i) {
+        v.emplace_back(new int(i));
+    }
+    SmallVector<std::unique_ptr<int>, 2> w(std::move(v));
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(i, *w[i]);
+    }
+}
+
+// an element of the vector pushed while it grows
+TEST_F(SmallVectorTest, PushOwnElement) {
+    SmallVector<std::string, 2> v;
+    v.push_back("first element, longer than the small string buffer");
+    v.push_back("second");
+    v.push_back(v[0]);
+    EXPECT_EQ(v[0], v[2]);
+    v.emplace_back(v[1]);
+    EXPECT_EQ("second", v[3]);
+}
+
+TEST_F(SmallVectorTest, ResizeAndErase) {
+    SmallVector<int, 4> v = {0, 1, 2, 3, 4, 5};
+    v.erase(v.begin() + 1, v.begin() + 3);
+    EXPECT_TRUE((v == SmallVector<int, 4>{0, 3, 4, 5}));
+    v.erase(v.begin());
+    EXPECT_TRUE((v == SmallVector<int, 4>{3, 4, 5}));
+    v.resize(5, 9);
+    EXPECT_TRUE((v == SmallVector<int, 4>{3, 4, 5, 9, 9}));
+    v.resize(1);
+    EXPECT_TRUE((v == SmallVector<int, 4>{3}));
+    v.assign(2, 1);
+    EXPECT_TRUE((v == SmallVector<int, 4>{1, 1}));
+}
+
+TEST_F(SmallVectorTest, Destroys) {
+    Tracked::live = 0;
+    {
+        SmallVector<Tracked, 3> v;
+        for (int i = 0; i < 10; ++i) {
+            v.emplace_back(std::to_string(i));
+        }
+        EXPECT_EQ(10, Tracked::live);
+        v.erase(v.begin(), v.begin() + 5);
+        EXPECT_EQ(5, Tracked::live);
+        EXPECT_EQ("5", v[0].value);
+        SmallVector<Tracked, 3> w(std::move(v));
+        EXPECT_EQ(5, Tracked::live);
+        v.emplace_back("a");
+        SmallVector<Tracked, 3> inline_moved(std::move(v));
+        EXPECT_EQ(6, Tracked::live);
+        w.resize(2);
+        EXPECT_EQ(3, Tracked::live);
+    }
+    EXPECT_EQ(0, Tracked::live);
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
@@ -0,0 +1,193 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <utility>
+
+#include "algorithm/bit.h"
+#include "concurrent/event_count.h"
+#include "include/atomic.h"
+
+namespace cg {
+
+// Bounded queue of one producer thread and one consumer thread, a ring of a
+// power of two slots. The producer writes tail_, the consumer head_, each on
+// a cache line of its own; each side keeps a copy of the other's index and
+// reads the shared one only when its copy says full or empty, so in a
+// stream the line of the other side moves once per ring, not per item. The
+// batch calls publish once for many items.
+//
+// Try calls never block. Push blocks while the ring is full, Pop while it is
+// empty; they yield a while, then sleep on a futex. Waking costs the other
+// side a syscall only when a thread sleeps.
+template <typename T>
+class SpscQueue {
+public:
+    // capacity rounded up to a power of two
+    explicit SpscQueue(std::size_t capacity)
+        : mask_(NextPowerOfTwo<uint64_t>(capacity) - 1),
+          slots_(static_cast<T*>(::operator new(sizeof(T) * (mask_ + 1)))),
+          tail_(0), head_cache_(0), head_(0), tail_cache_(0) {}
+
+    ~SpscQueue() {
+        for (uint64_t i = head_.load(std::memory_order_relaxed);
+             i != tail_.load(std::memory_order_relaxed); ++i) {
+            slots_[i & mask_].~T();
+        }
+        ::operator delete(slots_);
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    std::size_t Capacity() const {
+        return static_cast<std::size_t>(mask_ + 1);
+    }
+
+    // approximate while the threads run
+    std::size_t Size() const {
+        const uint64_t head = head_.load(std::memory_order_acquire);
+        const uint64_t tail = tail_.load(std::memory_order_acquire);
+        return tail > head ? static_cast<std::size_t>(tail - head) : 0;
+    }
+
+    bool Empty() const {
+        return Size() == 0;
+    }
+
+    // producer: false when full, args untouched then
+    template <typename... Args>
+    bool TryEmplace(Args&&... args) {
+        const uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ > mask_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ > mask_) {
+                return false;
+            }
+        }
+        new (&slots_[tail & mask_]) T(std::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+        not_empty_.NotifyOne();
+        return true;
+    }
+
+    bool TryPush(const T& item) {
+        return TryEmplace(item);
+    }
+
+    // item is moved from only when pushed
+    bool TryPush(T&& item) {
+        return TryEmplace(std::move(item));
+    }
+
+    void Push(const T& item) {
+        if (!TryPush(item)) {
+            not_full_.Wait([&] { return TryPush(item); });
+        }
+    }
+
+    void Push(T&& item) {
+        if (!TryPush(std::move(item))) {
+            not_full_.Wait([&] { return TryPush(std::move(item)); });
+        }
+    }
+
+    // producer: pushes *first, *++first... up to n items, as many as fit,
+    // and returns how many
+    template <typename Iter>
+    std::size_t TryPushBatch(Iter first, std::size_t n) {
+        const uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (mask_ + 1 - (tail - head_cache_) < n) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+        }
+        n = std::min<std::size_t>(n, mask_ + 1 - (tail - head_cache_));
+        if (n == 0) {
+            return 0;
+        }
+        for (std::size_t i = 0; i < n; ++i, ++first) {
+            new (&slots_[(tail + i) & mask_]) T(*first);
+        }
+        tail_.store(tail + n, std::memory_order_release);
+        not_empty_.NotifyOne();
+        return n;
+    }
+
+    // consumer: false when empty
+    bool TryPop(T* item) {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) {
+                return false;
+            }
+        }
+        T* slot = &slots_[head & mask_];
+        *item = std::move(*slot);
+        slot->~T();
+        head_.store(head + 1, std::memory_order_release);
+        not_full_.NotifyOne();
+        return true;
+    }
+
+    void Pop(T* item) {
+        if (!TryPop(item)) {
+            not_empty_.Wait([&] { return TryPop(item); });
+        }
+    }
+
+    // consumer: pops up to max items into items, returns how many
+    std::size_t TryPopBatch(T* items, std::size_t max) {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        if (tail_cache_ - head < max) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+        }
+        const std::size_t n = std::min<std::size_t>(max, tail_cache_ - head);
+        if (n == 0) {
+            return 0;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            T* slot = &slots_[(head + i) & mask_];
+            items[i] = std::move(*slot);
+            slot->~T();
+        }
+        head_.store(head + n, std::memory_order_release);
+        not_full_.NotifyOne();
+        return n;
+    }
+
+    // consumer: blocks until at least one item is there
+    std::size_t PopBatch(T* items, std::size_t max) {
+        std::size_t n = TryPopBatch(items, max);
+        if (n == 0) {
+            not_empty_.Wait([&] { return (n = TryPopBatch(items, max)) != 0; });
+        }
+        return n;
+    }
+
+private:
+private:
+    // read by both, written by none
+    const uint64_t mask_;
+    T* const slots_;
+    char pad0_[kCacheLineSize];
+    // the producer's
+    std::atomic<uint64_t> tail_;
+    uint64_t head_cache_;
+    char pad1_[kCacheLineSize];
+    // the consumer's
+    std::atomic<uint64_t> head_;
+    uint64_t tail_cache_;
+    char pad2_[kCacheLineSize];
+    EventCount not_empty_;  // the consumer sleeps on it
+    EventCount not_full_;   // the producer sleeps on it
+};
+
+}  // end of namespace cg
@@ -0,0 +1,204 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "container/spsc_queue.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class SpscQueueTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+// counts the live copies, to see that the queue destroys what it holds
+struct Counted {
+    static int live;
+
+    int value;
+
+    explicit Counted(int v = 0) : value(v) {
+        ++live;
+    }
+
+    Counted(const Counted& other) : value(other.value) {
+        ++live;
+    }
+
+    Counted& operator=(const Counted& other) = default;
+
+    ~Counted() {
+        --live;
+    }
+};
+
+int Counted::live = 0;
+
+TEST_F(SpscQueueTest, Capacity) {
+    EXPECT_EQ(1U, SpscQueue<int>(1).Capacity());
+    EXPECT_EQ(8U, SpscQueue<int>(5).Capacity());
+    EXPECT_EQ(1024U, SpscQueue<int>(1024).Capacity());
+}
+
+TEST_F(SpscQueueTest, Fifo) {
+    SpscQueue<int> queue(4);
+    int item = 0;
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_FALSE(queue.TryPop(&item));
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.TryPush(i));
+    }
+    EXPECT_FALSE(queue.TryPush(4));
+    EXPECT_EQ(4U, queue.Size());
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.TryPop(&item));
+        EXPECT_EQ(i, item);
+    }
+    EXPECT_FALSE(queue.TryPop(&item));
+
+    // around the ring a few times
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(queue.TryPush(i));
+        EXPECT_TRUE(queue.TryPush(i + 1000));
+        EXPECT_TRUE(queue.TryPop(&item));
+        EXPECT_EQ(i, item);
+        EXPECT_TRUE(queue.TryPop(&item));
+        EXPECT_EQ(i + 1000, item);
+    }
+}
+
+TEST_F(SpscQueueTest, MoveOnlyWhenPushed) {
+    SpscQueue<std::unique_ptr<int>> queue(1);
+    std::unique_ptr<int> a(new int(1));
+    std::unique_ptr<int> b(new int(2));
+    EXPECT_TRUE(queue.TryPush(std::move(a)));
+    EXPECT_EQ(nullptr, a);
+    EXPECT_FALSE(queue.TryPush(std::move(b)));
+    ASSERT_NE(nullptr, b);
+    EXPECT_EQ(2, *b);
+
+    std::unique_ptr<int> out;
+    EXPECT_TRUE(queue.TryPop(&out));
+    EXPECT_EQ(1, *out);
+    EXPECT_TRUE(queue.TryEmplace(new int(3)));
+    EXPECT_TRUE(queue.TryPop(&out));
+    EXPECT_EQ(3, *out);
+}
+
+TEST_F(SpscQueueTest, DestroysItemsLeft) {
+    Counted::live = 0;
+    {
+        SpscQueue<Counted> queue(8);
+        for (int i = 0; i < 5; ++i) {
+            queue.TryEmplace(i);
+        }
+        Counted out;
+        queue.TryPop(&out);
+        EXPECT_EQ(5, Counted::live);
+    }
+    EXPECT_EQ(0, Counted::live);
+}
+
+TEST_F(SpscQueueTest, Batch) {
+    SpscQueue<int> queue(8);
+    std::vector<int> in;
+    for (int i = 0; i < 10; ++i) {
+        in.push_back(i);
+    }
+    EXPECT_EQ(8U, queue.TryPushBatch(in.begin(), in.size()));
+    EXPECT_EQ(0U, queue.TryPushBatch(in.begin(), in.size()));
+
+    int out[10];
+    EXPECT_EQ(3U, queue.TryPopBatch(out, 3));
+    EXPECT_EQ(0, out[0]);
+    EXPECT_EQ(2, out[2]);
+    EXPECT_EQ(2U, queue.TryPushBatch(in.begin() + 8, 2));
+    EXPECT_EQ(7U, queue.TryPopBatch(out, 10));
+    EXPECT_EQ(3, out[0]);
+    EXPECT_EQ(9, out[6]);
+    EXPECT_EQ(0U, queue.TryPopBatch(out, 10));
+}
+
+// a small ring makes both sides block often
+TEST_F(SpscQueueTest, Stream) {
+    const uint64_t kItems = 1000000;
+    SpscQueue<uint64_t> queue(16);
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < kItems; ++i) {
+            queue.Push(i);
+        }
+    });
+    uint64_t item;
+    for (uint64_t i = 0; i < kItems; ++i) {
+        queue.Pop(&item);
+        ASSERT_EQ(i, item);
+    }
+    producer.join();
+    EXPECT_TRUE(queue.Empty());
+}
+
+TEST_F(SpscQueueTest, StreamBatch) {
+    const uint64_t kItems = 1000000;
+    SpscQueue<uint64_t> queue(64);
+    std::thread producer([&] {
+        uint64_t batch[10];
+        for (uint64_t i = 0; i < kItems;) {
+            const uint64_t n = std::min<uint64_t>(10, kItems - i);
+            for (uint64_t j = 0; j < n; ++j) {
+                batch[j] = i + j;
+            }
+            uint64_t* next = batch;
+            uint64_t left = n;
+            while (left > 0) {
+                const std::size_t pushed = queue.TryPushBatch(next, left);
+                next += pushed;
+                left -= pushed;
+                if (left > 0) {
+                    std::this_thread::yield();
+                }
+            }
+            i += n;
+        }
+    });
+    uint64_t batch[32];
+    for (uint64_t i = 0; i < kItems;) {
+        const std::size_t n = queue.PopBatch(batch, 32);
+        for (std::size_t j = 0; j < n; ++j) {
+            ASSERT_EQ(i + j, batch[j]);
+        }
+        i += n;
+    }
+    producer.join();
+}
+
+TEST_F(SpscQueueTest, Strings) {
+    const int kItems = 100000;
+    SpscQueue<std::string> queue(128);
+    std::thread producer([&] {
+        for (int i = 0; i < kItems; ++i) {
+            queue.Push(std::to_string(i));
+        }
+    });
+    std::string item;
+    for (int i = 0; i < kItems; ++i) {
+        queue.Pop(&item);
+        ASSERT_EQ(std::to_string(i), item);
+    }
+    producer.join();
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
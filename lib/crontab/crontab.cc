@@ -1,178 +1,700 @@
 #include "include/crontab.h"
 
-#include <time.h>
+#include <stdlib.h>
 
 #include <string>
-#include <unordered_map>
 
-#include "include/assert.h"
+#include "algorithm/bit.h"
 #include "include/log.h"
 #include "system/timestamp.h"
 
 namespace cg {
 
-bool CronTab::CanExecute() {
-    return month() && week() && day() && hour() && minute();
+uint8_t CronTab::MinValue(RuleType type) {
+    static const uint8_t kMin[RULE_TYPE_NUM] = {1, 0, 1, 0, 0};
+    return kMin[type];
 }
 
-bool CronTab::month() {
-    return compare(RULE_TYPE_MON);
+uint8_t CronTab::MaxValue(RuleType type) {
+    static const uint8_t kMax[RULE_TYPE_NUM] = {12, 6, 31, 23, 59};
+    return kMax[type];
 }
 
-bool CronTab::week() {
-    return compare(RULE_TYPE_WEEK);
+uint64_t CronTab::CompileRule(RuleType type, const Rule& rule) {
+    const uint8_t lo = MinValue(type);
+    const uint8_t hi = MaxValue(type);
+    uint64_t mask = 0;
+    if (rule.type_ == RULE_TYPE_NUM || rule.policy_ == POLICY_NUM || rule.list_.empty()
+            || (rule.policy_ == POLICY_DIVISION && rule.list_[0] <= 1)) {
+        for (uint32_t v = lo; v <= hi; ++v) {
+            mask |= (1ULL << v);
+        }
+        return mask;
+    }
+    if (rule.policy_ == POLICY_DIVISION) {
+        for (uint32_t v = lo; v <= hi; v += rule.list_[0]) {
+            mask |= (1ULL << v);
+        }
+        return mask;
+    }
+    for (auto v : rule.list_) {
+        if (type == RULE_TYPE_WEEK && v == 7) {
+            v = 0;
+        }
+        // out of range values never match
+        if (v >= lo && v <= hi) {
+            mask |= (1ULL << v);
+        }
+    }
+    return mask;
+}
+
+void CronTab::compile() {
+    mask_.minute = CompileRule(RULE_TYPE_MINUTE, rules_[RULE_TYPE_MINUTE]);
+    mask_.hour = CompileRule(RULE_TYPE_HOUR, rules_[RULE_TYPE_HOUR]);
+    mask_.day = static_cast<uint32_t>(CompileRule(RULE_TYPE_DAY, rules_[RULE_TYPE_DAY]));
+    mask_.month = static_cast<uint32_t>(CompileRule(RULE_TYPE_MON, rules_[RULE_TYPE_MON]));
+    mask_.week = static_cast<uint8_t>(CompileRule(RULE_TYPE_WEEK, rules_[RULE_TYPE_WEEK]));
+}
+
+namespace {
+
+bool isLeapYear(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+int daysInMonth(int year, int month) {
+    static const int kDays[13] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return month == 2 && isLeapYear(year) ? 29 : kDays[month];
 }
 
-bool CronTab::day() {
-    return compare(RULE_TYPE_DAY);
+// 0 is sunday
+int weekday(int year, int month, int day) {
+    static const int kOffset[12] = {0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4};
+    if (month < 3) {
+        --year;
+    }
+    return (year + year / 4 - year / 100 + year / 400 + kOffset[month - 1] + day) % 7;
 }
 
-bool CronTab::hour() {
-    return compare(RULE_TYPE_HOUR);
+// lowest set bit of mask >= from, -1 if none
+int nextBit(uint64_t mask, int from) {
+    if (from > 63) {
+        return -1;
+    }
+    mask >>= from;
+    return mask == 0 ? -1 : from + CountTrailingZeros(mask);
 }
 
-bool CronTab::minute() {
-    return compare(RULE_TYPE_MINUTE);
+// highest set bit of mask <= from, -1 if none
+int prevBit(uint64_t mask, int from) {
+    if (from < 0) {
+        return -1;
+    }
+    if (from < 63) {
+        mask &= (2ULL << from) - 1;
+    }
+    return Log2Floor(mask);
+}
+
+}  // end of anonymous namespace
+
+struct CronTab::Fields {
+    int year;
+    int month;  // 1-12
+    int day;
+    int hour;
+    int minute;
+
+    Fields(int y, int mo, int d, int h, int mi)
+        : year(y), month(mo), day(d), hour(h), minute(mi) {}
+
+    explicit Fields(time_t t) {
+        struct tm stm;
+        LocalTime(t, &stm);
+        year = stm.tm_year + 1900;
+        month = stm.tm_mon + 1;
+        day = stm.tm_mday;
+        hour = stm.tm_hour;
+        minute = stm.tm_min;
+    }
+
+    time_t ToTimestamp(int isdst) const {
+        struct tm stm = {};
+        stm.tm_year = year - 1900;
+        stm.tm_mon = month - 1;
+        stm.tm_mday = day;
+        stm.tm_hour = hour;
+        stm.tm_min = minute;
+        stm.tm_isdst = isdst;
+        return mktime(&stm);
+    }
+};
+
+uint32_t CronTab::days(int year, int month) const {
+    // bit k of week_days is the weekday of day k + 1, repeated over 35 days
+    const uint32_t week = mask_.week & 0x7f;
+    const uint64_t rotated = ((week | (week << 7)) >> weekday(year, month, 1)) & 0x7f;
+    const uint64_t week_days = rotated | (rotated << 7) | (rotated << 14)
+        | (rotated << 21) | (rotated << 28);
+    const uint64_t in_month = (2ULL << daysInMonth(year, month)) - 2;
+    return static_cast<uint32_t>(mask_.day & (week_days << 1) & in_month);
 }
 
-bool CronTab::compare(RuleType type) {
-    // no set this type, default no limit
-    if (rules_[type].Empty()) {
+// Moves f to the first matching minute at or after it. A field that has no
+// match left carries into the next larger one, which resets the smaller ones.
+bool CronTab::next(Fields* f, int last_year) const {
+    while (f->year <= last_year) {
+        int month = nextBit(mask_.month, f->month);
+        if (month < 0) {
+            *f = Fields{f->year + 1, 1, 1, 0, 0};
+            continue;
+        }
+        if (month != f->month) {
+            *f = Fields{f->year, month, 1, 0, 0};
+        }
+        int day = nextBit(days(f->year, f->month), f->day);
+        if (day < 0) {
+            *f = Fields{f->year, f->month + 1, 1, 0, 0};
+            continue;
+        }
+        if (day != f->day) {
+            *f = Fields{f->year, f->month, day, 0, 0};
+        }
+        int hour = nextBit(mask_.hour, f->hour);
+        if (hour < 0) {
+            *f = Fields{f->year, f->month, f->day + 1, 0, 0};
+            continue;
+        }
+        if (hour != f->hour) {
+            *f = Fields{f->year, f->month, f->day, hour, 0};
+        }
+        int minute = nextBit(mask_.minute, f->minute);
+        if (minute < 0) {
+            *f = Fields{f->year, f->month, f->day, f->hour + 1, 0};
+            continue;
+        }
+        f->minute = minute;
         return true;
     }
-    bool ans = false;
-    auto curr = getCurrentDate(type);
-    switch (rules_[type].policy_) {
-        case POLICY_DIVISION: {
-            ans = (curr % rules_[type].list_[0] == 0);
-        } break;
-        case POLICY_SOMEONE: {
-            auto rule = rules_[type];
-            ans = rule.Find(curr);
-        } break;
-        default:
-            break;
+    return false;
+}
+
+// Mirror of next: moves f to the last matching minute at or before it.
+bool CronTab::prev(Fields* f, int first_year) const {
+    while (f->year >= first_year) {
+        int month = prevBit(mask_.month, f->month);
+        if (month < 0) {
+            *f = Fields{f->year - 1, 12, 31, 23, 59};
+            continue;
+        }
+        if (month != f->month) {
+            *f = Fields{f->year, month, 31, 23, 59};
+        }
+        int day = prevBit(days(f->year, f->month), f->day);
+        if (day < 0) {
+            *f = Fields{f->year, f->month - 1, 31, 23, 59};
+            continue;
+        }
+        if (day != f->day) {
+            *f = Fields{f->year, f->month, day, 23, 59};
+        }
+        int hour = prevBit(mask_.hour, f->hour);
+        if (hour < 0) {
+            *f = Fields{f->year, f->month, f->day - 1, 23, 59};
+            continue;
+        }
+        if (hour != f->hour) {
+            *f = Fields{f->year, f->month, f->day, hour, 59};
+        }
+        int minute = prevBit(mask_.minute, f->minute);
+        if (minute < 0) {
+            *f = Fields{f->year, f->month, f->day, f->hour - 1, 59};
+            continue;
+        }
+        f->minute = minute;
+        return true;
     }
-    if (!ans) {
-        LOG(DEBUG) << "Someone plice failed. type=" << static_cast<uint32_t>(type)
-                  << ", curr=" << curr << ", val=" << static_cast<uint32_t>(rules_[type].list_[0])
-                  << ", policy=" << static_cast<uint32_t>(rules_[type].policy_);
+    return false;
+}
+
+time_t CronTab::NextFireTime(time_t after) const {
+    Fields f(after);
+    const int last_year = f.year + kSearchYears;
+    f.minute += 1;
+    while (next(&f, last_year)) {
+        time_t t = f.ToTimestamp(-1);
+        if (t <= after) {
+            // the hour repeated when daylight saving ends, take its second pass
+            t = f.ToTimestamp(0);
+        }
+        if (t > after && CanExecute(CronTime::FromTimestamp(t))) {
+            return t;
+        }
+        // skipped by daylight saving, go on from the next minute
+        f.minute += 1;
     }
-    return ans;
+    return -1;
 }
 
-int CronTab::getCurrentDate(RuleType type) {
-    time_t tt = time(nullptr);
-    struct tm stm;
-    localtime_r(&tt, &stm);
-    int ans = 0;
-    switch (type) {
-        case RULE_TYPE_MON:
-            ans = stm.tm_mon;
-            break;
-        case RULE_TYPE_WEEK:
-            ans = stm.tm_wday;
-            break;
-        case RULE_TYPE_DAY:
-            ans = stm.tm_mday;
-            break;
-        case RULE_TYPE_HOUR:
-            ans = stm.tm_hour;
-            break;
-        case RULE_TYPE_MINUTE:
-            ans = stm.tm_min;
-            break;
-        default:
-            ans = -1;
+time_t CronTab::PrevFireTime(time_t before) const {
+    Fields f(before - 1);
+    const int first_year = f.year - kSearchYears;
+    while (prev(&f, first_year)) {
+        time_t t = f.ToTimestamp(-1);
+        if (t >= before) {
+            t = f.ToTimestamp(1);
+        }
+        if (t < before && CanExecute(CronTime::FromTimestamp(t))) {
+            return t;
+        }
+        f.minute -= 1;
+    }
+    return -1;
+}
+
+namespace {
+
+const char* const kParseMessages[CRON_PARSE_NUM] = {
+    "ok",
+    "empty expression",
+    "expect 5 fields",
+    "unexpected character",
+    "bad number",
+    "value out of range",
+    "range start after its end",
+    "bad step",
+    "unknown name",
+    "unknown macro",
+};
+
+const char* const kMonthNames[12] = {
+    "jan", "feb", "mar", "apr", "may", "jun", "jul", "aug", "sep", "oct", "nov", "dec",
+};
+
+const char* const kWeekNames[7] = {"sun", "mon", "tue", "wed", "thu", "fri", "sat"};
+
+struct CronMacro {
+    const char* name;
+    const char* expr;
+};
+
+const CronMacro kMacros[] = {
+    {"yearly", "0 0 1 1 *"},
+    {"annually", "0 0 1 1 *"},
+    {"monthly", "0 0 1 * *"},
+    {"weekly", "0 0 * * 0"},
+    {"daily", "0 0 * * *"},
+    {"midnight", "0 0 * * *"},
+    {"hourly", "0 * * * *"},
+};
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool isLetter(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+char lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+// word (lower case) equals s of size n in any case
+bool equalFold(const char* word, const char* s, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (word[i] == '\0' || word[i] != lower(s[i])) {
+            return false;
+        }
+    }
+    return word[n] == '\0';
+}
+
+class CronParser {
+public:
+    CronParser(const Slice& expr, CronParseError* error)
+        : begin_(expr.Data()), p_(expr.Data()), end_(expr.Data() + expr.Size()), error_(error) {}
+
+    bool Parse(CronMask* mask) {
+        skipBlank();
+        if (p_ == end_) {
+            return fail(CRON_PARSE_EMPTY, RULE_TYPE_NUM, p_);
+        }
+        if (*p_ == '@') {
+            return macro(mask);
+        }
+        // crontab order
+        static const RuleType kFields[RULE_TYPE_NUM] = {
+            RULE_TYPE_MINUTE, RULE_TYPE_HOUR, RULE_TYPE_DAY, RULE_TYPE_MON, RULE_TYPE_WEEK,
+        };
+        uint64_t bits[RULE_TYPE_NUM];
+        for (int i = 0; i < RULE_TYPE_NUM; ++i) {
+            if (i > 0) {
+                const char* q = p_;
+                skipBlank();
+                if (p_ == q || p_ == end_) {
+                    return fail(CRON_PARSE_FIELD_COUNT, RULE_TYPE_NUM, p_);
+                }
+            }
+            if (!field(kFields[i], &bits[kFields[i]])) {
+                return false;
+            }
+        }
+        skipBlank();
+        if (p_ != end_) {
+            return fail(CRON_PARSE_FIELD_COUNT, RULE_TYPE_NUM, p_);
+        }
+        mask->minute = bits[RULE_TYPE_MINUTE];
+        mask->hour = bits[RULE_TYPE_HOUR];
+        mask->day = static_cast<uint32_t>(bits[RULE_TYPE_DAY]);
+        mask->month = static_cast<uint32_t>(bits[RULE_TYPE_MON]);
+        mask->week = static_cast<uint8_t>(bits[RULE_TYPE_WEEK]);
+        return true;
+    }
+
+private:
+    bool fail(CronParseCode code, RuleType field, const char* at) {
+        if (error_ != nullptr) {
+            error_->code = code;
+            error_->field = field;
+            error_->offset = static_cast<std::size_t>(at - begin_);
+        }
+        return false;
+    }
+
+    void skipBlank() {
+        while (p_ < end_ && isBlank(*p_)) {
+            ++p_;
+        }
+    }
+
+    bool macro(CronMask* mask) {
+        const char* at = p_++;
+        const char* name = p_;
+        while (p_ < end_ && !isBlank(*p_)) {
+            ++p_;
+        }
+        const std::size_t n = static_cast<std::size_t>(p_ - name);
+        skipBlank();
+        if (p_ != end_) {
+            return fail(CRON_PARSE_FIELD_COUNT, RULE_TYPE_NUM, p_);
+        }
+        for (const auto& it : kMacros) {
+            if (equalFold(it.name, name, n)) {
+                return CronParser(Slice(it.expr), nullptr).Parse(mask);
+            }
+        }
+        return fail(CRON_PARSE_UNKNOWN_MACRO, RULE_TYPE_NUM, at);
+    }
+
+    // up to 3 digits
+    bool number(RuleType type, int* v) {
+        const char* at = p_;
+        int n = 0;
+        while (p_ < end_ && isDigit(*p_) && p_ - at < 3) {
+            n = n * 10 + (*p_++ - '0');
+        }
+        if (p_ == at || (p_ < end_ && isDigit(*p_))) {
+            return fail(CRON_PARSE_BAD_NUMBER, type, at);
+        }
+        *v = n;
+        return true;
+    }
+
+    bool name(RuleType type, int* v) {
+        const char* at = p_;
+        while (p_ < end_ && isLetter(*p_)) {
+            ++p_;
+        }
+        const std::size_t n = static_cast<std::size_t>(p_ - at);
+        if (type == RULE_TYPE_MON) {
+            for (int i = 0; i < 12; ++i) {
+                if (equalFold(kMonthNames[i], at, n)) {
+                    *v = i + 1;
+                    return true;
+                }
+            }
+        } else if (type == RULE_TYPE_WEEK) {
+            for (int i = 0; i < 7; ++i) {
+                if (equalFold(kWeekNames[i], at, n)) {
+                    *v = i;
+                    return true;
+                }
+            }
+        }
+        return fail(CRON_PARSE_UNKNOWN_NAME, type, at);
+    }
+
+    bool value(RuleType type, int* v) {
+        const char* at = p_;
+        if (p_ < end_ && isLetter(*p_)) {
+            return name(type, v);
+        }
+        if (!number(type, v)) {
+            return false;
+        }
+        // 7 is sunday as well
+        const int hi = type == RULE_TYPE_WEEK ? 7 : CronTab::MaxValue(type);
+        if (*v < CronTab::MinValue(type) || *v > hi) {
+            return fail(CRON_PARSE_OUT_OF_RANGE, type, at);
+        }
+        return true;
+    }
+
+    bool field(RuleType type, uint64_t* bits) {
+        const int max = type == RULE_TYPE_WEEK ? 7 : CronTab::MaxValue(type);
+        *bits = 0;
+        for (;;) {
+            const char* at = p_;
+            int lo = CronTab::MinValue(type);
+            int hi = max;
+            bool single = false;
+            if (p_ < end_ && *p_ == '*') {
+                ++p_;
+            } else {
+                if (!value(type, &lo)) {
+                    return false;
+                }
+                hi = lo;
+                single = true;
+                if (p_ < end_ && *p_ == '-') {
+                    ++p_;
+                    if (!value(type, &hi)) {
+                        return false;
+                    }
+                    if (hi < lo) {
+                        return fail(CRON_PARSE_BAD_RANGE, type, at);
+                    }
+                    single = false;
+                }
+            }
+            int step = 1;
+            if (p_ < end_ && *p_ == '/') {
+                ++p_;
+                const char* step_at = p_;
+                if (!number(type, &step) || step == 0) {
+                    return fail(CRON_PARSE_BAD_STEP, type, step_at);
+                }
+                if (single) {
+                    hi = max;
+                }
+            }
+            for (int v = lo; v <= hi; v += step) {
+                *bits |= (1ULL << v);
+            }
+            if (p_ < end_ && *p_ == ',') {
+                ++p_;
+                continue;
+            }
             break;
+        }
+        if (p_ < end_ && !isBlank(*p_)) {
+            return fail(CRON_PARSE_UNEXPECTED_CHAR, type, p_);
+        }
+        if (type == RULE_TYPE_WEEK && (*bits & (1ULL << 7))) {
+            *bits = (*bits | 1) & 0x7f;
+        }
+        return true;
+    }
+
+private:
+    const char* begin_;
+    const char* p_;
+    const char* end_;
+    CronParseError* error_;
+};
+
+// the syntax of the Rule model, see CronTab::Invalid
+
+// "*"
+bool matchEveryone(const Slice& s) {
+    return s.Size() == 1 && s[0] == '*';
+}
+
+// "*/n"
+bool matchEvery(const Slice& s) {
+    if (s.Size() < 3 || s[0] != '*' || s[1] != '/') {
+        return false;
+    }
+    for (std::size_t i = 2; i < s.Size(); ++i) {
+        if (!isDigit(s[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// "a,b,,c,"
+bool matchSomeone(const Slice& s) {
+    if (s.Empty() || !isDigit(s[0])) {
+        return false;
     }
-    return ans;
+    for (std::size_t i = 0; i < s.Size(); ++i) {
+        if (!isDigit(s[i]) && s[i] != ',') {
+            return false;
+        }
+    }
+    return true;
+}
+
+// "a-b,,c-d,"
+bool matchSomeoneRange(const Slice& s) {
+    std::size_t i = 0;
+    while (i < s.Size()) {
+        for (int side = 0; side < 2; ++side) {
+            const std::size_t digits = i;
+            while (i < s.Size() && isDigit(s[i])) {
+                ++i;
+            }
+            if (i == digits) {
+                return false;
+            }
+            if (side == 0) {
+                if (i == s.Size() || s[i] != '-') {
+                    return false;
+                }
+                ++i;
+            }
+        }
+        while (i < s.Size() && s[i] == ',') {
+            ++i;
+        }
+    }
+    return !s.Empty();
+}
+
+// the leading digits of s, as atoi would read them
+uint8_t leadingNumber(const Slice& s) {
+    uint32_t n = 0;
+    for (std::size_t i = 0; i < s.Size() && isDigit(s[i]); ++i) {
+        n = n * 10 + static_cast<uint32_t>(s[i] - '0');
+    }
+    return static_cast<uint8_t>(n);
+}
+
+// "a-b"
+void parseRangeOf(const Slice& s, uint8_t* begin, uint8_t* end) {
+    Slice rest = s;
+    while (!rest.Empty() && rest[0] != '-') {
+        rest.RemovePrefix(1);
+    }
+    *begin = leadingNumber(s);
+    if (!rest.Empty()) {
+        rest.RemovePrefix(1);
+    }
+    *end = leadingNumber(rest);
+}
+
+}  // end of anonymous namespace
+
+const char* CronParseError::Message() const {
+    return code < CRON_PARSE_NUM ? kParseMessages[code] : "unknown error";
+}
+
+bool ParseCronExpr(const Slice& expr, CronMask* mask, CronParseError* error) {
+    if (error != nullptr) {
+        error->code = CRON_PARSE_OK;
+        error->field = RULE_TYPE_NUM;
+        error->offset = 0;
+    }
+    return CronParser(expr, error).Parse(mask);
+}
+
+bool CronTab::Init(const Slice& expr, CronParseError* error) {
+    CronMask mask;
+    if (!ParseCronExpr(expr, &mask, error)) {
+        return false;
+    }
+    mask_ = mask;
+    return true;
+}
+
+bool CronTab::Invalid(const std::string& pattern) {
+    SmallVector<Slice, RULE_TYPE_NUM + 1> v;
+    StringSplit(Slice(" "), Slice(pattern), &v);
+    if (v.size() != 5) {
+        fprintf(stderr, "invalid pattern for split. pattern:%s, size:%u\n",
+                pattern.c_str(), static_cast<uint32_t>(v.size()));
+        return true;
+    }
+    for (const auto& it : v) {
+        if (!matchEvery(it) && !matchEveryone(it) && !matchSomeone(it)
+                && !matchSomeoneRange(it)) {
+            fprintf(stderr, "invalid pattern. field:%.*s\n",
+                    static_cast<int>(it.Size()), it.Data());
+            return true;
+        }
+    }
+    return false;
 }
 
 Policy ParsePolicy(const std::string& pattern) {
-    if (RE2::FullMatch(pattern, k_pattern_division_everyone) ||
-        RE2::FullMatch(pattern, k_pattern_division_every)) {
+    const Slice s(pattern);
+    if (matchEveryone(s) || matchEvery(s)) {
         return POLICY_DIVISION;
-    } else if (RE2::FullMatch(pattern, k_pattern_someone) ||
-               RE2::FullMatch(pattern, k_pattern_someone_range)) {
+    } else if (matchSomeone(s) || matchSomeoneRange(s)) {
         return POLICY_SOMEONE;
     }
     return POLICY_NUM;
 }
 
-std::vector<uint8_t> ParseData(const Policy& policy, const std::string& pattern) {
-    std::vector<uint8_t> data;
+RuleList ParseData(const Policy& policy, const std::string& pattern) {
+    const Slice s(pattern);
+    RuleList data;
     switch (policy) {
         case POLICY_DIVISION: {
-            auto str = pattern;
-            if (RE2::FullMatch(str, k_pattern_division_everyone)) {
+            if (matchEveryone(s)) {
                 data.push_back(static_cast<uint8_t>(1));
-            } else {
-                auto tmp = str.substr(str.find_first_of("/") + 1);
-                CG_ASSERT(RE2::FullMatch(tmp, "[0-9]+"));
-                data.push_back(static_cast<uint8_t>(std::stoi(tmp)));
+            } else if (matchEvery(s)) {
+                data.push_back(leadingNumber(Slice(s.Data() + 2, s.Size() - 2)));
             }
         } break;
         case POLICY_SOMEONE: {
-            auto str = pattern;
-            if (RE2::FullMatch(str, k_pattern_someone)) {
-                auto pos = str.find_first_of(",");
-                while (pos != std::string::npos) {
-                    auto tmp = str.substr(0, pos);
-                    if (tmp != "") {
-                        CG_ASSERT(RE2::FullMatch(tmp, "[0-9]+"));
-                        data.push_back(static_cast<uint8_t>(std::stoi(tmp)));
-                    }
-                    str = str.substr(pos + 1);
-                    pos = str.find_first_of(",");
-                }
-                if (str != "" && str != ",") {
-                    CG_ASSERT(RE2::FullMatch(str, "[0-9]+"));
-                    data.push_back(static_cast<uint8_t>(std::stoi(str)));
+            // eg: ["1", "2"] or ["0-10", "15-20"]
+            SmallVector<Slice, 16> list;
+            StringSplit(Slice(","), s, &list);
+            if (matchSomeone(s)) {
+                for (const auto& it : list) {
+                    data.push_back(leadingNumber(it));
                 }
-            } else if (RE2::FullMatch(str, k_pattern_someone_range)) {
-                // eg: 0-10,15-20
-                // eg: ["0-10", "15-20"]
-                std::vector<std::string> range_list;
-                StringSplit(",", str, &range_list);
-                for (const auto& it : range_list) {
+            } else if (matchSomeoneRange(s)) {
+                for (const auto& it : list) {
                     uint8_t begin = 0;
                     uint8_t end = 0;
-                    parseRange(it, &begin, &end);
-                    for (uint8_t i = begin; i <= end; ++i) {
-                        data.push_back(i);
+                    parseRangeOf(it, &begin, &end);
+                    for (uint32_t i = begin; i <= end; ++i) {
+                        data.push_back(static_cast<uint8_t>(i));
                     }
                 }
             }
         } break;
         default:
-            CG_ASSERT(false);
+            // POLICY_NUM, what ParsePolicy gives a broken pattern: no values
             break;
     }
     return data;
 }
 
 CronTab* GenCronTab(const std::string& pattern) {
-    std::vector<std::string> v;
-    StringSplit(" ", pattern, &v);
-    CG_ASSERT_EQ(5U, v.size());
-    std::vector<Rule> rules(RULE_TYPE_NUM);
-    for (int i = RULE_TYPE_NUM - 1; i >= 0; --i) {
-        auto policy = ParsePolicy(v[i]);
-        auto data = ParseData(policy, v[i]);
-        rules[i] = CronTab::GenRule(static_cast<RuleType>(RULE_TYPE_NUM - i - 1), policy, data);
-    }
+    return GenCronTab(Slice(pattern), nullptr);
+}
+
+CronTab* GenCronTab(const Slice& pattern, CronParseError* error) {
     CronTab* crontab = new CronTab();
-    crontab->Init(rules);
+    if (!crontab->Init(pattern, error)) {
+        delete crontab;
+        return nullptr;
+    }
     return crontab;
 }
 
 void parseRange(const std::string& pattern, uint8_t* begin, uint8_t* end) {
-    auto pos = pattern.find_first_of("-");
-    auto begin_str = pattern.substr(0, pos);
-    auto end_str = pattern.substr(pos + 1);
-    *begin = static_cast<uint8_t>(std::stoi(begin_str));
-    *end = static_cast<uint8_t>(std::stoi(end_str));
+    parseRangeOf(Slice(pattern), begin, end);
 }
 
 }  // end of namespace cg
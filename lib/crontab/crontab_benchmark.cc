@@ -0,0 +1,414 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "include/crontab.h"
+#include "re2/re2.h"
+
+// every allocation of the binary, for the allocs_per_item counters
+static uint64_t g_allocs = 0;
+
+void* operator new(std::size_t size) {
+    ++g_allocs;
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+namespace cg {
+namespace {
+
+const int kRules = 100000;
+
+const char* kPatterns[] = {
+    "*/5 * * * *",
+    "0,15,30,45 */2 * * 1-5",
+    "0-10,20-30,40-50 1,2,3,4,5,6 1-7,15-21 * *",
+    "30 8 * 1,4,7,10 0-6",
+    "*/1 */3 1,11,21 * *",
+    "5,10,15,20,25,30,35,40,45,50,55 0-23 * * *",
+    "0 0 1 1 *",
+    "12 0-6,18-23 * 2-11 1,3,5",
+};
+
+// The matching CronTab did before the rules were compiled: one localtime per
+// field and a linear scan of the listed values.
+class LegacyCronTab {
+public:
+    explicit LegacyCronTab(const std::string& pattern) {
+        static const RuleType kFields[RULE_TYPE_NUM] = {
+            RULE_TYPE_MINUTE, RULE_TYPE_HOUR, RULE_TYPE_DAY, RULE_TYPE_MON, RULE_TYPE_WEEK,
+        };
+        std::vector<std::string> v;
+        StringSplit(" ", pattern, &v);
+        for (int i = 0; i < RULE_TYPE_NUM; ++i) {
+            auto policy = ParsePolicy(v[i]);
+            rules_[kFields[i]] = CronTab::GenRule(kFields[i], policy, ParseData(policy, v[i]));
+        }
+    }
+
+    bool CanExecute() {
+        for (int i = 0; i < RULE_TYPE_NUM; ++i) {
+            if (!compare(static_cast<RuleType>(i))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    bool compare(RuleType type) {
+        if (rules_[type].Empty()) {
+            return true;
+        }
+        int curr = getCurrentDate(type);
+        Rule rule = rules_[type];
+        if (rule.policy_ == POLICY_DIVISION) {
+            return curr % rule.list_[0] == 0;
+        }
+        return rule.Find(curr);
+    }
+
+    static int getCurrentDate(RuleType type) {
+        time_t tt = time(nullptr);
+        struct tm stm;
+        localtime_r(&tt, &stm);
+        switch (type) {
+            case RULE_TYPE_MON:
+                return stm.tm_mon + 1;
+            case RULE_TYPE_WEEK:
+                return stm.tm_wday;
+            case RULE_TYPE_DAY:
+                return stm.tm_mday;
+            case RULE_TYPE_HOUR:
+                return stm.tm_hour;
+            case RULE_TYPE_MINUTE:
+                return stm.tm_min;
+            default:
+                return -1;
+        }
+    }
+
+    Rule rules_[RULE_TYPE_NUM];
+};
+
+const char* pattern(int i) {
+    return kPatterns[i % (sizeof(kPatterns) / sizeof(kPatterns[0]))];
+}
+
+std::vector<std::unique_ptr<CronTab>>& cronTabs() {
+    static std::vector<std::unique_ptr<CronTab>> tabs;
+    if (tabs.empty()) {
+        for (int i = 0; i < kRules; ++i) {
+            tabs.emplace_back(GenCronTab(pattern(i)));
+        }
+    }
+    return tabs;
+}
+
+void BM_LegacyCanExecute(benchmark::State& state) {
+    std::vector<LegacyCronTab> tabs;
+    for (int i = 0; i < kRules; ++i) {
+        tabs.emplace_back(pattern(i));
+    }
+    for (auto _ : state) {
+        int n = 0;
+        for (auto& it : tabs) {
+            n += it.CanExecute();
+        }
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetItemsProcessed(state.iterations() * tabs.size());
+}
+
+// one snapshot per rule
+void BM_MaskCanExecute(benchmark::State& state) {
+    auto& tabs = cronTabs();
+    for (auto _ : state) {
+        int n = 0;
+        for (auto& it : tabs) {
+            n += it->CanExecute();
+        }
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetItemsProcessed(state.iterations() * tabs.size());
+}
+
+// one snapshot per evaluation of the whole table
+void BM_MaskCanExecuteSnapshot(benchmark::State& state) {
+    auto& tabs = cronTabs();
+    for (auto _ : state) {
+        CronTime now = CronTime::Now();
+        int n = 0;
+        for (auto& it : tabs) {
+            n += it->CanExecute(now);
+        }
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetItemsProcessed(state.iterations() * tabs.size());
+}
+
+// patterns ordered by how far away their next fire time is
+const char* kSparsePatterns[] = {
+    "*/5 * * * *",
+    "30 8 * * 1-5",
+    "0 0 1 * *",
+    "0 0 13 * 5",
+    "0 0 1 1 *",
+};
+
+const time_t kYear = 366 * 86400;
+
+// Step minute by minute over a one year horizon, what polling every minute costs.
+time_t bruteForceNext(const CronTab& crontab, time_t after) {
+    for (time_t t = after - after % 60 + 60; t <= after + kYear; t += 60) {
+        if (crontab.CanExecute(CronTime::FromTimestamp(t))) {
+            return t;
+        }
+    }
+    return -1;
+}
+
+void BM_NextFireTimeBruteForce(benchmark::State& state) {
+    std::unique_ptr<CronTab> crontab(GenCronTab(kSparsePatterns[state.range(0)]));
+    time_t after = 1616840400;  // 2021-03-27 10:20 UTC
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bruteForceNext(*crontab, after));
+    }
+    state.SetLabel(kSparsePatterns[state.range(0)]);
+}
+
+void BM_NextFireTime(benchmark::State& state) {
+    std::unique_ptr<CronTab> crontab(GenCronTab(kSparsePatterns[state.range(0)]));
+    time_t after = 1616840400;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(crontab->NextFireTime(after));
+    }
+    state.SetLabel(kSparsePatterns[state.range(0)]);
+}
+
+void BM_PrevFireTime(benchmark::State& state) {
+    std::unique_ptr<CronTab> crontab(GenCronTab(kSparsePatterns[state.range(0)]));
+    time_t before = 1616840400;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(crontab->PrevFireTime(before));
+    }
+    state.SetLabel(kSparsePatterns[state.range(0)]);
+}
+
+// The regex parser GenCronTab used before ParseCronExpr, kept as the baseline.
+namespace re2_path {
+
+const char* k_pattern_division_everyone = "\\*";
+const char* k_pattern_division_every = "\\*/[0-9]+";
+const char* k_pattern_someone = "([0-9]+[,]*)+";
+const char* k_pattern_someone_range = "([0-9]+-[0-9]+[,]*)+";
+
+bool invalid(const std::string& pattern) {
+    std::vector<std::string> v;
+    StringSplit(" ", pattern, &v);
+    if (v.size() != 5) {
+        return true;
+    }
+    for (const auto& it : v) {
+        if (!RE2::FullMatch(it, k_pattern_division_every)
+                && !(RE2::FullMatch(it, k_pattern_division_everyone))
+                && !(RE2::FullMatch(it, k_pattern_someone))
+                && !(RE2::FullMatch(it, k_pattern_someone_range))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Policy parsePolicy(const std::string& pattern) {
+    if (RE2::FullMatch(pattern, k_pattern_division_everyone) ||
+        RE2::FullMatch(pattern, k_pattern_division_every)) {
+        return POLICY_DIVISION;
+    } else if (RE2::FullMatch(pattern, k_pattern_someone) ||
+               RE2::FullMatch(pattern, k_pattern_someone_range)) {
+        return POLICY_SOMEONE;
+    }
+    return POLICY_NUM;
+}
+
+std::vector<uint8_t> parseData(const Policy& policy, const std::string& pattern) {
+    std::vector<uint8_t> data;
+    auto str = pattern;
+    if (policy == POLICY_DIVISION) {
+        if (RE2::FullMatch(str, k_pattern_division_everyone)) {
+            data.push_back(static_cast<uint8_t>(1));
+        } else {
+            data.push_back(static_cast<uint8_t>(std::stoi(str.substr(str.find_first_of("/") + 1))));
+        }
+    } else if (RE2::FullMatch(str, k_pattern_someone)) {
+        auto pos = str.find_first_of(",");
+        while (pos != std::string::npos) {
+            auto tmp = str.substr(0, pos);
+            if (tmp != "") {
+                data.push_back(static_cast<uint8_t>(std::stoi(tmp)));
+            }
+            str = str.substr(pos + 1);
+            pos = str.find_first_of(",");
+        }
+        if (str != "" && str != ",") {
+            data.push_back(static_cast<uint8_t>(std::stoi(str)));
+        }
+    } else if (RE2::FullMatch(str, k_pattern_someone_range)) {
+        std::vector<std::string> range_list;
+        StringSplit(",", str, &range_list);
+        for (const auto& it : range_list) {
+            auto pos = it.find_first_of("-");
+            uint8_t begin = static_cast<uint8_t>(std::stoi(it.substr(0, pos)));
+            uint8_t end = static_cast<uint8_t>(std::stoi(it.substr(pos + 1)));
+            for (uint32_t i = begin; i <= end; ++i) {
+                data.push_back(static_cast<uint8_t>(i));
+            }
+        }
+    }
+    return data;
+}
+
+CronTab* genCronTab(const std::string& pattern) {
+    if (invalid(pattern)) {
+        return nullptr;
+    }
+    static const RuleType kFields[RULE_TYPE_NUM] = {
+        RULE_TYPE_MINUTE, RULE_TYPE_HOUR, RULE_TYPE_DAY, RULE_TYPE_MON, RULE_TYPE_WEEK,
+    };
+    std::vector<std::string> v;
+    StringSplit(" ", pattern, &v);
+    std::vector<Rule> rules(RULE_TYPE_NUM);
+    for (int i = 0; i < RULE_TYPE_NUM; ++i) {
+        auto policy = parsePolicy(v[i]);
+        rules[i] = CronTab::GenRule(kFields[i], policy, parseData(policy, v[i]));
+    }
+    CronTab* crontab = new CronTab();
+    crontab->Init(rules);
+    return crontab;
+}
+
+}  // end of namespace re2_path
+
+void countAllocs(benchmark::State& state, uint64_t before, int64_t items) {
+    state.counters["allocs_per_item"] = static_cast<double>(g_allocs - before)
+        / static_cast<double>(items);
+}
+
+// a job table reload: parse every line into a CronTab
+void BM_ParseTableRE2(benchmark::State& state) {
+    std::vector<std::string> table;
+    std::size_t bytes = 0;
+    for (int i = 0; i < 1024; ++i) {
+        table.emplace_back(pattern(i));
+        bytes += table.back().size();
+    }
+    const uint64_t before = g_allocs;
+    for (auto _ : state) {
+        for (const auto& it : table) {
+            std::unique_ptr<CronTab> crontab(re2_path::genCronTab(it));
+            benchmark::DoNotOptimize(crontab.get());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * table.size());
+    state.SetBytesProcessed(state.iterations() * bytes);
+    countAllocs(state, before, state.iterations() * table.size());
+}
+
+void BM_ParseTable(benchmark::State& state) {
+    std::vector<std::string> table;
+    std::size_t bytes = 0;
+    for (int i = 0; i < 1024; ++i) {
+        table.emplace_back(pattern(i));
+        bytes += table.back().size();
+    }
+    const uint64_t before = g_allocs;
+    for (auto _ : state) {
+        for (const auto& it : table) {
+            std::unique_ptr<CronTab> crontab(GenCronTab(it));
+            benchmark::DoNotOptimize(crontab.get());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * table.size());
+    state.SetBytesProcessed(state.iterations() * bytes);
+    countAllocs(state, before, state.iterations() * table.size());
+}
+
+// The Rule model as its callers drive it: check, split, then a Rule per
+// field from ParsePolicy, ParseData and GenRule.
+void BM_ParseRules(benchmark::State& state) {
+    static const RuleType kFields[RULE_TYPE_NUM] = {
+        RULE_TYPE_MINUTE, RULE_TYPE_HOUR, RULE_TYPE_DAY, RULE_TYPE_MON, RULE_TYPE_WEEK,
+    };
+    std::vector<std::string> table;
+    for (int i = 0; i < 1024; ++i) {
+        table.emplace_back(pattern(i));
+    }
+    const uint64_t before = g_allocs;
+    for (auto _ : state) {
+        for (const auto& it : table) {
+            if (CronTab::Invalid(it)) {
+                continue;
+            }
+            std::vector<std::string> v;
+            StringSplit(" ", it, &v);
+            Rule rules[RULE_TYPE_NUM];
+            for (int i = 0; i < RULE_TYPE_NUM; ++i) {
+                const Policy policy = ParsePolicy(v[i]);
+                rules[i] = CronTab::GenRule(kFields[i], policy, ParseData(policy, v[i]));
+            }
+            benchmark::DoNotOptimize(rules);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * table.size());
+    countAllocs(state, before, state.iterations() * table.size());
+}
+
+// the parser alone, into a mask on the stack
+void BM_ParseCronExpr(benchmark::State& state) {
+    std::vector<std::string> table;
+    std::size_t bytes = 0;
+    for (int i = 0; i < 1024; ++i) {
+        table.emplace_back(pattern(i));
+        bytes += table.back().size();
+    }
+    for (auto _ : state) {
+        for (const auto& it : table) {
+            CronMask mask;
+            benchmark::DoNotOptimize(ParseCronExpr(Slice(it), &mask));
+            benchmark::DoNotOptimize(mask);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * table.size());
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+BENCHMARK(BM_LegacyCanExecute)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MaskCanExecute)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MaskCanExecuteSnapshot)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_NextFireTimeBruteForce)->DenseRange(0, 4)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_NextFireTime)->DenseRange(0, 4);
+BENCHMARK(BM_PrevFireTime)->DenseRange(0, 4);
+BENCHMARK(BM_ParseTableRE2);
+BENCHMARK(BM_ParseTable);
+BENCHMARK(BM_ParseRules);
+BENCHMARK(BM_ParseCronExpr);
+
+}  // end of anonymous namespace
+}  // end of namespace cg
@@ -1,6 +1,8 @@
 #include "include/crontab.h"
 
 #include <iostream>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "include/assert.h"
@@ -59,6 +61,8 @@ TEST_F(CronTabTest, ParsePolicy) {
 }
 
 TEST_F(CronTabTest, ParseData) {
+    EXPECT_TRUE(ParseData(ParsePolicy("x"), "x").empty());
+    EXPECT_TRUE(ParseData(POLICY_NUM, "1,2").empty());
     ParseData(POLICY_DIVISION, "*");
     ParseData(POLICY_DIVISION, "*/2");
     ParseData(POLICY_SOMEONE, "1,2");
@@ -119,4 +123,286 @@ TEST_F(CronTabTest, Basic) {
     }
 }
 
+TEST_F(CronTabTest, CompileRule) {
+    // empty and */1 rules take every value of the field
+    EXPECT_EQ(0x0fffffffffffffffULL, CronTab::CompileRule(RULE_TYPE_MINUTE, Rule{}));
+    EXPECT_EQ(0x1ffeULL, CronTab::CompileRule(RULE_TYPE_MON,
+                CronTab::GenRule(RULE_TYPE_MON, POLICY_DIVISION, {1})));
+    EXPECT_EQ(0x7fULL, CronTab::CompileRule(RULE_TYPE_WEEK,
+                CronTab::GenRule(RULE_TYPE_WEEK, POLICY_DIVISION, {})));
+    // steps count from the lowest value of the field
+    EXPECT_EQ(0x555ULL, CronTab::CompileRule(RULE_TYPE_HOUR,
+                CronTab::GenRule(RULE_TYPE_HOUR, POLICY_DIVISION, {2})) & 0xfff);
+    EXPECT_EQ(0xaaaULL, CronTab::CompileRule(RULE_TYPE_DAY,
+                CronTab::GenRule(RULE_TYPE_DAY, POLICY_DIVISION, {2})) & 0xfff);
+    // 7 is sunday too, out of range values are dropped
+    EXPECT_EQ(0x3ULL, CronTab::CompileRule(RULE_TYPE_WEEK,
+                CronTab::GenRule(RULE_TYPE_WEEK, POLICY_SOMEONE, {1, 7, 8})));
+    EXPECT_EQ(0x1002ULL, CronTab::CompileRule(RULE_TYPE_MON,
+                CronTab::GenRule(RULE_TYPE_MON, POLICY_SOMEONE, {0, 1, 12, 13})));
+}
+
+TEST_F(CronTabTest, FieldOrder) {
+    std::unique_ptr<CronTab> crontab(GenCronTab("5 6 7 8 1"));
+    EXPECT_EQ(1ULL << 5, crontab->Mask().minute);
+    EXPECT_EQ(1ULL << 6, crontab->Mask().hour);
+    EXPECT_EQ(1U << 7, crontab->Mask().day);
+    EXPECT_EQ(1U << 8, crontab->Mask().month);
+    EXPECT_EQ(1U << 1, crontab->Mask().week);
+}
+
+TEST_F(CronTabTest, Match) {
+    std::unique_ptr<CronTab> crontab(GenCronTab("*/15 9-17 * 1,7 1-5"));
+    CronTime now;
+    now.minute = 30;
+    now.hour = 9;
+    now.day = 20;
+    now.month = 7;
+    now.week = 3;
+    EXPECT_EQ(true, crontab->CanExecute(now));
+    now.minute = 31;
+    EXPECT_EQ(false, crontab->CanExecute(now));
+    now.minute = 0;
+    now.hour = 18;
+    EXPECT_EQ(false, crontab->CanExecute(now));
+    now.hour = 17;
+    now.month = 12;
+    EXPECT_EQ(false, crontab->CanExecute(now));
+    now.month = 1;
+    now.week = 0;
+    EXPECT_EQ(false, crontab->CanExecute(now));
+    now.week = 5;
+    EXPECT_EQ(true, crontab->CanExecute(now));
+
+    // 2021-03-27 10:20 is a saturday in march
+    struct tm stm = {};
+    stm.tm_year = 121;
+    stm.tm_mon = 2;
+    stm.tm_mday = 27;
+    stm.tm_hour = 10;
+    stm.tm_min = 20;
+    stm.tm_isdst = -1;
+    now = CronTime::FromTimestamp(mktime(&stm));
+    EXPECT_EQ(20, now.minute);
+    EXPECT_EQ(10, now.hour);
+    EXPECT_EQ(27, now.day);
+    EXPECT_EQ(3, now.month);
+    EXPECT_EQ(6, now.week);
+    crontab.reset(GenCronTab("20 10 27 3 6"));
+    EXPECT_EQ(true, crontab->CanExecute(now));
+    crontab.reset(GenCronTab("20 10 27 2 6"));
+    EXPECT_EQ(false, crontab->CanExecute(now));
+}
+
+namespace {
+
+time_t localTime(int year, int month, int day, int hour, int minute) {
+    struct tm stm = {};
+    stm.tm_year = year - 1900;
+    stm.tm_mon = month - 1;
+    stm.tm_mday = day;
+    stm.tm_hour = hour;
+    stm.tm_min = minute;
+    stm.tm_isdst = -1;
+    return mktime(&stm);
+}
+
+}  // end of anonymous namespace
+
+TEST_F(CronTabTest, NextFireTime) {
+    const time_t now = localTime(2021, 3, 27, 10, 20);
+    std::unique_ptr<CronTab> crontab(GenCronTab("* * * * *"));
+    EXPECT_EQ(localTime(2021, 3, 27, 10, 21), crontab->NextFireTime(now));
+    EXPECT_EQ(localTime(2021, 3, 27, 10, 21), crontab->NextFireTime(now + 59));
+    EXPECT_EQ(localTime(2021, 3, 27, 10, 19), crontab->PrevFireTime(now));
+    EXPECT_EQ(now, crontab->PrevFireTime(now + 1));
+
+    crontab.reset(GenCronTab("0 0 1 1 *"));
+    EXPECT_EQ(localTime(2022, 1, 1, 0, 0), crontab->NextFireTime(now));
+    EXPECT_EQ(localTime(2021, 1, 1, 0, 0), crontab->PrevFireTime(now));
+    EXPECT_EQ(localTime(2020, 1, 1, 0, 0), crontab->PrevFireTime(localTime(2021, 1, 1, 0, 0)));
+
+    // carry over every field
+    crontab.reset(GenCronTab("30 8 29 2 *"));
+    EXPECT_EQ(localTime(2024, 2, 29, 8, 30), crontab->NextFireTime(now));
+    EXPECT_EQ(localTime(2020, 2, 29, 8, 30), crontab->PrevFireTime(now));
+
+    // day and weekday must both match: friday the 13th
+    crontab.reset(GenCronTab("0 0 13 * 5"));
+    EXPECT_EQ(localTime(2021, 8, 13, 0, 0), crontab->NextFireTime(now));
+    EXPECT_EQ(localTime(2020, 11, 13, 0, 0), crontab->PrevFireTime(now));
+
+    // never fires
+    crontab.reset(GenCronTab("0 0 30 2 *"));
+    EXPECT_EQ(-1, crontab->NextFireTime(now));
+    EXPECT_EQ(-1, crontab->PrevFireTime(now));
+}
+
+TEST_F(CronTabTest, FireTimeBruteForce) {
+    const char* patterns[] = {
+        "*/7 3-5 * * 1,3",
+        "15 */6 1-10 * *",
+        "59 23 31 * *",
+        "0,30 12 * 1,3 0",
+    };
+    const time_t starts[] = {
+        localTime(2021, 1, 30, 23, 59),
+        localTime(2021, 2, 28, 12, 0),
+        localTime(2024, 2, 28, 23, 45),
+    };
+    for (const auto& pattern : patterns) {
+        std::unique_ptr<CronTab> crontab(GenCronTab(pattern));
+        for (auto start : starts) {
+            time_t expect = -1;
+            for (time_t t = start - start % 60 + 60; t < start + 90 * 86400; t += 60) {
+                if (crontab->CanExecute(CronTime::FromTimestamp(t))) {
+                    expect = t;
+                    break;
+                }
+            }
+            EXPECT_EQ(expect, crontab->NextFireTime(start)) << pattern << " after " << start;
+            expect = -1;
+            for (time_t t = start - start % 60 - (start % 60 == 0 ? 60 : 0);
+                    t > start - 90 * 86400; t -= 60) {
+                if (crontab->CanExecute(CronTime::FromTimestamp(t))) {
+                    expect = t;
+                    break;
+                }
+            }
+            EXPECT_EQ(expect, crontab->PrevFireTime(start)) << pattern << " before " << start;
+        }
+    }
+}
+
+namespace {
+
+CronMask parse(const char* expr) {
+    CronMask mask;
+    CronParseError error;
+    bool ok = ParseCronExpr(Slice(expr), &mask, &error);
+    EXPECT_EQ(true, ok) << expr << ": " << error.Message() << " at " << error.offset;
+    return mask;
+}
+
+CronParseError parseError(const char* expr) {
+    CronMask mask;
+    CronParseError error;
+    EXPECT_EQ(false, ParseCronExpr(Slice(expr), &mask, &error)) << expr;
+    return error;
+}
+
+}  // end of anonymous namespace
+
+TEST_F(CronTabTest, ParseCronExpr) {
+    CronMask mask = parse("* * * * *");
+    EXPECT_EQ(0x0fffffffffffffffULL, mask.minute);
+    EXPECT_EQ(0xffffffULL, mask.hour);
+    EXPECT_EQ(0xfffffffeU, mask.day);
+    EXPECT_EQ(0x1ffeU, mask.month);
+    EXPECT_EQ(0x7fU, mask.week);
+
+    mask = parse("  1,5-7,10-20/5,*/30 */6 1/10 2-3 1-5  ");
+    EXPECT_EQ((1ULL << 1) | (7ULL << 5) | (1ULL << 10) | (1ULL << 15) | (1ULL << 20)
+            | 1 | (1ULL << 30), mask.minute);
+    EXPECT_EQ((1ULL << 0) | (1ULL << 6) | (1ULL << 12) | (1ULL << 18), mask.hour);
+    EXPECT_EQ((1U << 1) | (1U << 11) | (1U << 21) | (1U << 31), mask.day);
+    EXPECT_EQ((1U << 2) | (1U << 3), mask.month);
+    EXPECT_EQ(0x3eU, mask.week);
+
+    // names in any case, 7 is sunday
+    mask = parse("0 0 * jan,Jul-SEP sat-7");
+    EXPECT_EQ((1U << 1) | (7U << 7), mask.month);
+    EXPECT_EQ((1U << 6) | 1U, mask.week);
+    EXPECT_EQ(0x3U, parse("0 0 * * 7,1").week);
+    EXPECT_EQ(0x55U, parse("0 0 * * */2").week);
+
+    // the same masks as the Rule model
+    const char* patterns[] = {"*/5 * * * *", "0-10,20-30 1,2 * * 1-5", "*/2 */3 */2 */4 *"};
+    for (auto pattern : patterns) {
+        std::unique_ptr<CronTab> crontab(new CronTab);
+        std::vector<std::string> v;
+        StringSplit(" ", pattern, &v);
+        static const RuleType kFields[RULE_TYPE_NUM] = {
+            RULE_TYPE_MINUTE, RULE_TYPE_HOUR, RULE_TYPE_DAY, RULE_TYPE_MON, RULE_TYPE_WEEK,
+        };
+        std::vector<Rule> rules(RULE_TYPE_NUM);
+        for (int i = 0; i < RULE_TYPE_NUM; ++i) {
+            auto policy = ParsePolicy(v[i]);
+            rules[i] = CronTab::GenRule(kFields[i], policy, ParseData(policy, v[i]));
+        }
+        crontab->Init(rules);
+        mask = parse(pattern);
+        EXPECT_EQ(crontab->Mask().minute, mask.minute) << pattern;
+        EXPECT_EQ(crontab->Mask().hour, mask.hour) << pattern;
+        EXPECT_EQ(crontab->Mask().day, mask.day) << pattern;
+        EXPECT_EQ(crontab->Mask().month, mask.month) << pattern;
+        EXPECT_EQ(crontab->Mask().week, mask.week) << pattern;
+    }
+}
+
+TEST_F(CronTabTest, ParseCronExprMacro) {
+    const char* macros[][2] = {
+        {"@yearly", "0 0 1 1 *"},
+        {"@annually", "0 0 1 1 *"},
+        {"@monthly", "0 0 1 * *"},
+        {" @WEEKLY ", "0 0 * * 0"},
+        {"@daily", "0 0 * * *"},
+        {"@midnight", "0 0 * * *"},
+        {"@hourly", "0 * * * *"},
+    };
+    for (const auto& it : macros) {
+        CronMask a = parse(it[0]);
+        CronMask b = parse(it[1]);
+        EXPECT_EQ(b.minute, a.minute) << it[0];
+        EXPECT_EQ(b.hour, a.hour) << it[0];
+        EXPECT_EQ(b.day, a.day) << it[0];
+        EXPECT_EQ(b.month, a.month) << it[0];
+        EXPECT_EQ(b.week, a.week) << it[0];
+    }
+}
+
+TEST_F(CronTabTest, ParseCronExprError) {
+    struct {
+        const char* expr;
+        CronParseCode code;
+        RuleType field;
+        std::size_t offset;
+    } cases[] = {
+        {"", CRON_PARSE_EMPTY, RULE_TYPE_NUM, 0},
+        {"   ", CRON_PARSE_EMPTY, RULE_TYPE_NUM, 3},
+        {"* * * *", CRON_PARSE_FIELD_COUNT, RULE_TYPE_NUM, 7},
+        {"* * * * * *", CRON_PARSE_FIELD_COUNT, RULE_TYPE_NUM, 10},
+        {"* * * * 1;", CRON_PARSE_UNEXPECTED_CHAR, RULE_TYPE_WEEK, 9},
+        {"*-1 * * * *", CRON_PARSE_UNEXPECTED_CHAR, RULE_TYPE_MINUTE, 1},
+        {"1,,2 * * * *", CRON_PARSE_BAD_NUMBER, RULE_TYPE_MINUTE, 2},
+        {"1, * * * *", CRON_PARSE_BAD_NUMBER, RULE_TYPE_MINUTE, 2},
+        {"* 0001 * * *", CRON_PARSE_BAD_NUMBER, RULE_TYPE_HOUR, 2},
+        {"60 * * * *", CRON_PARSE_OUT_OF_RANGE, RULE_TYPE_MINUTE, 0},
+        {"* 1-24 * * *", CRON_PARSE_OUT_OF_RANGE, RULE_TYPE_HOUR, 4},
+        {"* * 0 * *", CRON_PARSE_OUT_OF_RANGE, RULE_TYPE_DAY, 4},
+        {"* * * 13 *", CRON_PARSE_OUT_OF_RANGE, RULE_TYPE_MON, 6},
+        {"* * * * 8", CRON_PARSE_OUT_OF_RANGE, RULE_TYPE_WEEK, 8},
+        {"* 5-3 * * *", CRON_PARSE_BAD_RANGE, RULE_TYPE_HOUR, 2},
+        {"*/0 * * * *", CRON_PARSE_BAD_STEP, RULE_TYPE_MINUTE, 2},
+        {"*/ * * * *", CRON_PARSE_BAD_STEP, RULE_TYPE_MINUTE, 2},
+        {"* * * foo *", CRON_PARSE_UNKNOWN_NAME, RULE_TYPE_MON, 6},
+        {"* * * mon *", CRON_PARSE_UNKNOWN_NAME, RULE_TYPE_MON, 6},
+        {"jan * * * *", CRON_PARSE_UNKNOWN_NAME, RULE_TYPE_MINUTE, 0},
+        {"@reboot", CRON_PARSE_UNKNOWN_MACRO, RULE_TYPE_NUM, 0},
+        {"@daily *", CRON_PARSE_FIELD_COUNT, RULE_TYPE_NUM, 7},
+    };
+    for (const auto& it : cases) {
+        CronParseError error = parseError(it.expr);
+        EXPECT_EQ(it.code, error.code) << it.expr << ": " << error.Message();
+        EXPECT_EQ(it.field, error.field) << it.expr;
+        EXPECT_EQ(it.offset, error.offset) << it.expr;
+    }
+    EXPECT_EQ(std::string("value out of range"), parseError("60 * * * *").Message());
+
+    CronParseError error;
+    EXPECT_EQ(nullptr, GenCronTab(Slice("* * *"), &error));
+    EXPECT_EQ(CRON_PARSE_FIELD_COUNT, error.code);
+    EXPECT_EQ(nullptr, GenCronTab("* * * * * *"));
+}
+
 }  // end of namespace cg
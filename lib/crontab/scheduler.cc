@@ -0,0 +1,237 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "crontab/scheduler.h"
+
+#include <time.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace cg {
+
+int64_t SystemClock::NowMs() const {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+Scheduler::Scheduler(Clock* clock, int workers)
+    : clock_(clock),
+      own_clock_(clock == nullptr ? new SystemClock : nullptr),
+      wheel_(static_cast<uint64_t>((clock == nullptr ? own_clock_.get() : clock)->NowMs())),
+      next_id_(1),
+      stop_(true),
+      fired_(0),
+      cancelled_(0),
+      latency_sum_(0),
+      latency_square_sum_(0),
+      latency_max_(0) {
+    if (clock_ == nullptr) {
+        clock_ = own_clock_.get();
+    }
+    for (int i = 0; i < workers; ++i) {
+        workers_.emplace_back(&Scheduler::workerLoop, this);
+    }
+}
+
+Scheduler::~Scheduler() {
+    Stop();
+    {
+        std::lock_guard<std::mutex> guard(queue_mu_);
+        // one exit marker per worker, after the queued callbacks
+        for (std::size_t i = 0; i < workers_.size(); ++i) {
+            queue_.push_back(Task{nullptr, 0});
+        }
+    }
+    queue_cv_.notify_all();
+    for (auto& it : workers_) {
+        it.join();
+    }
+}
+
+int64_t Scheduler::nextFireMs(const CronTab& crontab, int64_t after_ms) {
+    // fire times are whole minutes, anything within the second is after it
+    time_t t = crontab.NextFireTime(static_cast<time_t>(after_ms / 1000));
+    return t < 0 ? -1 : static_cast<int64_t>(t) * 1000;
+}
+
+Scheduler::JobId Scheduler::Schedule(const std::string& pattern, Callback callback) {
+    std::unique_ptr<CronTab> crontab(GenCronTab(pattern));
+    if (crontab == nullptr) {
+        return 0;
+    }
+    return Schedule(std::move(crontab), std::move(callback));
+}
+
+Scheduler::JobId Scheduler::Schedule(std::unique_ptr<CronTab> crontab, Callback callback) {
+    if (crontab == nullptr) {
+        return 0;
+    }
+    const int64_t next = nextFireMs(*crontab, clock_->NowMs());
+    if (next < 0) {
+        return 0;
+    }
+    std::unique_ptr<Job> job(new Job);
+    job->expires = static_cast<uint64_t>(next);
+    job->crontab = std::move(crontab);
+    job->callback = std::make_shared<Callback>(std::move(callback));
+
+    JobId id;
+    {
+        std::lock_guard<std::mutex> guard(mu_);
+        id = next_id_++;
+        job->id = id;
+        wheel_.Add(job.get());
+        jobs_.emplace(id, std::move(job));
+    }
+    // the tick thread may sleep past the new job
+    wakeup_.Set();
+    return id;
+}
+
+bool Scheduler::Cancel(JobId id) {
+    {
+        std::lock_guard<std::mutex> guard(mu_);
+        auto it = jobs_.find(id);
+        if (it == jobs_.end()) {
+            return false;
+        }
+        wheel_.Remove(it->second.get());
+        jobs_.erase(it);
+    }
+    std::lock_guard<std::mutex> guard(stats_mu_);
+    ++cancelled_;
+    return true;
+}
+
+int64_t Scheduler::NextFireTimeMs(JobId id) const {
+    std::lock_guard<std::mutex> guard(mu_);
+    auto it = jobs_.find(id);
+    return it == jobs_.end() ? -1 : static_cast<int64_t>(it->second->expires);
+}
+
+std::size_t Scheduler::Tick() {
+    std::lock_guard<std::mutex> tick_guard(tick_mu_);
+    const int64_t now = clock_->NowMs();
+    due_.clear();
+    {
+        std::lock_guard<std::mutex> guard(mu_);
+        wheel_.Advance(static_cast<uint64_t>(now));
+        while (TimerNode* node = wheel_.PopExpired()) {
+            Job* job = static_cast<Job*>(node);
+            due_.push_back(Task{job->callback, static_cast<int64_t>(job->expires)});
+            const int64_t next = nextFireMs(*job->crontab,
+                    std::max(static_cast<int64_t>(job->expires), now));
+            if (next < 0) {
+                jobs_.erase(job->id);
+                continue;
+            }
+            job->expires = static_cast<uint64_t>(next);
+            wheel_.Add(job);
+        }
+    }
+    if (workers_.empty()) {
+        for (const auto& it : due_) {
+            run(it);
+        }
+        return due_.size();
+    }
+    {
+        std::lock_guard<std::mutex> guard(queue_mu_);
+        queue_.insert(queue_.end(), due_.begin(), due_.end());
+    }
+    if (due_.size() == 1) {
+        queue_cv_.notify_one();
+    } else if (!due_.empty()) {
+        queue_cv_.notify_all();
+    }
+    return due_.size();
+}
+
+void Scheduler::run(const Task& task) {
+    const int64_t latency = clock_->NowMs() - task.due_ms;
+    {
+        std::lock_guard<std::mutex> guard(stats_mu_);
+        ++fired_;
+        latency_sum_ += latency;
+        latency_square_sum_ += static_cast<double>(latency) * latency;
+        latency_max_ = std::max(latency_max_, latency);
+    }
+    (*task.callback)();
+}
+
+void Scheduler::workerLoop() {
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(queue_mu_);
+            queue_cv_.wait(lock, [this] { return !queue_.empty(); });
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        if (task.callback == nullptr) {
+            return;
+        }
+        run(task);
+    }
+}
+
+void Scheduler::tickLoop() {
+    for (;;) {
+        Tick();
+        uint64_t timeout;
+        {
+            std::lock_guard<std::mutex> guard(mu_);
+            timeout = wheel_.NextTimeout();
+        }
+        // wake up at least once a minute to follow changes of the wall clock;
+        // the sleep itself is on the monotonic clock
+        timeout = std::min<uint64_t>(timeout, 60 * 1000);
+        wakeup_.WaitFor(static_cast<int64_t>(timeout) * 1000000);
+        if (stop_.load(std::memory_order_acquire)) {
+            return;
+        }
+    }
+}
+
+void Scheduler::Start() {
+    std::lock_guard<std::mutex> guard(stop_mu_);
+    if (!stop_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    stop_.store(false, std::memory_order_release);
+    ticker_ = std::thread(&Scheduler::tickLoop, this);
+}
+
+void Scheduler::Stop() {
+    std::lock_guard<std::mutex> guard(stop_mu_);
+    if (stop_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    stop_.store(true, std::memory_order_release);
+    wakeup_.Set();
+    ticker_.join();
+}
+
+SchedulerStats Scheduler::GetStats() const {
+    SchedulerStats stats;
+    {
+        std::lock_guard<std::mutex> guard(mu_);
+        stats.jobs = jobs_.size();
+    }
+    std::lock_guard<std::mutex> guard(stats_mu_);
+    stats.fired = fired_;
+    stats.cancelled = cancelled_;
+    stats.latency_mean_ms = fired_ == 0 ? 0 : latency_sum_ / fired_;
+    const double variance = fired_ == 0 ? 0
+        : latency_square_sum_ / fired_ - stats.latency_mean_ms * stats.latency_mean_ms;
+    stats.jitter_ms = variance > 0 ? std::sqrt(variance) : 0;
+    stats.latency_max_ms = latency_max_;
+    return stats;
+}
+
+}  // end of namespace cg
@@ -0,0 +1,166 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "concurrent/conditionvar.h"
+#include "crontab/timing_wheel.h"
+#include "include/crontab.h"
+
+namespace cg {
+
+// Wall clock in milliseconds seen by the Scheduler.
+class Clock {
+public:
+    virtual ~Clock() {}
+
+    virtual int64_t NowMs() const = 0;
+};
+
+class SystemClock : public Clock {
+public:
+    int64_t NowMs() const override;
+};
+
+// Clock moved by hand, lets tests and benchmarks run faster than real time.
+class SimulatedClock : public Clock {
+public:
+    explicit SimulatedClock(int64_t now_ms) : now_ms_(now_ms) {}
+
+    int64_t NowMs() const override {
+        return now_ms_.load(std::memory_order_acquire);
+    }
+
+    void SetMs(int64_t now_ms) {
+        now_ms_.store(now_ms, std::memory_order_release);
+    }
+
+    void AdvanceMs(int64_t ms) {
+        now_ms_.fetch_add(ms, std::memory_order_acq_rel);
+    }
+
+private:
+    std::atomic<int64_t> now_ms_;
+};
+
+struct SchedulerStats {
+    uint64_t jobs;       // jobs scheduled and not cancelled or finished
+    uint64_t fired;      // callbacks started
+    uint64_t cancelled;
+    // delay from the fire time to the start of the callback
+    double latency_mean_ms;
+    int64_t latency_max_ms;
+    double jitter_ms;    // standard deviation of the delay
+};
+
+// Runs callbacks at the times of their crontab patterns.
+//
+// Jobs wait in a TimingWheel of millisecond ticks: Schedule and Cancel are a
+// hash lookup plus a list insert/unlink, and Tick only visits the slots the
+// clock moved over. A due job is put back at its next fire time before its
+// callback is handed to the workers, a time missed while the clock jumped is
+// not replayed. With no worker, callbacks run in Tick on the calling thread.
+//
+// Either call Tick whenever the clock moved (simulated clocks), or Start a
+// thread sleeping until the wheel's next timeout.
+class Scheduler {
+public:
+    typedef std::function<void()> Callback;
+    typedef uint64_t JobId;
+
+    // clock is not owned, nullptr for the system clock.
+    explicit Scheduler(Clock* clock = nullptr, int workers = 1);
+
+    ~Scheduler();
+
+    Scheduler(const Scheduler&) = delete;
+
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    // 0 when the pattern is invalid or never fires.
+    JobId Schedule(const std::string& pattern, Callback callback);
+
+    // 0 when crontab is null or never fires.
+    JobId Schedule(std::unique_ptr<CronTab> crontab, Callback callback);
+
+    // A callback already handed to the workers still runs.
+    bool Cancel(JobId id);
+
+    // Next fire time of a job in milliseconds, -1 if there is no such job.
+    int64_t NextFireTimeMs(JobId id) const;
+
+    // Fire every job due at the current time, returns how many.
+    std::size_t Tick();
+
+    void Start();
+
+    // Stops the tick thread, the destructor also waits for the queued callbacks.
+    void Stop();
+
+    SchedulerStats GetStats() const;
+
+private:
+    struct Job : TimerNode {
+        JobId id;
+        std::unique_ptr<CronTab> crontab;
+        std::shared_ptr<Callback> callback;
+    };
+
+    struct Task {
+        std::shared_ptr<Callback> callback;
+        int64_t due_ms;
+    };
+
+    // ms of the first fire time after after_ms, -1 if none
+    static int64_t nextFireMs(const CronTab& crontab, int64_t after_ms);
+
+    void run(const Task& task);
+
+    void workerLoop();
+
+    void tickLoop();
+
+private:
+    Clock* clock_;
+    std::unique_ptr<Clock> own_clock_;
+
+    mutable std::mutex mu_;
+    TimingWheel wheel_;
+    std::unordered_map<JobId, std::unique_ptr<Job>> jobs_;
+    JobId next_id_;
+    std::vector<Task> due_;  // reused by Tick, guarded by tick_mu_
+    std::mutex tick_mu_;
+
+    std::mutex queue_mu_;
+    std::condition_variable queue_cv_;
+    std::deque<Task> queue_;
+    std::vector<std::thread> workers_;
+
+    std::mutex stop_mu_;  // serializes Start and Stop
+    std::atomic<bool> stop_;
+    Event wakeup_;  // set by Schedule and Stop, ends the sleep of the tick thread
+    std::thread ticker_;
+
+    mutable std::mutex stats_mu_;
+    uint64_t fired_;
+    uint64_t cancelled_;
+    double latency_sum_;
+    double latency_square_sum_;
+    int64_t latency_max_;
+};
+
+}  // end of namespace cg
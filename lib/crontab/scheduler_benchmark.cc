@@ -0,0 +1,111 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "crontab/scheduler.h"
+
+namespace cg {
+namespace {
+
+const int kJobs = 100000;
+const int64_t kStartMs = 1616840430000LL;  // 2021-03-27 10:20:30 UTC
+
+// spread over the hour like real job tables: every few minutes or at fixed minutes
+std::string pattern(int i) {
+    switch (i % 4) {
+        case 0:
+            return "*/" + std::to_string(i % 15 + 1) + " * * * *";
+        case 1:
+            return std::to_string(i % 60) + " * * * *";
+        case 2:
+            return std::to_string(i % 60) + "," + std::to_string((i + 30) % 60) + " * * * *";
+        default:
+            return std::to_string(i % 60) + " */2 * * *";
+    }
+}
+
+void BM_ScheduleCancel(benchmark::State& state) {
+    SimulatedClock clock(kStartMs);
+    Scheduler scheduler(&clock, 0);
+    for (int i = 0; i < kJobs; ++i) {
+        scheduler.Schedule(pattern(i), [] {});
+    }
+    std::unique_ptr<CronTab> crontab(GenCronTab("*/7 * * * *"));
+    for (auto _ : state) {
+        auto id = scheduler.Schedule(std::unique_ptr<CronTab>(new CronTab(*crontab)), [] {});
+        scheduler.Cancel(id);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// one simulated hour ticked every second, callbacks run inline
+void BM_SimulatedHour(benchmark::State& state) {
+    uint64_t fired = 0;
+    SchedulerStats stats = SchedulerStats();
+    for (auto _ : state) {
+        state.PauseTiming();
+        SimulatedClock clock(kStartMs);
+        std::unique_ptr<Scheduler> scheduler(new Scheduler(&clock, 0));
+        for (int i = 0; i < kJobs; ++i) {
+            scheduler->Schedule(pattern(i), [] {});
+        }
+        state.ResumeTiming();
+        for (int s = 0; s < 3600; ++s) {
+            clock.AdvanceMs(1000);
+            fired += scheduler->Tick();
+        }
+        state.PauseTiming();
+        stats = scheduler->GetStats();
+        scheduler.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(fired);
+    state.counters["latency_mean_ms"] = stats.latency_mean_ms;
+    state.counters["latency_max_ms"] = stats.latency_max_ms;
+    state.counters["jitter_ms"] = stats.jitter_ms;
+}
+
+// the same hour driven by a binary heap of fire times
+void BM_HeapSimulatedHour(benchmark::State& state) {
+    typedef std::pair<int64_t, int> Entry;
+    uint64_t fired = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<std::unique_ptr<CronTab>> tabs;
+        std::vector<std::function<void()>> callbacks;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+        for (int i = 0; i < kJobs; ++i) {
+            tabs.emplace_back(GenCronTab(pattern(i)));
+            callbacks.emplace_back([] {});
+            heap.emplace(tabs.back()->NextFireTime(kStartMs / 1000) * 1000LL, i);
+        }
+        state.ResumeTiming();
+        int64_t now = kStartMs;
+        for (int s = 0; s < 3600; ++s) {
+            now += 1000;
+            while (!heap.empty() && heap.top().first <= now) {
+                Entry top = heap.top();
+                heap.pop();
+                callbacks[top.second]();
+                ++fired;
+                heap.emplace(tabs[top.second]->NextFireTime(now / 1000) * 1000LL, top.second);
+            }
+        }
+    }
+    state.SetItemsProcessed(fired);
+}
+
+BENCHMARK(BM_ScheduleCancel);
+BENCHMARK(BM_SimulatedHour)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HeapSimulatedHour)->Unit(benchmark::kMillisecond);
+
+}  // end of anonymous namespace
+}  // end of namespace cg
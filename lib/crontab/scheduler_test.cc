@@ -0,0 +1,121 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "crontab/scheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class SchedulerTest : public ::testing::Test {
+protected:
+    SchedulerTest() : clock_(localMs(2021, 3, 27, 10, 20, 30)) {}
+
+    static int64_t localMs(int year, int month, int day, int hour, int minute, int second) {
+        struct tm stm = {};
+        stm.tm_year = year - 1900;
+        stm.tm_mon = month - 1;
+        stm.tm_mday = day;
+        stm.tm_hour = hour;
+        stm.tm_min = minute;
+        stm.tm_sec = second;
+        stm.tm_isdst = -1;
+        return static_cast<int64_t>(mktime(&stm)) * 1000;
+    }
+
+    SimulatedClock clock_;
+};
+
+TEST_F(SchedulerTest, Basic) {
+    Scheduler scheduler(&clock_, 0);
+    int every = 0;
+    int hourly = 0;
+    auto a = scheduler.Schedule("* * * * *", [&every] { ++every; });
+    auto b = scheduler.Schedule("0 * * * *", [&hourly] { ++hourly; });
+    EXPECT_NE(0U, a);
+    EXPECT_NE(0U, b);
+    EXPECT_EQ(localMs(2021, 3, 27, 10, 21, 0), scheduler.NextFireTimeMs(a));
+    EXPECT_EQ(localMs(2021, 3, 27, 11, 0, 0), scheduler.NextFireTimeMs(b));
+
+    EXPECT_EQ(0U, scheduler.Tick());
+    for (int i = 0; i < 120 * 60; ++i) {
+        clock_.AdvanceMs(1000);
+        scheduler.Tick();
+    }
+    EXPECT_EQ(120, every);
+    EXPECT_EQ(2, hourly);
+    EXPECT_EQ(localMs(2021, 3, 27, 12, 21, 0), scheduler.NextFireTimeMs(a));
+
+    EXPECT_EQ(true, scheduler.Cancel(a));
+    EXPECT_EQ(false, scheduler.Cancel(a));
+    EXPECT_EQ(-1, scheduler.NextFireTimeMs(a));
+    clock_.AdvanceMs(3600 * 1000);
+    EXPECT_EQ(1U, scheduler.Tick());
+    EXPECT_EQ(120, every);
+    EXPECT_EQ(3, hourly);
+
+    SchedulerStats stats = scheduler.GetStats();
+    EXPECT_EQ(1U, stats.jobs);
+    EXPECT_EQ(123U, stats.fired);
+    EXPECT_EQ(1U, stats.cancelled);
+    EXPECT_LE(stats.latency_max_ms, 3600 * 1000);
+}
+
+TEST_F(SchedulerTest, Invalid) {
+    Scheduler scheduler(&clock_, 0);
+    EXPECT_EQ(0U, scheduler.Schedule("* * *", [] {}));
+    EXPECT_EQ(0U, scheduler.Schedule("0 0 30 2 *", [] {}));
+    EXPECT_EQ(0U, scheduler.Schedule(std::unique_ptr<CronTab>(), [] {}));
+    EXPECT_EQ(0U, scheduler.GetStats().jobs);
+}
+
+// a clock jump fires a job once, missed times are not replayed
+TEST_F(SchedulerTest, ClockJump) {
+    Scheduler scheduler(&clock_, 0);
+    int n = 0;
+    auto id = scheduler.Schedule("*/5 * * * *", [&n] { ++n; });
+    clock_.AdvanceMs(86400 * 1000);
+    EXPECT_EQ(1U, scheduler.Tick());
+    EXPECT_EQ(0U, scheduler.Tick());
+    EXPECT_EQ(1, n);
+    EXPECT_EQ(localMs(2021, 3, 28, 10, 25, 0), scheduler.NextFireTimeMs(id));
+    SchedulerStats stats = scheduler.GetStats();
+    EXPECT_EQ(86400 * 1000 - 270 * 1000, stats.latency_max_ms);
+}
+
+TEST_F(SchedulerTest, Workers) {
+    std::atomic<int> n(0);
+    {
+        Scheduler scheduler(&clock_, 4);
+        for (int i = 0; i < 1000; ++i) {
+            scheduler.Schedule("* * * * *", [&n] { n.fetch_add(1); });
+        }
+        for (int i = 0; i < 10; ++i) {
+            clock_.AdvanceMs(60 * 1000);
+            scheduler.Tick();
+        }
+        // the destructor waits for the queued callbacks
+    }
+    EXPECT_EQ(10000, n.load());
+}
+
+TEST_F(SchedulerTest, TickThread) {
+    SystemClock clock;
+    Scheduler scheduler(&clock, 1);
+    scheduler.Start();
+    scheduler.Schedule("* * * * *", [] {});
+    EXPECT_EQ(1U, scheduler.GetStats().jobs);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    scheduler.Stop();
+    scheduler.Stop();
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
@@ -0,0 +1,184 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "crontab/timing_wheel.h"
+
+#include "algorithm/bit.h"
+
+namespace cg {
+namespace {
+
+const uint64_t kSlotMask = TimingWheel::kSlots - 1;
+
+uint64_t rotl(uint64_t v, int c) {
+    c &= 63;
+    return c == 0 ? v : (v << c) | (v >> (64 - c));
+}
+
+uint64_t rotr(uint64_t v, int c) {
+    c &= 63;
+    return c == 0 ? v : (v >> c) | (v << (64 - c));
+}
+
+}  // end of anonymous namespace
+
+const int TimingWheel::kSlotBits;
+const int TimingWheel::kSlots;
+const int TimingWheel::kLevels;
+const uint64_t TimingWheel::kMaxTimeout;
+const int TimingWheel::kExpiredSlot;
+
+TimingWheel::TimingWheel(uint64_t now) : now_(now), size_(0) {
+    for (auto& it : pending_) {
+        it = 0;
+    }
+    for (auto& it : slots_) {
+        it.prev = &it;
+        it.next = &it;
+    }
+}
+
+void TimingWheel::link(TimerNode* node, int slot) {
+    TimerNode* head = &slots_[slot];
+    node->prev = head->prev;
+    node->next = head;
+    head->prev->next = node;
+    head->prev = node;
+    node->slot = slot;
+}
+
+void TimingWheel::moveAll(TimerNode* from, TimerNode* to) {
+    if (from->next == from) {
+        return;
+    }
+    from->next->prev = to->prev;
+    to->prev->next = from->next;
+    from->prev->next = to;
+    to->prev = from->prev;
+    from->prev = from;
+    from->next = from;
+}
+
+void TimingWheel::Add(TimerNode* node) {
+    ++size_;
+    if (node->expires <= now_) {
+        link(node, kExpiredSlot);
+        return;
+    }
+    uint64_t remain = node->expires - now_;
+    if (remain > kMaxTimeout) {
+        remain = kMaxTimeout;
+    }
+    // the level is picked by the distance, the slot by the absolute time so
+    // that slots line up with the ticks Advance passes; above level 0 the
+    // slot is one before, the timer cascades when that slot comes up
+    const int level = Log2Floor(remain) / kSlotBits;
+    const int slot = static_cast<int>(
+            ((node->expires >> (level * kSlotBits)) - (level != 0)) & kSlotMask);
+    pending_[level] |= (1ULL << slot);
+    link(node, level * kSlots + slot);
+}
+
+void TimingWheel::Remove(TimerNode* node) {
+    if (!node->Pending()) {
+        return;
+    }
+    --size_;
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    if (node->slot != kExpiredSlot) {
+        TimerNode* head = &slots_[node->slot];
+        if (head->next == head) {
+            pending_[node->slot / kSlots] &= ~(1ULL << (node->slot % kSlots));
+        }
+    }
+    node->prev = nullptr;
+    node->next = nullptr;
+    node->slot = -1;
+}
+
+void TimingWheel::Advance(uint64_t now) {
+    if (now <= now_) {
+        return;
+    }
+    TimerNode todo;
+    todo.prev = &todo;
+    todo.next = &todo;
+    uint64_t elapsed = now - now_;
+    for (int level = 0; level < kLevels; ++level) {
+        const int shift = level * kSlotBits;
+        uint64_t passed;
+        if ((elapsed >> shift) > kSlotMask) {
+            // a whole turn of this level
+            passed = ~0ULL;
+        } else {
+            // slots from the old position up to and including the new one
+            const int steps = static_cast<int>((elapsed >> shift) & kSlotMask);
+            const int from = static_cast<int>((now_ >> shift) & kSlotMask);
+            const int to = static_cast<int>((now >> shift) & kSlotMask);
+            passed = rotl((1ULL << steps) - 1, from) | (1ULL << to);
+            passed |= rotr(rotl((1ULL << steps) - 1, to), steps);
+        }
+        uint64_t hit = passed & pending_[level];
+        while (hit != 0) {
+            const int slot = CountTrailingZeros(hit);
+            moveAll(&slots_[level * kSlots + slot], &todo);
+            hit &= hit - 1;
+            pending_[level] &= ~(1ULL << slot);
+        }
+        // the next level only moves when this one wraps
+        if (!(passed & 1)) {
+            break;
+        }
+        const uint64_t turn = static_cast<uint64_t>(kSlots) << shift;
+        if (elapsed < turn) {
+            elapsed = turn;
+        }
+    }
+    now_ = now;
+    // re-add: due timers go to the expired list, the others cascade down
+    while (todo.next != &todo) {
+        TimerNode* node = todo.next;
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+        --size_;
+        Add(node);
+    }
+}
+
+TimerNode* TimingWheel::PopExpired() {
+    TimerNode* head = &slots_[kExpiredSlot];
+    if (head->next == head) {
+        return nullptr;
+    }
+    TimerNode* node = head->next;
+    Remove(node);
+    return node;
+}
+
+uint64_t TimingWheel::NextTimeout() const {
+    if (slots_[kExpiredSlot].next != &slots_[kExpiredSlot]) {
+        return 0;
+    }
+    uint64_t timeout = kMaxTimeout;
+    uint64_t lower = 0;  // ticks the lower levels moved into the current slot
+    for (int level = 0; level < kLevels; ++level) {
+        if (pending_[level] != 0) {
+            const int shift = level * kSlotBits;
+            const int slot = static_cast<int>((now_ >> shift) & kSlotMask);
+            // a timer above level 0 sits one slot before its time
+            uint64_t t = static_cast<uint64_t>(CountTrailingZeros(rotr(pending_[level], slot))
+                    + (level != 0)) << shift;
+            t -= lower & now_;
+            if (t < timeout) {
+                timeout = t;
+            }
+        }
+        lower = (lower << kSlotBits) | kSlotMask;
+    }
+    return timeout;
+}
+
+}  // end of namespace cg
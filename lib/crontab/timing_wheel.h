@@ -0,0 +1,86 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <cstddef>
+
+namespace cg {
+
+// Intrusive node of a TimingWheel, embed or derive it in the timer object.
+struct TimerNode {
+    uint64_t expires;  // absolute tick
+    TimerNode* prev;
+    TimerNode* next;
+    int slot;  // level * kSlots + slot, kExpiredSlot, or -1 when not in the wheel
+
+    TimerNode() : expires(0), prev(nullptr), next(nullptr), slot(-1) {}
+
+    bool Pending() const {
+        return slot >= 0;
+    }
+};
+
+// Hierarchical timing wheel: kLevels wheels of 64 slots, level l covering
+// 64^(l+1) ticks. Add and Remove are O(1) list operations. Advance visits
+// only the slots it passes, found through one occupancy bitmap per level, so
+// jumping the clock over a long idle period costs O(kLevels) and not one
+// step per tick. Timers in a higher level cascade down when their slot comes
+// up. Not thread safe.
+class TimingWheel {
+public:
+    static const int kSlotBits = 6;
+    static const int kSlots = 1 << kSlotBits;
+    static const int kLevels = 6;
+    // timers further away wait in the last level and are re-added when reached
+    static const uint64_t kMaxTimeout = (1ULL << (kSlotBits * kLevels)) - 1;
+    static const int kExpiredSlot = kLevels * kSlots;
+
+    explicit TimingWheel(uint64_t now);
+
+    TimingWheel(const TimingWheel&) = delete;
+
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    uint64_t Now() const {
+        return now_;
+    }
+
+    // Timers in the wheel, expired ones included.
+    std::size_t Size() const {
+        return size_;
+    }
+
+    // node->expires must be set, a time not after Now() expires at once.
+    void Add(TimerNode* node);
+
+    void Remove(TimerNode* node);
+
+    // Move the clock to now and every timer with expires <= now to the
+    // expired list. A clock going backwards is ignored.
+    void Advance(uint64_t now);
+
+    // An expired timer removed from the wheel, nullptr if none.
+    TimerNode* PopExpired();
+
+    // Ticks from Now() until Advance may have something to do, 0 when timers
+    // are expired already and kMaxTimeout when the wheel is empty. It may be
+    // early, a timer of a high level only cascades at that time.
+    uint64_t NextTimeout() const;
+
+private:
+    void link(TimerNode* node, int slot);
+
+    static void moveAll(TimerNode* from, TimerNode* to);
+
+private:
+    uint64_t now_;
+    std::size_t size_;
+    uint64_t pending_[kLevels];  // bit s set when slot s of the level is not empty
+    TimerNode slots_[kLevels * kSlots + 1];  // list heads, the last one holds expired timers
+};
+
+}  // end of namespace cg
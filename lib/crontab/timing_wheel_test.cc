@@ -0,0 +1,131 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "crontab/timing_wheel.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class TimingWheelTest : public ::testing::Test {
+protected:
+    // drains the expired list, checks every timer is due and returns how many
+    std::size_t popAll(TimingWheel* wheel) {
+        std::size_t n = 0;
+        while (TimerNode* node = wheel->PopExpired()) {
+            EXPECT_LE(node->expires, wheel->Now());
+            EXPECT_EQ(false, node->Pending());
+            ++n;
+        }
+        return n;
+    }
+};
+
+TEST_F(TimingWheelTest, Basic) {
+    TimingWheel wheel(1000);
+    TimerNode a, b, c;
+    a.expires = 1001;
+    b.expires = 1000 + 64 * 64 + 7;
+    c.expires = 900;  // already due
+    wheel.Add(&a);
+    wheel.Add(&b);
+    wheel.Add(&c);
+    EXPECT_EQ(3U, wheel.Size());
+    EXPECT_EQ(0U, wheel.NextTimeout());
+    EXPECT_EQ(&c, wheel.PopExpired());
+    EXPECT_EQ(nullptr, wheel.PopExpired());
+    EXPECT_EQ(1U, wheel.NextTimeout());
+
+    wheel.Advance(1001);
+    EXPECT_EQ(&a, wheel.PopExpired());
+    EXPECT_EQ(nullptr, wheel.PopExpired());
+
+    wheel.Advance(b.expires - 1);
+    EXPECT_EQ(nullptr, wheel.PopExpired());
+    EXPECT_EQ(1U, wheel.Size());
+    wheel.Advance(b.expires);
+    EXPECT_EQ(&b, wheel.PopExpired());
+    EXPECT_EQ(0U, wheel.Size());
+    EXPECT_EQ(TimingWheel::kMaxTimeout, wheel.NextTimeout());
+}
+
+TEST_F(TimingWheelTest, Remove) {
+    TimingWheel wheel(0);
+    TimerNode a, b;
+    a.expires = 100;
+    b.expires = 100;
+    wheel.Add(&a);
+    wheel.Add(&b);
+    wheel.Remove(&a);
+    EXPECT_EQ(false, a.Pending());
+    wheel.Remove(&a);
+    EXPECT_EQ(1U, wheel.Size());
+    wheel.Advance(1000);
+    EXPECT_EQ(&b, wheel.PopExpired());
+    EXPECT_EQ(nullptr, wheel.PopExpired());
+}
+
+TEST_F(TimingWheelTest, FarAway) {
+    TimingWheel wheel(5);
+    TimerNode a;
+    a.expires = 5 + TimingWheel::kMaxTimeout * 3 + 11;
+    wheel.Add(&a);
+    for (uint64_t now = 5; now < a.expires; now += TimingWheel::kMaxTimeout / 3) {
+        wheel.Advance(now);
+        EXPECT_EQ(nullptr, wheel.PopExpired());
+    }
+    wheel.Advance(a.expires);
+    EXPECT_EQ(&a, wheel.PopExpired());
+}
+
+// random adds, removes and clock jumps checked against a sorted map
+TEST_F(TimingWheelTest, Random) {
+    std::mt19937_64 rng(7);
+    const int kTimers = 4096;
+    std::vector<TimerNode> nodes(kTimers);
+    std::multimap<uint64_t, TimerNode*> expect;
+    TimingWheel wheel(rng() % 100000);
+    for (int round = 0; round < 2000; ++round) {
+        TimerNode& node = nodes[rng() % kTimers];
+        if (node.Pending()) {
+            for (auto it = expect.lower_bound(node.expires); ; ++it) {
+                if (it->second == &node) {
+                    expect.erase(it);
+                    break;
+                }
+            }
+            wheel.Remove(&node);
+        } else {
+            // distances over every level
+            node.expires = wheel.Now() + (rng() >> (rng() % 64));
+            if (node.expires < wheel.Now()) {
+                node.expires = wheel.Now() + 1;
+            }
+            expect.emplace(node.expires, &node);
+            wheel.Add(&node);
+        }
+
+        const uint64_t timeout = wheel.NextTimeout();
+        if (!expect.empty()) {
+            EXPECT_LE(wheel.Now() + timeout, expect.begin()->first);
+        }
+        const uint64_t now = wheel.Now() + (rng() >> (rng() % 44 + 20));
+        wheel.Advance(now);
+        std::size_t due = 0;
+        while (!expect.empty() && expect.begin()->first <= now) {
+            expect.erase(expect.begin());
+            ++due;
+        }
+        EXPECT_EQ(due, popAll(&wheel));
+        EXPECT_EQ(expect.size(), wheel.Size());
+    }
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
@@ -5,8 +5,9 @@
 #pragma once
 
 #include <stdlib.h>
-#include <sstream>
+#include <string>
 
+#include "include/log.h"
 #include "include/macros.h"
 
 #define ASSERT(c) cg::Assertion(__FILE__, __LINE__).Is((c), #c)
@@ -14,6 +15,8 @@
 #define ASSERT_FALSE(c) cg::Assertion(__FILE__, __LINE__).Is(!(c), #c)
 #define CG_CHECK_NOTNULL(p) cg::Assertion(__FILE__, __LINE__).Is((p != nullptr) \
         "'" #p "' Must Not Null")
+#define CG_ASSERT(c) cg::Assertion(__FILE__, __LINE__).Is((c), #c)
+#define CG_ASSERT_EQ(a, b) cg::Assertion(__FILE__, __LINE__).Is((a) == (b), #a " == " #b)
 
 namespace cg {
 
@@ -25,12 +28,12 @@ public:
         if (LIKELY(ok_)) {
             return;
         }
-        LOG(FATAL) << "fname:" << fname_ << ", line:" << line_ << ", msg:" <<  ss_.str().c_str();
+        LOG(FATAL) << "fname:" << fname_ << ", line:" << line_ << ", msg:" <<  msg_;
         abort();
     }
 
     void inline SetStatus(const char* msg) {
-        ss_ << " Assertion failure " << msg;
+        msg_.append(" Assertion failure ").append(msg);
         ok_ = false;
     }
 
@@ -45,7 +48,8 @@ private:
     bool ok_;
     const char* fname_;
     int line_;
-    std::stringstream ss_;
+    // only built on failure, an empty std::string costs no allocation
+    std::string msg_;
 };
 
 }  // end of namespace cg
@@ -5,23 +5,212 @@
 
 #pragma once
 
-namespace raft {
+#include <stdint.h>
 
-template<type T>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "base/cpu.h"
+#include "include/macros.h"
+
+namespace cg {
+
+// std::atomic with the memory order spelled out at the call, and the read-
+// modify-writes the hardware lacks as CAS loops. Every operation takes its
+// order, seq_cst by default as in std::atomic; the order of a failed CAS is
+// derived from the one of success.
+template <typename T>
 class Atomic {
 public:
-    T operator()() {
-        return v_;
+    Atomic() : v_(T()) {}
+
+    explicit Atomic(T v) : v_(v) {}
+
+    Atomic(const Atomic&) = delete;
+
+    Atomic& operator=(const Atomic&) = delete;
+
+    T Load(std::memory_order order = std::memory_order_seq_cst) const {
+        return v_.load(order);
+    }
+
+    void Store(T v, std::memory_order order = std::memory_order_seq_cst) {
+        v_.store(v, order);
+    }
+
+    T Exchange(T v, std::memory_order order = std::memory_order_seq_cst) {
+        return v_.exchange(v, order);
+    }
+
+    // On failure *expected is the current value.
+    bool CompareExchange(T* expected, T desired,
+                         std::memory_order order = std::memory_order_seq_cst) {
+        return v_.compare_exchange_strong(*expected, desired, order, failureOrder(order));
+    }
+
+    // may fail spuriously, for the loops that retry anyway
+    bool CompareExchangeWeak(T* expected, T desired,
+                             std::memory_order order = std::memory_order_seq_cst) {
+        return v_.compare_exchange_weak(*expected, desired, order, failureOrder(order));
+    }
+
+    // The fetch ops return the value before, for the integral types and
+    // FetchAdd/FetchSub of pointers.
+    T FetchAdd(T d, std::memory_order order = std::memory_order_seq_cst) {
+        return v_.fetch_add(d, order);
+    }
+
+    T FetchSub(T d, std::memory_order order = std::memory_order_seq_cst) {
+        return v_.fetch_sub(d, order);
+    }
+
+    T FetchAnd(T bits, std::memory_order order = std::memory_order_seq_cst) {
+        return v_.fetch_and(bits, order);
+    }
+
+    T FetchOr(T bits, std::memory_order order = std::memory_order_seq_cst) {
+        return v_.fetch_or(bits, order);
+    }
+
+    T FetchXor(T bits, std::memory_order order = std::memory_order_seq_cst) {
+        return v_.fetch_xor(bits, order);
+    }
+
+    // Replaces the value v by func(v) in a CAS loop, returns the v replaced.
+    // func may run several times.
+    template <typename Func>
+    T FetchUpdate(Func func, std::memory_order order = std::memory_order_seq_cst) {
+        T old = v_.load(std::memory_order_relaxed);
+        while (!v_.compare_exchange_weak(old, func(old), order, std::memory_order_relaxed)) {
+        }
+        return old;
+    }
+
+    // Stores v if it is above, or below, the value; returns the value before.
+    // A value already past v costs a load, no write.
+    T FetchMax(T v, std::memory_order order = std::memory_order_seq_cst) {
+        T old = v_.load(std::memory_order_relaxed);
+        while (old < v
+               && !v_.compare_exchange_weak(old, v, order, std::memory_order_relaxed)) {
+        }
+        return old;
+    }
+
+    T FetchMin(T v, std::memory_order order = std::memory_order_seq_cst) {
+        T old = v_.load(std::memory_order_relaxed);
+        while (v < old
+               && !v_.compare_exchange_weak(old, v, order, std::memory_order_relaxed)) {
+        }
+        return old;
+    }
+
+    T operator()() const {
+        return Load();
+    }
+
+    // seq_cst, as the operators of std::atomic
+    T operator++() {
+        return FetchAdd(1) + 1;
+    }
+
+    T operator++(int) {
+        return FetchAdd(1);
+    }
+
+    T operator--() {
+        return FetchSub(1) - 1;
+    }
+
+    T operator--(int) {
+        return FetchSub(1);
+    }
+
+private:
+    static constexpr std::memory_order failureOrder(std::memory_order order) {
+        return order == std::memory_order_acq_rel ? std::memory_order_acquire
+            : order == std::memory_order_release ? std::memory_order_relaxed
+            : order;
+    }
+
+private:
+    std::atomic<T> v_;
+};
+
+static const std::size_t kCacheLineSize = 64;
+
+// A value padded to a cache line of its own. The pad follows the value: in
+// an array, or among members, the values are a line apart and share no line.
+// new of C++11 does not honor an alignas above 16, so there is none.
+template <typename T>
+struct CacheLinePadded {
+    T value;
+    char pad[kCacheLineSize - sizeof(T) % kCacheLineSize];
+
+    CacheLinePadded() : value() {}
+
+    explicit CacheLinePadded(const T& v) : value(v) {}
+};
+
+namespace internal {
+
+// 0, 1, 2... for the threads in the order they ask: a small index of the
+// calling thread for picking a stripe or a shard.
+inline uint32_t ThreadSlot() {
+    static std::atomic<uint32_t> next(1);
+    static thread_local uint32_t slot = 0;
+    if (UNLIKELY(slot == 0)) {
+        slot = next.fetch_add(1, std::memory_order_relaxed);
+    }
+    return slot - 1;
+}
+
+}  // end of namespace internal
+
+// Counter for statistics bumped from many threads. Threads add to one of a
+// few stripes, each on its own cache line, chosen by thread: up to as many
+// threads as cpus never write the same line. A read sums the stripes, it is
+// exact once the writers stopped and approximate while they run.
+class StripedCounter {
+public:
+    // a stripe per cpu, at most 64
+    StripedCounter() {
+        const uint32_t stripes = PerCpuShards();
+        mask_ = stripes - 1;
+        stripes_.reset(new CacheLinePadded<std::atomic<int64_t>>[stripes]);
+        Reset();
+    }
+
+    StripedCounter(const StripedCounter&) = delete;
+
+    StripedCounter& operator=(const StripedCounter&) = delete;
+
+    void Add(int64_t n) {
+        stripes_[internal::ThreadSlot() & mask_].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void Increment() {
+        Add(1);
     }
 
-    operator++() {
+    int64_t Sum() const {
+        int64_t sum = 0;
+        for (uint32_t i = 0; i <= mask_; ++i) {
+            sum += stripes_[i].value.load(std::memory_order_relaxed);
+        }
+        return sum;
     }
 
-    operator++(int) {
+    // not atomic: adds meanwhile may survive it or not
+    void Reset() {
+        for (uint32_t i = 0; i <= mask_; ++i) {
+            stripes_[i].value.store(0, std::memory_order_relaxed);
+        }
     }
 
 private:
-    T v_;
+    uint32_t mask_;
+    std::unique_ptr<CacheLinePadded<std::atomic<int64_t>>[]> stripes_;
 };
 
-}  // end of namespace raft
+}  // end of namespace cg
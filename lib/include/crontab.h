@@ -5,7 +5,9 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 
 #include <algorithm>
 #include <cmath>
@@ -13,24 +15,14 @@
 #include <string>
 #include <vector>
 
+#include "container/small_vector.h"
 #include "include/log.h"
+#include "include/slice.h"
 #include "include/strings.h"
-#include "re2/re2.h"
 #include "system/timestamp.h"
 
 namespace cg {
 
-static const char* k_pattern_division_everyone = "\\*";
-static const char* k_pattern_division_every = "\\*/[0-9]+";
-static const char* k_pattern_someone = "([0-9]+[,]*)+";
-static const char* k_pattern_someone_range = "([0-9]+-[0-9]+[,]*)+";  // eg: 0-10,15-20
-
-struct Date {
-    uint64_t timestamp_;
-
-    Date() : timestamp_(0) {}
-};
-
 enum RuleType {
     RULE_TYPE_MON = uint8_t(0),
     RULE_TYPE_WEEK,
@@ -46,10 +38,13 @@ enum Policy {
     POLICY_NUM,
 };
 
+// The values of a rule, inline up to a field listing 16 of them.
+typedef SmallVector<uint8_t, 16> RuleList;
+
 struct Rule {
     RuleType type_;
     Policy policy_;
-    std::vector<uint8_t> list_;
+    RuleList list_;
 
     Rule() {
         type_ = RULE_TYPE_NUM;
@@ -68,55 +63,97 @@ struct Rule {
         }
         return false;
     }
+};
 
-    int Distance(int date) {
-        uint8_t min_gap = 255;
-        uint8_t res = 0;
-        for (auto& it : list_) {
-            if (policy_ == POLICY_DIVISION && static_cast<uint32_t>(it) == 0) {
-                LOG(INFO) << "ignore type_:" << type_;
-                res = 0;
-                break;
-            }
-            auto gap = std::min(static_cast<uint8_t>(std::abs(static_cast<uint8_t>(date) - it)),
-                    min_gap);
-            if (gap != min_gap) {
-                res = it;
-            }
-        }
-        return static_cast<int>(res);
+// Broken down local time of one evaluation, taken once and shared by every rule.
+struct CronTime {
+    uint8_t minute;  // 0-59
+    uint8_t hour;    // 0-23
+    uint8_t day;     // 1-31
+    uint8_t month;   // 1-12
+    uint8_t week;    // 0-6, 0 is sunday
+
+    static CronTime FromTimestamp(time_t t) {
+        struct tm stm;
+        LocalTime(t, &stm);
+        CronTime now;
+        now.minute = static_cast<uint8_t>(stm.tm_min);
+        now.hour = static_cast<uint8_t>(stm.tm_hour);
+        now.day = static_cast<uint8_t>(stm.tm_mday);
+        now.month = static_cast<uint8_t>(stm.tm_mon + 1);
+        now.week = static_cast<uint8_t>(stm.tm_wday);
+        return now;
     }
+
+    static CronTime Now() {
+        return FromTimestamp(CoarseClock::Seconds());
+    }
+};
+
+// The rules compiled into one bit per allowed value of each field.
+struct CronMask {
+    uint64_t minute;
+    uint64_t hour;
+    uint32_t day;
+    uint32_t month;
+    uint8_t week;
+
+    bool Match(const CronTime& now) const {
+        return ((minute >> now.minute) & (hour >> now.hour) & (day >> now.day)
+                & (month >> now.month) & (week >> now.week) & 1) != 0;
+    }
+};
+
+enum CronParseCode {
+    CRON_PARSE_OK = 0,
+    CRON_PARSE_EMPTY,            // nothing but blanks
+    CRON_PARSE_FIELD_COUNT,      // not 5 fields
+    CRON_PARSE_UNEXPECTED_CHAR,
+    CRON_PARSE_BAD_NUMBER,       // no digit, or too many
+    CRON_PARSE_OUT_OF_RANGE,
+    CRON_PARSE_BAD_RANGE,        // a-b with a > b
+    CRON_PARSE_BAD_STEP,         // /0 or no step after '/'
+    CRON_PARSE_UNKNOWN_NAME,
+    CRON_PARSE_UNKNOWN_MACRO,
+    CRON_PARSE_NUM,
 };
 
+struct CronParseError {
+    CronParseCode code;
+    RuleType field;      // RULE_TYPE_NUM when the error is not inside a field
+    std::size_t offset;  // byte offset into the expression
+
+    const char* Message() const;
+};
+
+// Parse a crontab expression into masks in one pass, without regex or
+// allocation. Grammar:
+//
+//   expr  := "minute hour day month week" | "@yearly" | "@annually" | "@monthly"
+//          | "@weekly" | "@daily" | "@midnight" | "@hourly"
+//   field := item ("," item)*
+//   item  := ("*" | value | value "-" value) ["/" step]
+//
+// value is a number, or for month and week a three letter name (JAN, MON...)
+// in any case. "a/n" runs from a to the end of the field. Week takes 0-7
+// where both 0 and 7 are sunday. Day and week must both match, unlike
+// crontab(5) which fires when either does. On failure error (if not nullptr)
+// tells what and where.
+bool ParseCronExpr(const Slice& expr, CronMask* mask, CronParseError* error = nullptr);
+
 class CronTab {
 public:
-    // check crontab pattern
-    static bool Invalid(const std::string& pattern) {
-        std::vector<std::string> v;
-        StringSplit(" ", pattern, &v);
-        if (v.size() != 5) {
-            fprintf(stderr, "invalid pattern for split. pattern:%s, size:%u\n",
-                    pattern.c_str(), static_cast<uint32_t>(v.size()));
-            return true;
-        }
-        for (const auto& it : v) {
-            if (!RE2::FullMatch(it, k_pattern_division_every)
-                    && !(RE2::FullMatch(it, k_pattern_division_everyone))
-                    && !(RE2::FullMatch(it, k_pattern_someone))
-                    && !(RE2::FullMatch(it, k_pattern_someone_range))) {
-                fprintf(stderr, "invalid regex. pattern:%s\n", it.c_str());
-                return true;
-            }
-        }
-        return false;
-    }
+    // Check a pattern against the syntax of the Rule model: every field is
+    // "*", "*/n", "a,b,..." or "a-b,c-d,...". Values are not range checked,
+    // ParseCronExpr accepts the full grammar.
+    static bool Invalid(const std::string& pattern);
 
     static bool Invalid(RuleType type, Policy policy) {
         return (type < RULE_TYPE_MON || type >= RULE_TYPE_NUM)
             || (policy < POLICY_DIVISION || policy >= POLICY_NUM);
     }
 
-    static Rule GenRule(RuleType type, Policy policy, const std::vector<uint8_t> data) {
+    static Rule GenRule(RuleType type, Policy policy, const RuleList& data) {
         if (Invalid(type, policy)) {
             return Rule{};
         }
@@ -127,8 +164,34 @@ public:
         return rule;
     }
 
+    // A template only so that GenRule(type, policy, {1, 2}) picks the one above.
+    template <typename Alloc>
+    static Rule GenRule(RuleType type, Policy policy, const std::vector<uint8_t, Alloc>& data) {
+        return GenRule(type, policy, RuleList(data.begin(), data.end()));
+    }
+
+    // Allowed values of a field: month 1-12, week 0-6 (7 is also sunday),
+    // day 1-31, hour 0-23, minute 0-59.
+    static uint8_t MinValue(RuleType type);
+
+    static uint8_t MaxValue(RuleType type);
+
+    // Bits of the values rule allows, every value of the field for an empty rule.
+    // Division steps from the lowest value of the field like crontab(5): */2 on
+    // days is 1,3,5... and on minutes 0,2,4...
+    static uint64_t CompileRule(RuleType type, const Rule& rule);
+
 public:
-    CronTab() {}
+    // Years searched by NextFireTime/PrevFireTime, enough for every day and
+    // weekday combination, the calendar repeats every 28 years.
+    static const int kSearchYears = 29;
+
+    CronTab() {
+        compile();
+    }
+
+    // Parse a crontab expression, see ParseCronExpr.
+    bool Init(const Slice& expr, CronParseError* error = nullptr);
 
     bool Init(const std::vector<Rule>& rules) {
         for (auto& rule : rules) {
@@ -137,44 +200,59 @@ public:
             }
             rules_[rule.type_] = rule;
         }
-        setLastDivision();
+        compile();
         return true;
     }
 
-    bool CanExecute();
+    // Take a time snapshot and match it, prefer CanExecute(now) when many
+    // crontabs are checked at once.
+    bool CanExecute() const {
+        return CanExecute(CronTime::Now());
+    }
 
-private:
-    bool month();
+    bool CanExecute(const CronTime& now) const {
+        return mask_.Match(now);
+    }
 
-    bool week();
+    // First minute strictly after `after` that the crontab fires at, -1 if none
+    // within kSearchYears (e.g. "0 0 30 2 *"). Jumps from field to field, so
+    // a scheduler can sleep until the returned time.
+    time_t NextFireTime(time_t after) const;
 
-    bool day();
+    // Last minute strictly before `before` that the crontab fires at, -1 if none.
+    time_t PrevFireTime(time_t before) const;
 
-    bool hour();
+    const CronMask& Mask() const {
+        return mask_;
+    }
 
-    bool minute();
+private:
+    struct Fields;
 
-    bool compare(RuleType type);
+    void compile();
 
-    int getCurrentDate(RuleType);
+    // Days of month the day and weekday masks both allow, bit d for day d.
+    uint32_t days(int year, int month) const;
 
-    bool enoughDistance();
+    bool next(Fields* f, int last_year) const;
 
-    void setLastDivision();
+    bool prev(Fields* f, int first_year) const;
 
 private:
     // Consistent with the crontab
     Rule rules_[RULE_TYPE_NUM];
-    Date last_exe_;
-    RuleType last_division_;
+    CronMask mask_;
 };
 
-// NOTE(caoge): parse crontab config by regex
+// nullptr when pattern is not a valid expression, see ParseCronExpr.
 CronTab* GenCronTab(const std::string& pattern);
 
+CronTab* GenCronTab(const Slice& pattern, CronParseError* error);
+
 Policy ParsePolicy(const std::string& pattern);
 
-std::vector<uint8_t> ParseData(const Policy& policy, const std::string& pattern);
+// The values pattern lists under policy, empty for POLICY_NUM.
+RuleList ParseData(const Policy& policy, const std::string& pattern);
 
 void parseRange(const std::string& pattern, uint8_t* begin, uint8_t* end);
 
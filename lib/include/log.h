@@ -1,2 +1,454 @@
 //  Created by caoge@strivemycodelife@163.com on 2021-03-21
 #pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <time.h>
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+#include "include/macros.h"
+#include "string/digits.h"
+
+// Levels below CG_MIN_LOG_LEVEL are removed at compile time, e.g.
+// -DCG_MIN_LOG_LEVEL=2 drops LOG(DEBUG) together with its arguments.
+#ifndef CG_MIN_LOG_LEVEL
+#define CG_MIN_LOG_LEVEL 0
+#endif
+
+namespace cg {
+
+enum LogLevel {
+    LOG_LEVEL_ALL = 0,
+    LOG_LEVEL_DEBUG,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_FATAL,
+    LOG_LEVEL_NUM,
+};
+
+struct LogConfig {
+    std::string path;         // file appended to, stderr when empty
+    std::size_t buffer_size;  // bytes of the ring of each thread, rounded up to a power of two
+    bool block_when_full;     // wait for the writer when a ring is full, drop the line otherwise
+    int flush_interval_ms;    // how long the idle writer sleeps
+
+    LogConfig() : buffer_size(1 << 20), block_when_full(true), flush_interval_ms(1) {}
+};
+
+struct LogStats {
+    uint64_t lines;    // lines put into the rings
+    uint64_t dropped;  // lines lost to a full ring
+    uint64_t bytes;    // bytes written out
+    uint64_t writes;   // writev calls
+};
+
+// Logging works without it, to stderr. Switching the file is allowed at any
+// time, lines still in the rings go to the new one.
+bool InitLogging(const LogConfig& config);
+
+// Returns when every line logged before the call has been written.
+void FlushLog();
+
+LogStats GetLogStats();
+
+// Binary log of BLOG: records hold the id of their call site and the raw
+// bytes of the arguments, log_decoder formats them offline. An empty path
+// discards the records. Each call appends a new header to the file.
+bool InitBinaryLog(const LogConfig& config);
+
+void FlushBinaryLog();
+
+LogStats GetBinaryLogStats();
+
+namespace internal {
+
+extern std::atomic<int> g_min_log_level;
+
+inline bool LogEnabled(int level) {
+    return level >= g_min_log_level.load(std::memory_order_relaxed);
+}
+
+// true for the 1st, (n+1)th, (2n+1)th... call
+inline bool LogEveryN(std::atomic<uint64_t>* counter, uint64_t n) {
+    return counter->fetch_add(1, std::memory_order_relaxed) % n == 0;
+}
+
+inline bool LogFirstN(std::atomic<uint64_t>* counter, uint64_t n) {
+    return counter->load(std::memory_order_relaxed) < n
+        && counter->fetch_add(1, std::memory_order_relaxed) < n;
+}
+
+// true at most once per ms milliseconds
+bool LogEveryMs(std::atomic<int64_t>* last, int64_t ms);
+
+}  // end of namespace internal
+
+inline void SetMinLogLevel(LogLevel level) {
+    internal::g_min_log_level.store(level, std::memory_order_relaxed);
+}
+
+inline LogLevel MinLogLevel() {
+    return static_cast<LogLevel>(internal::g_min_log_level.load(std::memory_order_relaxed));
+}
+
+// Formats a line into a buffer of the LogMessage, much cheaper than an
+// ostream. Lines longer than the inline buffer move to the heap.
+class LogStream {
+public:
+    static const std::size_t kInlineSize = 1024;
+
+    LogStream() : size_(0) {}
+
+    LogStream(const LogStream&) = delete;
+
+    LogStream& operator=(const LogStream&) = delete;
+
+    void Append(const char* p, std::size_t n) {
+        if (LIKELY(heap_.empty() && size_ + n <= kInlineSize)) {
+            memcpy(buf_ + size_, p, n);
+            size_ += n;
+            return;
+        }
+        appendSlow(p, n);
+    }
+
+    const char* Data() const {
+        return heap_.empty() ? buf_ : heap_.data();
+    }
+
+    std::size_t Size() const {
+        return heap_.empty() ? size_ : heap_.size();
+    }
+
+    LogStream& operator<<(const char* s) {
+        if (s == nullptr) {
+            Append("(null)", 6);
+        } else {
+            Append(s, strlen(s));
+        }
+        return *this;
+    }
+
+    LogStream& operator<<(const std::string& s) {
+        Append(s.data(), s.size());
+        return *this;
+    }
+
+    LogStream& operator<<(char c) {
+        Append(&c, 1);
+        return *this;
+    }
+
+    LogStream& operator<<(bool b) {
+        return b ? (Append("true", 4), *this) : (Append("false", 5), *this);
+    }
+
+    LogStream& operator<<(unsigned char v) {
+        return appendUInt(v);
+    }
+
+    LogStream& operator<<(unsigned short v) {
+        return appendUInt(v);
+    }
+
+    LogStream& operator<<(unsigned int v) {
+        return appendUInt(v);
+    }
+
+    LogStream& operator<<(unsigned long v) {
+        return appendUInt(v);
+    }
+
+    LogStream& operator<<(unsigned long long v) {
+        return appendUInt(v);
+    }
+
+    LogStream& operator<<(short v) {
+        return appendInt(v);
+    }
+
+    LogStream& operator<<(int v) {
+        return appendInt(v);
+    }
+
+    LogStream& operator<<(long v) {
+        return appendInt(v);
+    }
+
+    LogStream& operator<<(long long v) {
+        return appendInt(v);
+    }
+
+    LogStream& operator<<(double v);
+
+    LogStream& operator<<(float v) {
+        return *this << static_cast<double>(v);
+    }
+
+    LogStream& operator<<(const void* p);
+
+private:
+    void appendSlow(const char* p, std::size_t n);
+
+    LogStream& appendUInt(uint64_t v) {
+        char buf[20];
+        char* begin = FormatDecimal(v, buf + sizeof(buf));
+        Append(begin, buf + sizeof(buf) - begin);
+        return *this;
+    }
+
+    LogStream& appendInt(int64_t v) {
+        char buf[21];
+        const uint64_t u = v < 0 ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+        char* begin = FormatDecimal(u, buf + sizeof(buf));
+        if (v < 0) {
+            *--begin = '-';
+        }
+        Append(begin, buf + sizeof(buf) - begin);
+        return *this;
+    }
+
+private:
+    std::size_t size_;
+    char buf_[kInlineSize];
+    std::string heap_;
+};
+
+// One line: the prefix is written by the constructor, the destructor hands
+// the line to the ring of the calling thread. FATAL flushes and aborts.
+class LogMessage {
+public:
+    LogMessage(const char* file, int line, LogLevel level);
+
+    ~LogMessage();
+
+    LogStream& Stream() {
+        return stream_;
+    }
+
+private:
+    LogLevel level_;
+    LogStream stream_;
+};
+
+namespace internal {
+
+// turns the stream expression into void for the ?: of CG_LOG_IF
+struct LogVoidify {
+    void operator&(LogStream&) {}
+};
+
+}  // end of namespace internal
+
+namespace internal {
+
+// site id, payload size and tick in front of the arguments of a record
+const std::size_t kBinaryRecordHeaderSize = 16;
+
+// Returns the id of a BLOG call site; file, format and types must outlive it.
+uint32_t RegisterBinaryLogSite(const char* file, int line, LogLevel level,
+                               const char* format, const char* types);
+
+// Contiguous room for a record of n bytes in the ring of the calling thread,
+// nullptr when the record is dropped. BinaryLogCommit publishes it.
+char* BinaryLogReserve(std::size_t n);
+
+void BinaryLogCommit();
+
+// flushes and aborts
+void BinaryLogFatal();
+
+// TSC where there is one, the writer stores its rate in the file
+inline uint64_t BinaryLogTick() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+// Encoding of one argument type, the type char is what the decoder reads:
+// i/I signed 32/64 bits, u/U unsigned, d double, p pointer, s string.
+template <typename T, typename Enable = void>
+struct BinaryArg;
+
+template <typename T>
+struct BinaryArg<T, typename std::enable_if<std::is_integral<T>::value>::type> {
+    static const bool kWide = sizeof(T) > 4;
+    static const char kType = std::is_signed<T>::value ? (kWide ? 'I' : 'i') : (kWide ? 'U' : 'u');
+    typedef typename std::conditional<kWide,
+            typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::type,
+            typename std::conditional<std::is_signed<T>::value, int32_t, uint32_t>::type>::type Stored;
+
+    static std::size_t Size(T) {
+        return sizeof(Stored);
+    }
+
+    static char* Write(char* p, T v) {
+        const Stored stored = static_cast<Stored>(v);
+        memcpy(p, &stored, sizeof(stored));
+        return p + sizeof(stored);
+    }
+};
+
+template <typename T>
+struct BinaryArg<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+    static const char kType = 'd';
+
+    static std::size_t Size(T) {
+        return sizeof(double);
+    }
+
+    static char* Write(char* p, T v) {
+        const double stored = v;
+        memcpy(p, &stored, sizeof(stored));
+        return p + sizeof(stored);
+    }
+};
+
+// the address only, BLOG does not follow pointers other than strings
+template <typename T>
+struct BinaryArg<T*> {
+    static const char kType = 'p';
+
+    static std::size_t Size(const T*) {
+        return sizeof(uint64_t);
+    }
+
+    static char* Write(char* p, const T* v) {
+        const uint64_t stored = reinterpret_cast<uintptr_t>(v);
+        memcpy(p, &stored, sizeof(stored));
+        return p + sizeof(stored);
+    }
+};
+
+// 32 bits of length, then the bytes
+struct BinaryStringArg {
+    static const char kType = 's';
+
+    static std::size_t Size(const char* s) {
+        return sizeof(uint32_t) + (s == nullptr ? 6 : strlen(s));
+    }
+
+    static char* Write(char* p, const char* s) {
+        if (s == nullptr) {
+            s = "(null)";
+        }
+        const uint32_t n = static_cast<uint32_t>(strlen(s));
+        memcpy(p, &n, sizeof(n));
+        memcpy(p + sizeof(n), s, n);
+        return p + sizeof(n) + n;
+    }
+};
+
+template <>
+struct BinaryArg<const char*> : BinaryStringArg {};
+
+template <>
+struct BinaryArg<char*> : BinaryStringArg {};
+
+template <typename T>
+struct BinaryArgOf : BinaryArg<typename std::decay<T>::type> {};
+
+template <typename... Args>
+struct BinaryArgTypes {
+    static const char kValue[sizeof...(Args) + 1];
+};
+
+template <typename... Args>
+const char BinaryArgTypes<Args...>::kValue[sizeof...(Args) + 1] = {BinaryArgOf<Args>::kType..., '\0'};
+
+// only named in decltype, the arguments are not evaluated
+template <typename... Args>
+BinaryArgTypes<Args...> BinaryLogTypeList(const Args&...);
+
+template <typename... Args>
+const char* BinaryLogTypes(const Args&...) {
+    return BinaryArgTypes<Args...>::kValue;
+}
+
+template <typename... Args>
+void BinaryLogWrite(uint32_t site, const Args&... args) {
+    const uint64_t tick = BinaryLogTick();
+    std::size_t size = 0;
+    const int sizes[] = {0, (size += BinaryArgOf<Args>::Size(args), 0)...};
+    (void)sizes;
+    char* p = BinaryLogReserve(kBinaryRecordHeaderSize + size);
+    if (p == nullptr) {
+        return;
+    }
+    const uint32_t header[2] = {site, static_cast<uint32_t>(size)};
+    memcpy(p, header, sizeof(header));
+    memcpy(p + sizeof(header), &tick, sizeof(tick));
+    p += kBinaryRecordHeaderSize;
+    const int writes[] = {0, (p = BinaryArgOf<Args>::Write(p, args), 0)...};
+    (void)writes;
+    BinaryLogCommit();
+}
+
+// never called, lets the compiler check the arguments against the format
+inline void BinaryLogCheckFormat(const char*, ...) __attribute__((format(printf, 1, 2)));
+
+inline void BinaryLogCheckFormat(const char*, ...) {}
+
+}  // end of namespace internal
+
+}  // end of namespace cg
+
+// __builtin_strrchr on a literal is folded by the compiler
+#define CG_LOG_BASENAME(f) (__builtin_strrchr(f, '/') ? __builtin_strrchr(f, '/') + 1 : (f))
+
+// Neither the message nor cond is evaluated when level is disabled.
+#define CG_LOG_IF(level, cond) \
+    !((level) >= CG_MIN_LOG_LEVEL && cg::internal::LogEnabled(level) && (cond)) ? (void)0 \
+        : cg::internal::LogVoidify() & \
+          cg::LogMessage(CG_LOG_BASENAME(__FILE__), __LINE__, level).Stream()
+
+// state private to one call site
+#define CG_LOG_SITE(type) ([]() -> type* { static type site(0); return &site; }())
+
+#ifdef LOG
+#error "LOG is already defined, by another logging library?"
+#endif
+// LOG(DEBUG|INFO|WARN|ERROR|FATAL) << ...
+#define LOG(level) CG_LOG_IF(cg::LOG_LEVEL_##level, true)
+#define LOG_IF(level, cond) CG_LOG_IF(cg::LOG_LEVEL_##level, (cond))
+// rate limited: the 1st of every n calls, the first n calls, once per ms
+#define LOG_EVERY_N(level, n) \
+    CG_LOG_IF(cg::LOG_LEVEL_##level, \
+              cg::internal::LogEveryN(CG_LOG_SITE(std::atomic<uint64_t>), (n)))
+#define LOG_FIRST_N(level, n) \
+    CG_LOG_IF(cg::LOG_LEVEL_##level, \
+              cg::internal::LogFirstN(CG_LOG_SITE(std::atomic<uint64_t>), (n)))
+#define LOG_EVERY_MS(level, ms) \
+    CG_LOG_IF(cg::LOG_LEVEL_##level, \
+              cg::internal::LogEveryMs(CG_LOG_SITE(std::atomic<int64_t>), (ms)))
+
+// BLOG(INFO, "user %d took %.3f ms", id, ms): printf style, with the format
+// checked at compile time. Only the site id, a tick and the raw arguments
+// are recorded, strings by value; nothing is formatted until log_decoder
+// reads the file.
+#define BLOG(level, format, ...) \
+    do { \
+        if (cg::LOG_LEVEL_##level >= CG_MIN_LOG_LEVEL \
+            && cg::internal::LogEnabled(cg::LOG_LEVEL_##level)) { \
+            if (false) { \
+                cg::internal::BinaryLogCheckFormat(format, ##__VA_ARGS__); \
+            } \
+            static const uint32_t cg_blog_site = cg::internal::RegisterBinaryLogSite( \
+                    CG_LOG_BASENAME(__FILE__), __LINE__, cg::LOG_LEVEL_##level, format, \
+                    decltype(cg::internal::BinaryLogTypeList(__VA_ARGS__))::kValue); \
+            cg::internal::BinaryLogWrite(cg_blog_site, ##__VA_ARGS__); \
+            if (cg::LOG_LEVEL_##level == cg::LOG_LEVEL_FATAL) { \
+                cg::internal::BinaryLogFatal(); \
+            } \
+        } \
+    } while (0)
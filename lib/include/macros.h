@@ -5,7 +5,6 @@
 #pragma once
 
 #include <functional>
-#include <iostream>
 
 #undef LIKELY
 #undef UNLIKELY
@@ -18,11 +17,6 @@
 #define UNLIKELY(x) (x)
 #endif
 
-#define FATAL 1
-#undef LOG
-#define LOG(x) std::cout
-#define LOG_FATAL(x) LOG(X)
-
 class LibInitializer {
     explicit LibInitializer(std::function<void(void)> func) {
         func();
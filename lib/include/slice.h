@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <string>
 
+#include "base/common_prefix.h"
 #include "include/assert.h"
 
 namespace cg {
@@ -16,6 +17,8 @@ class Slice {
 public:
     Slice() : data_(""), size_(0) {}
 
+    Slice(const char* d, std::size_t n) : data_(d), size_(n) {}
+
     explicit Slice(const std::string& s) : data_(s.data()), size_(s.size()) {}
 
     explicit Slice(const char* s) : data_(s) {
@@ -58,6 +61,14 @@ public:
 
     bool DecodeHex(std::string* result) const;
 
+    // Hex encode into a caller supplied buffer, no allocation. Return
+    // 2 * Size(), the chars written or, like snprintf, the chars needed:
+    // nothing is written when the result is greater than cap.
+    std::size_t ToHex(char* buf, std::size_t cap) const;
+
+    // Hex decode into a caller supplied buffer of at least Size() / 2 bytes.
+    bool DecodeHex(char* buf, std::size_t cap, std::size_t* len) const;
+
     inline int Compare(const Slice& b) const {
         ASSERT(data_ != nullptr && b.data_ != nullptr);
         const std::size_t min_len = (size_ < b.size_) ? size_ : b.size_;
@@ -81,14 +92,8 @@ public:
     }
 
     inline std::size_t DifferenceOffset(const Slice& b) const {
-        std::size_t off = 0;
         const std::size_t len = (size_ < b.size_) ? size_ : b.size_;
-        for (; off < len; ++off) {
-            if (data_[off] != b.data_[off]) {
-                break;
-            }
-        }
-        return off;
+        return CommonPrefix(data_, b.data_, len);
     }
 
 private:
@@ -96,12 +101,19 @@ private:
     std::size_t size_;
 };
 
-bool operator==(const Slice& a, const Slice& b) {
+inline bool operator==(const Slice& a, const Slice& b) {
     return ((a.Size() == b.Size()) && (memcmp(a.Data(), b.Data(), a.Size()) == 0));
 }
 
-bool operator!=(const Slice& a, const Slice& b) {
+inline bool operator!=(const Slice& a, const Slice& b) {
     return !(a == b);
 }
 
+// Prefix compression helpers for a run of n keys sorted by Slice::Compare.
+// shared[0] = 0 and shared[i] = keys[i - 1].DifferenceOffset(keys[i]).
+void SharedPrefixLengths(const Slice* keys, std::size_t n, std::size_t* shared);
+
+// Length of the prefix shared by all n sorted keys, 0 if n is 0.
+std::size_t SortedCommonPrefix(const Slice* keys, std::size_t n);
+
 }  // end of namespace cg
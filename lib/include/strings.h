@@ -1 +1,221 @@
+//  Created by caoge@strivemycodelife@163.com on 2021-03-21
 #pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "include/slice.h"
+
+// Searching, splitting and trimming without copies: the results are Slices
+// into the searched text, valid as long as it is. The delimiter searches
+// test 16 or 32 bytes at a time with SSE2/AVX2.
+
+namespace cg {
+
+static const std::size_t kStringNpos = static_cast<std::size_t>(-1);
+
+namespace internal {
+
+// A set of bytes prepared once for the search kernels: up to 8 bytes are
+// compared by simd, repeated to fill 4 or 8 lanes; the bitmap serves the
+// rest and the tails.
+class ByteSet {
+public:
+    explicit ByteSet(const Slice& chars) : count_(0) {
+        memset(bits_, 0, sizeof(bits_));
+        for (std::size_t i = 0; i < chars.Size(); ++i) {
+            const unsigned char c = chars.Data()[i];
+            if (!Contains(c)) {
+                bits_[c >> 6] |= 1ULL << (c & 63);
+                if (count_ < 8) {
+                    chars_[count_] = c;
+                }
+                ++count_;
+            }
+        }
+        for (int i = count_; i < 8; ++i) {
+            chars_[i] = count_ == 0 ? 0 : chars_[0];
+        }
+    }
+
+    bool Contains(unsigned char c) const {
+        return (bits_[c >> 6] >> (c & 63)) & 1;
+    }
+
+    // distinct bytes in the set
+    int Count() const {
+        return count_;
+    }
+
+    const char* Chars() const {
+        return chars_;
+    }
+
+private:
+    uint64_t bits_[4];
+    char chars_[8];
+    int count_;
+};
+
+// Bit i set when p[i] is in the set, for i < min(n, 64).
+uint64_t MatchMask64(const char* p, std::size_t n, const ByteSet& set);
+
+// The kernels MatchMask64 dispatches to, over 64 readable bytes; exposed for
+// test and benchmark. The simd versions must only be called when the cpu
+// supports them and for sets of 1 to 8 bytes.
+uint64_t MatchBlockScalar(const char* p, const ByteSet& set);
+
+#if defined(__x86_64__)
+uint64_t MatchBlockSSE2(const char* p, const ByteSet& set);
+uint64_t MatchBlockAVX2(const char* p, const ByteSet& set);
+#endif
+
+// Index of the first byte of p[0, n) in the set, or not in it; n if none.
+std::size_t FindAnyOf(const char* p, std::size_t n, const ByteSet& set);
+std::size_t FindNotOf(const char* p, std::size_t n, const ByteSet& set);
+
+// the bits of mask above bit i
+inline uint64_t BitsAbove(uint64_t mask, unsigned i) {
+    return mask & ~((2ULL << i) - 1);
+}
+
+}  // end of namespace internal
+
+// Index of the first char of s at or after pos that is one of chars,
+// kStringNpos if none.
+inline std::size_t StringFindAnyOf(const Slice& s, const Slice& chars, std::size_t pos = 0) {
+    if (pos >= s.Size()) {
+        return kStringNpos;
+    }
+    const std::size_t i = internal::FindAnyOf(s.Data() + pos, s.Size() - pos,
+                                              internal::ByteSet(chars));
+    return pos + i == s.Size() ? kStringNpos : pos + i;
+}
+
+// Index of the first char of s at or after pos that is none of chars,
+// kStringNpos if none.
+inline std::size_t StringFindNotOf(const Slice& s, const Slice& chars, std::size_t pos = 0) {
+    if (pos >= s.Size()) {
+        return kStringNpos;
+    }
+    const std::size_t i = internal::FindNotOf(s.Data() + pos, s.Size() - pos,
+                                              internal::ByteSet(chars));
+    return pos + i == s.Size() ? kStringNpos : pos + i;
+}
+
+// s without the chars of chars at its front, its back or both.
+inline Slice StringTrimLeft(const Slice& s, const Slice& chars = Slice(" \t\r\n\f\v")) {
+    const internal::ByteSet set(chars);
+    std::size_t begin = 0;
+    while (begin < s.Size() && set.Contains(s.Data()[begin])) {
+        ++begin;
+    }
+    return Slice(s.Data() + begin, s.Size() - begin);
+}
+
+inline Slice StringTrimRight(const Slice& s, const Slice& chars = Slice(" \t\r\n\f\v")) {
+    const internal::ByteSet set(chars);
+    std::size_t end = s.Size();
+    while (end > 0 && set.Contains(s.Data()[end - 1])) {
+        --end;
+    }
+    return Slice(s.Data(), end);
+}
+
+inline Slice StringTrim(const Slice& s, const Slice& chars = Slice(" \t\r\n\f\v")) {
+    return StringTrimRight(StringTrimLeft(s, chars), chars);
+}
+
+// Calls func(const Slice&) on every token of str: the runs of chars that
+// are not in seps, empty tokens are dropped. The separators of 64 bytes are
+// found at once, tokens are walked by their bits.
+template <typename Func>
+void ForEachToken(const Slice& seps, const Slice& str, Func func) {
+    const internal::ByteSet set(seps);
+    const char* p = str.Data();
+    const std::size_t n = str.Size();
+    std::size_t begin = kStringNpos;  // of the token being walked
+    for (std::size_t base = 0; base < n; base += 64) {
+        const std::size_t len = n - base < 64 ? n - base : 64;
+        const uint64_t valid = len == 64 ? ~0ULL : (1ULL << len) - 1;
+        const uint64_t sep_bits = internal::MatchMask64(p + base, len, set);
+        uint64_t chars = ~sep_bits & valid;
+        uint64_t ends = sep_bits;
+        for (;;) {
+            if (begin == kStringNpos) {
+                if (chars == 0) {
+                    break;
+                }
+                const unsigned i = __builtin_ctzll(chars);
+                begin = base + i;
+                ends = internal::BitsAbove(ends, i);
+            } else {
+                if (ends == 0) {
+                    break;
+                }
+                const unsigned i = __builtin_ctzll(ends);
+                func(Slice(p + begin, base + i - begin));
+                begin = kStringNpos;
+                chars = internal::BitsAbove(chars, i);
+            }
+        }
+    }
+    if (begin != kStringNpos) {
+        func(Slice(p + begin, n - begin));
+    }
+}
+
+// Calls func(const Slice&) on every field of str between single separators,
+// empty fields included: "a,,b" has the fields a, "" and b.
+template <typename Func>
+void ForEachField(const Slice& seps, const Slice& str, Func func) {
+    const internal::ByteSet set(seps);
+    const char* p = str.Data();
+    const std::size_t n = str.Size();
+    std::size_t begin = 0;
+    for (std::size_t base = 0; base < n; base += 64) {
+        const std::size_t len = n - base < 64 ? n - base : 64;
+        uint64_t sep_bits = internal::MatchMask64(p + base, len, set);
+        while (sep_bits != 0) {
+            const std::size_t end = base + __builtin_ctzll(sep_bits);
+            func(Slice(p + begin, end - begin));
+            begin = end + 1;
+            sep_bits &= sep_bits - 1;
+        }
+    }
+    func(Slice(p + begin, n - begin));
+}
+
+// The tokens of str into *out, see ForEachToken. Reusing out saves the
+// allocations once it has grown; Vector is std::vector<Slice>, or a
+// SmallVector<Slice, N> (container/small_vector.h) that needs none for up
+// to N tokens.
+template <typename Vector>
+void StringSplit(const Slice& seps, const Slice& str, Vector* out) {
+    out->clear();
+    ForEachToken(seps, str, [out](const Slice& token) { out->push_back(token); });
+}
+
+// The fields of str into *out, see ForEachField.
+template <typename Vector>
+void StringSplitFields(const Slice& seps, const Slice& str, Vector* out) {
+    out->clear();
+    ForEachField(seps, str, [out](const Slice& field) { out->push_back(field); });
+}
+
+// Split str by any char of sep into *out, empty tokens are dropped. The
+// tokens are copies: std::string, or a Buffer (container/buffer.h) that
+// keeps short ones without allocation.
+template <typename Vector>
+void StringSplit(const std::string& sep, const std::string& str, Vector* out) {
+    out->clear();
+    ForEachToken(Slice(sep), Slice(str), [out](const Slice& token) {
+        out->emplace_back(token.Data(), token.Size());
+    });
+}
+
+}  // end of namespace cg
@@ -0,0 +1,311 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "include/log.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "log/binary_log_format.h"
+#include "log/log_ring.h"
+
+namespace cg {
+namespace {
+
+int64_t nowNs(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// ticks of BinaryLogTick per ns, measured once over 10ms
+double tickRate() {
+    static const double rate = [] {
+        const uint64_t tick = internal::BinaryLogTick();
+        const int64_t ns = nowNs(CLOCK_MONOTONIC);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return static_cast<double>(internal::BinaryLogTick() - tick)
+            / static_cast<double>(nowNs(CLOCK_MONOTONIC) - ns);
+    }();
+    return rate;
+}
+
+template <typename T>
+void put(std::string* out, T v) {
+    out->append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+struct Site {
+    const char* file;
+    int line;
+    LogLevel level;
+    const char* format;
+    const char* types;
+};
+
+// Same threading as the LogWriter of log.cc: one ring per thread, one thread
+// writing them out. The writer drops the padding left where a record did not
+// fit before the end of a ring and writes what is left of each ring as a
+// chunk, after the sites the records refer to.
+class BinaryLogWriter : public LogRingWriter {
+public:
+    // never destroyed: threads may log while static destructors run
+    static BinaryLogWriter* Instance() {
+        static BinaryLogWriter* writer = new BinaryLogWriter;
+        return writer;
+    }
+
+    bool Init(const LogConfig& config);
+
+    uint32_t RegisterSite(const Site& site);
+
+private:
+    BinaryLogWriter();
+
+    static void stopAtExit() {
+        Instance()->Stop();
+    }
+
+    void writeRanges(const std::vector<LogRingRange>& ranges) override;
+
+    // [begin, end) of a ring as at most two iovecs
+    void addRange(LogRing* ring, uint64_t begin, uint64_t end);
+
+    void appendSites();
+
+private:
+    std::mutex sites_mu_;
+    std::vector<Site> sites_;  // id i + 1 at i
+
+    std::mutex io_mu_;  // fd_ and the state of the current file
+    int fd_;            // -1 discards
+    std::size_t sites_written_;
+    int64_t last_sync_ns_;  // 0 to sync in the next round
+
+    // used by the writer only
+    std::vector<struct iovec> iov_;
+    std::vector<std::array<char, 9>> chunks_;
+    std::string meta_;
+};
+
+BinaryLogWriter::BinaryLogWriter() : fd_(-1), sites_written_(0), last_sync_ns_(0) {
+    start();
+    atexit(&BinaryLogWriter::stopAtExit);
+}
+
+bool BinaryLogWriter::Init(const LogConfig& config) {
+    int fd = -1;
+    if (!config.path.empty()) {
+        fd = open(config.path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        std::string header;
+        header.push_back(static_cast<char>(BINARY_LOG_HEADER));
+        header.append(kBinaryLogMagic, kBinaryLogMagicSize);
+        put(&header, tickRate());
+        if (write(fd, header.data(), header.size()) != static_cast<ssize_t>(header.size())) {
+            close(fd);
+            return false;
+        }
+    }
+    configure(config);
+    std::lock_guard<std::mutex> guard(io_mu_);
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+    fd_ = fd;
+    sites_written_ = 0;
+    last_sync_ns_ = 0;
+    return true;
+}
+
+uint32_t BinaryLogWriter::RegisterSite(const Site& site) {
+    std::lock_guard<std::mutex> guard(sites_mu_);
+    sites_.push_back(site);
+    return static_cast<uint32_t>(sites_.size());
+}
+
+void BinaryLogWriter::addRange(LogRing* ring, uint64_t begin, uint64_t end) {
+    const std::size_t pos = begin & (ring->capacity - 1);
+    const std::size_t n = end - begin;
+    const std::size_t first = std::min(n, ring->capacity - pos);
+    if (first > 0) {
+        iov_.push_back(iovec{ring->data + pos, first});
+    }
+    if (first < n) {
+        iov_.push_back(iovec{ring->data, n - first});
+    }
+}
+
+void BinaryLogWriter::appendSites() {
+    std::lock_guard<std::mutex> guard(sites_mu_);
+    for (; sites_written_ < sites_.size(); ++sites_written_) {
+        const Site& site = sites_[sites_written_];
+        const std::size_t file = strlen(site.file);
+        const std::size_t types = strlen(site.types);
+        const std::size_t format = strlen(site.format);
+        meta_.push_back(static_cast<char>(BINARY_LOG_SITE));
+        put(&meta_, static_cast<uint32_t>(sites_written_ + 1));
+        put(&meta_, static_cast<uint8_t>(site.level));
+        put(&meta_, static_cast<uint32_t>(site.line));
+        put(&meta_, static_cast<uint16_t>(file));
+        put(&meta_, static_cast<uint16_t>(types));
+        put(&meta_, static_cast<uint32_t>(format));
+        meta_.append(site.file, file);
+        meta_.append(site.types, types);
+        meta_.append(site.format, format);
+    }
+}
+
+void BinaryLogWriter::writeRanges(const std::vector<LogRingRange>& ranges) {
+    iov_.clear();
+    chunks_.resize(ranges.size());
+    // iov_[0] is left for meta_, filled once the records are known
+    iov_.push_back(iovec{nullptr, 0});
+    for (std::size_t i = 0; i < ranges.size(); ++i) {
+        LogRing* ring = ranges[i].ring;
+        const uint64_t head = ranges[i].head;
+        std::array<char, 9>& chunk = chunks_[i];
+        iov_.push_back(iovec{chunk.data(), chunk.size()});
+        // site 0 pads the end of the ring, the next record is at its start
+        uint64_t bytes = 0;
+        uint64_t begin = ranges[i].tail;
+        uint64_t t = begin;
+        while (t < head) {
+            const std::size_t pos = t & (ring->capacity - 1);
+            uint32_t header[2];
+            memcpy(header, ring->data + pos, sizeof(header));
+            if (header[0] == 0) {
+                addRange(ring, begin, t);
+                bytes += t - begin;
+                t += ring->capacity - pos;
+                begin = t;
+            } else {
+                t += BinaryRecordSize(header[1]);
+            }
+        }
+        addRange(ring, begin, head);
+        bytes += head - begin;
+        chunk[0] = static_cast<char>(BINARY_LOG_CHUNK);
+        const uint32_t fields[2] = {static_cast<uint32_t>(ring->tid), static_cast<uint32_t>(bytes)};
+        memcpy(chunk.data() + 1, fields, sizeof(fields));
+    }
+    uint64_t bytes = 0;
+    uint64_t writes = 0;
+    {
+        std::lock_guard<std::mutex> guard(io_mu_);
+        if (fd_ >= 0) {
+            // the sites of every record seen above are registered by now
+            meta_.clear();
+            appendSites();
+            const int64_t now = nowNs(CLOCK_MONOTONIC_COARSE);
+            if (last_sync_ns_ == 0 || now - last_sync_ns_ >= 1000000000) {
+                meta_.push_back(static_cast<char>(BINARY_LOG_SYNC));
+                put(&meta_, internal::BinaryLogTick());
+                put(&meta_, nowNs(CLOCK_REALTIME));
+                last_sync_ns_ = now;
+            }
+            iov_[0] = iovec{&meta_[0], meta_.size()};
+            // on an error there is nowhere to report it, the records are lost
+            LogWriteAll(fd_, iov_.data(), static_cast<int>(iov_.size()), &bytes, &writes);
+        }
+    }
+    addWritten(bytes, writes);
+}
+
+// ring of the calling thread and what it knows of it
+struct BinaryRingHolder {
+    LogRing* ring;
+    uint64_t tail;  // last tail read, the ring has at least that much room
+    uint64_t next;  // head after the reserved record
+
+    BinaryRingHolder() : ring(nullptr), tail(0), next(0) {}
+
+    ~BinaryRingHolder() {
+        if (ring != nullptr) {
+            ring->closed.store(true, std::memory_order_release);
+        }
+    }
+};
+
+BinaryRingHolder& threadRing() {
+    static thread_local BinaryRingHolder holder;
+    if (UNLIKELY(holder.ring == nullptr)) {
+        holder.ring = BinaryLogWriter::Instance()->NewRing();
+    }
+    return holder;
+}
+
+}  // end of anonymous namespace
+
+namespace internal {
+
+uint32_t RegisterBinaryLogSite(const char* file, int line, LogLevel level,
+                               const char* format, const char* types) {
+    return BinaryLogWriter::Instance()->RegisterSite(Site{file, line, level, format, types});
+}
+
+char* BinaryLogReserve(std::size_t n) {
+    BinaryRingHolder& holder = threadRing();
+    LogRing* ring = holder.ring;
+    n = (n + 7) & ~static_cast<std::size_t>(7);
+    const uint64_t head = ring->head.load(std::memory_order_relaxed);
+    const std::size_t pos = head & (ring->capacity - 1);
+    // a record never wraps, the rest of the ring is skipped instead
+    const std::size_t skip = n <= ring->capacity - pos ? 0 : ring->capacity - pos;
+    if (UNLIKELY(head + skip + n - holder.tail > ring->capacity)) {
+        // a record the ring cannot hold even empty is dropped at once
+        if (skip + n > ring->capacity
+            || !BinaryLogWriter::Instance()->WaitRoom(ring, head + skip + n, false,
+                                                      &holder.tail)) {
+            LogRing::Bump(&ring->dropped);
+            return nullptr;
+        }
+    }
+    if (skip != 0) {
+        const uint32_t padding = 0;
+        memcpy(ring->data + pos, &padding, sizeof(padding));
+    }
+    holder.next = head + skip + n;
+    return ring->data + ((head + skip) & (ring->capacity - 1));
+}
+
+void BinaryLogCommit() {
+    BinaryRingHolder& holder = threadRing();
+    holder.ring->head.store(holder.next, std::memory_order_release);
+    LogRing::Bump(&holder.ring->lines);
+    BinaryLogWriter::Instance()->AfterPush();
+}
+
+void BinaryLogFatal() {
+    FlushBinaryLog();
+    abort();
+}
+
+}  // end of namespace internal
+
+bool InitBinaryLog(const LogConfig& config) {
+    return BinaryLogWriter::Instance()->Init(config);
+}
+
+void FlushBinaryLog() {
+    BinaryLogWriter::Instance()->Flush();
+}
+
+LogStats GetBinaryLogStats() {
+    return BinaryLogWriter::Instance()->Stats();
+}
+
+}  // end of namespace cg
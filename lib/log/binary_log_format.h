@@ -0,0 +1,39 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace cg {
+
+// A binary log is a sequence of entries, each led by its kind byte; numbers
+// are in the byte order of the machine that wrote them.
+//
+//   header  0x7f "CGBLOG1" | double ticks per ns
+//           starts the file and every InitBinaryLog after, site ids restart
+//   site    'S' | u32 id | u8 level | u32 line | u16 n file | u16 n types
+//               | u32 n format | file | types | format
+//           written before the first record of the site, id 0 is unused
+//   sync    'T' | u64 tick | i64 unix ns
+//           a tick read together with the wall clock, once a second
+//   chunk   'C' | u32 tid | u32 n | n bytes of records
+//           records of one thread, each 8 byte aligned:
+//           u32 site | u32 n | u64 tick | n bytes of arguments
+enum BinaryLogEntry {
+    BINARY_LOG_HEADER = 0x7f,
+    BINARY_LOG_SITE = 'S',
+    BINARY_LOG_SYNC = 'T',
+    BINARY_LOG_CHUNK = 'C',
+};
+
+const char kBinaryLogMagic[] = "CGBLOG1";
+const int kBinaryLogMagicSize = 7;
+
+// whole size of a record with n bytes of arguments
+inline uint64_t BinaryRecordSize(uint64_t n) {
+    return (16 + n + 7) & ~static_cast<uint64_t>(7);
+}
+
+}  // end of namespace cg
@@ -0,0 +1,215 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "include/log.h"
+
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "log/log_decoder.h"
+
+namespace cg {
+namespace unittest {
+
+class BinaryLogTest : public ::testing::Test {
+protected:
+    static void SetUpTestCase() {
+        path_ = "/tmp/cg_binary_log_test_" + std::to_string(getpid()) + ".blog";
+        unlink(path_.c_str());
+        ASSERT_TRUE(InitBinaryLog(config(1 << 20)));
+    }
+
+    static void TearDownTestCase() {
+        InitBinaryLog(LogConfig());
+        unlink(path_.c_str());
+    }
+
+    void SetUp() {
+        SetMinLogLevel(LOG_LEVEL_INFO);
+    }
+
+    static LogConfig config(std::size_t buffer_size) {
+        LogConfig config;
+        config.path = path_;
+        config.buffer_size = buffer_size;
+        return config;
+    }
+
+    static std::string read(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+
+    static std::string decode(const std::string& data) {
+        LogDecoder decoder;
+        std::string text;
+        const std::size_t used = decoder.Decode(data.data(), data.size(), &text);
+        EXPECT_TRUE(decoder.Ok()) << decoder.Error();
+        EXPECT_EQ(data.size(), used);
+        return text;
+    }
+
+    // decoded lines of the log file containing marker
+    static std::vector<std::string> lines(const std::string& marker) {
+        FlushBinaryLog();
+        std::istringstream text(decode(read(path_)));
+        std::vector<std::string> result;
+        std::string line;
+        while (std::getline(text, line)) {
+            if (line.find(marker) != std::string::npos) {
+                result.push_back(line);
+            }
+        }
+        return result;
+    }
+
+    static std::string path_;
+};
+
+std::string BinaryLogTest::path_;
+
+TEST_F(BinaryLogTest, Basic) {
+    const std::string s = "str";
+    BLOG(INFO, "basic marker %d %s %.2f %u %lld %c", -5, s.c_str(), 1.5, 7u, 1LL << 40, 'x');
+    BLOG(WARN, "basic marker warn");
+    auto result = lines("basic marker");
+    ASSERT_EQ(2U, result.size());
+    EXPECT_NE(std::string::npos,
+              result[0].find(" binary_log_test.cc:" + std::to_string(__LINE__ - 5)
+                             + "] basic marker -5 str 1.50 7 1099511627776 x"));
+    EXPECT_EQ('I', result[0][0]);
+    EXPECT_EQ('W', result[1][0]);
+
+    // the tick is turned back into the wall clock
+    time_t now = time(nullptr);
+    struct tm stm;
+    localtime_r(&now, &stm);
+    char day[16];
+    strftime(day, sizeof(day), "I%Y%m%d", &stm);
+    EXPECT_EQ(day, result[0].substr(0, 9));
+}
+
+TEST_F(BinaryLogTest, Level) {
+    int evaluated = 0;
+    auto touch = [&evaluated] {
+        return ++evaluated;
+    };
+    BLOG(DEBUG, "level marker %d", touch());
+    EXPECT_EQ(0, evaluated);
+    SetMinLogLevel(LOG_LEVEL_ALL);
+    BLOG(DEBUG, "level marker %d", touch());
+    EXPECT_EQ(1, evaluated);
+    EXPECT_EQ(1U, lines("level marker").size());
+}
+
+TEST_F(BinaryLogTest, Threads) {
+    // a small ring wraps and pads its end all the time
+    ASSERT_TRUE(InitBinaryLog(config(4096)));
+    const int kThreads = 8;
+    const int kLines = 5000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([t] {
+            std::string pad;
+            for (int i = 0; i < kLines; ++i) {
+                pad.assign(i % 97, 'p');
+                BLOG(INFO, "thread marker %d %d %s end", t, i, pad.c_str());
+            }
+        });
+    }
+    for (auto& it : threads) {
+        it.join();
+    }
+    auto result = lines("thread marker");
+    ASSERT_EQ(static_cast<std::size_t>(kThreads * kLines), result.size());
+    std::vector<int> next(kThreads, 0);
+    for (const auto& it : result) {
+        std::istringstream in(it.substr(it.find("thread marker") + 14));
+        int t = -1;
+        int i = -1;
+        std::string pad;
+        std::string end;
+        in >> t >> i;
+        if (i % 97 != 0) {
+            in >> pad;
+        }
+        in >> end;
+        ASSERT_EQ("end", end) << it;
+        EXPECT_EQ(std::string(i % 97, 'p'), pad);
+        EXPECT_EQ(next[t]++, i);
+    }
+    ASSERT_TRUE(InitBinaryLog(config(1 << 20)));
+}
+
+TEST_F(BinaryLogTest, Pieces) {
+    for (int i = 0; i < 100; ++i) {
+        BLOG(INFO, "pieces marker %d", i);
+    }
+    FlushBinaryLog();
+    const std::string data = read(path_);
+    const std::string whole = decode(data);
+    // fed a few bytes at a time, the decoder keeps what it cannot use yet
+    LogDecoder decoder;
+    std::string text;
+    std::string pending;
+    for (std::size_t pos = 0; pos < data.size(); pos += 7) {
+        pending.append(data, pos, 7);
+        pending.erase(0, decoder.Decode(pending.data(), pending.size(), &text));
+        ASSERT_TRUE(decoder.Ok()) << decoder.Error();
+    }
+    EXPECT_EQ("", pending);
+    EXPECT_EQ(whole, text);
+}
+
+TEST_F(BinaryLogTest, Size) {
+    const LogStats before = GetBinaryLogStats();
+    for (int i = 0; i < 1000; ++i) {
+        BLOG(INFO, "size marker: request done, user=%d cost_us=%d", 123456, i);
+    }
+    FlushBinaryLog();
+    const LogStats after = GetBinaryLogStats();
+    EXPECT_EQ(1000U, after.lines - before.lines);
+    // 16 bytes of record header and 8 of arguments, against ~90 of text
+    EXPECT_GT(30 * 1000U, after.bytes - before.bytes);
+    EXPECT_EQ(1000U, lines("size marker").size());
+}
+
+TEST_F(BinaryLogTest, Drop) {
+    const LogStats before = GetBinaryLogStats();
+    std::thread([] {
+        std::string big(1 << 21, 'x');
+        BLOG(INFO, "drop marker %s", big.c_str());
+    }).join();
+    const LogStats after = GetBinaryLogStats();
+    EXPECT_EQ(1U, after.dropped - before.dropped);
+    EXPECT_EQ(0U, lines("drop marker").size());
+}
+
+TEST_F(BinaryLogTest, Fatal) {
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    // no pid in the name: the child of a threadsafe death test has its own
+    const std::string path = "/tmp/cg_binary_log_test_fatal.blog";
+    unlink(path.c_str());
+    LogConfig fatal;
+    fatal.path = path;
+    EXPECT_DEATH({
+        InitBinaryLog(fatal);
+        BLOG(FATAL, "fatal marker %d", 7);
+    }, "");
+    EXPECT_NE(std::string::npos, decode(read(path)).find("] fatal marker 7\n"));
+    unlink(path.c_str());
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
@@ -0,0 +1,267 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "include/log.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include "log/log_ring.h"
+#include "thread/this_thread.h"
+
+namespace cg {
+namespace internal {
+
+std::atomic<int> g_min_log_level(LOG_LEVEL_INFO);
+
+bool LogEveryMs(std::atomic<int64_t>* last, int64_t ms) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    // +1 so that the first call, with last still 0, always passes
+    const int64_t now = static_cast<int64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000 + 1;
+    int64_t prev = last->load(std::memory_order_relaxed);
+    return (prev == 0 || now - prev >= ms)
+        && last->compare_exchange_strong(prev, now, std::memory_order_relaxed);
+}
+
+}  // end of namespace internal
+
+namespace {
+
+// Writes the lines of the rings as they are.
+class LogWriter : public LogRingWriter {
+public:
+    // never destroyed: threads may log while static destructors run
+    static LogWriter* Instance() {
+        static LogWriter* writer = new LogWriter;
+        return writer;
+    }
+
+    bool Init(const LogConfig& config);
+
+    void Push(LogRing* ring, const char* p, std::size_t n, bool fatal);
+
+private:
+    LogWriter();
+
+    static void stopAtExit() {
+        Instance()->Stop();
+    }
+
+    // straight to the file, for when the rings are of no use
+    void writeDirect(const char* p, std::size_t n);
+
+    void writeRanges(const std::vector<LogRingRange>& ranges) override;
+
+private:
+    std::mutex io_mu_;  // fd_ and the writev calls
+    int fd_;
+
+    // used by the writer only
+    std::vector<struct iovec> iov_;
+};
+
+LogWriter::LogWriter() : fd_(STDERR_FILENO) {
+    start();
+    atexit(&LogWriter::stopAtExit);
+}
+
+bool LogWriter::Init(const LogConfig& config) {
+    int fd = STDERR_FILENO;
+    if (!config.path.empty()) {
+        fd = open(config.path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+    }
+    configure(config);
+    std::lock_guard<std::mutex> guard(io_mu_);
+    if (fd_ != STDERR_FILENO) {
+        close(fd_);
+    }
+    fd_ = fd;
+    return true;
+}
+
+void LogWriter::Push(LogRing* ring, const char* p, std::size_t n, bool fatal) {
+    if (UNLIKELY(Stopped() || n > ring->capacity)) {
+        // no writer anymore, or a line the ring cannot hold
+        writeDirect(p, n);
+        return;
+    }
+    const uint64_t head = ring->head.load(std::memory_order_relaxed);
+    uint64_t tail = ring->tail.load(std::memory_order_acquire);
+    if (UNLIKELY(head + n - tail > ring->capacity)
+        && !WaitRoom(ring, head + n, fatal, &tail)) {
+        if (Stopped()) {
+            writeDirect(p, n);
+        } else {
+            LogRing::Bump(&ring->dropped);
+        }
+        return;
+    }
+    const std::size_t pos = head & (ring->capacity - 1);
+    const std::size_t first = std::min(n, ring->capacity - pos);
+    memcpy(ring->data + pos, p, first);
+    memcpy(ring->data, p + first, n - first);
+    ring->head.store(head + n, std::memory_order_release);
+    LogRing::Bump(&ring->lines);
+    AfterPush();
+}
+
+void LogWriter::writeDirect(const char* p, std::size_t n) {
+    std::lock_guard<std::mutex> guard(io_mu_);
+    ssize_t r = write(fd_, p, n);
+    (void)r;
+}
+
+void LogWriter::writeRanges(const std::vector<LogRingRange>& ranges) {
+    iov_.clear();
+    for (const auto& it : ranges) {
+        LogRing* ring = it.ring;
+        const std::size_t pos = it.tail & (ring->capacity - 1);
+        const std::size_t n = it.head - it.tail;
+        const std::size_t first = std::min(n, ring->capacity - pos);
+        iov_.push_back(iovec{ring->data + pos, first});
+        if (first < n) {
+            iov_.push_back(iovec{ring->data, n - first});
+        }
+    }
+    uint64_t bytes = 0;
+    uint64_t writes = 0;
+    {
+        std::lock_guard<std::mutex> guard(io_mu_);
+        // on an error there is nowhere to report it, the lines are lost
+        LogWriteAll(fd_, iov_.data(), static_cast<int>(iov_.size()), &bytes, &writes);
+    }
+    addWritten(bytes, writes);
+}
+
+struct RingHolder {
+    LogRing* ring;
+
+    RingHolder() : ring(nullptr) {}
+
+    ~RingHolder() {
+        if (ring != nullptr) {
+            ring->closed.store(true, std::memory_order_release);
+        }
+    }
+};
+
+LogRing* threadRing() {
+    static thread_local RingHolder holder;
+    if (UNLIKELY(holder.ring == nullptr)) {
+        holder.ring = LogWriter::Instance()->NewRing();
+    }
+    return holder.ring;
+}
+
+// "20261018 10:20:30" of the current second, rebuilt once a second per thread
+struct TimeCache {
+    time_t second;
+    char text[17];
+
+    TimeCache() : second(-1) {}
+
+    static char* put2(char* p, int v) {
+        p[0] = static_cast<char>('0' + v / 10);
+        p[1] = static_cast<char>('0' + v % 10);
+        return p + 2;
+    }
+
+    const char* Format(time_t now) {
+        if (now != second) {
+            struct tm stm;
+            localtime_r(&now, &stm);
+            const int year = stm.tm_year + 1900;
+            char* p = put2(put2(text, year / 100), year % 100);
+            p = put2(put2(p, stm.tm_mon + 1), stm.tm_mday);
+            *p++ = ' ';
+            p = put2(p, stm.tm_hour);
+            *p++ = ':';
+            p = put2(p, stm.tm_min);
+            *p++ = ':';
+            p = put2(p, stm.tm_sec);
+            *p = '\0';
+            second = now;
+        }
+        return text;
+    }
+};
+
+}  // end of anonymous namespace
+
+const std::size_t LogStream::kInlineSize;
+
+void LogStream::appendSlow(const char* p, std::size_t n) {
+    if (heap_.empty()) {
+        heap_.reserve(2 * (size_ + n));
+        heap_.assign(buf_, size_);
+    }
+    heap_.append(p, n);
+}
+
+LogStream& LogStream::operator<<(double v) {
+    char buf[32];
+    int n = snprintf(buf, sizeof(buf), "%.17g", v);
+    Append(buf, static_cast<std::size_t>(n));
+    return *this;
+}
+
+LogStream& LogStream::operator<<(const void* p) {
+    char buf[24];
+    int n = snprintf(buf, sizeof(buf), "%p", p);
+    Append(buf, static_cast<std::size_t>(n));
+    return *this;
+}
+
+// I20261018 10:20:30.123456 4242 file.cc:42] message
+LogMessage::LogMessage(const char* file, int line, LogLevel level) : level_(level) {
+    static thread_local TimeCache cache;
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    stream_ << "ADIWEF"[level] << cache.Format(ts.tv_sec) << '.';
+    char usec[6];
+    uint32_t us = static_cast<uint32_t>(ts.tv_nsec / 1000);
+    for (int i = 5; i >= 0; --i) {
+        usec[i] = static_cast<char>('0' + us % 10);
+        us /= 10;
+    }
+    stream_.Append(usec, sizeof(usec));
+    stream_ << ' ' << ThisThread::Tid() << ' ' << file << ':' << line << "] ";
+}
+
+LogMessage::~LogMessage() {
+    stream_ << '\n';
+    LogWriter* writer = LogWriter::Instance();
+    const bool fatal = level_ == LOG_LEVEL_FATAL;
+    writer->Push(threadRing(), stream_.Data(), stream_.Size(), fatal);
+    if (UNLIKELY(fatal)) {
+        writer->Flush();
+        abort();
+    }
+}
+
+bool InitLogging(const LogConfig& config) {
+    return LogWriter::Instance()->Init(config);
+}
+
+void FlushLog() {
+    LogWriter::Instance()->Flush();
+}
+
+LogStats GetLogStats() {
+    return LogWriter::Instance()->Stats();
+}
+
+}  // end of namespace cg
@@ -0,0 +1,138 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <stdio.h>
+#include <time.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "include/log.h"
+
+namespace cg {
+namespace {
+
+int64_t nowNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// Times every 16th call and reports the tail latency of the thread, averaged
+// over the threads; the other calls keep the clock out of the mean.
+template <typename Func>
+void measure(benchmark::State& state, Func func) {
+    std::vector<int64_t> samples;
+    samples.reserve(1 << 16);
+    int i = 0;
+    for (auto _ : state) {
+        if ((i & 15) != 0 || samples.size() == samples.capacity()) {
+            func(i++);
+            continue;
+        }
+        const int64_t begin = nowNs();
+        func(i++);
+        samples.push_back(nowNs() - begin);
+    }
+    std::sort(samples.begin(), samples.end());
+    auto at = [&samples](double q) {
+        return samples.empty() ? 0.0 : static_cast<double>(samples[samples.size() * q]);
+    };
+    state.counters["p50_ns"] = benchmark::Counter(at(0.5), benchmark::Counter::kAvgThreads);
+    state.counters["p99_ns"] = benchmark::Counter(at(0.99), benchmark::Counter::kAvgThreads);
+    state.counters["p999_ns"] = benchmark::Counter(at(0.999), benchmark::Counter::kAvgThreads);
+    state.SetItemsProcessed(state.iterations());
+}
+
+// bytes each line took in the file, over the lines of the whole run
+void bytesPerLine(benchmark::State& state, const LogStats& before, const LogStats& after) {
+    if (after.lines > before.lines) {
+        state.counters["bytes_per_line"] = static_cast<double>(after.bytes - before.bytes)
+            / static_cast<double>(after.lines - before.lines);
+    }
+}
+
+void initLogging() {
+    static bool done = false;
+    if (!done) {
+        LogConfig config;
+        config.path = "/dev/null";
+        InitLogging(config);
+        InitBinaryLog(config);
+        done = true;
+    }
+}
+
+void BM_Log(benchmark::State& state) {
+    LogStats before;
+    if (state.thread_index() == 0) {
+        initLogging();
+        before = GetLogStats();
+    }
+    measure(state, [](int i) {
+        LOG(INFO) << "request done, user=" << 123456 << " cost_us=" << i << " ok=" << true;
+    });
+    if (state.thread_index() == 0) {
+        FlushLog();
+        bytesPerLine(state, before, GetLogStats());
+    }
+}
+
+void BM_LogDisabled(benchmark::State& state) {
+    measure(state, [](int i) {
+        LOG(DEBUG) << "request done, user=" << 123456 << " cost_us=" << i << " ok=" << true;
+    });
+}
+
+void BM_BinaryLog(benchmark::State& state) {
+    LogStats before;
+    if (state.thread_index() == 0) {
+        initLogging();
+        before = GetBinaryLogStats();
+    }
+    measure(state, [](int i) {
+        BLOG(INFO, "request done, user=%d cost_us=%d ok=%d", 123456, i, true);
+    });
+    if (state.thread_index() == 0) {
+        FlushBinaryLog();
+        bytesPerLine(state, before, GetBinaryLogStats());
+    }
+}
+
+void BM_BinaryLogDisabled(benchmark::State& state) {
+    measure(state, [](int i) {
+        BLOG(DEBUG, "request done, user=%d cost_us=%d ok=%d", 123456, i, true);
+    });
+}
+
+// what LOG() used to be: an ostream written synchronously
+void BM_Ostream(benchmark::State& state) {
+    static std::ofstream out("/dev/null");
+    static std::mutex mu;
+    measure(state, [](int i) {
+        std::lock_guard<std::mutex> guard(mu);
+        out << "request done, user=" << 123456 << " cost_us=" << i << " ok=" << true << std::endl;
+    });
+}
+
+void BM_Fprintf(benchmark::State& state) {
+    static FILE* out = fopen("/dev/null", "w");
+    measure(state, [](int i) {
+        fprintf(out, "request done, user=%d cost_us=%d ok=%s\n", 123456, i, "true");
+    });
+}
+
+BENCHMARK(BM_Log)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_LogDisabled)->Threads(1)->Threads(16)->UseRealTime();
+BENCHMARK(BM_BinaryLog)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_BinaryLogDisabled)->Threads(1)->Threads(16)->UseRealTime();
+BENCHMARK(BM_Ostream)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_Fprintf)->ThreadRange(1, 16)->UseRealTime();
+
+}  // end of anonymous namespace
+}  // end of namespace cg
@@ -0,0 +1,373 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "log/log_decoder.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "include/log.h"
+#include "log/binary_log_format.h"
+
+namespace cg {
+namespace {
+
+template <typename T>
+T get(const char* p) {
+    T v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+const std::size_t kHeaderSize = 1 + kBinaryLogMagicSize + sizeof(double);
+const std::size_t kSiteSize = 1 + 4 + 1 + 4 + 2 + 2 + 4;  // without the strings
+const std::size_t kSyncSize = 1 + 8 + 8;
+const std::size_t kChunkSize = 1 + 4 + 4;  // without the records
+
+// One argument of a record, read by the conversions of the format.
+class ArgReader {
+public:
+    ArgReader(const std::string& types, const char* args, std::size_t n)
+        : types_(types), args_(args), n_(n), next_(0), pos_(0) {}
+
+    bool Integer(int64_t* v) {
+        if (!has(1)) {
+            return false;
+        }
+        switch (types_[next_]) {
+        case 'i':
+            return read<int32_t>(v);
+        case 'I':
+            return read<int64_t>(v);
+        case 'u':
+            return read<uint32_t>(v);
+        case 'U':
+            return read<uint64_t>(v);
+        default:
+            return false;
+        }
+    }
+
+    bool Double(double* v) {
+        return has(1) && types_[next_] == 'd' && read<double>(v);
+    }
+
+    bool Pointer(uint64_t* v) {
+        return has(1) && types_[next_] == 'p' && read<uint64_t>(v);
+    }
+
+    bool String(std::string* v) {
+        if (!has(1) || types_[next_] != 's' || pos_ + 4 > n_) {
+            return false;
+        }
+        const uint32_t len = get<uint32_t>(args_ + pos_);
+        if (pos_ + 4 + len > n_) {
+            return false;
+        }
+        v->assign(args_ + pos_ + 4, len);
+        pos_ += 4 + len;
+        ++next_;
+        return true;
+    }
+
+private:
+    bool has(std::size_t count) const {
+        return next_ + count <= types_.size();
+    }
+
+    template <typename Stored, typename T>
+    bool read(T* v) {
+        if (pos_ + sizeof(Stored) > n_) {
+            return false;
+        }
+        *v = static_cast<T>(get<Stored>(args_ + pos_));
+        pos_ += sizeof(Stored);
+        ++next_;
+        return true;
+    }
+
+private:
+    const std::string& types_;
+    const char* args_;
+    std::size_t n_;
+    std::size_t next_;  // index in types_
+    std::size_t pos_;   // offset in args_
+};
+
+template <typename T>
+void appendFormatted(std::string* out, const std::string& spec, T v) {
+    char buf[128];
+    const int n = snprintf(buf, sizeof(buf), spec.c_str(), v);
+    if (n < 0) {
+        return;
+    }
+    if (static_cast<std::size_t>(n) < sizeof(buf)) {
+        out->append(buf, n);
+        return;
+    }
+    const std::size_t size = out->size();
+    out->resize(size + n + 1);
+    snprintf(&(*out)[size], n + 1, spec.c_str(), v);
+    out->resize(size + n);
+}
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+}  // end of anonymous namespace
+
+LogDecoder::LogDecoder() : ticks_per_ns_(0), sync_tick_(0), sync_ns_(0) {}
+
+bool LogDecoder::Format(const std::string& format, const std::string& types,
+                        const char* args, std::size_t n, std::string* out) {
+    ArgReader reader(types, args, n);
+    std::size_t i = 0;
+    while (i < format.size()) {
+        if (format[i] != '%') {
+            out->push_back(format[i++]);
+            continue;
+        }
+        if (i + 1 < format.size() && format[i + 1] == '%') {
+            out->push_back('%');
+            i += 2;
+            continue;
+        }
+        // rebuilt with the lengths the stored arguments have
+        std::string spec = "%";
+        ++i;
+        while (i < format.size() && strchr("-+ #0'", format[i]) != nullptr) {
+            spec.push_back(format[i++]);
+        }
+        for (int part = 0; part < 2; ++part) {
+            if (part == 1) {
+                if (i >= format.size() || format[i] != '.') {
+                    break;
+                }
+                spec.push_back(format[i++]);
+            }
+            if (i < format.size() && format[i] == '*') {
+                int64_t v;
+                if (!reader.Integer(&v)) {
+                    return false;
+                }
+                spec += std::to_string(v);
+                ++i;
+            }
+            while (i < format.size() && isDigit(format[i])) {
+                spec.push_back(format[i++]);
+            }
+        }
+        while (i < format.size() && strchr("hlLqjzt", format[i]) != nullptr) {
+            ++i;
+        }
+        if (i >= format.size()) {
+            return false;
+        }
+        const char conversion = format[i++];
+        int64_t integer;
+        double real;
+        uint64_t pointer;
+        std::string str;
+        switch (conversion) {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            if (!reader.Integer(&integer)) {
+                return false;
+            }
+            appendFormatted(out, spec + "ll" + conversion, static_cast<long long>(integer));
+            break;
+        case 'c':
+            if (!reader.Integer(&integer)) {
+                return false;
+            }
+            appendFormatted(out, spec + conversion, static_cast<int>(integer));
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            if (!reader.Double(&real)) {
+                return false;
+            }
+            appendFormatted(out, spec + conversion, real);
+            break;
+        case 's':
+            if (!reader.String(&str)) {
+                return false;
+            }
+            appendFormatted(out, spec + conversion, str.c_str());
+            break;
+        case 'p':
+            if (!reader.Pointer(&pointer)) {
+                return false;
+            }
+            appendFormatted(out, spec + conversion,
+                            reinterpret_cast<void*>(static_cast<uintptr_t>(pointer)));
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t LogDecoder::entrySize(const char* data, std::size_t n) {
+    switch (static_cast<unsigned char>(data[0])) {
+    case BINARY_LOG_HEADER:
+        return n < kHeaderSize ? 0 : kHeaderSize;
+    case BINARY_LOG_SITE:
+        if (n < kSiteSize) {
+            return 0;
+        }
+        return kSiteSize + get<uint16_t>(data + 10) + get<uint16_t>(data + 12)
+            + get<uint32_t>(data + 14);
+    case BINARY_LOG_SYNC:
+        return n < kSyncSize ? 0 : kSyncSize;
+    case BINARY_LOG_CHUNK:
+        return n < kChunkSize ? 0 : kChunkSize + get<uint32_t>(data + 5);
+    default:
+        error_ = "unknown entry " + std::to_string(static_cast<unsigned char>(data[0]));
+        return 0;
+    }
+}
+
+std::size_t LogDecoder::Decode(const char* data, std::size_t n, std::string* out) {
+    std::size_t used = 0;
+    while (used < n && Ok()) {
+        const std::size_t size = entrySize(data + used, n - used);
+        if (size == 0 || size > n - used) {
+            break;
+        }
+        if (!decodeEntry(data + used, size, out)) {
+            break;
+        }
+        used += size;
+    }
+    return used;
+}
+
+bool LogDecoder::decodeEntry(const char* data, std::size_t n, std::string* out) {
+    const int kind = static_cast<unsigned char>(data[0]);
+    if (kind != BINARY_LOG_HEADER && ticks_per_ns_ == 0) {
+        error_ = "no header";
+        return false;
+    }
+    switch (kind) {
+    case BINARY_LOG_HEADER:
+        if (memcmp(data + 1, kBinaryLogMagic, kBinaryLogMagicSize) != 0) {
+            error_ = "bad magic";
+            return false;
+        }
+        ticks_per_ns_ = get<double>(data + 1 + kBinaryLogMagicSize);
+        if (!(ticks_per_ns_ > 0)) {
+            error_ = "bad tick rate";
+            return false;
+        }
+        sites_.clear();
+        sync_tick_ = 0;
+        sync_ns_ = 0;
+        return true;
+    case BINARY_LOG_SITE: {
+        const uint32_t id = get<uint32_t>(data + 1);
+        if (id == 0 || id > (1U << 24)) {
+            error_ = "bad site id " + std::to_string(id);
+            return false;
+        }
+        if (sites_.size() <= id) {
+            sites_.resize(id + 1);
+        }
+        Site& site = sites_[id];
+        site.level = get<uint8_t>(data + 5);
+        site.line = static_cast<int>(get<uint32_t>(data + 6));
+        const char* p = data + kSiteSize;
+        site.file.assign(p, get<uint16_t>(data + 10));
+        p += site.file.size();
+        site.types.assign(p, get<uint16_t>(data + 12));
+        p += site.types.size();
+        site.format.assign(p, get<uint32_t>(data + 14));
+        if (site.level >= LOG_LEVEL_NUM) {
+            error_ = "bad level of site " + std::to_string(id);
+            return false;
+        }
+        return true;
+    }
+    case BINARY_LOG_SYNC:
+        sync_tick_ = get<uint64_t>(data + 1);
+        sync_ns_ = get<int64_t>(data + 9);
+        return true;
+    case BINARY_LOG_CHUNK: {
+        const int tid = static_cast<int>(get<uint32_t>(data + 1));
+        std::size_t pos = kChunkSize;
+        while (pos < n) {
+            if (n - pos < 16) {
+                error_ = "cut record";
+                return false;
+            }
+            const uint32_t site = get<uint32_t>(data + pos);
+            const uint32_t size = get<uint32_t>(data + pos + 4);
+            const uint64_t tick = get<uint64_t>(data + pos + 8);
+            const uint64_t record = BinaryRecordSize(size);
+            if (record > n - pos) {
+                error_ = "cut record";
+                return false;
+            }
+            if (!decodeRecord(tid, site, tick, data + pos + 16, size, out)) {
+                return false;
+            }
+            pos += record;
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool LogDecoder::decodeRecord(int tid, uint32_t id, uint64_t tick, const char* args,
+                              std::size_t n, std::string* out) {
+    if (id >= sites_.size() || sites_[id].file.empty()) {
+        error_ = "unknown site " + std::to_string(id);
+        return false;
+    }
+    const Site& site = sites_[id];
+    const int64_t ns = sync_ns_ + static_cast<int64_t>(
+            static_cast<double>(static_cast<int64_t>(tick - sync_tick_)) / ticks_per_ns_);
+    time_t second = static_cast<time_t>(ns / 1000000000);
+    int64_t nsec = ns % 1000000000;
+    if (nsec < 0) {
+        --second;
+        nsec += 1000000000;
+    }
+    struct tm stm;
+    localtime_r(&second, &stm);
+    char prefix[128];
+    const int len = snprintf(prefix, sizeof(prefix), "%c%04d%02d%02d %02d:%02d:%02d.%06d %d ",
+                             "ADIWEF"[site.level], stm.tm_year + 1900, stm.tm_mon + 1,
+                             stm.tm_mday, stm.tm_hour, stm.tm_min, stm.tm_sec,
+                             static_cast<int>(nsec / 1000), tid);
+    out->append(prefix, len);
+    out->append(site.file);
+    out->push_back(':');
+    out->append(std::to_string(site.line));
+    out->append("] ");
+    if (!Format(site.format, site.types, args, n, out)) {
+        error_ = "arguments do not match " + site.file + ":" + std::to_string(site.line);
+        return false;
+    }
+    out->push_back('\n');
+    return true;
+}
+
+}  // end of namespace cg
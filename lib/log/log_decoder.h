@@ -0,0 +1,68 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace cg {
+
+// Turns a binary log written by BLOG back into the text lines of LOG:
+//
+//   I20261018 10:20:30.123456 4242 file.cc:42] message
+//
+// Data may be fed in pieces of any size. Lines of a thread keep their order,
+// lines of different threads are grouped by the chunks the writer wrote.
+class LogDecoder {
+public:
+    LogDecoder();
+
+    // Decodes the whole entries at the front of data, appending their lines
+    // to out. Returns the bytes used, the rest is to be passed again with
+    // more data after it. Stops at a corrupt entry, see Ok.
+    std::size_t Decode(const char* data, std::size_t n, std::string* out);
+
+    bool Ok() const {
+        return error_.empty();
+    }
+
+    const std::string& Error() const {
+        return error_;
+    }
+
+    // Formats a printf format with the arguments of a record, types being
+    // the type chars of BinaryArg. False if the arguments do not match.
+    static bool Format(const std::string& format, const std::string& types,
+                       const char* args, std::size_t n, std::string* out);
+
+private:
+    struct Site {
+        int level;
+        int line;
+        std::string file;
+        std::string types;
+        std::string format;
+    };
+
+    // size of the entry at the front of data, 0 if not all there yet
+    std::size_t entrySize(const char* data, std::size_t n);
+
+    bool decodeEntry(const char* data, std::size_t n, std::string* out);
+
+    bool decodeRecord(int tid, uint32_t site, uint64_t tick, const char* args, std::size_t n,
+                      std::string* out);
+
+private:
+    std::vector<Site> sites_;  // id i at i
+    double ticks_per_ns_;
+    uint64_t sync_tick_;
+    int64_t sync_ns_;
+    std::string error_;
+};
+
+}  // end of namespace cg
@@ -0,0 +1,48 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+// log_decoder [binary log]: prints the text of a binary log written by BLOG,
+// reads stdin without a file.
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+
+#include "log/log_decoder.h"
+
+int main(int argc, char** argv) {
+    if (argc > 2 || (argc == 2 && strcmp(argv[1], "-h") == 0)) {
+        fprintf(stderr, "usage: %s [binary log]\n", argv[0]);
+        return 2;
+    }
+    FILE* in = argc == 2 ? fopen(argv[1], "rb") : stdin;
+    if (in == nullptr) {
+        fprintf(stderr, "log_decoder: cannot open %s: %s\n", argv[1], strerror(errno));
+        return 1;
+    }
+    cg::LogDecoder decoder;
+    std::string pending;
+    std::string text;
+    char buf[1 << 16];
+    std::size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0) {
+        pending.append(buf, n);
+        text.clear();
+        const std::size_t used = decoder.Decode(pending.data(), pending.size(), &text);
+        fwrite(text.data(), 1, text.size(), stdout);
+        if (!decoder.Ok()) {
+            fprintf(stderr, "log_decoder: %s\n", decoder.Error().c_str());
+            return 1;
+        }
+        pending.erase(0, used);
+    }
+    if (!pending.empty()) {
+        // the writer died in the middle of an entry
+        fprintf(stderr, "log_decoder: %zu bytes of a cut entry at the end\n", pending.size());
+    }
+    return 0;
+}
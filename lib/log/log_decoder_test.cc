@@ -0,0 +1,101 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "log/log_decoder.h"
+
+#include <stdio.h>
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "include/log.h"
+
+namespace cg {
+namespace unittest {
+
+class LogDecoderTest : public ::testing::Test {
+protected:
+    // formats the arguments the way BLOG stores them
+    template <typename... Args>
+    static std::string format(const std::string& format, const Args&... args) {
+        std::string types = internal::BinaryLogTypes(args...);
+        std::size_t size = 0;
+        const int sizes[] = {0, (size += internal::BinaryArgOf<Args>::Size(args), 0)...};
+        (void)sizes;
+        std::string data(size, '\0');
+        char* p = &data[0];
+        const int writes[] = {0, (p = internal::BinaryArgOf<Args>::Write(p, args), 0)...};
+        (void)writes;
+        (void)p;
+        std::string out;
+        if (!LogDecoder::Format(format, types, data.data(), data.size(), &out)) {
+            return "<mismatch>";
+        }
+        return out;
+    }
+};
+
+TEST_F(LogDecoderTest, Types) {
+    EXPECT_EQ("", std::string(internal::BinaryLogTypes()));
+    const char* s = "s";
+    char buf[4] = "abc";
+    int i = 0;
+    EXPECT_EQ("iIuUdpsssi", std::string(internal::BinaryLogTypes(
+            1, 2L, 3u, static_cast<uint64_t>(4), 5.0f, &i, s, "literal", buf, 'c')));
+}
+
+TEST_F(LogDecoderTest, Format) {
+    EXPECT_EQ("plain", format("plain"));
+    EXPECT_EQ("100%", format("100%%"));
+    EXPECT_EQ("-5 7 18446744073709551615 -9223372036854775808",
+              format("%d %u %llu %ld", -5, 7u, UINT64_MAX, INT64_MIN));
+    EXPECT_EQ("ff 0X1F 017", format("%x %#X %#o", 255, 31u, 15));
+    EXPECT_EQ("[   42] [42   ] [00042]", format("[%5d] [%-5d] [%05d]", 42, 42, 42));
+    EXPECT_EQ("[  7] [3.14]", format("[%*d] [%.*f]", 3, 7, 2, 3.14159));
+    EXPECT_EQ("1.500 2.5e+00 0.25", format("%.3f %.1e %g", 1.5, 2.5, 0.25f));
+    EXPECT_EQ("str [  ab] (null) x", format("%s [%4.2s] %s %c", "str", "abc",
+                                            static_cast<const char*>(nullptr), 'x'));
+    std::string big(1000, 'b');
+    EXPECT_EQ(big + "!", format("%s!", big.c_str()));
+
+    int v = 0;
+    char expected[32];
+    snprintf(expected, sizeof(expected), "%p", static_cast<void*>(&v));
+    EXPECT_EQ(expected, format("%p", &v));
+}
+
+TEST_F(LogDecoderTest, Mismatch) {
+    EXPECT_EQ("<mismatch>", format("%d"));
+    EXPECT_EQ("<mismatch>", format("%d", 1.5));
+    EXPECT_EQ("<mismatch>", format("%f", 1));
+    EXPECT_EQ("<mismatch>", format("%s", 1));
+    EXPECT_EQ("<mismatch>", format("%d %", 1));
+    EXPECT_EQ("<mismatch>", format("%n", 1));
+    // printf ignores extra arguments as well
+    EXPECT_EQ("1", format("%d", 1, 2));
+}
+
+TEST_F(LogDecoderTest, Corrupt) {
+    std::string out;
+    LogDecoder decoder;
+    const std::string unknown = "\x01garbage";
+    EXPECT_EQ(0U, decoder.Decode(unknown.data(), unknown.size(), &out));
+    EXPECT_FALSE(decoder.Ok());
+
+    // anything before the header
+    LogDecoder other;
+    const std::string sync = std::string("T") + std::string(16, '\0');
+    EXPECT_EQ(0U, other.Decode(sync.data(), sync.size(), &out));
+    EXPECT_EQ("no header", other.Error());
+
+    // a cut entry waits for more data
+    LogDecoder cut;
+    const std::string header = "\x7f" "CGBLOG1";
+    EXPECT_EQ(0U, cut.Decode(header.data(), header.size(), &out));
+    EXPECT_TRUE(cut.Ok());
+    EXPECT_EQ("", out);
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
@@ -0,0 +1,226 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "log/log_ring.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <linux/membarrier.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "algorithm/bit.h"
+#include "thread/this_thread.h"
+
+namespace cg {
+
+std::size_t LogRingSize(std::size_t n) {
+    return NextPowerOfTwo<uint64_t>(std::max<std::size_t>(n, 4096));
+}
+
+bool LogWriteAll(int fd, struct iovec* iov, int count, uint64_t* bytes, uint64_t* writes) {
+    while (count > 0) {
+        const int batch = std::min(count, IOV_MAX);
+        ssize_t r = writev(fd, iov, batch);
+        if (r < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        ++*writes;
+        *bytes += r;
+        // skip what was written, a short write resumes inside an iovec
+        while (count > 0 && static_cast<std::size_t>(r) >= iov->iov_len) {
+            r -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + r;
+            iov->iov_len -= r;
+        }
+    }
+    return true;
+}
+
+namespace {
+
+bool registerMembarrier() {
+    return syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0) == 0;
+}
+
+}  // end of anonymous namespace
+
+LogRingWriter::LogRingWriter()
+    : buffer_size_(LogConfig().buffer_size),
+      flush_interval_ms_(LogConfig().flush_interval_ms),
+      block_when_full_(LogConfig().block_when_full),
+      flush_requested_(0),
+      flush_done_(0),
+      stopped_(false),
+      membarrier_(registerMembarrier()),
+      retired_(),
+      bytes_(0),
+      writes_(0) {}
+
+void LogRingWriter::start() {
+    thread_ = std::thread(&LogRingWriter::run, this);
+}
+
+void LogRingWriter::configure(const LogConfig& config) {
+    std::lock_guard<std::mutex> guard(mu_);
+    buffer_size_ = LogRingSize(config.buffer_size);
+    flush_interval_ms_ = std::max(config.flush_interval_ms, 1);
+    block_when_full_.store(config.block_when_full, std::memory_order_relaxed);
+}
+
+void LogRingWriter::addWritten(uint64_t bytes, uint64_t writes) {
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    writes_.fetch_add(writes, std::memory_order_relaxed);
+}
+
+LogRing* LogRingWriter::NewRing() {
+    std::lock_guard<std::mutex> guard(mu_);
+    LogRing* ring = new LogRing(buffer_size_, ThisThread::Tid());
+    rings_.push_back(ring);
+    return ring;
+}
+
+bool LogRingWriter::WaitRoom(LogRing* ring, uint64_t end, bool force, uint64_t* tail) {
+    for (;;) {
+        *tail = ring->tail.load(std::memory_order_acquire);
+        if (end - *tail <= ring->capacity) {
+            return true;
+        }
+        if ((!force && !block_when_full_.load(std::memory_order_relaxed))
+            || stopped_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        cv_.notify_one();
+        sched_yield();
+    }
+}
+
+LogStats LogRingWriter::Stats() {
+    std::lock_guard<std::mutex> guard(mu_);
+    LogStats stats = retired_;
+    for (auto ring : rings_) {
+        stats.lines += ring->lines.load(std::memory_order_relaxed);
+        stats.dropped += ring->dropped.load(std::memory_order_relaxed);
+    }
+    stats.bytes = bytes_.load(std::memory_order_relaxed);
+    stats.writes = writes_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void LogRingWriter::Flush() {
+    std::unique_lock<std::mutex> lock(mu_);
+    if (stopped_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    const uint64_t ticket = ++flush_requested_;
+    cv_.notify_one();
+    done_cv_.wait(lock, [this, ticket] {
+        return flush_done_ >= ticket || stopped_.load(std::memory_order_relaxed);
+    });
+}
+
+void LogRingWriter::Stop() {
+    {
+        std::lock_guard<std::mutex> guard(mu_);
+        if (stopped_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        stopped_.store(true, std::memory_order_release);
+    }
+    cv_.notify_one();
+    thread_.join();
+    // pairs with the barrier of AfterPush: a push this drain misses sees stopped_
+    if (!membarrier_
+        || syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0) != 0) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+    // what was pushed while the writer exited
+    drainStopped();
+    done_cv_.notify_all();
+}
+
+void LogRingWriter::drainStopped() {
+    while (drain() > 0) {
+    }
+}
+
+std::size_t LogRingWriter::drain() {
+    std::lock_guard<std::mutex> drain_guard(drain_mu_);
+    {
+        std::lock_guard<std::mutex> guard(mu_);
+        snapshot_ = rings_;
+    }
+    ranges_.clear();
+    std::size_t total = 0;
+    for (auto ring : snapshot_) {
+        // closed is read before head so that a ring found closed and empty
+        // really has nothing left
+        const bool closed = ring->closed.load(std::memory_order_acquire);
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        if (head == tail) {
+            if (closed) {
+                std::lock_guard<std::mutex> guard(mu_);
+                retired_.lines += ring->lines.load(std::memory_order_relaxed);
+                retired_.dropped += ring->dropped.load(std::memory_order_relaxed);
+                rings_.erase(std::find(rings_.begin(), rings_.end(), ring));
+                delete ring;
+            }
+            continue;
+        }
+        ranges_.push_back(LogRingRange{ring, tail, head});
+        total += head - tail;
+    }
+    if (!ranges_.empty()) {
+        writeRanges(ranges_);
+        for (const auto& it : ranges_) {
+            it.ring->tail.store(it.head, std::memory_order_release);
+        }
+    }
+    return total;
+}
+
+void LogRingWriter::run() {
+    int idle = 0;
+    for (;;) {
+        uint64_t ticket;
+        {
+            std::lock_guard<std::mutex> guard(mu_);
+            ticket = flush_requested_;
+        }
+        // a round that finds every ring empty has written all that was
+        // pushed before the flush was requested
+        bool written = false;
+        while (drain() > 0) {
+            written = true;
+        }
+        // back off while nothing is logged, up to 32 intervals
+        idle = written ? 0 : std::min(idle + 1, 5);
+        std::unique_lock<std::mutex> lock(mu_);
+        if (ticket > flush_done_) {
+            flush_done_ = ticket;
+            done_cv_.notify_all();
+        }
+        if (stopped_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        if (flush_requested_ == ticket) {
+            cv_.wait_for(lock, std::chrono::milliseconds(flush_interval_ms_ << idle));
+        }
+    }
+}
+
+}  // end of namespace cg
@@ -0,0 +1,164 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "include/log.h"
+
+namespace cg {
+
+// Byte ring between one logging thread and a writer thread. Positions only
+// grow, the writer hands [tail, head) to writev as at most two pieces. The
+// pads keep head and tail on their own cache lines, new of C++11 does not
+// honor an alignas above 16.
+struct LogRing {
+    std::atomic<uint64_t> head;  // written by the owner thread
+    char pad0[64];
+    std::atomic<uint64_t> tail;  // written by the writer
+    char pad1[64];
+    std::atomic<bool> closed;    // the owner thread exited
+    // written by the owner thread only, no cache line shared between threads
+    std::atomic<uint64_t> lines;
+    std::atomic<uint64_t> dropped;
+    std::size_t capacity;
+    char* data;
+    int tid;  // of the owner thread
+
+    LogRing(std::size_t cap, int owner)
+        : head(0), tail(0), closed(false), lines(0), dropped(0), capacity(cap),
+          data(new char[cap]), tid(owner) {}
+
+    ~LogRing() {
+        delete[] data;
+    }
+
+    LogRing(const LogRing&) = delete;
+
+    LogRing& operator=(const LogRing&) = delete;
+
+    static void Bump(std::atomic<uint64_t>* counter) {
+        counter->store(counter->load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+// n rounded up to a power of two, at least 4096
+std::size_t LogRingSize(std::size_t n);
+
+// Writes every iovec to fd, resuming after short writes and EINTR. Returns
+// false on an error, adds to bytes and writes what did get written.
+bool LogWriteAll(int fd, struct iovec* iov, int count, uint64_t* bytes, uint64_t* writes);
+
+// [tail, head) of a ring, what one round writes of it
+struct LogRingRange {
+    LogRing* ring;
+    uint64_t tail;
+    uint64_t head;
+};
+
+// The part of a log writer that does not depend on what is in the rings:
+// the rings of the logging threads, the thread that empties them every
+// flush interval or on a Flush, and the last drain at exit. A writer only
+// turns the ranges of a round into writes, in writeRanges.
+class LogRingWriter {
+public:
+    virtual ~LogRingWriter() {}
+
+    LogRingWriter(const LogRingWriter&) = delete;
+
+    LogRingWriter& operator=(const LogRingWriter&) = delete;
+
+    // the ring of a new logging thread, which sets closed when it exits
+    LogRing* NewRing();
+
+    // Waits until ring has room up to end. False when the record is to be
+    // dropped: the ring is full and block_when_full is off unless force,
+    // or the writer is stopped and nobody empties the ring anymore.
+    bool WaitRoom(LogRing* ring, uint64_t end, bool force, uint64_t* tail);
+
+    // Called once head is published. Stop's last drain may have read the
+    // ring before that, the caller then writes the ring out itself. With
+    // membarrier a compiler barrier does here, Stop makes the threads fence.
+    void AfterPush() {
+        if (LIKELY(membarrier_)) {
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+        } else {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        if (UNLIKELY(stopped_.load(std::memory_order_relaxed))) {
+            drainStopped();
+        }
+    }
+
+    // Returns when everything pushed before the call has been written.
+    void Flush();
+
+    // Writes out what is left and ends the writer thread, for atexit.
+    void Stop();
+
+    bool Stopped() const {
+        return stopped_.load(std::memory_order_acquire);
+    }
+
+    LogStats Stats();
+
+protected:
+    LogRingWriter();
+
+    // the writer thread calls writeRanges, so it starts once the derived
+    // writer is built
+    void start();
+
+    // the ring size, interval and blocking of config
+    void configure(const LogConfig& config);
+
+    // what writeRanges got written, for Stats
+    void addWritten(uint64_t bytes, uint64_t writes);
+
+    // Writes the non empty ranges of one round. The tails move past them
+    // once it returns, an error loses them.
+    virtual void writeRanges(const std::vector<LogRingRange>& ranges) = 0;
+
+private:
+    void run();
+
+    // one round over every ring, returns the bytes taken out of them
+    std::size_t drain();
+
+    void drainStopped();
+
+private:
+    std::mutex mu_;  // rings_, config, flush and stop state
+    std::condition_variable cv_;       // wakes the writer
+    std::condition_variable done_cv_;  // wakes Flush
+    std::vector<LogRing*> rings_;
+    std::size_t buffer_size_;
+    int flush_interval_ms_;
+    std::atomic<bool> block_when_full_;
+    uint64_t flush_requested_;
+    uint64_t flush_done_;
+    std::atomic<bool> stopped_;
+    const bool membarrier_;  // the process can make its threads run a fence
+    std::thread thread_;
+
+    // one drain at a time: the writer thread, Stop, or a push after Stop
+    std::mutex drain_mu_;
+    std::vector<LogRing*> snapshot_;
+    std::vector<LogRingRange> ranges_;
+
+    LogStats retired_;  // counters of the rings already freed, guarded by mu_
+    std::atomic<uint64_t> bytes_;
+    std::atomic<uint64_t> writes_;
+};
+
+}  // end of namespace cg
@@ -0,0 +1,246 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "include/log.h"
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class LogTest : public ::testing::Test {
+protected:
+    static void SetUpTestCase() {
+        path_ = "/tmp/cg_log_test_" + std::to_string(getpid()) + ".log";
+        LogConfig config;
+        config.path = path_;
+        ASSERT_TRUE(InitLogging(config));
+    }
+
+    static void TearDownTestCase() {
+        InitLogging(LogConfig());
+        unlink(path_.c_str());
+    }
+
+    void SetUp() {
+        SetMinLogLevel(LOG_LEVEL_INFO);
+    }
+
+    // lines of the log file containing marker
+    static std::vector<std::string> lines(const std::string& marker) {
+        FlushLog();
+        std::ifstream in(path_);
+        std::vector<std::string> result;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.find(marker) != std::string::npos) {
+                result.push_back(line);
+            }
+        }
+        return result;
+    }
+
+    static std::string format(LogStream& stream) {
+        return std::string(stream.Data(), stream.Size());
+    }
+
+    static std::string path_;
+};
+
+std::string LogTest::path_;
+
+TEST_F(LogTest, Stream) {
+    LogStream stream;
+    stream << 0 << ' ' << -1 << ' ' << INT64_MIN << ' ' << UINT64_MAX << ' '
+           << static_cast<short>(-300) << ' ' << 10u << ' ' << 99 << ' ' << 100;
+    EXPECT_EQ("0 -1 -9223372036854775808 18446744073709551615 -300 10 99 100", format(stream));
+
+    LogStream other;
+    const char* null = nullptr;
+    other << true << ',' << false << ',' << null << ',' << std::string("str") << ',' << 0.5;
+    EXPECT_EQ("true,false,(null),str,0.5", format(other));
+
+    // past the inline buffer
+    LogStream big;
+    std::string s(LogStream::kInlineSize - 1, 'a');
+    big << s << "bc" << 12;
+    EXPECT_EQ(s + "bc12", format(big));
+}
+
+TEST_F(LogTest, Basic) {
+    LOG(INFO) << "basic marker " << 42;
+    LOG(WARN) << "basic marker warn";
+    LOG(ERROR) << "basic marker error";
+    auto result = lines("basic marker");
+    ASSERT_EQ(3U, result.size());
+    EXPECT_EQ('I', result[0][0]);
+    EXPECT_NE(std::string::npos, result[0].find(" log_test.cc:"));
+    EXPECT_NE(std::string::npos, result[0].find("] basic marker 42"));
+    EXPECT_EQ('W', result[1][0]);
+    EXPECT_EQ('E', result[2][0]);
+    // I20261018 10:20:30.123456
+    EXPECT_EQ(' ', result[0][9]);
+    EXPECT_EQ('.', result[0][18]);
+}
+
+TEST_F(LogTest, Level) {
+    int evaluated = 0;
+    auto touch = [&evaluated] {
+        ++evaluated;
+        return "level marker";
+    };
+    LOG(DEBUG) << touch();
+    EXPECT_EQ(0, evaluated);
+    SetMinLogLevel(LOG_LEVEL_ALL);
+    LOG(DEBUG) << touch();
+    EXPECT_EQ(1, evaluated);
+    SetMinLogLevel(LOG_LEVEL_ERROR);
+    LOG(WARN) << touch();
+    LOG_IF(ERROR, false) << touch();
+    LOG_IF(ERROR, true) << touch();
+    EXPECT_EQ(2, evaluated);
+    EXPECT_EQ(2U, lines("level marker").size());
+}
+
+TEST_F(LogTest, RateLimit) {
+    for (int i = 0; i < 100; ++i) {
+        LOG_EVERY_N(INFO, 10) << "every n marker " << i;
+        LOG_FIRST_N(INFO, 3) << "first n marker " << i;
+        LOG_EVERY_MS(INFO, 3600 * 1000) << "every ms marker " << i;
+    }
+    auto every = lines("every n marker");
+    ASSERT_EQ(10U, every.size());
+    EXPECT_NE(std::string::npos, every[1].find("every n marker 10"));
+    EXPECT_EQ(3U, lines("first n marker").size());
+    EXPECT_EQ(1U, lines("every ms marker").size());
+}
+
+TEST_F(LogTest, Threads) {
+    const int kThreads = 8;
+    const int kLines = 2000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < kLines; ++i) {
+                LOG(INFO) << "thread marker " << t << ' ' << i << " end";
+            }
+        });
+    }
+    for (auto& it : threads) {
+        it.join();
+    }
+    auto result = lines("thread marker");
+    ASSERT_EQ(static_cast<std::size_t>(kThreads * kLines), result.size());
+    // lines of one thread are whole and in order
+    std::vector<int> next(kThreads, 0);
+    for (const auto& it : result) {
+        std::istringstream in(it.substr(it.find("thread marker") + 14));
+        int t = -1;
+        int i = -1;
+        std::string end;
+        in >> t >> i >> end;
+        ASSERT_EQ("end", end) << it;
+        EXPECT_EQ(next[t]++, i);
+    }
+}
+
+TEST_F(LogTest, LongLine) {
+    std::string s(100000, 'x');
+    LOG(INFO) << "long marker " << s;
+    auto result = lines("long marker");
+    ASSERT_EQ(1U, result.size());
+    EXPECT_NE(std::string::npos, result[0].find("long marker " + s));
+}
+
+TEST_F(LogTest, Drop) {
+    LogConfig config;
+    config.path = path_;
+    config.buffer_size = 4096;
+    config.block_when_full = false;
+    config.flush_interval_ms = 100;
+    ASSERT_TRUE(InitLogging(config));
+    LogStats before = GetLogStats();
+    // a new thread gets a ring of the new size
+    std::thread([] {
+        for (int i = 0; i < 1000; ++i) {
+            LOG(INFO) << "drop marker " << i;
+        }
+    }).join();
+    LogStats after = GetLogStats();
+    EXPECT_EQ(1000U, (after.lines - before.lines) + (after.dropped - before.dropped));
+    EXPECT_LT(0U, after.dropped - before.dropped);
+    EXPECT_EQ(after.lines - before.lines, lines("drop marker").size());
+
+    config = LogConfig();
+    config.path = path_;
+    ASSERT_TRUE(InitLogging(config));
+}
+
+// Threads keep logging while the process exits: a line pushed as the writer
+// stops is written by its thread, none is lost before the last one.
+TEST_F(LogTest, LinesAcrossExit) {
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    // the child is a new process started by this one
+    const std::string path = "/tmp/cg_log_exit_" + std::to_string(getpid()) + ".log";
+    EXPECT_EXIT({
+        LogConfig config;
+        config.path = "/tmp/cg_log_exit_" + std::to_string(getppid()) + ".log";
+        InitLogging(config);
+        for (int t = 0; t < 4; ++t) {
+            std::thread([t] {
+                for (uint64_t i = 0;; ++i) {
+                    LOG(INFO) << "exit marker " << t << ' ' << i;
+                }
+            }).detach();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        exit(0);
+    }, ::testing::ExitedWithCode(0), "");
+
+    std::ifstream in(path);
+    std::vector<uint64_t> next(4, 0);
+    std::string line;
+    bool gap = false;
+    while (std::getline(in, line)) {
+        const std::size_t pos = line.find("exit marker ");
+        // a line without its newline was cut by the exit
+        if (pos == std::string::npos || in.eof()) {
+            continue;
+        }
+        int t = 0;
+        uint64_t i = 0;
+        std::istringstream(line.substr(pos + 12)) >> t >> i;
+        gap = gap || i != next[t];
+        next[t] = i + 1;
+    }
+    unlink(path.c_str());
+    EXPECT_FALSE(gap);
+    for (int t = 0; t < 4; ++t) {
+        EXPECT_GT(next[t], 0U) << t;
+    }
+}
+
+TEST_F(LogTest, Fatal) {
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    // the line reaches stderr before the abort
+    EXPECT_DEATH({
+        InitLogging(LogConfig());
+        LOG(FATAL) << "fatal marker " << 7;
+    }, "fatal marker 7");
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
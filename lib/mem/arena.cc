@@ -0,0 +1,142 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "mem/arena.h"
+
+#include <stdlib.h>
+
+#include <new>
+
+#include "base/hex.h"
+
+namespace cg {
+
+static_assert(sizeof(std::atomic<std::size_t>) + sizeof(std::size_t) == 2 * Arena::kAlign,
+        "block data must start aligned");
+
+Arena::Arena(std::size_t block_size)
+    : block_size_(block_size < 2 * kAlign ? 2 * kAlign : block_size),
+      current_(nullptr),
+      memory_usage_(0),
+      empty_(nullptr),
+      wasted_(0) {
+    // an empty block so the fast path never sees a null current_
+    empty_ = newBlock(0);
+    blocks_.pop_back();
+    current_.store(empty_, std::memory_order_release);
+}
+
+Arena::~Arena() {
+    for (auto& b : blocks_) {
+        free(b);
+    }
+    for (auto& b : free_blocks_) {
+        free(b);
+    }
+    free(empty_);
+}
+
+Arena::Block* Arena::newBlock(std::size_t size) {
+    Block* b = nullptr;
+    if (size == block_size_ && !free_blocks_.empty()) {
+        b = free_blocks_.back();
+        free_blocks_.pop_back();
+    } else {
+        void* mem = malloc(sizeof(Block) + size);
+        if (mem == nullptr) {
+            throw std::bad_alloc();
+        }
+        b = new (mem) Block;
+        b->size = size;
+        memory_usage_.fetch_add(sizeof(Block) + size, std::memory_order_relaxed);
+    }
+    b->used.store(0, std::memory_order_relaxed);
+    blocks_.push_back(b);
+    return b;
+}
+
+void Arena::freeBlock(Block* b) {
+    memory_usage_.fetch_sub(sizeof(Block) + b->size, std::memory_order_relaxed);
+    free(b);
+}
+
+// Slow path of all allocations. Return nullptr when another thread already
+// switched current_ away from `current` so the caller should retry.
+char* Arena::allocateFallback(Block* current, std::size_t bytes) {
+    std::lock_guard<std::mutex> guard(mu_);
+    if (current_.load(std::memory_order_relaxed) != current) {
+        return nullptr;
+    }
+    if (bytes > block_size_ / 4) {
+        // big objects get a block of their own, the rest of current is kept
+        Block* b = newBlock(bytes);
+        b->used.store(bytes, std::memory_order_relaxed);
+        return b->Data();
+    }
+    wasted_ += current->size - current->used.load(std::memory_order_relaxed);
+    Block* b = newBlock(block_size_);
+    b->used.store(bytes, std::memory_order_relaxed);
+    current_.store(b, std::memory_order_release);
+    return b->Data();
+}
+
+void Arena::Reset() {
+    std::lock_guard<std::mutex> guard(mu_);
+    for (auto& b : blocks_) {
+        if (b->size == block_size_) {
+            free_blocks_.push_back(b);
+        } else {
+            freeBlock(b);
+        }
+    }
+    blocks_.clear();
+    wasted_ = 0;
+    empty_->used.store(0, std::memory_order_relaxed);
+    current_.store(empty_, std::memory_order_release);
+}
+
+ArenaStats Arena::GetStats() {
+    std::lock_guard<std::mutex> guard(mu_);
+    ArenaStats stats;
+    stats.memory_usage = MemoryUsage();
+    stats.allocated = 0;
+    for (auto& b : blocks_) {
+        stats.allocated += b->used.load(std::memory_order_relaxed);
+    }
+    stats.wasted = wasted_;
+    stats.blocks = blocks_.size();
+    stats.free_blocks = free_blocks_.size();
+    return stats;
+}
+
+Slice ArenaHexEncode(Arena* arena, const Slice& s) {
+    if (s.Empty()) {
+        return Slice();
+    }
+    char* buf = arena->Allocate(2 * s.Size());
+    HexEncode(s.Data(), s.Size(), buf);
+    return Slice(buf, 2 * s.Size());
+}
+
+bool ArenaHexDecode(Arena* arena, const Slice& s, Slice* result) {
+    if (s.Size() % 2) {
+        return false;
+    }
+    if (!result) {
+        return false;
+    }
+    if (s.Empty()) {
+        *result = Slice();
+        return true;
+    }
+    char* buf = arena->Allocate(s.Size() / 2);
+    if (!HexDecode(s.Data(), s.Size(), buf)) {
+        return false;
+    }
+    *result = Slice(buf, s.Size() / 2);
+    return true;
+}
+
+}  // end of namespace cg
@@ -0,0 +1,168 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "include/macros.h"
+#include "include/slice.h"
+
+namespace cg {
+
+struct ArenaStats {
+    std::size_t memory_usage;  // bytes taken from the system, bookkeeping included
+    std::size_t allocated;     // bytes handed out since the last Reset, padding included
+    std::size_t wasted;        // unused tails of the blocks left behind for a new one
+    std::size_t blocks;        // blocks in use
+    std::size_t free_blocks;   // blocks kept by Reset for reuse
+};
+
+// Bump pointer allocator, memory is given back all at once by Reset or when
+// the arena is destroyed. Reset keeps the regular sized blocks, so an arena
+// reused across requests stops allocating once it has warmed up.
+// Allocate/AllocateAligned/Reset must be externally synchronized,
+// AllocateConcurrently may be called from many threads at once.
+class Arena {
+public:
+    static const std::size_t kBlockSize = 4096;
+    static const std::size_t kAlign = sizeof(void*);
+
+    explicit Arena(std::size_t block_size = kBlockSize);
+
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // bytes > 0, no alignment guarantee
+    char* Allocate(std::size_t bytes);
+
+    // bytes > 0, aligned to kAlign
+    char* AllocateAligned(std::size_t bytes);
+
+    // bytes > 0, aligned to kAlign, thread safe and lock free unless a new block is needed
+    char* AllocateConcurrently(std::size_t bytes);
+
+    // Copy the bytes of s into the arena, the result lives as long as the arena memory.
+    Slice Copy(const Slice& s) {
+        if (s.Empty()) {
+            return Slice();
+        }
+        char* mem = Allocate(s.Size());
+        memcpy(mem, s.Data(), s.Size());
+        return Slice(mem, s.Size());
+    }
+
+    // Invalidate everything allocated so far. Blocks of the regular size are
+    // kept for the following allocations, oversized ones are freed.
+    void Reset();
+
+    // bytes requested from the system so far
+    std::size_t MemoryUsage() const {
+        return memory_usage_.load(std::memory_order_relaxed);
+    }
+
+    ArenaStats GetStats();
+
+private:
+    struct Block {
+        std::atomic<std::size_t> used;
+        std::size_t size;
+
+        char* Data() {
+            return reinterpret_cast<char*>(this + 1);
+        }
+    };
+
+    char* allocateFallback(Block* current, std::size_t bytes);
+
+    Block* newBlock(std::size_t size);
+
+    void freeBlock(Block* b);
+
+private:
+    const std::size_t block_size_;
+    std::atomic<Block*> current_;
+    std::atomic<std::size_t> memory_usage_;
+    std::mutex mu_;  // protect the block lists and the switch of current_
+    Block* empty_;   // current_ before the first allocation, never holds data
+    std::vector<Block*> blocks_;
+    std::vector<Block*> free_blocks_;
+    std::size_t wasted_;
+};
+
+// Hex encode s into the arena, the counterpart of Slice::ToString(true).
+Slice ArenaHexEncode(Arena* arena, const Slice& s);
+
+// Hex decode s into the arena, false if s is not an even run of hex digits.
+bool ArenaHexDecode(Arena* arena, const Slice& s, Slice* result);
+
+// Reset the arena when leaving the scope, for request lifetime allocations.
+class ScopedArena {
+public:
+    explicit ScopedArena(Arena* arena) : arena_(arena) {}
+
+    ~ScopedArena() {
+        arena_->Reset();
+    }
+
+    ScopedArena(const ScopedArena&) = delete;
+    ScopedArena& operator=(const ScopedArena&) = delete;
+
+    Arena* Get() const {
+        return arena_;
+    }
+
+private:
+    Arena* arena_;
+};
+
+inline char* Arena::Allocate(std::size_t bytes) {
+    Block* b = current_.load(std::memory_order_relaxed);
+    std::size_t used = b->used.load(std::memory_order_relaxed);
+    if (LIKELY(used + bytes <= b->size)) {
+        b->used.store(used + bytes, std::memory_order_relaxed);
+        return b->Data() + used;
+    }
+    return allocateFallback(b, bytes);
+}
+
+inline char* Arena::AllocateAligned(std::size_t bytes) {
+    Block* b = current_.load(std::memory_order_relaxed);
+    std::size_t used = b->used.load(std::memory_order_relaxed);
+    used = (used + kAlign - 1) & ~(kAlign - 1);
+    if (LIKELY(used + bytes <= b->size)) {
+        b->used.store(used + bytes, std::memory_order_relaxed);
+        return b->Data() + used;
+    }
+    return allocateFallback(b, bytes);
+}
+
+inline char* Arena::AllocateConcurrently(std::size_t bytes) {
+    // round up so that every concurrent allocation stays aligned
+    bytes = (bytes + kAlign - 1) & ~(kAlign - 1);
+    while (true) {
+        Block* b = current_.load(std::memory_order_acquire);
+        // used never goes past the size: the tail of a retired block is known
+        std::size_t used = b->used.load(std::memory_order_relaxed);
+        while (LIKELY(used + bytes <= b->size)) {
+            if (b->used.compare_exchange_weak(used, used + bytes, std::memory_order_relaxed)) {
+                return b->Data() + used;
+            }
+        }
+        char* result = allocateFallback(b, bytes);
+        if (result != nullptr) {
+            return result;
+        }
+    }
+}
+
+}  // end of namespace cg
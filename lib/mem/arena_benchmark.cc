@@ -0,0 +1,146 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "include/slice.h"
+#include "mem/arena.h"
+
+namespace cg {
+namespace {
+
+// A config push of crontab jobs, each request parses the whole table and
+// keeps every token, the way a reload builds its rule set.
+const char* kCronLines[] = {
+    "*/5 * * * *",
+    "0,15,30,45 */2 * * 1-5",
+    "0-10,20-30,40-50 1,2,3,4,5,6 1-7,15-21 * *",
+    "30 8 * 1,4,7,10 0-6",
+    "*/1 */3 1,11,21 * *",
+    "5,10,15,20,25,30,35,40,45,50,55 0-23 * * *",
+    "0 0 1 1 *",
+    "12 0-6,18-23 * 2-11 1,3,5",
+};
+const int kLines = 64;
+
+struct HeapRule {
+    std::vector<std::vector<std::string>> fields;
+};
+
+struct ArenaRule {
+    Slice* fields[5];
+    int counts[5];
+};
+
+template <typename Func>
+void forEachToken(const char* p, const char* end, char delim, Func func) {
+    while (p < end) {
+        const char* q = p;
+        while (q < end && *q != delim) {
+            ++q;
+        }
+        if (q > p) {
+            func(p, q);
+        }
+        p = q + 1;
+    }
+}
+
+void parseHeap(const std::string& line, HeapRule* rule) {
+    const char* begin = line.data();
+    forEachToken(begin, begin + line.size(), ' ', [rule](const char* b, const char* e) {
+        rule->fields.emplace_back();
+        auto& items = rule->fields.back();
+        forEachToken(b, e, ',', [&items](const char* ib, const char* ie) {
+            items.emplace_back(ib, ie - ib);
+        });
+    });
+}
+
+void parseArena(const std::string& line, Arena* arena, ArenaRule* rule) {
+    const char* begin = line.data();
+    int field = 0;
+    forEachToken(begin, begin + line.size(), ' ', [&](const char* b, const char* e) {
+        if (field >= 5) {
+            return;
+        }
+        int count = 1;
+        for (const char* p = b; p < e; ++p) {
+            count += (*p == ',');
+        }
+        Slice* items = reinterpret_cast<Slice*>(arena->AllocateAligned(count * sizeof(Slice)));
+        int n = 0;
+        forEachToken(b, e, ',', [&](const char* ib, const char* ie) {
+            items[n++] = arena->Copy(Slice(ib, ie - ib));
+        });
+        rule->fields[field] = items;
+        rule->counts[field++] = n;
+    });
+}
+
+std::vector<std::string> cronTable() {
+    std::vector<std::string> table;
+    for (int i = 0; i < kLines; ++i) {
+        table.emplace_back(kCronLines[i % (sizeof(kCronLines) / sizeof(kCronLines[0]))]);
+    }
+    return table;
+}
+
+void BM_ParseHeap(benchmark::State& state) {
+    std::vector<std::string> table = cronTable();
+    for (auto _ : state) {
+        std::vector<HeapRule> rules(table.size());
+        for (std::size_t i = 0; i < table.size(); ++i) {
+            parseHeap(table[i], &rules[i]);
+        }
+        benchmark::DoNotOptimize(rules.data());
+    }
+    state.SetItemsProcessed(state.iterations() * table.size());
+}
+
+ArenaRule* parseTable(const std::vector<std::string>& table, Arena* arena) {
+    ArenaRule* rules = reinterpret_cast<ArenaRule*>(
+            arena->AllocateAligned(table.size() * sizeof(ArenaRule)));
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        parseArena(table[i], arena, &rules[i]);
+    }
+    return rules;
+}
+
+// a new arena for every request, blocks come from malloc each time
+void BM_ParseArena(benchmark::State& state) {
+    std::vector<std::string> table = cronTable();
+    for (auto _ : state) {
+        Arena arena;
+        benchmark::DoNotOptimize(parseTable(table, &arena));
+    }
+    state.SetItemsProcessed(state.iterations() * table.size());
+}
+
+// one arena reset after every request, blocks are reused
+void BM_ParseScopedArena(benchmark::State& state) {
+    std::vector<std::string> table = cronTable();
+    Arena arena;
+    for (auto _ : state) {
+        ScopedArena scope(&arena);
+        benchmark::DoNotOptimize(parseTable(table, &arena));
+    }
+    state.SetItemsProcessed(state.iterations() * table.size());
+
+    ScopedArena scope(&arena);
+    parseTable(table, &arena);
+    ArenaStats stats = arena.GetStats();
+    state.counters["memory_usage"] = stats.memory_usage;
+    state.counters["allocated"] = stats.allocated;
+    state.counters["wasted"] = stats.wasted;
+}
+
+BENCHMARK(BM_ParseHeap);
+BENCHMARK(BM_ParseArena);
+BENCHMARK(BM_ParseScopedArena);
+
+}  // end of anonymous namespace
+}  // end of namespace cg
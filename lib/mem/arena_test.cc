@@ -0,0 +1,170 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "mem/arena.h"
+
+#include <string.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class ArenaTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+TEST_F(ArenaTest, Empty) {
+    Arena arena;
+    // only the bookkeeping of the initial empty block
+    EXPECT_EQ(sizeof(Arena::Block), arena.MemoryUsage());
+}
+
+TEST_F(ArenaTest, Simple) {
+    Arena arena;
+    std::vector<std::pair<std::size_t, char*>> allocated;
+    std::size_t bytes = 0;
+    for (int i = 0; i < 10000; ++i) {
+        std::size_t s = (i % 100 == 0) ? 2000 + i : (i % 7) + 1;
+        char* r = (i % 2) ? arena.AllocateAligned(s) : arena.Allocate(s);
+        if (i % 2) {
+            EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(r) & (Arena::kAlign - 1));
+        }
+        memset(r, i % 256, s);
+        bytes += s;
+        allocated.emplace_back(s, r);
+        EXPECT_GE(arena.MemoryUsage(), bytes);
+    }
+    for (std::size_t i = 0; i < allocated.size(); ++i) {
+        for (std::size_t j = 0; j < allocated[i].first; ++j) {
+            ASSERT_EQ(static_cast<char>(i % 256), allocated[i].second[j]);
+        }
+    }
+}
+
+TEST_F(ArenaTest, Concurrent) {
+    Arena arena(1024);
+    const int thread_num = 8;
+    const int count = 10000;
+    std::vector<std::vector<char*>> allocated(thread_num);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_num; ++t) {
+        threads.emplace_back([&arena, &allocated, t, count]() {
+            for (int i = 0; i < count; ++i) {
+                std::size_t s = (i % 50 == 0) ? 512 : 24;
+                char* r = arena.AllocateConcurrently(s);
+                memset(r, t, s);
+                allocated[t].push_back(r);
+            }
+        });
+    }
+    for (auto& it : threads) {
+        it.join();
+    }
+    for (int t = 0; t < thread_num; ++t) {
+        for (int i = 0; i < count; ++i) {
+            char* r = allocated[t][i];
+            EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(r) & (Arena::kAlign - 1));
+            std::size_t s = (i % 50 == 0) ? 512 : 24;
+            for (std::size_t j = 0; j < s; ++j) {
+                ASSERT_EQ(static_cast<char>(t), r[j]);
+            }
+        }
+    }
+}
+
+// a big allocation takes a block of its own and leaves current_ be, as
+// Allocate does; a retired block counts the whole of its free tail
+TEST_F(ArenaTest, ConcurrentBlocks) {
+    Arena concurrent;
+    Arena plain;
+    for (std::size_t s : {100, 4000, 100}) {
+        concurrent.AllocateConcurrently(s);
+        plain.AllocateAligned(s);
+    }
+    EXPECT_EQ(2U, concurrent.GetStats().blocks);
+    EXPECT_EQ(plain.GetStats().blocks, concurrent.GetStats().blocks);
+    EXPECT_EQ(0U, concurrent.GetStats().wasted);
+
+    concurrent.AllocateConcurrently(1000);
+    concurrent.AllocateConcurrently(1000);
+    concurrent.AllocateConcurrently(1000);
+    const std::size_t used = concurrent.GetStats().allocated - 4000;
+    concurrent.AllocateConcurrently(1000);
+    EXPECT_EQ(3U, concurrent.GetStats().blocks);
+    EXPECT_EQ(Arena::kBlockSize - used, concurrent.GetStats().wasted);
+}
+
+TEST_F(ArenaTest, Reset) {
+    Arena arena(1024);
+    for (int i = 0; i < 100; ++i) {
+        arena.AllocateAligned(100);
+    }
+    arena.AllocateAligned(4096);
+    ArenaStats stats = arena.GetStats();
+    // a 1024 byte block holds 9 objects (8 * 104 + 100 bytes) and wastes 92 bytes,
+    // 100 objects fill 11 blocks plus one object in the 12th
+    EXPECT_EQ(11U * 932 + 100 + 4096, stats.allocated);
+    EXPECT_EQ(13U, stats.blocks);
+    EXPECT_EQ(0U, stats.free_blocks);
+    EXPECT_EQ(11U * 92, stats.wasted);
+    const std::size_t usage = arena.MemoryUsage();
+
+    arena.Reset();
+    stats = arena.GetStats();
+    EXPECT_EQ(0U, stats.allocated);
+    EXPECT_EQ(0U, stats.blocks);
+    EXPECT_EQ(12U, stats.free_blocks);
+    EXPECT_EQ(0U, stats.wasted);
+    // the oversized block is given back, the regular ones are kept
+    EXPECT_EQ(usage - 4096 - sizeof(Arena::Block), arena.MemoryUsage());
+
+    // warmed up, the same workload allocates nothing from the system
+    const std::size_t warm = arena.MemoryUsage();
+    for (int round = 0; round < 10; ++round) {
+        ScopedArena scope(&arena);
+        for (int i = 0; i < 99; ++i) {
+            char* p = scope.Get()->AllocateAligned(100);
+            memset(p, i, 100);
+        }
+    }
+    EXPECT_EQ(warm, arena.MemoryUsage());
+    EXPECT_EQ(0U, arena.GetStats().allocated);
+}
+
+TEST_F(ArenaTest, Copy) {
+    Arena arena;
+    std::string data = "hello arena";
+    Slice copy = arena.Copy(Slice(data));
+    data[0] = 'H';
+    EXPECT_EQ(0, copy.Compare(Slice("hello arena")));
+    EXPECT_NE(data.data(), copy.Data());
+    EXPECT_EQ(true, arena.Copy(Slice()).Empty());
+}
+
+TEST_F(ArenaTest, Hex) {
+    Arena arena;
+    std::string data("\x00\x01\x7f\x80\xfe\xff", 6);
+    Slice hex = ArenaHexEncode(&arena, Slice(data));
+    EXPECT_EQ(0, hex.Compare(Slice("00017F80FEFF")));
+
+    Slice raw;
+    EXPECT_EQ(true, ArenaHexDecode(&arena, hex, &raw));
+    EXPECT_EQ(0, raw.Compare(Slice(data)));
+    EXPECT_EQ(true, ArenaHexDecode(&arena, Slice(), &raw));
+    EXPECT_EQ(true, raw.Empty());
+    EXPECT_EQ(false, ArenaHexDecode(&arena, Slice("0"), &raw));
+    EXPECT_EQ(false, ArenaHexDecode(&arena, Slice("0g"), &raw));
+    EXPECT_EQ(true, ArenaHexEncode(&arena, Slice()).Empty());
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
@@ -0,0 +1,143 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "mem/mem_pool_lite.h"
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace cg {
+namespace {
+
+// free objects of one class shared by all threads, kept as whole batches
+// so that a refill is a single pop under the lock
+struct CentralList {
+    std::mutex mu;
+    std::vector<std::pair<void*, uint32_t>> batches;
+};
+
+// never destroyed, thread caches may be released after static destructors ran
+CentralList* centralLists() {
+    static CentralList* lists = new CentralList[MemPoolLite::kNumClasses];
+    return lists;
+}
+
+}  // end of anonymous namespace
+
+struct MemPoolLite::Registry {
+    std::mutex mu;
+    ThreadCache* head;  // caches of the live threads
+    MemPoolStats retired;  // counters of the threads already gone
+    std::atomic<uint64_t> bytes_held;
+
+    Registry() : head(nullptr), retired(), bytes_held(0) {}
+};
+
+MemPoolLite::Registry* MemPoolLite::registry() {
+    static Registry* r = new Registry;
+    return r;
+}
+
+MemPoolLite::ThreadCache::ThreadCache() : hits(0), refills(0), releases(0), prev(nullptr) {
+    for (auto& it : lists) {
+        it.head = nullptr;
+        it.count = 0;
+    }
+    Registry* r = registry();
+    std::lock_guard<std::mutex> guard(r->mu);
+    next = r->head;
+    if (next != nullptr) {
+        next->prev = this;
+    }
+    r->head = this;
+}
+
+MemPoolLite::ThreadCache::~ThreadCache() {
+    for (int cls = 0; cls < kNumClasses; ++cls) {
+        if (lists[cls].count > 0) {
+            Release(cls, lists[cls].count);
+        }
+    }
+    Registry* r = registry();
+    std::lock_guard<std::mutex> guard(r->mu);
+    r->retired.hits += hits.load(std::memory_order_relaxed);
+    r->retired.refills += refills.load(std::memory_order_relaxed);
+    r->retired.releases += releases.load(std::memory_order_relaxed);
+    if (prev != nullptr) {
+        prev->next = next;
+    } else {
+        r->head = next;
+    }
+    if (next != nullptr) {
+        next->prev = prev;
+    }
+}
+
+void* MemPoolLite::ThreadCache::Refill(int cls) {
+    Bump(&refills);
+    FreeList& list = lists[cls];
+    CentralList& central = centralLists()[cls];
+    {
+        std::lock_guard<std::mutex> guard(central.mu);
+        if (!central.batches.empty()) {
+            list.head = central.batches.back().first;
+            list.count = central.batches.back().second;
+            central.batches.pop_back();
+        }
+    }
+    if (list.head == nullptr) {
+        // carve a fresh span into a batch of objects
+        const std::size_t size = ClassSize(cls);
+        const uint32_t count = BatchSize(cls);
+        char* span = static_cast<char*>(malloc(size * count));
+        if (span == nullptr) {
+            throw std::bad_alloc();
+        }
+        registry()->bytes_held.fetch_add(size * count, std::memory_order_relaxed);
+        for (uint32_t i = 0; i + 1 < count; ++i) {
+            nextOf(span + i * size) = span + (i + 1) * size;
+        }
+        nextOf(span + (count - 1) * size) = nullptr;
+        list.head = span;
+        list.count = count;
+    }
+    void* p = list.head;
+    list.head = nextOf(p);
+    --list.count;
+    return p;
+}
+
+void MemPoolLite::ThreadCache::Release(int cls, uint32_t count) {
+    Bump(&releases);
+    FreeList& list = lists[cls];
+    void* head = list.head;
+    void* tail = head;
+    for (uint32_t i = 1; i < count; ++i) {
+        tail = nextOf(tail);
+    }
+    list.head = nextOf(tail);
+    list.count -= count;
+    nextOf(tail) = nullptr;
+
+    CentralList& central = centralLists()[cls];
+    std::lock_guard<std::mutex> guard(central.mu);
+    central.batches.emplace_back(head, count);
+}
+
+MemPoolStats MemPoolLite::GetStats() {
+    Registry* r = registry();
+    std::lock_guard<std::mutex> guard(r->mu);
+    MemPoolStats stats = r->retired;
+    for (ThreadCache* c = r->head; c != nullptr; c = c->next) {
+        stats.hits += c->hits.load(std::memory_order_relaxed);
+        stats.refills += c->refills.load(std::memory_order_relaxed);
+        stats.releases += c->releases.load(std::memory_order_relaxed);
+    }
+    stats.bytes_held = r->bytes_held.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // end of namespace cg
@@ -1 +1,186 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
 #pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+#include "algorithm/bit.h"
+#include "include/macros.h"
+
+namespace cg {
+
+struct MemPoolStats {
+    uint64_t hits;        // allocations served by the thread cache
+    uint64_t refills;     // batches moved from the central lists into a thread cache
+    uint64_t releases;    // batches moved from a thread cache back to the central lists
+    uint64_t bytes_held;  // bytes taken from the system, the pool never gives them back
+};
+
+// Process wide pool for small objects with power of two size classes
+// (8 bytes ~ 32KB), bigger requests go straight to malloc.
+//
+// Every thread owns a cache with one free list per class, so the common
+// Allocate/Deallocate needs neither lock nor atomic RMW. Objects move between
+// a thread cache and the mutex protected central list of their class in
+// batches, which is how memory freed by one thread goes back to the others.
+// Deallocate must be given the size passed to Allocate.
+class MemPoolLite {
+public:
+    static const std::size_t kMinSize = 8;
+    static const std::size_t kMaxSize = 32 * 1024;
+    static const int kMinShift = 3;
+    static const int kNumClasses = 13;  // 2^3 ~ 2^15
+
+    static void* Allocate(std::size_t size);
+
+    static void Deallocate(void* p, std::size_t size);
+
+    static int SizeClass(std::size_t size) {
+        uint32_t n = LeastPowerOfTwo(static_cast<uint32_t>(size < kMinSize ? kMinSize : size));
+        return __builtin_ctz(n) - kMinShift;
+    }
+
+    static std::size_t ClassSize(int cls) {
+        return static_cast<std::size_t>(1) << (cls + kMinShift);
+    }
+
+    // objects moved per refill/release of class cls
+    static uint32_t BatchSize(int cls) {
+        uint32_t n = static_cast<uint32_t>((16 * 1024) >> (cls + kMinShift));
+        return n < 4 ? 4 : (n > 128 ? 128 : n);
+    }
+
+    // Sum of the counters of every thread, approximate while threads are running.
+    static MemPoolStats GetStats();
+
+private:
+    struct FreeList {
+        void* head;
+        uint32_t count;
+    };
+
+    struct ThreadCache {
+        FreeList lists[kNumClasses];
+        // written by the owner thread only, read by GetStats
+        std::atomic<uint64_t> hits;
+        std::atomic<uint64_t> refills;
+        std::atomic<uint64_t> releases;
+        ThreadCache* prev;
+        ThreadCache* next;
+
+        ThreadCache();
+
+        ~ThreadCache();
+
+        void* Refill(int cls);
+
+        void Release(int cls, uint32_t count);
+
+        void Bump(std::atomic<uint64_t>* counter) {
+            counter->store(counter->load(std::memory_order_relaxed) + 1,
+                           std::memory_order_relaxed);
+        }
+    };
+
+    struct Registry;
+
+    static Registry* registry();
+
+    static ThreadCache& threadCache() {
+        static thread_local ThreadCache cache;
+        return cache;
+    }
+
+    static void*& nextOf(void* p) {
+        return *static_cast<void**>(p);
+    }
+};
+
+inline void* MemPoolLite::Allocate(std::size_t size) {
+    if (UNLIKELY(size > kMaxSize)) {
+        void* p = malloc(size);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+    const int cls = SizeClass(size);
+    ThreadCache& cache = threadCache();
+    FreeList& list = cache.lists[cls];
+    if (LIKELY(list.head != nullptr)) {
+        void* p = list.head;
+        list.head = nextOf(p);
+        --list.count;
+        cache.Bump(&cache.hits);
+        return p;
+    }
+    return cache.Refill(cls);
+}
+
+inline void MemPoolLite::Deallocate(void* p, std::size_t size) {
+    if (p == nullptr) {
+        return;
+    }
+    if (UNLIKELY(size > kMaxSize)) {
+        free(p);
+        return;
+    }
+    const int cls = SizeClass(size);
+    ThreadCache& cache = threadCache();
+    FreeList& list = cache.lists[cls];
+    nextOf(p) = list.head;
+    list.head = p;
+    if (UNLIKELY(++list.count >= 2 * BatchSize(cls))) {
+        cache.Release(cls, BatchSize(cls));
+    }
+}
+
+// std compatible allocator backed by MemPoolLite.
+template <typename T>
+class PoolAllocator {
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind {
+        typedef PoolAllocator<U> other;
+    };
+
+    PoolAllocator() noexcept {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}  // NOLINT(runtime/explicit)
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(MemPoolLite::Allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        MemPoolLite::Deallocate(p, n * sizeof(T));
+    }
+};
+
+template <typename T, typename U>
+inline bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+    return true;
+}
+
+template <typename T, typename U>
+inline bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) {
+    return false;
+}
+
+}  // end of namespace cg
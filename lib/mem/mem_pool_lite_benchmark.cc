@@ -0,0 +1,72 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <stdlib.h>
+
+#include "benchmark/benchmark.h"
+#include "mem/mem_pool_lite.h"
+
+namespace cg {
+namespace {
+
+const int kBatch = 64;
+
+// object sizes of timer entries, rules and small buffers
+std::size_t objectSize(int i) {
+    static const std::size_t sizes[] = {16, 24, 48, 64, 96, 128, 256, 512};
+    return sizes[i & 7];
+}
+
+struct PoolAlloc {
+    static void* Allocate(std::size_t size) {
+        return MemPoolLite::Allocate(size);
+    }
+
+    static void Deallocate(void* p, std::size_t size) {
+        MemPoolLite::Deallocate(p, size);
+    }
+};
+
+struct MallocAlloc {
+    static void* Allocate(std::size_t size) {
+        return malloc(size);
+    }
+
+    static void Deallocate(void* p, std::size_t) {
+        free(p);
+    }
+};
+
+struct NewAlloc {
+    static void* Allocate(std::size_t size) {
+        return ::operator new(size);
+    }
+
+    static void Deallocate(void* p, std::size_t) {
+        ::operator delete(p);
+    }
+};
+
+// allocate a batch of mixed sizes, then free it
+template <typename Alloc>
+void BM_AllocFree(benchmark::State& state) {
+    void* objects[kBatch];
+    for (auto _ : state) {
+        for (int i = 0; i < kBatch; ++i) {
+            objects[i] = Alloc::Allocate(objectSize(i));
+        }
+        benchmark::DoNotOptimize(objects);
+        for (int i = 0; i < kBatch; ++i) {
+            Alloc::Deallocate(objects[i], objectSize(i));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+BENCHMARK_TEMPLATE(BM_AllocFree, PoolAlloc)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_AllocFree, MallocAlloc)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_AllocFree, NewAlloc)->ThreadRange(1, 32)->UseRealTime();
+
+}  // end of anonymous namespace
+}  // end of namespace cg
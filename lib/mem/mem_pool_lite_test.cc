@@ -0,0 +1,134 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "mem/mem_pool_lite.h"
+
+#include <string.h>
+
+#include <list>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class MemPoolLiteTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+TEST_F(MemPoolLiteTest, SizeClass) {
+    EXPECT_EQ(0, MemPoolLite::SizeClass(0));
+    EXPECT_EQ(0, MemPoolLite::SizeClass(1));
+    EXPECT_EQ(0, MemPoolLite::SizeClass(8));
+    EXPECT_EQ(1, MemPoolLite::SizeClass(9));
+    EXPECT_EQ(1, MemPoolLite::SizeClass(16));
+    EXPECT_EQ(MemPoolLite::kNumClasses - 1, MemPoolLite::SizeClass(MemPoolLite::kMaxSize));
+    for (std::size_t size = 1; size <= MemPoolLite::kMaxSize; ++size) {
+        int cls = MemPoolLite::SizeClass(size);
+        ASSERT_GE(MemPoolLite::ClassSize(cls), size);
+        if (cls > 0) {
+            ASSERT_LT(MemPoolLite::ClassSize(cls - 1), size);
+        }
+    }
+}
+
+TEST_F(MemPoolLiteTest, AllocateAndReuse) {
+    MemPoolStats before = MemPoolLite::GetStats();
+    void* p = MemPoolLite::Allocate(24);
+    memset(p, 1, 24);
+    MemPoolLite::Deallocate(p, 24);
+    // lifo thread cache hands the same object back
+    void* q = MemPoolLite::Allocate(32);
+    EXPECT_EQ(p, q);
+    MemPoolLite::Deallocate(q, 32);
+
+    MemPoolStats after = MemPoolLite::GetStats();
+    EXPECT_GE(after.hits, before.hits + 1);
+    EXPECT_GT(after.bytes_held, 0U);
+
+    // larger than kMaxSize goes to malloc
+    void* big = MemPoolLite::Allocate(MemPoolLite::kMaxSize + 1);
+    memset(big, 1, MemPoolLite::kMaxSize + 1);
+    MemPoolLite::Deallocate(big, MemPoolLite::kMaxSize + 1);
+    MemPoolLite::Deallocate(nullptr, 8);
+}
+
+TEST_F(MemPoolLiteTest, ManyObjects) {
+    std::vector<std::pair<char*, std::size_t>> objects;
+    for (int i = 0; i < 20000; ++i) {
+        std::size_t size = 1 + (i * 37) % 3000;
+        char* p = static_cast<char*>(MemPoolLite::Allocate(size));
+        memset(p, i & 0xff, size);
+        objects.emplace_back(p, size);
+    }
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+        for (std::size_t j = 0; j < objects[i].second; ++j) {
+            ASSERT_EQ(static_cast<char>(i & 0xff), objects[i].first[j]);
+        }
+        MemPoolLite::Deallocate(objects[i].first, objects[i].second);
+    }
+}
+
+TEST_F(MemPoolLiteTest, CrossThreadFree) {
+    const int count = 100000;
+    std::vector<void*> objects(count);
+    MemPoolStats before = MemPoolLite::GetStats();
+    std::thread producer([&objects, count]() {
+        for (int i = 0; i < count; ++i) {
+            objects[i] = MemPoolLite::Allocate(64);
+        }
+    });
+    producer.join();
+    std::thread consumer([&objects, count]() {
+        for (int i = 0; i < count; ++i) {
+            MemPoolLite::Deallocate(objects[i], 64);
+        }
+    });
+    consumer.join();
+    MemPoolStats middle = MemPoolLite::GetStats();
+    EXPECT_GT(middle.releases, before.releases);
+
+    // memory freed by the consumer is reused, no new span is carved
+    std::thread reuse([&objects, count]() {
+        for (int i = 0; i < count; ++i) {
+            objects[i] = MemPoolLite::Allocate(64);
+        }
+        for (int i = 0; i < count; ++i) {
+            MemPoolLite::Deallocate(objects[i], 64);
+        }
+    });
+    reuse.join();
+    EXPECT_EQ(middle.bytes_held, MemPoolLite::GetStats().bytes_held);
+}
+
+TEST_F(MemPoolLiteTest, Allocator) {
+    std::vector<int, PoolAllocator<int>> v;
+    for (int i = 0; i < 10000; ++i) {
+        v.push_back(i);
+    }
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(i, v[i]);
+    }
+
+    std::list<std::string, PoolAllocator<std::string>> l(100, "pool");
+    EXPECT_EQ(100U, l.size());
+
+    std::map<int, int, std::less<int>, PoolAllocator<std::pair<const int, int>>> m;
+    for (int i = 0; i < 1000; ++i) {
+        m[i] = i * 2;
+    }
+    EXPECT_EQ(1000U, m.size());
+    EXPECT_EQ(20, m[10]);
+    EXPECT_TRUE(PoolAllocator<int>() == PoolAllocator<char>());
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
@@ -0,0 +1,61 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace cg {
+
+// "00" "01" ... "99": two digits per division
+inline const char* DigitPairs() {
+    static const char kDigits[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    return kDigits;
+}
+
+inline int CountDigits(uint64_t v) {
+    int n = 1;
+    for (;;) {
+        if (v < 10) {
+            return n;
+        }
+        if (v < 100) {
+            return n + 1;
+        }
+        if (v < 1000) {
+            return n + 2;
+        }
+        if (v < 10000) {
+            return n + 3;
+        }
+        v /= 10000;
+        n += 4;
+    }
+}
+
+// Decimal digits of v written backwards ending at end, at most 20 of them.
+// Returns the first one.
+inline char* FormatDecimal(uint64_t v, char* end) {
+    const char* digits = DigitPairs();
+    char* p = end;
+    while (v >= 100) {
+        const unsigned i = static_cast<unsigned>(v % 100) * 2;
+        v /= 100;
+        *--p = digits[i + 1];
+        *--p = digits[i];
+    }
+    if (v >= 10) {
+        const unsigned i = static_cast<unsigned>(v) * 2;
+        *--p = digits[i + 1];
+        *--p = digits[i];
+    } else {
+        *--p = static_cast<char>('0' + v);
+    }
+    return p;
+}
+
+}  // end of namespace cg
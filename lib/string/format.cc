@@ -0,0 +1,795 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "string/format.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "string/digits.h"
+
+namespace cg {
+namespace {
+
+// Grisu3 of Florian Loitsch, "Printing Floating-Point Numbers Quickly and
+// Accurately with Integers", as in double-conversion: the shortest digits
+// that read back as the same double, the closest ones to it among those,
+// or a refusal for the ~0.5% of doubles where 64 bits cannot tell. Those
+// go to exactShortest.
+struct DiyFp {
+    static const int kSignificandBits = 52;
+    static const uint64_t kHiddenBit = 1ULL << kSignificandBits;
+    static const uint64_t kSignificandMask = kHiddenBit - 1;
+    static const int kExponentBias = 0x3FF + kSignificandBits;
+
+    uint64_t f;
+    int e;
+
+    DiyFp(uint64_t fp, int exp) : f(fp), e(exp) {}
+
+    explicit DiyFp(double d) {
+        uint64_t u;
+        memcpy(&u, &d, sizeof(u));
+        const int biased = static_cast<int>((u >> kSignificandBits) & 0x7FF);
+        const uint64_t significand = u & kSignificandMask;
+        if (biased != 0) {
+            f = significand + kHiddenBit;
+            e = biased - kExponentBias;
+        } else {
+            f = significand;
+            e = 1 - kExponentBias;
+        }
+    }
+
+    DiyFp operator-(const DiyFp& rhs) const {
+        return DiyFp(f - rhs.f, e);
+    }
+
+    // the high 64 bits of the product, rounded
+    DiyFp operator*(const DiyFp& rhs) const {
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 p = static_cast<unsigned __int128>(f) * rhs.f;
+        uint64_t h = static_cast<uint64_t>(p >> 64);
+        const uint64_t l = static_cast<uint64_t>(p);
+        if (l & (1ULL << 63)) {
+            ++h;
+        }
+        return DiyFp(h, e + rhs.e + 64);
+#else
+        const uint64_t a = f >> 32;
+        const uint64_t b = f & 0xFFFFFFFF;
+        const uint64_t c = rhs.f >> 32;
+        const uint64_t d = rhs.f & 0xFFFFFFFF;
+        const uint64_t ac = a * c;
+        const uint64_t bc = b * c;
+        const uint64_t ad = a * d;
+        const uint64_t bd = b * d;
+        uint64_t tmp = (bd >> 32) + (ad & 0xFFFFFFFF) + (bc & 0xFFFFFFFF);
+        tmp += 1U << 31;
+        return DiyFp(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), e + rhs.e + 64);
+#endif
+    }
+
+    DiyFp Normalize() const {
+        const int s = __builtin_clzll(f);
+        return DiyFp(f << s, e - s);
+    }
+
+    // the halfway points to the neighbouring doubles, with the same exponent
+    void NormalizedBoundaries(DiyFp* minus, DiyFp* plus) const {
+        DiyFp pl((f << 1) + 1, e - 1);
+        while (!(pl.f & (kHiddenBit << 1))) {
+            pl.f <<= 1;
+            --pl.e;
+        }
+        pl.f <<= 64 - kSignificandBits - 2;
+        pl.e -= 64 - kSignificandBits - 2;
+        // the gap below a power of two is half the one above, but for the
+        // smallest normal double whose neighbour below is a subnormal
+        const bool closer_below = f == kHiddenBit && e != 1 - kExponentBias;
+        DiyFp mi = closer_below ? DiyFp((f << 2) - 1, e - 2) : DiyFp((f << 1) - 1, e - 1);
+        mi.f <<= mi.e - pl.e;
+        mi.e = pl.e;
+        *plus = pl;
+        *minus = mi;
+    }
+};
+
+// 10^k as a normalized DiyFp, k = -348, -340, ..., 340
+const uint64_t kCachedPowersF[] = {
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+    0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+    0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+    0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+    0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+    0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+    0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+    0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+    0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+    0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+    0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+    0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+    0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+    0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+    0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+    0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+    0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+    0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+    0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+    0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+    0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+    0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL,
+};
+
+const int16_t kCachedPowersE[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+    -901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+    -582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+    -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+    56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+    694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+    1013, 1039, 1066,
+};
+
+const uint64_t kPow10[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL,
+};
+
+// a power of ten bringing a number of binary exponent e to [-60, -32], and
+// minus its decimal exponent in k
+DiyFp cachedPower(int e, int* k) {
+    const double dk = (-61 - e) * 0.30102999566398114 + 347;
+    int ik = static_cast<int>(dk);
+    if (dk - ik > 0.0) {
+        ++ik;
+    }
+    const unsigned index = static_cast<unsigned>((ik >> 3) + 1);
+    *k = -(-348 + static_cast<int>(index << 3));
+    return DiyFp(kCachedPowersF[index], kCachedPowersE[index]);
+}
+
+// Moves the last digit towards w while it stays inside the unsafe interval.
+// False when the digits may not be the closest ones inside the real
+// boundaries: the scaled values are only known within unit.
+bool roundWeed(char* buf, int len, uint64_t too_high_w, uint64_t unsafe, uint64_t rest,
+               uint64_t ten_kappa, uint64_t unit) {
+    const uint64_t small = too_high_w - unit;
+    const uint64_t big = too_high_w + unit;
+    while (rest < small && unsafe - rest >= ten_kappa
+           && (rest + ten_kappa < small || small - rest >= rest + ten_kappa - small)) {
+        --buf[len - 1];
+        rest += ten_kappa;
+    }
+    // a digit less would be closer to some w within unit as well
+    if (rest < big && unsafe - rest >= ten_kappa
+        && (rest + ten_kappa < big || big - rest > rest + ten_kappa - big)) {
+        return false;
+    }
+    return 2 * unit <= rest && rest <= unsafe - 4 * unit;
+}
+
+// The digits of high down to the first that falls inside (low, high)
+// widened by unit, the uncertainty of the scaled values.
+bool digitGen(const DiyFp& low, const DiyFp& w, const DiyFp& high, char* buf, int* len,
+              int* k) {
+    uint64_t unit = 1;
+    const DiyFp too_low(low.f - unit, low.e);
+    const DiyFp too_high(high.f + unit, high.e);
+    uint64_t unsafe = (too_high - too_low).f;
+    const DiyFp one(1ULL << -w.e, w.e);
+    uint32_t p1 = static_cast<uint32_t>(too_high.f >> -one.e);
+    uint64_t p2 = too_high.f & (one.f - 1);
+    int kappa = CountDigits(p1);
+    *len = 0;
+    while (kappa > 0) {
+        const uint32_t pow = static_cast<uint32_t>(kPow10[kappa - 1]);
+        const uint32_t d = p1 / pow;
+        p1 %= pow;
+        if (d != 0 || *len != 0) {
+            buf[(*len)++] = static_cast<char>('0' + d);
+        }
+        --kappa;
+        const uint64_t rest = (static_cast<uint64_t>(p1) << -one.e) + p2;
+        if (rest < unsafe) {
+            *k += kappa;
+            return roundWeed(buf, *len, (too_high - w).f, unsafe, rest,
+                             kPow10[kappa] << -one.e, unit);
+        }
+    }
+    for (;;) {
+        p2 *= 10;
+        unit *= 10;
+        unsafe *= 10;
+        const char d = static_cast<char>(p2 >> -one.e);
+        if (d != 0 || *len != 0) {
+            buf[(*len)++] = static_cast<char>('0' + d);
+        }
+        p2 &= one.f - 1;
+        --kappa;
+        if (p2 < unsafe) {
+            *k += kappa;
+            return roundWeed(buf, *len, (too_high - w).f * unit, unsafe, p2, one.f, unit);
+        }
+    }
+}
+
+// digits of v > 0 in buf, v = digits * 10^k, false when grisu3 cannot tell
+bool grisu3(double v, char* buf, int* len, int* k) {
+    const DiyFp fp(v);
+    DiyFp minus(0, 0);
+    DiyFp plus(0, 0);
+    fp.NormalizedBoundaries(&minus, &plus);
+    const DiyFp c_mk = cachedPower(plus.e, k);
+    const DiyFp w = fp.Normalize() * c_mk;
+    const DiyFp wp = plus * c_mk;
+    const DiyFp wm = minus * c_mk;
+    return digitGen(wm, w, wp, buf, len, k);
+}
+
+// n significant digits of v, correctly rounded by snprintf, as an integer
+// and its decimal exponent: v ~ *digits * 10^*k
+void roundedDigits(double v, int n, uint64_t* digits, int* k) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.*e", n - 1, v);
+    // d.ddde+x
+    uint64_t d = 0;
+    const char* p = text;
+    for (; *p != 'e'; ++p) {
+        if (*p != '.') {
+            d = d * 10 + (*p - '0');
+        }
+    }
+    *digits = d;
+    *k = atoi(p + 1) - (n - 1);
+}
+
+bool readsBack(uint64_t digits, int k, double v) {
+    char text[32];
+    snprintf(text, sizeof(text), "%llue%d", static_cast<unsigned long long>(digits), k);
+    return strtod(text, nullptr) == v;
+}
+
+// The exact path for what grisu3 refuses, slow but rare. A decimal of up
+// to 15 digits survives the trip through a normal double, so when the 15
+// digits of v read back they are the shortest ones followed by zeros.
+// Otherwise 16 digits, then the 17 that always do. Next to a power of two
+// the boundaries are uneven and a neighbour of the rounded digits may read
+// back where they do not. Subnormals have fewer bits and start from 1.
+void exactShortest(double v, char* buf, int* len, int* k) {
+    uint64_t digits = 0;
+    for (int n = v < DBL_MIN ? 1 : 15; n <= 17; ++n) {
+        roundedDigits(v, n, &digits, k);
+        if (readsBack(digits, *k, v)) {
+            break;
+        }
+        if (readsBack(digits - 1, *k, v)) {
+            --digits;
+            break;
+        }
+        if (readsBack(digits + 1, *k, v)) {
+            ++digits;
+            break;
+        }
+    }
+    while (digits % 10 == 0) {
+        digits /= 10;
+        ++*k;
+    }
+    char* end = buf + 24;
+    char* begin = FormatDecimal(digits, end);
+    *len = static_cast<int>(end - begin);
+    memmove(buf, begin, *len);
+}
+
+// "e-07", "e+100"
+char* writeExponent(int exp, char* p) {
+    *p++ = 'e';
+    *p++ = exp < 0 ? '-' : '+';
+    const unsigned u = exp < 0 ? -exp : exp;
+    char digits[4];
+    char* end = digits + sizeof(digits);
+    char* begin = FormatDecimal(u, end);
+    if (end - begin < 2) {
+        *p++ = '0';
+    }
+    memcpy(p, begin, end - begin);
+    return p + (end - begin);
+}
+
+struct Spec {
+    char fill;
+    char align;  // 0 for the default of the kind
+    char sign;   // 0, '+' or ' '
+    bool alt;
+    bool zero;
+    int width;
+    int precision;  // -1 for none
+    char type;      // 0 for none
+};
+
+int parseNumber(const char** p) {
+    int n = 0;
+    while (**p >= '0' && **p <= '9') {
+        n = n * 10 + (**p - '0');
+        ++*p;
+        if (n > (1 << 20)) {
+            return -1;
+        }
+    }
+    return n;
+}
+
+bool isAlign(char c) {
+    return c == '<' || c == '>' || c == '^';
+}
+
+// p just after the opening brace, returns the position after the closing
+// one, nullptr for a broken field
+const char* parseSpec(const char* p, Spec* spec) {
+    spec->fill = ' ';
+    spec->align = 0;
+    spec->sign = 0;
+    spec->alt = false;
+    spec->zero = false;
+    spec->width = 0;
+    spec->precision = -1;
+    spec->type = 0;
+    if (*p == '}') {
+        return p + 1;
+    }
+    if (*p != ':') {
+        return nullptr;
+    }
+    ++p;
+    if (*p != '\0' && *p != '}' && isAlign(p[1])) {
+        spec->fill = p[0];
+        spec->align = p[1];
+        p += 2;
+    } else if (isAlign(*p)) {
+        spec->align = *p++;
+    }
+    if (*p == '+' || *p == ' ') {
+        spec->sign = *p++;
+    } else if (*p == '-') {
+        ++p;
+    }
+    if (*p == '#') {
+        spec->alt = true;
+        ++p;
+    }
+    if (*p == '0') {
+        spec->zero = true;
+        ++p;
+    }
+    spec->width = parseNumber(&p);
+    if (*p == '.') {
+        ++p;
+        if (*p < '0' || *p > '9') {
+            return nullptr;
+        }
+        spec->precision = parseNumber(&p);
+    }
+    if (spec->width < 0 || (spec->precision < -1)) {
+        return nullptr;
+    }
+    if (*p != '}') {
+        if (*p == '\0' || p[1] != '}') {
+            return nullptr;
+        }
+        spec->type = *p++;
+    }
+    return p + 1;
+}
+
+// prefix (sign, 0x) and body padded to the width of spec
+void writePadded(FormatWriter* out, const Spec& spec, const char* prefix, std::size_t prefix_n,
+                 const char* body, std::size_t n, char default_align) {
+    const std::size_t size = prefix_n + n;
+    if (static_cast<std::size_t>(spec.width) <= size) {
+        out->Append(prefix, prefix_n);
+        out->Append(body, n);
+        return;
+    }
+    const std::size_t pad = spec.width - size;
+    if (spec.zero && spec.align == 0) {
+        out->Append(prefix, prefix_n);
+        out->Fill('0', pad);
+        out->Append(body, n);
+        return;
+    }
+    const char align = spec.align != 0 ? spec.align : default_align;
+    const std::size_t left = align == '<' ? 0 : align == '^' ? pad / 2 : pad;
+    out->Fill(spec.fill, left);
+    out->Append(prefix, prefix_n);
+    out->Append(body, n);
+    out->Fill(spec.fill, pad - left);
+}
+
+void writeString(FormatWriter* out, const Spec& spec, const char* p, std::size_t n) {
+    if (spec.precision >= 0 && static_cast<std::size_t>(spec.precision) < n) {
+        n = spec.precision;
+    }
+    writePadded(out, spec, "", 0, p, n, '<');
+}
+
+void writeInteger(FormatWriter* out, const Spec& spec, uint64_t abs, bool negative) {
+    char type = spec.type;
+    if (type == 'c') {
+        const char c = static_cast<char>(abs);
+        writePadded(out, spec, "", 0, &c, 1, '<');
+        return;
+    }
+    char prefix[4];
+    std::size_t prefix_n = 0;
+    if (negative) {
+        prefix[prefix_n++] = '-';
+    } else if (spec.sign != 0) {
+        prefix[prefix_n++] = spec.sign;
+    }
+    char buf[64];
+    char* end = buf + sizeof(buf);
+    char* begin = end;
+    if (type == 'x' || type == 'X') {
+        const char* digits = type == 'x' ? "0123456789abcdef" : "0123456789ABCDEF";
+        do {
+            *--begin = digits[abs & 15];
+            abs >>= 4;
+        } while (abs != 0);
+        if (spec.alt) {
+            prefix[prefix_n++] = '0';
+            prefix[prefix_n++] = type;
+        }
+    } else if (type == 'o') {
+        do {
+            *--begin = static_cast<char>('0' + (abs & 7));
+            abs >>= 3;
+        } while (abs != 0);
+        if (spec.alt) {
+            prefix[prefix_n++] = '0';
+        }
+    } else if (type == 'b') {
+        do {
+            *--begin = static_cast<char>('0' + (abs & 1));
+            abs >>= 1;
+        } while (abs != 0);
+        if (spec.alt) {
+            prefix[prefix_n++] = '0';
+            prefix[prefix_n++] = 'b';
+        }
+    } else {
+        begin = FormatDecimal(abs, end);
+    }
+    writePadded(out, spec, prefix, prefix_n, begin, end - begin, '>');
+}
+
+// {:.Nf} without snprintf when the scaled value is exact enough that its
+// rounding is not in doubt; false leaves it to snprintf.
+bool formatFixed(double v, int precision, char* buf, std::size_t* n) {
+    if (precision > 15) {
+        return false;
+    }
+    const double scaled = fabs(v) * static_cast<double>(kPow10[precision]);
+    if (!(scaled < 4503599627370496.0)) {  // 2^52, nan and inf fail too
+        return false;
+    }
+    uint64_t rounded = static_cast<uint64_t>(scaled);
+    const double frac = scaled - static_cast<double>(rounded);
+    // the product is off by half an ulp at most
+    if (fabs(frac - 0.5) <= scaled * 2.220446049250313e-16) {
+        return false;
+    }
+    rounded += frac > 0.5;
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    char* begin = FormatDecimal(rounded, end);
+    while (end - begin <= precision) {
+        *--begin = '0';
+    }
+    char* p = buf;
+    if (signbit(v)) {
+        *p++ = '-';
+    }
+    const std::size_t whole = end - begin - precision;
+    memcpy(p, begin, whole);
+    p += whole;
+    if (precision > 0) {
+        *p++ = '.';
+        memcpy(p, begin + whole, precision);
+        p += precision;
+    }
+    *n = p - buf;
+    return true;
+}
+
+void writeDouble(FormatWriter* out, const Spec& spec, double v) {
+    char buf[512];
+    char* body = buf;
+    std::size_t n;
+    std::string big;
+    const bool negative = signbit(v);
+    if (spec.type == 0 && spec.precision < 0) {
+        n = FormatShortest(v, buf);
+    } else if ((spec.type != 'f' && spec.type != 'F') || spec.alt
+               || !formatFixed(v, spec.precision >= 0 ? spec.precision : 6, buf, &n)) {
+        // correct rounding of the doubtful cases is what snprintf is good at
+        char format[16];
+        char* p = format;
+        *p++ = '%';
+        if (spec.alt) {
+            *p++ = '#';
+        }
+        *p++ = '.';
+        *p++ = '*';
+        *p++ = spec.type != 0 ? spec.type : 'g';
+        *p = '\0';
+        const int precision = spec.precision >= 0 ? spec.precision : 6;
+        const int len = snprintf(buf, sizeof(buf), format, precision, v);
+        if (len < 0) {
+            return;
+        }
+        n = len;
+        if (n >= sizeof(buf)) {
+            big.resize(n + 1);
+            snprintf(&big[0], n + 1, format, precision, v);
+            body = &big[0];
+        }
+    }
+    // the sign goes in front of the zeros
+    char prefix[1];
+    std::size_t prefix_n = 0;
+    if (negative && body[0] == '-') {
+        prefix[prefix_n++] = '-';
+        ++body;
+        --n;
+    } else if (!negative && spec.sign != 0 && body[0] != 'n') {
+        prefix[prefix_n++] = spec.sign;
+    }
+    writePadded(out, spec, prefix, prefix_n, body, n, '>');
+}
+
+void writeArg(FormatWriter* out, const Spec& spec, const FormatArg& arg) {
+    switch (arg.kind) {
+    case 'i':
+        if (spec.type == 0 && spec.width == 0 && spec.sign == 0) {
+            char buf[24];
+            char* end = buf + sizeof(buf);
+            char* begin = FormatDecimal(arg.i < 0 ? 0 - static_cast<uint64_t>(arg.i) : arg.i, end);
+            if (arg.i < 0) {
+                *--begin = '-';
+            }
+            out->Append(begin, end - begin);
+            return;
+        }
+        writeInteger(out, spec, arg.i < 0 ? 0 - static_cast<uint64_t>(arg.i) : arg.i, arg.i < 0);
+        return;
+    case 'u':
+        writeInteger(out, spec, arg.u, false);
+        return;
+    case 'c':
+        if (spec.type == 0 || spec.type == 'c') {
+            const char c = static_cast<char>(arg.i);
+            writePadded(out, spec, "", 0, &c, 1, '<');
+        } else {
+            writeInteger(out, spec, arg.i < 0 ? 0 - static_cast<uint64_t>(arg.i) : arg.i,
+                         arg.i < 0);
+        }
+        return;
+    case 'b':
+        if (spec.type == 'd') {
+            writeInteger(out, spec, arg.u, false);
+        } else {
+            writeString(out, spec, arg.u ? "true" : "false", arg.u ? 4 : 5);
+        }
+        return;
+    case 'f':
+        writeDouble(out, spec, arg.d);
+        return;
+    case 's':
+        writeString(out, spec, static_cast<const char*>(arg.p), arg.size);
+        return;
+    case 'p': {
+        Spec hex = spec;
+        hex.type = 'x';
+        hex.alt = true;
+        writeInteger(out, hex, reinterpret_cast<uintptr_t>(arg.p), false);
+        return;
+    }
+    default:
+        return;
+    }
+}
+
+// Appends to a std::string, resized ahead and cut back when done.
+class StringWriter : public FormatWriter {
+public:
+    explicit StringWriter(std::string* s) : s_(s), base_(s->size()) {
+        s_->resize(std::max<std::size_t>(s_->capacity(), base_ + 64));
+        reset(0);
+    }
+
+    ~StringWriter() {
+        s_->resize(base_ + (cur_ - begin_));
+    }
+
+protected:
+    void grow(std::size_t n) override {
+        const std::size_t used = cur_ - begin_;
+        s_->resize(std::max(2 * s_->size(), base_ + used + n));
+        reset(used);
+    }
+
+private:
+    void reset(std::size_t used) {
+        begin_ = &(*s_)[0] + base_;
+        cur_ = begin_ + used;
+        end_ = &(*s_)[0] + s_->size();
+    }
+
+private:
+    std::string* s_;
+    std::size_t base_;
+};
+
+// Fills a caller's buffer, keeping a byte for the NUL, and counts the rest.
+class FixedWriter : public FormatWriter {
+public:
+    FixedWriter(char* buf, std::size_t cap) {
+        begin_ = buf;
+        cur_ = buf;
+        end_ = cap == 0 ? buf : buf + cap - 1;
+    }
+
+    void Finish(std::size_t cap) {
+        if (cap != 0) {
+            *cur_ = '\0';
+        }
+    }
+
+protected:
+    void grow(std::size_t) override {}
+};
+
+}  // end of anonymous namespace
+
+void FormatWriter::appendSlow(const char* p, std::size_t n) {
+    grow(n);
+    const std::size_t room = end_ - cur_;
+    const std::size_t k = n < room ? n : room;
+    memcpy(cur_, p, k);
+    cur_ += k;
+    lost_ += n - k;
+}
+
+void FormatWriter::Fill(char c, std::size_t n) {
+    if (static_cast<std::size_t>(end_ - cur_) < n) {
+        grow(n);
+    }
+    const std::size_t room = end_ - cur_;
+    const std::size_t k = n < room ? n : room;
+    memset(cur_, c, k);
+    cur_ += k;
+    lost_ += n - k;
+}
+
+std::size_t FormatShortest(double v, char* buf) {
+    char* p = buf;
+    if (signbit(v)) {
+        *p++ = '-';
+        v = -v;
+    }
+    if (isnan(v)) {
+        memcpy(buf, "nan", 3);
+        return 3;
+    }
+    if (isinf(v)) {
+        memcpy(p, "inf", 3);
+        return p + 3 - buf;
+    }
+    if (v == 0) {
+        *p++ = '0';
+        return p - buf;
+    }
+    char digits[24];
+    int len;
+    int k;
+    if (!grisu3(v, digits, &len, &k)) {
+        exactShortest(v, digits, &len, &k);
+    }
+    // v = 0.digits * 10^point
+    const int point = len + k;
+    if (point - 1 < -4 || point - 1 >= 16) {
+        *p++ = digits[0];
+        if (len > 1) {
+            *p++ = '.';
+            memcpy(p, digits + 1, len - 1);
+            p += len - 1;
+        }
+        return writeExponent(point - 1, p) - buf;
+    }
+    if (k >= 0) {
+        // 1200
+        memcpy(p, digits, len);
+        p += len;
+        memset(p, '0', k);
+        return p + k - buf;
+    }
+    if (point > 0) {
+        // 12.34
+        memcpy(p, digits, point);
+        p += point;
+        *p++ = '.';
+        memcpy(p, digits + point, len - point);
+        return p + len - point - buf;
+    }
+    // 0.0012
+    *p++ = '0';
+    *p++ = '.';
+    memset(p, '0', -point);
+    p += -point;
+    memcpy(p, digits, len);
+    return p + len - buf;
+}
+
+namespace internal {
+
+void FormatArgs(FormatWriter* out, const char* format, const FormatArg* args, std::size_t n) {
+    std::size_t next = 0;
+    const char* p = format;
+    for (;;) {
+        const char* q = p;
+        while (*q != '\0' && *q != '{' && *q != '}') {
+            ++q;
+        }
+        out->Append(p, q - p);
+        if (*q == '\0') {
+            return;
+        }
+        // {{ and }}, or a } alone taken as it is
+        if (q[1] == *q || *q == '}') {
+            out->Push(*q);
+            p = q + (q[1] == *q ? 2 : 1);
+            continue;
+        }
+        Spec spec;
+        const char* end = parseSpec(q + 1, &spec);
+        if (end == nullptr || next == n) {
+            out->Push('{');
+            p = q + 1;
+            continue;
+        }
+        writeArg(out, spec, args[next++]);
+        p = end;
+    }
+}
+
+void AppendArgs(std::string* out, const char* format, const FormatArg* args, std::size_t n) {
+    StringWriter writer(out);
+    FormatArgs(&writer, format, args, n);
+}
+
+std::size_t FormatArgsTo(char* buf, std::size_t cap, const char* format,
+                         const FormatArg* args, std::size_t n) {
+    FixedWriter writer(buf, cap);
+    FormatArgs(&writer, format, args, n);
+    writer.Finish(cap);
+    return writer.Size();
+}
+
+}  // end of namespace internal
+
+}  // end of namespace cg
@@ -1 +1,452 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
 #pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "include/macros.h"
+#include "include/slice.h"
+#include "mem/arena.h"
+
+// Formatting with "{}" fields instead of printf conversions:
+//
+//   std::string s = CG_FORMAT("{} took {:.3f} ms, {:>8} left", name, ms, n);
+//
+// A field is {} or {:spec}, spec being [[fill]align][sign][#][0][width]
+// [.precision][type] as in Python: align is < > ^, sign + or space, # adds
+// 0x/0/0b, 0 pads numbers with zeros. Types: integers d x X o b c, floats
+// f F e E g G, strings s, pointers p. {{ and }} are literal braces.
+//
+// Without a type a double gets the shortest text that reads back as the
+// same double. Fields are taken in order, there are no indexes.
+//
+// The CG_FORMAT macros check the format against the argument types at
+// compile time. The functions only check at run time: a field without an
+// argument or with a broken spec is copied as it is, and a type that does
+// not suit the argument is ignored.
+
+namespace cg {
+
+// Where formatted text goes: the window [begin_, end_) is filled, grow is
+// called once it is full.
+class FormatWriter {
+public:
+    FormatWriter(const FormatWriter&) = delete;
+
+    FormatWriter& operator=(const FormatWriter&) = delete;
+
+    void Append(const char* p, std::size_t n) {
+        if (LIKELY(n <= static_cast<std::size_t>(end_ - cur_))) {
+            memcpy(cur_, p, n);
+            cur_ += n;
+            return;
+        }
+        appendSlow(p, n);
+    }
+
+    void Push(char c) {
+        if (LIKELY(cur_ != end_)) {
+            *cur_++ = c;
+            return;
+        }
+        appendSlow(&c, 1);
+    }
+
+    void Fill(char c, std::size_t n);
+
+    // bytes formatted, those a fixed buffer had no room for included
+    std::size_t Size() const {
+        return cur_ - begin_ + lost_;
+    }
+
+protected:
+    FormatWriter() : begin_(nullptr), cur_(nullptr), end_(nullptr), lost_(0) {}
+
+    virtual ~FormatWriter() {}
+
+    // room for at least n more bytes; a writer leaving end_ alone truncates
+    virtual void grow(std::size_t n) = 0;
+
+protected:
+    char* begin_;
+    char* cur_;
+    char* end_;
+    std::size_t lost_;
+
+private:
+    void appendSlow(const char* p, std::size_t n);
+};
+
+// Text on the stack up to N bytes, on the heap past that.
+template <std::size_t N = 256>
+class FormatBuffer : public FormatWriter {
+public:
+    FormatBuffer() {
+        begin_ = inline_;
+        cur_ = inline_;
+        end_ = inline_ + N;
+    }
+
+    const char* Data() const {
+        return begin_;
+    }
+
+    Slice ToSlice() const {
+        return Slice(begin_, cur_ - begin_);
+    }
+
+    std::string ToString() const {
+        return std::string(begin_, cur_ - begin_);
+    }
+
+    void Clear() {
+        cur_ = begin_;
+    }
+
+protected:
+    void grow(std::size_t n) override {
+        const std::size_t size = cur_ - begin_;
+        const std::size_t cap = std::max<std::size_t>(2 * (end_ - begin_), size + n);
+        std::unique_ptr<char[]> heap(new char[cap]);
+        memcpy(heap.get(), begin_, size);
+        heap_ = std::move(heap);
+        begin_ = heap_.get();
+        cur_ = begin_ + size;
+        end_ = begin_ + cap;
+    }
+
+private:
+    char inline_[N];
+    std::unique_ptr<char[]> heap_;
+};
+
+// Shortest text of v that strtod turns back into v, like 0.1, 1e+100 or
+// 123.456, the closest to v of those; up to 25 chars, no terminating NUL.
+// Returns the length.
+std::size_t FormatShortest(double v, char* buf);
+
+// An argument with its type erased, so that one function formats them all.
+struct FormatArg {
+    // the kind chars of FormatValue
+    char kind;
+    union {
+        int64_t i;
+        uint64_t u;
+        double d;
+        const void* p;
+    };
+    std::size_t size;  // of the string at p
+};
+
+// Kind and FormatArg of an argument type: i/u signed/unsigned integer,
+// c char, b bool, f floating point, s string, p pointer.
+template <typename T, typename Enable = void>
+struct FormatValue;
+
+template <typename T>
+struct FormatValue<T, typename std::enable_if<std::is_integral<T>::value
+                                              && std::is_signed<T>::value>::type> {
+    static constexpr char kKind = 'i';
+
+    static FormatArg Make(T v) {
+        FormatArg arg;
+        arg.kind = kKind;
+        arg.i = v;
+        return arg;
+    }
+};
+
+template <typename T>
+struct FormatValue<T, typename std::enable_if<std::is_integral<T>::value
+                                              && !std::is_signed<T>::value>::type> {
+    static constexpr char kKind = 'u';
+
+    static FormatArg Make(T v) {
+        FormatArg arg;
+        arg.kind = kKind;
+        arg.u = v;
+        return arg;
+    }
+};
+
+template <>
+struct FormatValue<char> {
+    static constexpr char kKind = 'c';
+
+    static FormatArg Make(char v) {
+        FormatArg arg;
+        arg.kind = kKind;
+        arg.i = v;
+        return arg;
+    }
+};
+
+template <>
+struct FormatValue<bool> {
+    static constexpr char kKind = 'b';
+
+    static FormatArg Make(bool v) {
+        FormatArg arg;
+        arg.kind = kKind;
+        arg.u = v;
+        return arg;
+    }
+};
+
+template <typename T>
+struct FormatValue<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+    static constexpr char kKind = 'f';
+
+    static FormatArg Make(T v) {
+        FormatArg arg;
+        arg.kind = kKind;
+        arg.d = v;
+        return arg;
+    }
+};
+
+template <typename T>
+struct FormatValue<T*> {
+    static constexpr char kKind = 'p';
+
+    static FormatArg Make(const T* v) {
+        FormatArg arg;
+        arg.kind = kKind;
+        arg.p = v;
+        return arg;
+    }
+};
+
+template <>
+struct FormatValue<std::nullptr_t> : FormatValue<void*> {};
+
+struct FormatString {
+    static constexpr char kKind = 's';
+
+    static FormatArg Make(const char* p, std::size_t n) {
+        FormatArg arg;
+        arg.kind = kKind;
+        arg.p = p;
+        arg.size = n;
+        return arg;
+    }
+
+    static FormatArg Make(const char* s) {
+        return s == nullptr ? Make("(null)", 6) : Make(s, strlen(s));
+    }
+};
+
+template <>
+struct FormatValue<const char*> : FormatString {};
+
+template <>
+struct FormatValue<char*> : FormatString {};
+
+template <>
+struct FormatValue<std::string> : FormatString {
+    static FormatArg Make(const std::string& s) {
+        return FormatString::Make(s.data(), s.size());
+    }
+};
+
+template <>
+struct FormatValue<Slice> : FormatString {
+    static FormatArg Make(const Slice& s) {
+        return FormatString::Make(s.Data(), s.Size());
+    }
+};
+
+template <typename T>
+struct FormatValueOf : FormatValue<typename std::decay<T>::type> {};
+
+namespace internal {
+
+void FormatArgs(FormatWriter* out, const char* format, const FormatArg* args, std::size_t n);
+
+void AppendArgs(std::string* out, const char* format, const FormatArg* args, std::size_t n);
+
+std::size_t FormatArgsTo(char* buf, std::size_t cap, const char* format,
+                         const FormatArg* args, std::size_t n);
+
+}  // end of namespace internal
+
+// The empty FormatArg at the end of the lists keeps the array of no argument
+// valid.
+template <typename... Args>
+void FormatTo(FormatWriter* out, const char* format, const Args&... args) {
+    const FormatArg list[] = {FormatValueOf<Args>::Make(args)..., FormatArg()};
+    internal::FormatArgs(out, format, list, sizeof...(Args));
+}
+
+// Like snprintf: writes at most cap - 1 bytes and a NUL, returns the size
+// of the whole text.
+template <typename... Args>
+std::size_t FormatTo(char* buf, std::size_t cap, const char* format, const Args&... args) {
+    const FormatArg list[] = {FormatValueOf<Args>::Make(args)..., FormatArg()};
+    return internal::FormatArgsTo(buf, cap, format, list, sizeof...(Args));
+}
+
+template <typename... Args>
+void FormatAppend(std::string* out, const char* format, const Args&... args) {
+    const FormatArg list[] = {FormatValueOf<Args>::Make(args)..., FormatArg()};
+    internal::AppendArgs(out, format, list, sizeof...(Args));
+}
+
+template <typename... Args>
+std::string Format(const char* format, const Args&... args) {
+    std::string out;
+    FormatAppend(&out, format, args...);
+    return out;
+}
+
+// the text is owned by arena
+template <typename... Args>
+Slice FormatArena(Arena* arena, const char* format, const Args&... args) {
+    FormatBuffer<> buf;
+    FormatTo(&buf, format, args...);
+    return arena->Copy(buf.ToSlice());
+}
+
+// Compile time check of a format string against the kinds of its arguments.
+// C++11 constexpr functions are one return statement, hence the recursion
+// over the format, one call per char: formats up to a few hundred chars.
+namespace internal {
+
+enum FormatError {
+    FORMAT_OK = 0,
+    FORMAT_TOO_FEW_ARGS,
+    FORMAT_TOO_MANY_ARGS,
+    FORMAT_BAD_BRACE,
+    FORMAT_BAD_SPEC,
+    FORMAT_BAD_PRECISION,
+    FORMAT_BAD_TYPE,
+};
+
+template <typename... Args>
+struct FormatKinds {
+    static constexpr char kValue[sizeof...(Args) + 1] = {FormatValueOf<Args>::kKind..., '\0'};
+};
+
+template <typename... Args>
+constexpr char FormatKinds<Args...>::kValue[sizeof...(Args) + 1];
+
+// only named in decltype, the arguments are not evaluated
+template <typename... Args>
+FormatKinds<Args...> FormatKindList(const Args&...);
+
+constexpr bool FormatIsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+constexpr bool FormatIsAlign(char c) {
+    return c == '<' || c == '>' || c == '^';
+}
+
+constexpr const char* FormatSkipDigits(const char* p) {
+    return FormatIsDigit(*p) ? FormatSkipDigits(p + 1) : p;
+}
+
+constexpr const char* FormatSkipFill(const char* p) {
+    return *p != '\0' && *p != '}' && FormatIsAlign(p[1]) ? p + 2 : FormatIsAlign(*p) ? p + 1 : p;
+}
+
+constexpr const char* FormatSkipSign(const char* p) {
+    return *p == '+' || *p == ' ' || *p == '-' ? p + 1 : p;
+}
+
+constexpr const char* FormatSkipChar(const char* p, char c) {
+    return *p == c ? p + 1 : p;
+}
+
+// flags and width of a spec, p just after its ':'
+constexpr const char* FormatSkipWidth(const char* p) {
+    return FormatSkipDigits(FormatSkipChar(FormatSkipChar(FormatSkipSign(FormatSkipFill(p)),
+                                                          '#'), '0'));
+}
+
+constexpr bool FormatTypeFits(char type, char kind) {
+    return kind == 'i' || kind == 'u' ? type == 'd' || type == 'x' || type == 'X' || type == 'o'
+                                        || type == 'b' || type == 'c'
+        : kind == 'c' ? type == 'c' || type == 'd' || type == 'x' || type == 'X' || type == 'o'
+        : kind == 'b' ? type == 's' || type == 'd'
+        : kind == 'f' ? type == 'f' || type == 'F' || type == 'e' || type == 'E' || type == 'g'
+                        || type == 'G'
+        : kind == 's' ? type == 's'
+        : kind == 'p' ? type == 'p'
+        : false;
+}
+
+constexpr int CheckFormat(const char* f, const char* kinds);
+
+// p at the type or the closing brace
+constexpr int CheckFormatType(const char* p, const char* kinds) {
+    return *p == '}' ? CheckFormat(p + 1, kinds + 1)
+        : *p == '\0' || p[1] != '}' ? FORMAT_BAD_SPEC
+        : !FormatTypeFits(*p, *kinds) ? FORMAT_BAD_TYPE
+        : CheckFormat(p + 2, kinds + 1);
+}
+
+// p after the width
+constexpr int CheckFormatPrecision(const char* p, const char* kinds) {
+    return *p != '.' ? CheckFormatType(p, kinds)
+        : !FormatIsDigit(p[1]) ? FORMAT_BAD_SPEC
+        : *kinds != 'f' && *kinds != 's' ? FORMAT_BAD_PRECISION
+        : CheckFormatType(FormatSkipDigits(p + 1), kinds);
+}
+
+// p just after the opening brace
+constexpr int CheckFormatField(const char* p, const char* kinds) {
+    return *kinds == '\0' ? FORMAT_TOO_FEW_ARGS
+        : *p == '}' ? CheckFormat(p + 1, kinds + 1)
+        : *p != ':' ? FORMAT_BAD_SPEC
+        : CheckFormatPrecision(FormatSkipWidth(p + 1), kinds);
+}
+
+constexpr int CheckFormat(const char* f, const char* kinds) {
+    return *f == '\0' ? (*kinds == '\0' ? FORMAT_OK : FORMAT_TOO_MANY_ARGS)
+        : *f == '{' ? (f[1] == '{' ? CheckFormat(f + 2, kinds) : CheckFormatField(f + 1, kinds))
+        : *f == '}' ? (f[1] == '}' ? CheckFormat(f + 2, kinds) : FORMAT_BAD_BRACE)
+        : CheckFormat(f + 1, kinds);
+}
+
+template <int kError>
+struct FormatCheck {
+    static_assert(kError != FORMAT_TOO_FEW_ARGS, "format has more fields than arguments");
+    static_assert(kError != FORMAT_TOO_MANY_ARGS, "format has fewer fields than arguments");
+    static_assert(kError != FORMAT_BAD_BRACE, "format has a } without {, write }} for one");
+    static_assert(kError != FORMAT_BAD_SPEC, "format has a malformed {:spec}");
+    static_assert(kError != FORMAT_BAD_PRECISION, "precision is for floats and strings");
+    static_assert(kError != FORMAT_BAD_TYPE, "type of a {:spec} does not suit its argument");
+
+    static const char* Checked(const char* format) {
+        return format;
+    }
+};
+
+}  // end of namespace internal
+
+}  // end of namespace cg
+
+// format, checked against the types of the arguments at compile time
+#define CG_FORMAT_CHECKED(format, ...) \
+    cg::internal::FormatCheck<cg::internal::CheckFormat( \
+            format, decltype(cg::internal::FormatKindList(__VA_ARGS__))::kValue)>::Checked(format)
+
+#define CG_FORMAT(format, ...) \
+    cg::Format(CG_FORMAT_CHECKED(format, ##__VA_ARGS__), ##__VA_ARGS__)
+#define CG_FORMAT_APPEND(out, format, ...) \
+    cg::FormatAppend(out, CG_FORMAT_CHECKED(format, ##__VA_ARGS__), ##__VA_ARGS__)
+// out is a FormatWriter*
+#define CG_FORMAT_TO(out, format, ...) \
+    cg::FormatTo(out, CG_FORMAT_CHECKED(format, ##__VA_ARGS__), ##__VA_ARGS__)
+#define CG_FORMAT_ARENA(arena, format, ...) \
+    cg::FormatArena(arena, CG_FORMAT_CHECKED(format, ##__VA_ARGS__), ##__VA_ARGS__)
@@ -0,0 +1,136 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <stdio.h>
+
+#include <sstream>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "string/format.h"
+
+namespace cg {
+namespace {
+
+// The same text three ways: integers, doubles and a log like mix.
+const int kInts[] = {7, -42, 123456, -2000000000, 99};
+const double kDoubles[] = {0.1, -3.25, 123456.789, 1e-7, 2.0 / 3};
+
+void BM_FormatInts(benchmark::State& state) {
+    char buf[128];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(FormatTo(buf, sizeof(buf), "{} {} {} {} {}", kInts[0], kInts[1],
+                                          kInts[2], kInts[3], kInts[4]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_SnprintfInts(benchmark::State& state) {
+    char buf[128];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(snprintf(buf, sizeof(buf), "%d %d %d %d %d", kInts[0], kInts[1],
+                                          kInts[2], kInts[3], kInts[4]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_StringstreamInts(benchmark::State& state) {
+    for (auto _ : state) {
+        std::ostringstream os;
+        os << kInts[0] << ' ' << kInts[1] << ' ' << kInts[2] << ' ' << kInts[3] << ' '
+           << kInts[4];
+        benchmark::DoNotOptimize(os.str());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_FormatDoubles(benchmark::State& state) {
+    char buf[128];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(FormatTo(buf, sizeof(buf), "{} {} {} {} {}", kDoubles[0],
+                                          kDoubles[1], kDoubles[2], kDoubles[3], kDoubles[4]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// %.17g is what snprintf needs to round-trip every double
+void BM_SnprintfDoubles(benchmark::State& state) {
+    char buf[128];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(snprintf(buf, sizeof(buf), "%.17g %.17g %.17g %.17g %.17g",
+                                          kDoubles[0], kDoubles[1], kDoubles[2], kDoubles[3],
+                                          kDoubles[4]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_FormatFixedDoubles(benchmark::State& state) {
+    char buf[128];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(FormatTo(buf, sizeof(buf), "{:.3f} {:.3f} {:.3f} {:.3f} {:.3f}",
+                                          kDoubles[0], kDoubles[1], kDoubles[2], kDoubles[3],
+                                          kDoubles[4]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_StringstreamDoubles(benchmark::State& state) {
+    for (auto _ : state) {
+        std::ostringstream os;
+        os.precision(17);
+        os << kDoubles[0] << ' ' << kDoubles[1] << ' ' << kDoubles[2] << ' ' << kDoubles[3] << ' '
+           << kDoubles[4];
+        benchmark::DoNotOptimize(os.str());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_FormatMixed(benchmark::State& state) {
+    const std::string name = "crontab";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CG_FORMAT("job {} ran {:>6} times in {:.2f} ms, next at {:#x}",
+                                           name, kInts[2], kDoubles[2], 0xdeadbeefu));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_SnprintfMixed(benchmark::State& state) {
+    const std::string name = "crontab";
+    for (auto _ : state) {
+        char buf[128];
+        const int n = snprintf(buf, sizeof(buf), "job %s ran %6d times in %.2f ms, next at %#x",
+                               name.c_str(), kInts[2], kDoubles[2], 0xdeadbeefu);
+        benchmark::DoNotOptimize(std::string(buf, n));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_StringstreamMixed(benchmark::State& state) {
+    const std::string name = "crontab";
+    for (auto _ : state) {
+        std::ostringstream os;
+        os << "job " << name << " ran ";
+        os.width(6);
+        os << kInts[2] << " times in ";
+        os.setf(std::ios::fixed);
+        os.precision(2);
+        os << kDoubles[2] << " ms, next at " << std::showbase << std::hex << 0xdeadbeefu;
+        benchmark::DoNotOptimize(os.str());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_FormatInts);
+BENCHMARK(BM_SnprintfInts);
+BENCHMARK(BM_StringstreamInts);
+BENCHMARK(BM_FormatDoubles);
+BENCHMARK(BM_SnprintfDoubles);
+BENCHMARK(BM_FormatFixedDoubles);
+BENCHMARK(BM_StringstreamDoubles);
+BENCHMARK(BM_FormatMixed);
+BENCHMARK(BM_SnprintfMixed);
+BENCHMARK(BM_StringstreamMixed);
+
+}  // end of anonymous namespace
+}  // end of namespace cg
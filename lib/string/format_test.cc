@@ -0,0 +1,225 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "string/format.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <limits>
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class FormatTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    static std::string shortest(double v) {
+        char buf[32];
+        return std::string(buf, FormatShortest(v, buf));
+    }
+};
+
+TEST_F(FormatTest, Integers) {
+    EXPECT_EQ("0 1 -1 42", CG_FORMAT("{} {} {} {}", 0, 1, -1, 42));
+    EXPECT_EQ("9223372036854775807 -9223372036854775808",
+              CG_FORMAT("{} {}", std::numeric_limits<int64_t>::max(),
+                        std::numeric_limits<int64_t>::min()));
+    EXPECT_EQ("18446744073709551615", CG_FORMAT("{}", std::numeric_limits<uint64_t>::max()));
+    EXPECT_EQ("255 ff FF 377 11111111", CG_FORMAT("{} {:x} {:X} {:o} {:b}", 255, 255, 255, 255,
+                                                  255u));
+    EXPECT_EQ("0xff 0377 0b101", CG_FORMAT("{:#x} {:#o} {:#b}", 255, 255, 5));
+    EXPECT_EQ("-ff", CG_FORMAT("{:x}", -255));
+    EXPECT_EQ("A", CG_FORMAT("{:c}", 65));
+    for (int64_t v = 1; v > 0 && v < std::numeric_limits<int64_t>::max() / 3; v = v * 3 + 1) {
+        EXPECT_EQ(std::to_string(v), Format("{}", v));
+        EXPECT_EQ(std::to_string(-v), Format("{}", -v));
+    }
+}
+
+TEST_F(FormatTest, Widths) {
+    EXPECT_EQ("   42", CG_FORMAT("{:5}", 42));
+    EXPECT_EQ("42   ", CG_FORMAT("{:<5}", 42));
+    EXPECT_EQ(" 42  ", CG_FORMAT("{:^5}", 42));
+    EXPECT_EQ("*42**", CG_FORMAT("{:*^5}", 42));
+    EXPECT_EQ("00042", CG_FORMAT("{:05}", 42));
+    EXPECT_EQ("-0042", CG_FORMAT("{:05}", -42));
+    EXPECT_EQ("+42 -42  42", CG_FORMAT("{:+} {:+} {: }", 42, -42, 42));
+    EXPECT_EQ("0x002a", CG_FORMAT("{:#06x}", 42));
+    EXPECT_EQ("ab   |   ab", CG_FORMAT("{:5}|{:>5}", "ab", "ab"));
+    EXPECT_EQ("x    ", CG_FORMAT("{:5}", 'x'));
+    EXPECT_EQ("12", CG_FORMAT("{:1}", 12));
+}
+
+TEST_F(FormatTest, Others) {
+    const std::string s = "string";
+    const char* null = nullptr;
+    EXPECT_EQ("string slice char* (null)", CG_FORMAT("{} {} {} {}", s, Slice("slice"),
+                                                    const_cast<char*>("char*"), null));
+    EXPECT_EQ("str", CG_FORMAT("{:.3}", s));
+    EXPECT_EQ("true false 1", CG_FORMAT("{} {} {:d}", true, false, true));
+    EXPECT_EQ("c", CG_FORMAT("{}", 'c'));
+    EXPECT_EQ("99", CG_FORMAT("{:d}", 'c'));
+    EXPECT_EQ("0x1234", CG_FORMAT("{}", reinterpret_cast<void*>(0x1234)));
+    EXPECT_EQ("0x0", CG_FORMAT("{}", nullptr));
+    EXPECT_EQ("{} {x}", CG_FORMAT("{{}} {{{}}}", 'x'));
+    EXPECT_EQ("no fields", CG_FORMAT("no fields"));
+}
+
+TEST_F(FormatTest, Floats) {
+    EXPECT_EQ("0 -0 1 -1.5 0.1 100 1e+16 1e-05 0.0001 123.456",
+              CG_FORMAT("{} {} {} {} {} {} {} {} {} {}", 0.0, -0.0, 1.0, -1.5, 0.1, 100.0, 1e16,
+                        1e-5, 1e-4, 123.456));
+    EXPECT_EQ("1e+100 1.7976931348623157e+308 5e-324 2.2250738585072014e-308",
+              CG_FORMAT("{} {} {} {}", 1e100, DBL_MAX, 4.9e-324, DBL_MIN));
+    EXPECT_EQ("nan inf -inf", CG_FORMAT("{} {} {}", NAN, INFINITY, -INFINITY));
+    EXPECT_EQ("0.5 0.10000000149011612", CG_FORMAT("{} {}", 0.5f, 0.1f));
+    EXPECT_EQ("3.142 3.14159 3.141593e+00 3.1", CG_FORMAT("{:.3f} {:g} {:e} {:.2}", M_PI, M_PI,
+                                                          M_PI, M_PI));
+    EXPECT_EQ("  1.50|+1.5|-01.5", CG_FORMAT("{:6.2f}|{:+}|{:05}", 1.5, 1.5, -1.5));
+    const std::string big = CG_FORMAT("{:.3f}", 1e300);
+    EXPECT_EQ(305U, big.size());
+    char expected[400];
+    snprintf(expected, sizeof(expected), "%.3f", 1e300);
+    EXPECT_EQ(expected, big);
+}
+
+// {:.Nf} takes a path of its own when the rounding is clear.
+TEST_F(FormatTest, FixedMatchesSnprintf) {
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    const char* formats[] = {"{:.0f}", "{:.1f}", "{:.2f}", "{:.3f}", "{:.4f}", "{:.5f}",
+                             "{:.6f}", "{:.7f}", "{:.8f}"};
+    char expected[64];
+    for (int i = 0; i < 100000; ++i) {
+        double v = dist(rng);
+        if (i % 3 == 0) {
+            v = static_cast<double>(static_cast<int64_t>(v)) / 1000 + 0.0005;
+        }
+        const int precision = i % 9;
+        snprintf(expected, sizeof(expected), "%.*f", precision, v);
+        ASSERT_EQ(expected, Format(formats[precision], v));
+    }
+}
+
+// The significant digits of %.17g trimmed to the fewest that read back.
+std::string shortestSnprintf(double v) {
+    char buf[32];
+    for (int precision = 1; precision <= 17; ++precision) {
+        snprintf(buf, sizeof(buf), "%.*e", precision - 1, v);
+        if (strtod(buf, nullptr) == v) {
+            break;
+        }
+    }
+    std::string digits;
+    for (const char* p = buf; *p != 'e'; ++p) {
+        if (*p >= '0' && *p <= '9') {
+            digits.push_back(*p);
+        }
+    }
+    return digits.substr(0, digits.find_last_not_of('0') + 1);
+}
+
+// the digits of a FormatShortest text, without the zeros of 0.001 or 1200
+std::string significant(const std::string& s) {
+    std::string digits;
+    for (std::size_t i = 0; i < s.size() && s[i] != 'e'; ++i) {
+        if (s[i] >= '0' && s[i] <= '9' && (s[i] != '0' || !digits.empty())) {
+            digits.push_back(s[i]);
+        }
+    }
+    return digits.substr(0, digits.find_last_not_of('0') + 1);
+}
+
+TEST_F(FormatTest, Shortest) {
+    // Grisu2 gave 4.1752050594835004e+78
+    EXPECT_EQ("4.1752050594835e+78", shortest(4.1752050594835004e+78));
+    EXPECT_EQ("5e-324", shortest(5e-324));
+    EXPECT_EQ("2.2250738585072014e-308", shortest(DBL_MIN));
+    EXPECT_EQ("9007199254740992", shortest(9007199254740992.0));
+    EXPECT_EQ("1e+23", shortest(1e23));
+}
+
+// The digits read back as the same double and are those of the shortest
+// correctly rounded %.17g that does: as few, and the closest to v. Below a
+// power of two the rounded digits may miss the uneven boundaries where a
+// neighbour of them reads back, one digit fewer than snprintf finds.
+TEST_F(FormatTest, ShortestMatchesSnprintf) {
+    std::mt19937_64 rng(42);
+    for (int i = 0; i < 200000; ++i) {
+        uint64_t bits = rng();
+        double v;
+        memcpy(&v, &bits, sizeof(v));
+        if (!isfinite(v) || v == 0) {
+            continue;
+        }
+        if (i % 4 == 0) {
+            v = static_cast<double>(rng() % 1000000) / 1000;
+        } else if (i % 4 == 1) {
+            // the powers of two, where the boundaries are uneven
+            v = ldexp(1.0, static_cast<int>(rng() % 2098) - 1074);
+        }
+        const std::string s = shortest(v);
+        ASSERT_EQ(v, strtod(s.c_str(), nullptr)) << s;
+        int exp = 0;
+        const std::string expected = shortestSnprintf(v);
+        const std::string digits = significant(s);
+        if (digits.size() < expected.size()) {
+            ASSERT_EQ(0.0, frexp(v, &exp) - 0.5) << s;
+            continue;
+        }
+        ASSERT_EQ(expected, digits) << s;
+    }
+}
+
+TEST_F(FormatTest, RuntimeErrors) {
+    EXPECT_EQ("a {} b", Format("a {} b"));
+    EXPECT_EQ("1 {", Format("{} {", 1));
+    EXPECT_EQ("1 } 2", Format("{} } {}", 1, 2));
+    EXPECT_EQ("{:q 1", Format("{:q {}", 1));
+    EXPECT_EQ("1", Format("{}", 1, 2));
+    EXPECT_EQ("abc", Format("{:x}", "abc"));
+    EXPECT_EQ("1", Format("{:.2}", 1));
+}
+
+TEST_F(FormatTest, Outputs) {
+    char buf[8];
+    EXPECT_EQ(11U, FormatTo(buf, sizeof(buf), "{} {}", 12345, "hello"));
+    EXPECT_STREQ("12345 h", buf);
+    EXPECT_EQ(2U, FormatTo(buf, sizeof(buf), "{}", 42));
+    EXPECT_STREQ("42", buf);
+    EXPECT_EQ(2U, FormatTo(buf, 0, "{}", 42));
+
+    std::string s = "prefix:";
+    CG_FORMAT_APPEND(&s, "{}-{}", 1, 2);
+    EXPECT_EQ("prefix:1-2", s);
+    const std::string long_text(1000, 'x');
+    CG_FORMAT_APPEND(&s, "{}{:>300}", long_text, 'y');
+    EXPECT_EQ(7 + 3 + 1000 + 300U, s.size());
+    EXPECT_EQ('y', s.back());
+
+    FormatBuffer<16> fb;
+    CG_FORMAT_TO(&fb, "{} {}", 1.5, long_text);
+    EXPECT_EQ("1.5 " + long_text, fb.ToString());
+    fb.Clear();
+    CG_FORMAT_TO(&fb, "{:08.3f}", -1.0);
+    EXPECT_EQ("-001.000", fb.ToString());
+    EXPECT_EQ(8U, fb.Size());
+
+    Arena arena;
+    const Slice slice = CG_FORMAT_ARENA(&arena, "{}+{}={}", 1, 1, 2);
+    EXPECT_EQ("1+1=2", std::string(slice.Data(), slice.Size()));
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
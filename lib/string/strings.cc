@@ -0,0 +1,161 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "include/strings.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "base/cpu.h"
+
+namespace cg {
+namespace internal {
+namespace {
+
+typedef uint64_t (*MatchBlockFunc)(const char*, const ByteSet&);
+
+MatchBlockFunc pickKernel() {
+#if defined(__x86_64__)
+    if (CpuSupportsAVX2()) {
+        return MatchBlockAVX2;
+    }
+    return MatchBlockSSE2;
+#else
+    return MatchBlockScalar;
+#endif
+}
+
+#if defined(__x86_64__)
+// Lanes equal to one of the first K chars of the set; 4 lanes cover the
+// sets of up to 4 chars, the padding repeats the first one.
+template <int K>
+inline __m128i matchSSE2(__m128i x, const __m128i* c) {
+    __m128i m = _mm_cmpeq_epi8(x, c[0]);
+    for (int k = 1; k < K; ++k) {
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(x, c[k]));
+    }
+    return m;
+}
+
+template <int K>
+uint64_t matchBlockSSE2(const char* p, const char* chars) {
+    __m128i c[K];
+    for (int k = 0; k < K; ++k) {
+        c[k] = _mm_set1_epi8(chars[k]);
+    }
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+        mask |= static_cast<uint64_t>(
+                static_cast<uint32_t>(_mm_movemask_epi8(matchSSE2<K>(x, c)))) << (16 * i);
+    }
+    return mask;
+}
+
+template <int K>
+__attribute__((target("avx2")))
+inline __m256i matchAVX2(__m256i x, const __m256i* c) {
+    __m256i m = _mm256_cmpeq_epi8(x, c[0]);
+    for (int k = 1; k < K; ++k) {
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(x, c[k]));
+    }
+    return m;
+}
+
+template <int K>
+__attribute__((target("avx2")))
+uint64_t matchBlockAVX2(const char* p, const char* chars) {
+    __m256i c[K];
+    for (int k = 0; k < K; ++k) {
+        c[k] = _mm256_set1_epi8(chars[k]);
+    }
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+    const uint32_t m0 = static_cast<uint32_t>(_mm256_movemask_epi8(matchAVX2<K>(lo, c)));
+    const uint32_t m1 = static_cast<uint32_t>(_mm256_movemask_epi8(matchAVX2<K>(hi, c)));
+    return static_cast<uint64_t>(m1) << 32 | m0;
+}
+#endif
+
+}  // end of anonymous namespace
+
+uint64_t MatchBlockScalar(const char* p, const ByteSet& set) {
+    uint64_t mask = 0;
+    for (int i = 0; i < 64; ++i) {
+        mask |= static_cast<uint64_t>(set.Contains(p[i])) << i;
+    }
+    return mask;
+}
+
+#if defined(__x86_64__)
+uint64_t MatchBlockSSE2(const char* p, const ByteSet& set) {
+    if (set.Count() == 1) {
+        return matchBlockSSE2<1>(p, set.Chars());
+    }
+    if (set.Count() <= 4) {
+        return matchBlockSSE2<4>(p, set.Chars());
+    }
+    return matchBlockSSE2<8>(p, set.Chars());
+}
+
+__attribute__((target("avx2")))
+uint64_t MatchBlockAVX2(const char* p, const ByteSet& set) {
+    if (set.Count() == 1) {
+        return matchBlockAVX2<1>(p, set.Chars());
+    }
+    if (set.Count() <= 4) {
+        return matchBlockAVX2<4>(p, set.Chars());
+    }
+    return matchBlockAVX2<8>(p, set.Chars());
+}
+#endif
+
+uint64_t MatchMask64(const char* p, std::size_t n, const ByteSet& set) {
+    static const MatchBlockFunc kernel = pickKernel();
+    if (set.Count() == 0 || n == 0) {
+        return 0;
+    }
+    if (n < 64) {
+        // short text or the tail: the kernels read whole blocks
+        if (n < 16 || set.Count() > 8) {
+            uint64_t mask = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                mask |= static_cast<uint64_t>(set.Contains(p[i])) << i;
+            }
+            return mask;
+        }
+        char block[64];
+        memcpy(block, p, n);
+        memset(block + n, 0, sizeof(block) - n);
+        return kernel(block, set) & ((1ULL << n) - 1);
+    }
+    return set.Count() > 8 ? MatchBlockScalar(p, set) : kernel(p, set);
+}
+
+std::size_t FindAnyOf(const char* p, std::size_t n, const ByteSet& set) {
+    for (std::size_t base = 0; base < n; base += 64) {
+        const uint64_t mask = MatchMask64(p + base, n - base, set);
+        if (mask != 0) {
+            return base + __builtin_ctzll(mask);
+        }
+    }
+    return n;
+}
+
+std::size_t FindNotOf(const char* p, std::size_t n, const ByteSet& set) {
+    for (std::size_t base = 0; base < n; base += 64) {
+        const std::size_t len = n - base < 64 ? n - base : 64;
+        const uint64_t valid = len == 64 ? ~0ULL : (1ULL << len) - 1;
+        const uint64_t mask = ~MatchMask64(p + base, len, set) & valid;
+        if (mask != 0) {
+            return base + __builtin_ctzll(mask);
+        }
+    }
+    return n;
+}
+
+}  // end of namespace internal
+}  // end of namespace cg
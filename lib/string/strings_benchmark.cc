@@ -0,0 +1,111 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "include/strings.h"
+
+namespace cg {
+namespace {
+
+// Log like lines of words of 1 to 12 chars.
+std::string makeText(std::size_t n, char sep) {
+    std::mt19937 rng(42);
+    std::string text;
+    while (text.size() < n) {
+        const std::size_t word = 1 + rng() % 12;
+        for (std::size_t i = 0; i < word; ++i) {
+            text.push_back(static_cast<char>('a' + rng() % 26));
+        }
+        text.push_back(rng() % 16 == 0 ? '\n' : sep);
+    }
+    return text;
+}
+
+// the find_first_of/find_first_not_of loop StringSplit used to be
+void legacySplit(const std::string& sep, const std::string& str, std::vector<std::string>* out) {
+    out->clear();
+    std::string::size_type begin = str.find_first_not_of(sep);
+    while (begin != std::string::npos) {
+        std::string::size_type end = str.find_first_of(sep, begin);
+        if (end == std::string::npos) {
+            out->emplace_back(str, begin);
+            break;
+        }
+        out->emplace_back(str, begin, end - begin);
+        begin = str.find_first_not_of(sep, end);
+    }
+}
+
+void BM_LegacySplit(benchmark::State& state) {
+    const std::string text = makeText(state.range(0), ' ');
+    std::vector<std::string> v;
+    for (auto _ : state) {
+        legacySplit(" \n", text, &v);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+void BM_SplitCopy(benchmark::State& state) {
+    const std::string text = makeText(state.range(0), ' ');
+    std::vector<std::string> v;
+    for (auto _ : state) {
+        StringSplit(" \n", text, &v);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+void BM_SplitSlice(benchmark::State& state) {
+    const std::string text = makeText(state.range(0), ' ');
+    std::vector<Slice> v;
+    for (auto _ : state) {
+        StringSplit(Slice(" \n"), Slice(text), &v);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+void BM_ForEachToken(benchmark::State& state) {
+    const std::string text = makeText(state.range(0), ' ');
+    for (auto _ : state) {
+        std::size_t bytes = 0;
+        ForEachToken(Slice(" \n"), Slice(text), [&bytes](const Slice& s) { bytes += s.Size(); });
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+// searches with the delimiters far apart: a line of a big config
+void BM_StdFindFirstOf(benchmark::State& state) {
+    std::string text(state.range(0), 'x');
+    text.back() = '#';
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(text.find_first_of("#;="));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+void BM_FindAnyOf(benchmark::State& state) {
+    std::string text(state.range(0), 'x');
+    text.back() = '#';
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(StringFindAnyOf(Slice(text), Slice("#;=")));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+BENCHMARK(BM_LegacySplit)->Arg(64)->Arg(4096);
+BENCHMARK(BM_SplitCopy)->Arg(64)->Arg(4096);
+BENCHMARK(BM_SplitSlice)->Arg(64)->Arg(4096);
+BENCHMARK(BM_ForEachToken)->Arg(64)->Arg(4096);
+BENCHMARK(BM_StdFindFirstOf)->Arg(64)->Arg(4096);
+BENCHMARK(BM_FindAnyOf)->Arg(64)->Arg(4096);
+
+}  // end of anonymous namespace
+}  // end of namespace cg
@@ -0,0 +1,171 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "include/strings.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base/cpu.h"
+#include "container/buffer.h"
+#include "container/small_vector.h"
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class StringsTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    static std::vector<std::string> tokens(const std::string& seps, const std::string& str) {
+        std::vector<Slice> v;
+        StringSplit(Slice(seps), Slice(str), &v);
+        std::vector<std::string> result;
+        for (const Slice& s : v) {
+            EXPECT_TRUE(s.Data() >= str.data() && s.Data() + s.Size() <= str.data() + str.size());
+            result.emplace_back(s.Data(), s.Size());
+        }
+        return result;
+    }
+
+    static std::vector<std::string> fields(const std::string& seps, const std::string& str) {
+        std::vector<Slice> v;
+        StringSplitFields(Slice(seps), Slice(str), &v);
+        std::vector<std::string> result;
+        for (const Slice& s : v) {
+            result.emplace_back(s.Data(), s.Size());
+        }
+        return result;
+    }
+
+    // the find_first_of/find_first_not_of loop StringSplit used to be
+    static std::vector<std::string> legacySplit(const std::string& sep, const std::string& str) {
+        std::vector<std::string> out;
+        std::string::size_type begin = str.find_first_not_of(sep);
+        while (begin != std::string::npos) {
+            std::string::size_type end = str.find_first_of(sep, begin);
+            if (end == std::string::npos) {
+                out.emplace_back(str, begin);
+                break;
+            }
+            out.emplace_back(str, begin, end - begin);
+            begin = str.find_first_not_of(sep, end);
+        }
+        return out;
+    }
+};
+
+TEST_F(StringsTest, Split) {
+    typedef std::vector<std::string> Strings;
+    EXPECT_EQ(Strings({"*/5", "1", "*", "*", "1-5"}), tokens(" ", "*/5 1  * * 1-5"));
+    EXPECT_EQ(Strings({"a", "b", "c"}), tokens(" ,", "  a, b ,,c,"));
+    EXPECT_EQ(Strings(), tokens(" ", ""));
+    EXPECT_EQ(Strings(), tokens(" ", "    "));
+    EXPECT_EQ(Strings({"abc"}), tokens("", "abc"));
+
+    EXPECT_EQ(Strings({"a", "", "b", ""}), fields(",", "a,,b,"));
+    EXPECT_EQ(Strings({""}), fields(",", ""));
+    EXPECT_EQ(Strings({"", "x"}), fields(",;", ";x"));
+
+    Strings copies;
+    StringSplit(",", "1,2,,3", &copies);
+    EXPECT_EQ(Strings({"1", "2", "3"}), copies);
+}
+
+TEST_F(StringsTest, SplitSmallVector) {
+    const std::string line = "0 12 * * 1-5 extra";
+    SmallVector<Slice, 4> v;
+    StringSplit(Slice(" "), Slice(line), &v);
+    ASSERT_EQ(6U, v.size());
+    EXPECT_FALSE(v.is_inline());
+    EXPECT_TRUE(v[4] == Slice("1-5"));
+    StringSplit(Slice(" "), Slice("a b"), &v);
+    ASSERT_EQ(2U, v.size());
+    EXPECT_TRUE(v[1] == Slice("b"));
+    SmallVector<Slice, 4> f;
+    StringSplitFields(Slice(","), Slice("a,,b"), &f);
+    EXPECT_EQ(3U, f.size());
+    EXPECT_TRUE(f.is_inline());
+}
+
+// the copies of StringSplit kept without a std::string each
+TEST_F(StringsTest, SplitBuffers) {
+    std::vector<Buffer> tokens;
+    StringSplit(",", "alpha,,beta,gamma", &tokens);
+    ASSERT_EQ(3U, tokens.size());
+    EXPECT_TRUE(tokens[0] == Slice("alpha"));
+    EXPECT_TRUE(tokens[2] == Slice("gamma"));
+    EXPECT_TRUE(tokens[1].IsInline());
+}
+
+// Texts across the 16/64 byte blocks and the set sizes of every kernel.
+TEST_F(StringsTest, SplitMatchesLegacy) {
+    std::mt19937 rng(42);
+    const std::string seps[] = {" ", ",;", " \t\r\n", "abcdefg", "0123456789", "\x80\xff"};
+    for (int i = 0; i < 3000; ++i) {
+        const std::string& sep = seps[i % 6];
+        std::string str(rng() % 300, 'x');
+        for (char& c : str) {
+            c = rng() % 4 == 0 ? sep[rng() % sep.size()] : static_cast<char>(rng());
+        }
+        ASSERT_EQ(legacySplit(sep, str), tokens(sep, str));
+        std::vector<std::string> copies;
+        StringSplit(sep, str, &copies);
+        ASSERT_EQ(legacySplit(sep, str), copies);
+        for (std::size_t pos : {std::size_t(0), str.size() / 3, str.size()}) {
+            const std::size_t any = str.find_first_of(sep, pos);
+            const std::size_t none = str.find_first_not_of(sep, pos);
+            ASSERT_EQ(any == std::string::npos ? kStringNpos : any,
+                      StringFindAnyOf(Slice(str), Slice(sep), pos));
+            ASSERT_EQ(none == std::string::npos ? kStringNpos : none,
+                      StringFindNotOf(Slice(str), Slice(sep), pos));
+        }
+    }
+}
+
+TEST_F(StringsTest, Kernels) {
+    std::mt19937 rng(7);
+    char block[64];
+    for (int i = 0; i < 1000; ++i) {
+        std::string chars(1 + i % 8, '\0');
+        for (char& c : chars) {
+            c = static_cast<char>(rng() % 16);
+        }
+        for (char& c : block) {
+            c = static_cast<char>(rng() % 16);
+        }
+        const internal::ByteSet set((Slice(chars)));
+        const uint64_t expected = internal::MatchBlockScalar(block, set);
+#if defined(__x86_64__)
+        ASSERT_EQ(expected, internal::MatchBlockSSE2(block, set));
+        if (internal::CpuSupportsAVX2()) {
+            ASSERT_EQ(expected, internal::MatchBlockAVX2(block, set));
+        }
+#endif
+    }
+}
+
+TEST_F(StringsTest, Trim) {
+    EXPECT_EQ(Slice("a b"), StringTrim(Slice(" \t a b\r\n")));
+    EXPECT_EQ(Slice("a b\r\n"), StringTrimLeft(Slice(" \t a b\r\n")));
+    EXPECT_EQ(Slice(" \t a b"), StringTrimRight(Slice(" \t a b\r\n")));
+    EXPECT_EQ(Slice(""), StringTrim(Slice("   ")));
+    EXPECT_EQ(Slice("x"), StringTrim(Slice("--x--"), Slice("-")));
+}
+
+TEST_F(StringsTest, Find) {
+    const Slice s("key = value # comment");
+    EXPECT_EQ(4U, StringFindAnyOf(s, Slice("=#")));
+    EXPECT_EQ(12U, StringFindAnyOf(s, Slice("=#"), 5));
+    EXPECT_EQ(kStringNpos, StringFindAnyOf(s, Slice("!")));
+    EXPECT_EQ(kStringNpos, StringFindAnyOf(s, Slice("k"), 100));
+    EXPECT_EQ(3U, StringFindNotOf(s, Slice("yek")));
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
@@ -0,0 +1,229 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "system/timestamp.h"
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+#include <string.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace cg {
+namespace internal {
+
+std::atomic<int64_t> g_cached_monotonic_ns(0);
+std::atomic<int64_t> g_cached_realtime_ns(0);
+
+}  // end of namespace internal
+
+namespace {
+
+class ClockUpdater {
+public:
+    // never destroyed: the thread may be running while static destructors run
+    static ClockUpdater* Instance() {
+        static ClockUpdater* updater = new ClockUpdater;
+        return updater;
+    }
+
+    void Start(int64_t interval_us) {
+        std::lock_guard<std::mutex> start_guard(start_mu_);
+        {
+            std::lock_guard<std::mutex> guard(mu_);
+            interval_us_ = interval_us > 0 ? interval_us : 1;
+            stop_ = false;
+        }
+        if (thread_.joinable()) {
+            cv_.notify_one();
+            return;
+        }
+        update();
+        thread_ = std::thread(&ClockUpdater::loop, this);
+    }
+
+    void Stop() {
+        std::lock_guard<std::mutex> start_guard(start_mu_);
+        if (!thread_.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> guard(mu_);
+            stop_ = true;
+        }
+        cv_.notify_one();
+        thread_.join();
+        internal::g_cached_monotonic_ns.store(0, std::memory_order_relaxed);
+        internal::g_cached_realtime_ns.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    ClockUpdater() : interval_us_(1000), stop_(true) {}
+
+    static void update() {
+        internal::g_cached_monotonic_ns.store(MonotonicNs(), std::memory_order_relaxed);
+        internal::g_cached_realtime_ns.store(RealtimeNs(), std::memory_order_relaxed);
+    }
+
+    void loop() {
+        std::unique_lock<std::mutex> lock(mu_);
+        while (!stop_) {
+            cv_.wait_for(lock, std::chrono::microseconds(interval_us_));
+            update();
+        }
+    }
+
+private:
+    std::mutex start_mu_;  // Start and Stop
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    int64_t interval_us_;
+    bool stop_;
+};
+
+struct TscCalibration {
+    double ticks_per_ns;
+    uint64_t base_ticks;
+    int64_t base_ns;
+};
+
+// a (tick, ns) pair read as close together as the best of a few tries
+void readPair(uint64_t* ticks, int64_t* ns) {
+    uint64_t best = ~0ULL;
+    *ticks = 0;
+    *ns = 0;
+    for (int i = 0; i < 16; ++i) {
+        const uint64_t before = TscClock::Begin();
+        const int64_t now = MonotonicNs();
+        const uint64_t after = TscClock::End();
+        if (after - before < best) {
+            best = after - before;
+            *ticks = before + (after - before) / 2;
+            *ns = now;
+        }
+    }
+}
+
+const TscCalibration& calibration() {
+    static const TscCalibration calibration = [] {
+        TscCalibration c;
+#if defined(__x86_64__)
+        readPair(&c.base_ticks, &c.base_ns);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        uint64_t ticks;
+        int64_t ns;
+        readPair(&ticks, &ns);
+        c.ticks_per_ns = static_cast<double>(ticks - c.base_ticks)
+            / static_cast<double>(ns - c.base_ns);
+#else
+        c.base_ticks = 0;
+        c.base_ns = 0;
+        c.ticks_per_ns = 1.0;
+#endif
+        return c;
+    }();
+    return calibration;
+}
+
+std::atomic<uint32_t> g_local_time_generation(0);
+
+// The local time from begin to begin + span, the same but for the minutes
+// and seconds. begin is on a whole minute: utc offsets are whole minutes.
+struct LocalTimeCache {
+    time_t begin;
+    time_t span;
+    uint32_t generation;
+    struct tm base;
+
+    LocalTimeCache() : begin(0), span(0), generation(0) {
+        memset(&base, 0, sizeof(base));
+    }
+
+    // The hour of t when its first and last second have the offset of t:
+    // a transition off the hour (Lord Howe moves by 30 minutes) may fall
+    // between the start of the hour and t. The minute of t otherwise.
+    void Fill(time_t t, uint32_t gen) {
+        struct tm now;
+        localtime_r(&t, &now);
+        const time_t hour = t - now.tm_min * 60 - now.tm_sec;
+        struct tm last;
+        const time_t hour_end = hour + 3599;
+        localtime_r(&hour_end, &last);
+        localtime_r(&hour, &base);
+        if (sameOffset(base, now) && sameOffset(last, now) && base.tm_min == 0) {
+            begin = hour;
+            span = 3600;
+        } else {
+            begin = t - now.tm_sec;
+            span = 60;
+            const time_t tb = begin;
+            localtime_r(&tb, &base);
+        }
+        generation = gen;
+    }
+
+    static bool sameOffset(const struct tm& a, const struct tm& b) {
+        return a.tm_gmtoff == b.tm_gmtoff && a.tm_isdst == b.tm_isdst;
+    }
+};
+
+}  // end of anonymous namespace
+
+void CoarseClock::Start(int64_t interval_us) {
+    ClockUpdater::Instance()->Start(interval_us);
+}
+
+void CoarseClock::Stop() {
+    ClockUpdater::Instance()->Stop();
+}
+
+bool TscClock::Invariant() {
+#if defined(__x86_64__)
+    unsigned eax;
+    unsigned ebx;
+    unsigned ecx;
+    unsigned edx;
+    if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0) {
+        return false;
+    }
+    return (edx >> 8) & 1;
+#else
+    return true;
+#endif
+}
+
+double TscClock::TicksPerNs() {
+    return calibration().ticks_per_ns;
+}
+
+int64_t TscClock::NowNs() {
+    const TscCalibration& c = calibration();
+    const int64_t ticks = static_cast<int64_t>(Ticks() - c.base_ticks);
+    return c.base_ns + static_cast<int64_t>(static_cast<double>(ticks) / c.ticks_per_ns);
+}
+
+void LocalTime(time_t t, struct tm* out) {
+    static thread_local LocalTimeCache cache;
+    const uint32_t gen = g_local_time_generation.load(std::memory_order_relaxed);
+    if (t < cache.begin || t - cache.begin >= cache.span || cache.generation != gen) {
+        cache.Fill(t, gen);
+    }
+    const int offset = static_cast<int>(t - cache.begin);
+    *out = cache.base;
+    out->tm_min += offset / 60;
+    out->tm_sec = offset % 60;
+}
+
+void ResetLocalTime() {
+    tzset();
+    g_local_time_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // end of namespace cg
@@ -1 +1,148 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
 #pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+#include <atomic>
+
+// Clocks by what a reading costs:
+//
+//   CoarseClock    ~1ns, a load of what a background thread last read
+//   Coarse*Ns      vdso, the time of the last tick (1-4ms old)
+//   TscClock       the cpu cycle counter, for intervals
+//   MonotonicNs    vdso clock_gettime, exact to the ns
+//
+// and LocalTime, localtime_r once an hour per thread.
+
+namespace cg {
+
+inline int64_t ClockNs(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+inline int64_t MonotonicNs() {
+    return ClockNs(CLOCK_MONOTONIC);
+}
+
+inline int64_t RealtimeNs() {
+    return ClockNs(CLOCK_REALTIME);
+}
+
+inline int64_t CoarseMonotonicNs() {
+    return ClockNs(CLOCK_MONOTONIC_COARSE);
+}
+
+inline int64_t CoarseRealtimeNs() {
+    return ClockNs(CLOCK_REALTIME_COARSE);
+}
+
+namespace internal {
+
+// 0 while no thread updates them
+extern std::atomic<int64_t> g_cached_monotonic_ns;
+extern std::atomic<int64_t> g_cached_realtime_ns;
+
+}  // end of namespace internal
+
+// Readings a background thread refreshes every interval: a read is a relaxed
+// load, at most an interval old. Without the thread, reads go to the coarse
+// clocks.
+class CoarseClock {
+public:
+    // Starts the thread, or changes its interval if it runs.
+    static void Start(int64_t interval_us = 1000);
+
+    // Stops and joins the thread.
+    static void Stop();
+
+    static bool Running() {
+        return internal::g_cached_monotonic_ns.load(std::memory_order_relaxed) != 0;
+    }
+
+    static int64_t MonotonicNs() {
+        const int64_t ns = internal::g_cached_monotonic_ns.load(std::memory_order_relaxed);
+        return ns != 0 ? ns : CoarseMonotonicNs();
+    }
+
+    static int64_t RealtimeNs() {
+        const int64_t ns = internal::g_cached_realtime_ns.load(std::memory_order_relaxed);
+        return ns != 0 ? ns : CoarseRealtimeNs();
+    }
+
+    static time_t Seconds() {
+        return static_cast<time_t>(RealtimeNs() / 1000000000);
+    }
+};
+
+// The time stamp counter, converted to ns with a rate measured against
+// CLOCK_MONOTONIC at first use. Where there is no TSC, ticks are the ns of
+// CLOCK_MONOTONIC.
+//
+//   const uint64_t begin = TscClock::Begin();
+//   work();
+//   const int64_t ns = TscClock::ToNs(TscClock::End() - begin);
+class TscClock {
+public:
+    // unordered: the cpu may run it before or after the code around it
+    static uint64_t Ticks() {
+#if defined(__x86_64__)
+        return __builtin_ia32_rdtsc();
+#else
+        return static_cast<uint64_t>(MonotonicNs());
+#endif
+    }
+
+    // after the instructions before it, before the ones after it
+    static uint64_t Begin() {
+#if defined(__x86_64__)
+        __builtin_ia32_lfence();
+        const uint64_t t = __builtin_ia32_rdtsc();
+        __builtin_ia32_lfence();
+        return t;
+#else
+        return Ticks();
+#endif
+    }
+
+    // after the instructions before it have completed
+    static uint64_t End() {
+#if defined(__x86_64__)
+        unsigned aux;
+        const uint64_t t = __builtin_ia32_rdtscp(&aux);
+        __builtin_ia32_lfence();
+        return t;
+#else
+        return Ticks();
+#endif
+    }
+
+    // whether the TSC runs at a constant rate through frequency changes and
+    // sleep states, so that its ticks are time
+    static bool Invariant();
+
+    static double TicksPerNs();
+
+    static int64_t ToNs(uint64_t ticks) {
+        return static_cast<int64_t>(static_cast<double>(ticks) / TicksPerNs());
+    }
+
+    // CLOCK_MONOTONIC extrapolated by the TSC from the calibration on,
+    // drifting by the error of the rate (about 10us a second)
+    static int64_t NowNs();
+};
+
+// Broken down local time of t, like localtime_r. A thread caches the hour
+// it last asked for and runs localtime_r again only out of it, or once a
+// minute in an hour where the utc offset changes.
+void LocalTime(time_t t, struct tm* out);
+
+// Makes the caches of every thread recompute, after a change of TZ.
+void ResetLocalTime();
+
+}  // end of namespace cg
@@ -0,0 +1,99 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <time.h>
+
+#include "benchmark/benchmark.h"
+#include "system/timestamp.h"
+
+namespace cg {
+namespace {
+
+void BM_ClockGettimeMonotonic(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(MonotonicNs());
+    }
+}
+
+void BM_ClockGettimeRealtime(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(RealtimeNs());
+    }
+}
+
+void BM_CoarseMonotonic(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CoarseMonotonicNs());
+    }
+}
+
+void BM_CachedCoarseClock(benchmark::State& state) {
+    CoarseClock::Start();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CoarseClock::MonotonicNs());
+    }
+    CoarseClock::Stop();
+}
+
+void BM_Time(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(time(nullptr));
+    }
+}
+
+void BM_TscTicks(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TscClock::Ticks());
+    }
+}
+
+void BM_TscInterval(benchmark::State& state) {
+    TscClock::TicksPerNs();
+    for (auto _ : state) {
+        const uint64_t begin = TscClock::Begin();
+        benchmark::DoNotOptimize(TscClock::ToNs(TscClock::End() - begin));
+    }
+}
+
+void BM_TscNowNs(benchmark::State& state) {
+    TscClock::TicksPerNs();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TscClock::NowNs());
+    }
+}
+
+// seconds apart, as a cron check or a log line would ask
+void BM_LocaltimeR(benchmark::State& state) {
+    time_t t = time(nullptr);
+    struct tm stm;
+    for (auto _ : state) {
+        ++t;
+        localtime_r(&t, &stm);
+        benchmark::DoNotOptimize(stm);
+    }
+}
+
+void BM_LocalTime(benchmark::State& state) {
+    time_t t = time(nullptr);
+    struct tm stm;
+    for (auto _ : state) {
+        ++t;
+        LocalTime(t, &stm);
+        benchmark::DoNotOptimize(stm);
+    }
+}
+
+BENCHMARK(BM_ClockGettimeMonotonic);
+BENCHMARK(BM_ClockGettimeRealtime);
+BENCHMARK(BM_CoarseMonotonic);
+BENCHMARK(BM_CachedCoarseClock);
+BENCHMARK(BM_Time);
+BENCHMARK(BM_TscTicks);
+BENCHMARK(BM_TscInterval);
+BENCHMARK(BM_TscNowNs);
+BENCHMARK(BM_LocaltimeR);
+BENCHMARK(BM_LocalTime);
+
+}  // end of anonymous namespace
+}  // end of namespace cg
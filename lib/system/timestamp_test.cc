@@ -0,0 +1,119 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "system/timestamp.h"
+
+#include <stdlib.h>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class TimestampTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {
+        CoarseClock::Stop();
+    }
+
+    static void expectSameTm(const struct tm& a, const struct tm& b, time_t t) {
+        EXPECT_EQ(a.tm_year, b.tm_year) << t;
+        EXPECT_EQ(a.tm_mon, b.tm_mon) << t;
+        EXPECT_EQ(a.tm_mday, b.tm_mday) << t;
+        EXPECT_EQ(a.tm_hour, b.tm_hour) << t;
+        EXPECT_EQ(a.tm_min, b.tm_min) << t;
+        EXPECT_EQ(a.tm_sec, b.tm_sec) << t;
+        EXPECT_EQ(a.tm_wday, b.tm_wday) << t;
+        EXPECT_EQ(a.tm_yday, b.tm_yday) << t;
+        EXPECT_EQ(a.tm_isdst, b.tm_isdst) << t;
+        EXPECT_EQ(a.tm_gmtoff, b.tm_gmtoff) << t;
+    }
+
+    // LocalTime against localtime_r in zone, walking over the two hours
+    // before a change and the days after it, then at random times
+    static void checkZone(const char* zone, time_t change) {
+        const char* old = getenv("TZ");
+        const std::string saved = old == nullptr ? "" : old;
+        setenv("TZ", zone, 1);
+        ResetLocalTime();
+        std::mt19937 rng(42);
+        time_t t = change - 7200;
+        for (int i = 0; i < 20000; ++i) {
+            t += rng() % 97;
+            struct tm expected;
+            struct tm got;
+            localtime_r(&t, &expected);
+            LocalTime(t, &got);
+            expectSameTm(expected, got, t);
+        }
+        for (int i = 0; i < 2000; ++i) {
+            const time_t r = static_cast<time_t>(rng());
+            struct tm expected;
+            struct tm got;
+            localtime_r(&r, &expected);
+            LocalTime(r, &got);
+            expectSameTm(expected, got, r);
+        }
+        if (old == nullptr) {
+            unsetenv("TZ");
+        } else {
+            setenv("TZ", saved.c_str(), 1);
+        }
+        ResetLocalTime();
+    }
+};
+
+TEST_F(TimestampTest, CoarseClock) {
+    EXPECT_FALSE(CoarseClock::Running());
+    EXPECT_LE(CoarseClock::MonotonicNs(), MonotonicNs());
+    CoarseClock::Start(500);
+    EXPECT_TRUE(CoarseClock::Running());
+    const int64_t first = CoarseClock::MonotonicNs();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const int64_t second = CoarseClock::MonotonicNs();
+    EXPECT_GT(second, first);
+    EXPECT_LE(second, MonotonicNs());
+    EXPECT_LT(std::abs(CoarseClock::RealtimeNs() - RealtimeNs()), 1000000000);
+    EXPECT_LE(std::abs(CoarseClock::Seconds() - time(nullptr)), 1);
+    CoarseClock::Start(100);
+    EXPECT_TRUE(CoarseClock::Running());
+    CoarseClock::Stop();
+    EXPECT_FALSE(CoarseClock::Running());
+    EXPECT_GT(CoarseClock::MonotonicNs(), 0);
+}
+
+TEST_F(TimestampTest, Tsc) {
+    EXPECT_GT(TscClock::TicksPerNs(), 0);
+    const int64_t ns = MonotonicNs();
+    const uint64_t begin = TscClock::Begin();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const int64_t elapsed = TscClock::ToNs(TscClock::End() - begin);
+    const int64_t expected = MonotonicNs() - ns;
+    EXPECT_NEAR(static_cast<double>(expected), static_cast<double>(elapsed), expected * 0.05);
+    EXPECT_NEAR(static_cast<double>(MonotonicNs()), static_cast<double>(TscClock::NowNs()),
+                1e6);
+}
+
+// Against localtime_r in a zone with daylight saving time, across its
+// changes and the hours of the cache.
+TEST_F(TimestampTest, LocalTime) {
+    // 2026-03-08 07:00 UTC, the spring change
+    checkZone("America/New_York", 1772953200);
+}
+
+// A zone that moves its clocks by 30 minutes, at half past the hour:
+// 2024-04-06 15:00 UTC is 02:00 at +11, then 01:30 at +10:30.
+TEST_F(TimestampTest, LocalTimeHalfHourChange) {
+    checkZone("Australia/Lord_Howe", 1712415600);
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
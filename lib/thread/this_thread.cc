@@ -0,0 +1,245 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "thread/this_thread.h"
+
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 35))
+#include <sys/rseq.h>
+#define CG_HAVE_RSEQ 1
+#endif
+
+namespace cg {
+namespace internal {
+namespace {
+
+#if defined(__x86_64__)
+bool cpuHasRdpid() {
+    unsigned a, b, c, d;
+    return __get_cpuid_count(7, 0, &a, &b, &c, &d) && (c & (1U << 22)) != 0;
+}
+
+bool cpuHasRdtscp() {
+    unsigned a, b, c, d;
+    return __get_cpuid(0x80000001, &a, &b, &c, &d) && (d & (1U << 27)) != 0;
+}
+#endif
+
+// whether func reads the cpu sched_getcpu does; the thread may move between
+// the two reads, so a few tries
+bool agrees(int (*func)()) {
+    for (int i = 0; i < 3; ++i) {
+        const int cpu = func();
+        if (cpu < 0) {
+            return false;
+        }
+        if (cpu == sched_getcpu()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+typedef int (*CpuFunc)();
+
+CpuFunc pickCpuFunc() {
+    if (agrees(CpuByRseq)) {
+        return CpuByRseq;
+    }
+    if (agrees(CpuByRdpid)) {
+        return CpuByRdpid;
+    }
+    if (agrees(CpuByRdtscp)) {
+        return CpuByRdtscp;
+    }
+    if (sched_getcpu() >= 0) {
+        return CpuBySchedGetcpu;
+    }
+    return CpuBySyscall;
+}
+
+// "0-3,8,10-11" into the cpus of node
+void addCpuList(const char* list, int node, std::vector<int>* nodes) {
+    const char* p = list;
+    while (*p != '\0' && *p != '\n') {
+        char* end;
+        const long first = strtol(p, &end, 10);
+        if (end == p) {
+            return;
+        }
+        long last = first;
+        p = end;
+        if (*p == '-') {
+            last = strtol(p + 1, &end, 10);
+            p = end;
+        }
+        for (long cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu) {
+            if (static_cast<std::size_t>(cpu) >= nodes->size()) {
+                nodes->resize(cpu + 1, 0);
+            }
+            (*nodes)[cpu] = node;
+        }
+        if (*p == ',') {
+            ++p;
+        }
+    }
+}
+
+// node by cpu
+std::vector<int> readNumaNodes() {
+    std::vector<int> nodes;
+    DIR* dir = opendir("/sys/devices/system/node");
+    if (dir == nullptr) {
+        return nodes;
+    }
+    while (struct dirent* entry = readdir(dir)) {
+        int node;
+        if (sscanf(entry->d_name, "node%d", &node) != 1) {
+            continue;
+        }
+        char path[128];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        FILE* file = fopen(path, "r");
+        if (file == nullptr) {
+            continue;
+        }
+        char list[4096];
+        if (fgets(list, sizeof(list), file) != nullptr) {
+            addCpuList(list, node, &nodes);
+        }
+        fclose(file);
+    }
+    closedir(dir);
+    return nodes;
+}
+
+}  // end of anonymous namespace
+
+int CpuByRseq() {
+#if defined(CG_HAVE_RSEQ)
+    if (__rseq_size == 0) {
+        return -1;
+    }
+    const struct rseq* rs = reinterpret_cast<const struct rseq*>(
+            static_cast<const char*>(__builtin_thread_pointer()) + __rseq_offset);
+    const int cpu = static_cast<int>(*static_cast<const volatile uint32_t*>(&rs->cpu_id));
+    return cpu >= 0 ? cpu : -1;
+#else
+    return -1;
+#endif
+}
+
+int CpuByRdpid() {
+#if defined(__x86_64__)
+    static const bool kSupported = cpuHasRdpid();
+    if (!kSupported) {
+        return -1;
+    }
+    uint64_t aux;
+    __asm__ __volatile__("rdpid %0" : "=r"(aux));
+    return static_cast<int>(aux & 0xfff);
+#else
+    return -1;
+#endif
+}
+
+int CpuByRdtscp() {
+#if defined(__x86_64__)
+    static const bool kSupported = cpuHasRdtscp();
+    if (!kSupported) {
+        return -1;
+    }
+    unsigned aux;
+    __builtin_ia32_rdtscp(&aux);
+    return static_cast<int>(aux & 0xfff);
+#else
+    return -1;
+#endif
+}
+
+int CpuBySchedGetcpu() {
+    return sched_getcpu();
+}
+
+int CpuBySyscall() {
+    unsigned cpu = 0;
+    if (syscall(SYS_getcpu, &cpu, nullptr, nullptr) != 0) {
+        return 0;
+    }
+    return static_cast<int>(cpu);
+}
+
+}  // end of namespace internal
+
+int ThisThread::newTid() {
+    // the child of a fork is a new thread with the cache of the old one
+    static const int kAtFork = pthread_atfork(nullptr, nullptr, &ThisThread::resetTidAfterFork);
+    (void)kAtFork;
+    cachedTid() = static_cast<int>(syscall(SYS_gettid));
+    return cachedTid();
+}
+
+void ThisThread::resetTidAfterFork() {
+    cachedTid() = 0;
+}
+
+bool ThisThread::SetName(const std::string& name) {
+    return pthread_setname_np(pthread_self(), name.substr(0, 15).c_str()) == 0;
+}
+
+std::string ThisThread::Name() {
+    char name[16];
+    if (pthread_getname_np(pthread_self(), name, sizeof(name)) != 0) {
+        return std::string();
+    }
+    return name;
+}
+
+int ThisThread::CurrentCpu() {
+    static const internal::CpuFunc kFunc = internal::pickCpuFunc();
+    return kFunc();
+}
+
+int ThisThread::NumaNodeOfCpu(int cpu) {
+    static const std::vector<int> kNodes = internal::readNumaNodes();
+    return cpu >= 0 && static_cast<std::size_t>(cpu) < kNodes.size() ? kNodes[cpu] : 0;
+}
+
+bool ThisThread::SetAffinity(const std::vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+std::vector<int> ThisThread::Affinity() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        return cpus;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set)) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+}  // end of namespace cg
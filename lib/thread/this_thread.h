@@ -1 +1,85 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
 #pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "include/atomic.h"
+#include "include/macros.h"
+
+namespace cg {
+
+namespace internal {
+
+// the ways CurrentCpu may read the cpu, -1 where the way is missing; for
+// test and benchmark
+int CpuByRseq();          // the cpu_id the kernel keeps in glibc's rseq area
+int CpuByRdpid();         // TSC_AUX by rdpid, where Linux puts the cpu
+int CpuByRdtscp();        // TSC_AUX by rdtscp
+int CpuBySchedGetcpu();   // glibc: rseq, else the vdso
+int CpuBySyscall();
+
+}  // end of namespace internal
+
+// Who the calling thread is and where it runs. Tid and Index cost a load
+// after their first call in a thread. CurrentCpu reads the cpu the fastest
+// way this machine has, checked once against sched_getcpu: the rseq area
+// (~4ns), rdpid (~6ns), rdtscp (~30ns), then the vdso and the syscall.
+class ThisThread {
+public:
+    // kernel id, as gettid; cached, also across a fork
+    static int Tid() {
+        const int tid = cachedTid();
+        return LIKELY(tid != 0) ? tid : newTid();
+    }
+
+    // 0, 1, 2... in the order the threads first ask: an index for sharding
+    // counters and free lists. Not reused when threads exit.
+    static uint32_t Index() {
+        return internal::ThreadSlot();
+    }
+
+    // The kernel keeps 15 chars of a name, the rest is cut.
+    static bool SetName(const std::string& name);
+
+    static std::string Name();
+
+    // The cpu the thread ran on a moment ago, it may have moved since.
+    static int CurrentCpu();
+
+    // The numa node of CurrentCpu(), 0 without numa.
+    static int NumaNode() {
+        return NumaNodeOfCpu(CurrentCpu());
+    }
+
+    // from the node lists of /sys, read once; 0 for a cpu not listed
+    static int NumaNodeOfCpu(int cpu);
+
+    // Lets the thread run on the cpu only, or on the cpus only; false if
+    // none of them is allowed to the process.
+    static bool PinToCpu(int cpu) {
+        return SetAffinity(std::vector<int>(1, cpu));
+    }
+
+    static bool SetAffinity(const std::vector<int>& cpus);
+
+    // the cpus the thread may run on
+    static std::vector<int> Affinity();
+
+private:
+    static int& cachedTid() {
+        static thread_local int tid = 0;
+        return tid;
+    }
+
+    static int newTid();
+
+    static void resetTidAfterFork();
+};
+
+}  // end of namespace cg
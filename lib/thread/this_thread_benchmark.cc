@@ -0,0 +1,96 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "thread/this_thread.h"
+
+namespace cg {
+namespace {
+
+void BM_Tid(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ThisThread::Tid());
+    }
+}
+
+void BM_GettidSyscall(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(syscall(SYS_gettid));
+    }
+}
+
+void BM_Index(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ThisThread::Index());
+    }
+}
+
+void BM_Name(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ThisThread::Name());
+    }
+}
+
+void BM_CurrentCpu(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ThisThread::CurrentCpu());
+    }
+}
+
+void BM_NumaNode(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ThisThread::NumaNode());
+    }
+}
+
+// the ways CurrentCpu picks from, skipped where missing
+void cpuBenchmark(benchmark::State& state, int (*func)()) {
+    if (func() < 0) {
+        state.SkipWithError("not supported");
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(func());
+    }
+}
+
+void BM_CpuByRseq(benchmark::State& state) {
+    cpuBenchmark(state, internal::CpuByRseq);
+}
+
+void BM_CpuByRdpid(benchmark::State& state) {
+    cpuBenchmark(state, internal::CpuByRdpid);
+}
+
+void BM_CpuByRdtscp(benchmark::State& state) {
+    cpuBenchmark(state, internal::CpuByRdtscp);
+}
+
+void BM_CpuBySchedGetcpu(benchmark::State& state) {
+    cpuBenchmark(state, internal::CpuBySchedGetcpu);
+}
+
+void BM_CpuBySyscall(benchmark::State& state) {
+    cpuBenchmark(state, internal::CpuBySyscall);
+}
+
+BENCHMARK(BM_Tid);
+BENCHMARK(BM_GettidSyscall);
+BENCHMARK(BM_Index);
+BENCHMARK(BM_Name);
+BENCHMARK(BM_CurrentCpu);
+BENCHMARK(BM_NumaNode);
+BENCHMARK(BM_CpuByRseq);
+BENCHMARK(BM_CpuByRdpid);
+BENCHMARK(BM_CpuByRdtscp);
+BENCHMARK(BM_CpuBySchedGetcpu);
+BENCHMARK(BM_CpuBySyscall);
+
+}  // end of anonymous namespace
+}  // end of namespace cg
@@ -0,0 +1,102 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "thread/this_thread.h"
+
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class ThisThreadTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+TEST_F(ThisThreadTest, Tid) {
+    const int tid = ThisThread::Tid();
+    EXPECT_EQ(static_cast<int>(syscall(SYS_gettid)), tid);
+    EXPECT_EQ(tid, ThisThread::Tid());
+    int other = tid;
+    std::thread t([&other] { other = ThisThread::Tid(); });
+    t.join();
+    EXPECT_NE(tid, other);
+}
+
+// the child of a fork has a tid of its own
+TEST_F(ThisThreadTest, TidAfterFork) {
+    const int tid = ThisThread::Tid();
+    const pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        _exit(ThisThread::Tid() == static_cast<int>(syscall(SYS_gettid)) && ThisThread::Tid() != tid
+              ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(pid, waitpid(pid, &status, 0));
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(0, WEXITSTATUS(status));
+}
+
+TEST_F(ThisThreadTest, Index) {
+    const uint32_t index = ThisThread::Index();
+    EXPECT_EQ(index, ThisThread::Index());
+    uint32_t other = index;
+    std::thread t([&other] { other = ThisThread::Index(); });
+    t.join();
+    EXPECT_NE(index, other);
+}
+
+TEST_F(ThisThreadTest, Name) {
+    std::thread t([] {
+        EXPECT_TRUE(ThisThread::SetName("worker"));
+        EXPECT_EQ("worker", ThisThread::Name());
+        // cut to 15 chars
+        EXPECT_TRUE(ThisThread::SetName("a-very-long-thread-name"));
+        EXPECT_EQ("a-very-long-thr", ThisThread::Name());
+    });
+    t.join();
+}
+
+TEST_F(ThisThreadTest, CurrentCpu) {
+    const int cpu = ThisThread::CurrentCpu();
+    EXPECT_GE(cpu, 0);
+    EXPECT_GE(ThisThread::NumaNode(), 0);
+    EXPECT_EQ(0, ThisThread::NumaNodeOfCpu(-1));
+    // every way that exists reads a cpu
+    EXPECT_GE(internal::CpuBySchedGetcpu(), 0);
+    EXPECT_GE(internal::CpuBySyscall(), 0);
+    EXPECT_GE(internal::CpuByRseq(), -1);
+    EXPECT_GE(internal::CpuByRdpid(), -1);
+    EXPECT_GE(internal::CpuByRdtscp(), -1);
+}
+
+TEST_F(ThisThreadTest, Affinity) {
+    std::thread t([] {
+        const std::vector<int> cpus = ThisThread::Affinity();
+        ASSERT_FALSE(cpus.empty());
+        const int cpu = cpus.back();
+        EXPECT_TRUE(ThisThread::PinToCpu(cpu));
+        EXPECT_EQ(std::vector<int>(1, cpu), ThisThread::Affinity());
+        // runs there from the next time it is scheduled on
+        std::this_thread::yield();
+        EXPECT_EQ(cpu, ThisThread::CurrentCpu());
+        EXPECT_TRUE(ThisThread::SetAffinity(cpus));
+        EXPECT_EQ(cpus, ThisThread::Affinity());
+        EXPECT_FALSE(ThisThread::SetAffinity(std::vector<int>()));
+    });
+    t.join();
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
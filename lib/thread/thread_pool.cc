@@ -0,0 +1,255 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+
+#include "thread/thread_pool.h"
+
+#include <string>
+
+#include "concurrent/scop_lock.h"
+#include "thread/this_thread.h"
+
+namespace cg {
+
+namespace internal {
+void (*g_park_hook)(ThreadPool* pool) = nullptr;
+}  // end of namespace internal
+
+namespace {
+
+// searches with a yield in between before a worker parks
+const int kSearchRounds = 16;
+
+// the pool and index of the worker on this thread
+thread_local const ThreadPool* t_pool = nullptr;
+thread_local int t_index = -1;
+
+uint64_t nextRandom(uint64_t* seed) {
+    // xorshift64*
+    uint64_t x = *seed;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *seed = x;
+    return x * 2685821657736338717ULL;
+}
+
+}  // end of anonymous namespace
+
+ThreadPool::ThreadPool(int threads)
+    : shared_size_(0), epoch_(0), parked_(0), waking_(false), stop_(false) {
+    if (threads <= 0) {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    for (int i = 0; i < threads; ++i) {
+        workers_.emplace_back(new Worker);
+        workers_.back()->seed = 0x9e3779b97f4a7c15ULL * (i + 1);
+    }
+    // started once all exist, they steal from each other
+    for (int i = 0; i < threads; ++i) {
+        workers_[i]->thread = std::thread(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    stop_.store(true, std::memory_order_seq_cst);
+    epoch_.fetch_add(1, std::memory_order_release);
+    internal::FutexWake(&epoch_, INT32_MAX);
+    for (auto& it : workers_) {
+        it->thread.join();
+    }
+}
+
+int ThreadPool::CurrentWorker() const {
+    return t_pool == this ? t_index : -1;
+}
+
+void ThreadPool::push(internal::Task* task, TaskPriority priority) {
+    if (t_pool == this) {
+        workers_[t_index]->deques[priority].Push(task);
+    } else {
+        ScopLock<Mutex> guard(&shared_mu_);
+        shared_[priority].push_back(task);
+        shared_size_.fetch_add(1, std::memory_order_relaxed);
+    }
+    notify();
+}
+
+void ThreadPool::notify() {
+    // against a worker announcing it parks, then searching once more
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_.load(std::memory_order_relaxed) == 0
+        || waking_.load(std::memory_order_relaxed)
+        || waking_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    epoch_.fetch_add(1, std::memory_order_release);
+    internal::FutexWake(&epoch_, 1);
+}
+
+internal::Task* ThreadPool::popShared(int priority) {
+    if (shared_size_.load(std::memory_order_relaxed) == 0) {
+        return nullptr;
+    }
+    ScopLock<Mutex> guard(&shared_mu_);
+    if (shared_[priority].empty()) {
+        return nullptr;
+    }
+    internal::Task* task = shared_[priority].front();
+    shared_[priority].pop_front();
+    shared_size_.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+}
+
+internal::Task* ThreadPool::steal(Worker* w, int priority) {
+    const std::size_t n = workers_.size();
+    const std::size_t start = nextRandom(&w->seed) % n;
+    internal::Task* task;
+    for (std::size_t i = 0; i < n; ++i) {
+        Worker* victim = workers_[(start + i) % n].get();
+        if (victim != w && victim->deques[priority].Steal(&task)) {
+            Worker::Bump(&w->steals);
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+internal::Task* ThreadPool::findTask(Worker* w) {
+    internal::Task* task;
+    for (int p = 0; p < TASK_PRIORITY_COUNT; ++p) {
+        if (w->deques[p].Pop(&task)) {
+            return task;
+        }
+        if ((task = popShared(p)) != nullptr) {
+            return task;
+        }
+    }
+    for (int p = 0; p < TASK_PRIORITY_COUNT; ++p) {
+        if ((task = steal(w, p)) != nullptr) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+bool ThreadPool::hasWork() const {
+    if (shared_size_.load(std::memory_order_relaxed) != 0) {
+        return true;
+    }
+    for (const auto& it : workers_) {
+        for (int p = 0; p < TASK_PRIORITY_COUNT; ++p) {
+            if (!it->deques[p].Empty()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::park(Worker* w) {
+    const uint32_t epoch = epoch_.load(std::memory_order_acquire);
+    parked_.fetch_add(1, std::memory_order_seq_cst);
+    // a task pushed before the increment is seen here, one pushed after it
+    // sees the parked worker and wakes it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (internal::g_park_hook != nullptr) {
+        internal::g_park_hook(this);
+    }
+    bool running = true;
+    if (!hasWork()) {
+        if (stop_.load(std::memory_order_acquire)) {
+            running = false;
+        } else {
+            Worker::Bump(&w->parks);
+            internal::FutexWait(&epoch_, epoch);
+        }
+    }
+    parked_.fetch_sub(1, std::memory_order_relaxed);
+    // on every way out: a push after the increment may have picked this
+    // worker to wake even if it never slept, and notify wakes nobody else
+    // while the flag is set
+    waking_.store(false, std::memory_order_release);
+    return running;
+}
+
+void ThreadPool::run(Worker* w, internal::Task* task) {
+    task->Run();
+    delete task;
+    Worker::Bump(&w->tasks);
+}
+
+bool ThreadPool::RunOneTask() {
+    if (t_pool != this) {
+        return false;
+    }
+    Worker* w = workers_[t_index].get();
+    internal::Task* task = findTask(w);
+    if (task == nullptr) {
+        return false;
+    }
+    run(w, task);
+    return true;
+}
+
+void ThreadPool::workerLoop(int index) {
+    t_pool = this;
+    t_index = index;
+    ThisThread::SetName("pool-" + std::to_string(index));
+    Worker* w = workers_[index].get();
+    bool woken = false;
+    for (;;) {
+        internal::Task* task = findTask(w);
+        for (int i = 0; task == nullptr && i < kSearchRounds; ++i) {
+            std::this_thread::yield();
+            task = findTask(w);
+        }
+        if (task == nullptr) {
+            if (!park(w)) {
+                return;
+            }
+            woken = true;
+            continue;
+        }
+        if (woken) {
+            // there may be more where this came from: wake the next
+            woken = false;
+            notify();
+        }
+        run(w, task);
+    }
+}
+
+ThreadPoolStats ThreadPool::Stats() const {
+    ThreadPoolStats stats = {0, 0, 0};
+    for (const auto& it : workers_) {
+        stats.tasks += it->tasks.load(std::memory_order_relaxed);
+        stats.steals += it->steals.load(std::memory_order_relaxed);
+        stats.parks += it->parks.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+const uint32_t TaskGroup::kSleeping;
+
+void TaskGroup::Wait() {
+    for (;;) {
+        uint32_t pending = pending_.load(std::memory_order_acquire);
+        if ((pending & ~kSleeping) == 0) {
+            pending_.store(0, std::memory_order_relaxed);
+            return;
+        }
+        // a worker runs tasks, its own children first, instead of blocking
+        if (pool_->RunOneTask()) {
+            continue;
+        }
+        if ((pending & kSleeping) != 0
+            || pending_.compare_exchange_weak(pending, pending | kSleeping,
+                                              std::memory_order_acquire)) {
+            internal::FutexWait(&pending_, pending | kSleeping);
+        }
+    }
+}
+
+}  // end of namespace cg
@@ -0,0 +1,312 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <future>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "concurrent/futex.h"
+#include "concurrent/mutex.h"
+#include "include/atomic.h"
+#include "thread/work_stealing_deque.h"
+
+namespace cg {
+
+// The order in which a worker looks for tasks, see ThreadPool.
+enum TaskPriority {
+    TASK_PRIORITY_HIGH = 0,
+    TASK_PRIORITY_NORMAL,
+    TASK_PRIORITY_LOW,
+    TASK_PRIORITY_COUNT,
+};
+
+struct ThreadPoolStats {
+    uint64_t tasks;   // run
+    uint64_t steals;  // tasks taken from another worker
+    uint64_t parks;   // sleeps of idle workers
+};
+
+class ThreadPool;
+
+namespace internal {
+
+// Tests only: run by a worker that has announced it parks, before its last
+// look for work.
+extern void (*g_park_hook)(ThreadPool* pool);
+
+class Task {
+public:
+    virtual ~Task() {}
+
+    virtual void Run() = 0;
+};
+
+template <typename Func>
+class FuncTask : public Task {
+public:
+    explicit FuncTask(Func&& func) : func_(std::move(func)) {}
+
+    void Run() override {
+        func_();
+    }
+
+private:
+    Func func_;
+};
+
+// the ranges of a ParallelFor, handed out in chunks to the threads helping
+class ForRange {
+public:
+    ForRange(int64_t begin, int64_t end, int64_t min_chunk, int threads)
+        : next_(begin), end_(end), min_chunk_(std::max<int64_t>(min_chunk, 1)),
+          threads_(threads), left_(end - begin), finished_(0) {}
+
+    // Takes the next chunk: a share of what is left, so chunks get smaller
+    // toward the end and the threads finish together.
+    bool Take(int64_t* begin, int64_t* end) {
+        int64_t next = next_.load(std::memory_order_relaxed);
+        for (;;) {
+            if (next >= end_) {
+                return false;
+            }
+            const int64_t chunk = std::max((end_ - next) / (2 * threads_), min_chunk_);
+            const int64_t stop = std::min(end_, next + chunk);
+            if (next_.compare_exchange_weak(next, stop, std::memory_order_relaxed)) {
+                *begin = next;
+                *end = stop;
+                return true;
+            }
+        }
+    }
+
+    template <typename Func>
+    void Run(Func& func) {
+        int64_t begin, end;
+        while (Take(&begin, &end)) {
+            for (int64_t i = begin; i < end; ++i) {
+                func(i);
+            }
+            if (left_.fetch_sub(end - begin, std::memory_order_acq_rel) == end - begin) {
+                finished_.store(1, std::memory_order_release);
+                FutexWake(&finished_, INT32_MAX);
+            }
+        }
+    }
+
+    // until every chunk taken has run
+    void Wait() {
+        while (finished_.load(std::memory_order_acquire) == 0) {
+            FutexWait(&finished_, 0);
+        }
+    }
+
+private:
+    std::atomic<int64_t> next_;
+    const int64_t end_;
+    const int64_t min_chunk_;
+    const int64_t threads_;
+    std::atomic<int64_t> left_;  // items not run yet
+    std::atomic<uint32_t> finished_;
+};
+
+}  // end of namespace internal
+
+// Work-stealing thread pool. Every worker has a Chase-Lev deque per
+// priority: the tasks a worker submits go to its own deque, it runs them
+// newest first while they are hot in cache, and idle workers steal the
+// oldest ones, the biggest pieces of a recursive split, from a random
+// victim. Tasks from other threads go to a shared queue. A worker with
+// nothing to do searches a while, then parks on a futex; submitting wakes
+// one parked worker, which wakes the next if it finds work.
+//
+// A worker takes its own tasks by priority, then the shared ones by
+// priority, then steals by priority: priorities order the tasks of a
+// worker, they are no global order.
+class ThreadPool {
+public:
+    // 0 for a worker per cpu
+    explicit ThreadPool(int threads = 0);
+
+    // Runs the tasks already submitted, then joins the workers.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int Size() const {
+        return static_cast<int>(workers_.size());
+    }
+
+    // index of the calling thread among the workers of this pool, -1 if it
+    // is none of them
+    int CurrentWorker() const;
+
+    // Runs func() on a worker, without a result.
+    template <typename Func>
+    void Post(Func func, TaskPriority priority = TASK_PRIORITY_NORMAL) {
+        push(new internal::FuncTask<Func>(std::move(func)), priority);
+    }
+
+    // Runs func() on a worker; the future has its result or its exception.
+    // A task must not wait for the future of another, all the workers could
+    // be waiting: use a TaskGroup, whose Wait runs tasks.
+    template <typename Func>
+    std::future<typename std::result_of<Func()>::type> Submit(
+            Func func, TaskPriority priority = TASK_PRIORITY_NORMAL) {
+        typedef typename std::result_of<Func()>::type Result;
+        std::packaged_task<Result()> task(std::move(func));
+        std::future<Result> future = task.get_future();
+        Post(std::move(task), priority);
+        return future;
+    }
+
+    // Calls func(i) for i in [begin, end) on the workers and the calling
+    // thread, returns when all are done. Chunks are a share of what is left,
+    // at least min_chunk: big at first, small at the end when threads would
+    // otherwise wait for the slowest.
+    template <typename Func>
+    void ParallelFor(int64_t begin, int64_t end, Func func, int64_t min_chunk = 1);
+
+    // Runs one task, if the calling thread is a worker of this pool and finds
+    // one; for waits that help instead of blocking.
+    bool RunOneTask();
+
+    ThreadPoolStats Stats() const;
+
+private:
+    struct Worker {
+        WorkStealingDeque<internal::Task*> deques[TASK_PRIORITY_COUNT];
+        uint64_t seed;
+        // written by the worker only
+        std::atomic<uint64_t> tasks;
+        std::atomic<uint64_t> steals;
+        std::atomic<uint64_t> parks;
+        std::thread thread;
+
+        Worker() : seed(0), tasks(0), steals(0), parks(0) {}
+
+        static void Bump(std::atomic<uint64_t>* counter) {
+            counter->store(counter->load(std::memory_order_relaxed) + 1,
+                           std::memory_order_relaxed);
+        }
+    };
+
+    void push(internal::Task* task, TaskPriority priority);
+
+    // wakes a parked worker if there is one and none is waking already
+    void notify();
+
+    internal::Task* findTask(Worker* w);
+
+    internal::Task* popShared(int priority);
+
+    internal::Task* steal(Worker* w, int priority);
+
+    bool hasWork() const;
+
+    // false when the pool stops
+    bool park(Worker* w);
+
+    void run(Worker* w, internal::Task* task);
+
+    void workerLoop(int index);
+
+private:
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    Mutex shared_mu_;
+    std::deque<internal::Task*> shared_[TASK_PRIORITY_COUNT];
+    std::atomic<int64_t> shared_size_;  // read without the lock
+
+    std::atomic<uint32_t> epoch_;  // futex of the parked workers
+    std::atomic<uint32_t> parked_;
+    std::atomic<bool> waking_;     // a worker was woken and has not searched yet
+    std::atomic<bool> stop_;
+};
+
+// Tasks run on a pool and waited for together: the fork-join of recursive
+// algorithms. A worker waiting in Wait runs other tasks meanwhile, so tasks
+// may wait for the groups they created.
+//
+//   TaskGroup group(&pool);
+//   group.Run([&] { left = fib(n - 1); });
+//   right = fib(n - 2);
+//   group.Wait();
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool* pool) : pool_(pool), pending_(0) {}
+
+    ~TaskGroup() {
+        Wait();
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    template <typename Func>
+    void Run(Func func, TaskPriority priority = TASK_PRIORITY_NORMAL) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        pool_->Post(Done<Func>{this, std::move(func)}, priority);
+    }
+
+    void Wait();
+
+private:
+    template <typename Func>
+    struct Done {
+        TaskGroup* group;
+        Func func;
+
+        void operator()() {
+            func();
+            group->done();
+        }
+    };
+
+    // set in pending_ by a thread sleeping in Wait: only then is the last
+    // done a syscall
+    static const uint32_t kSleeping = 1U << 31;
+
+    void done() {
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == (kSleeping | 1)) {
+            internal::FutexWake(&pending_, INT32_MAX);
+        }
+    }
+
+private:
+    ThreadPool* pool_;
+    std::atomic<uint32_t> pending_;  // tasks not done
+};
+
+template <typename Func>
+void ThreadPool::ParallelFor(int64_t begin, int64_t end, Func func, int64_t min_chunk) {
+    if (begin >= end) {
+        return;
+    }
+    const int threads = Size() + 1;
+    std::shared_ptr<internal::ForRange> range =
+        std::make_shared<internal::ForRange>(begin, end, min_chunk, threads);
+    // helpers that start late find nothing left and return
+    const int64_t chunks = (end - begin + min_chunk - 1) / std::max<int64_t>(min_chunk, 1);
+    const int helpers = static_cast<int>(std::min<int64_t>(Size(), chunks - 1));
+    for (int i = 0; i < helpers; ++i) {
+        Post([range, func]() mutable { range->Run(func); });
+    }
+    range->Run(func);
+    range->Wait();
+}
+
+}  // end of namespace cg
@@ -0,0 +1,332 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "concurrent/conditionvar.h"
+#include "thread/thread_pool.h"
+
+namespace cg {
+namespace {
+
+// The pool one writes first: one queue under a mutex, a condition variable.
+class SimplePool {
+public:
+    explicit SimplePool(int threads) : stop_(false) {
+        for (int i = 0; i < threads; ++i) {
+            threads_.emplace_back([this] {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mu_);
+                        cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+                        if (queue_.empty()) {
+                            return;
+                        }
+                        task = std::move(queue_.front());
+                        queue_.pop_front();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+
+    ~SimplePool() {
+        {
+            std::lock_guard<std::mutex> guard(mu_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& it : threads_) {
+            it.join();
+        }
+    }
+
+    void Post(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> guard(mu_);
+            queue_.push_back(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+private:
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> queue_;
+    bool stop_;
+    std::vector<std::thread> threads_;
+};
+
+int threads() {
+    return std::max(2U, std::thread::hardware_concurrency());
+}
+
+int64_t fib(int n) {
+    return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+// fib(n) in tasks down to cutoff
+int64_t fibTasks(ThreadPool* pool, int n, int cutoff) {
+    if (n <= cutoff) {
+        return fib(n);
+    }
+    int64_t left = 0;
+    TaskGroup group(pool);
+    group.Run([pool, n, cutoff, &left] { left = fibTasks(pool, n - 1, cutoff); });
+    const int64_t right = fibTasks(pool, n - 2, cutoff);
+    group.Wait();
+    return left + right;
+}
+
+int64_t fibAsync(int n, int cutoff) {
+    if (n <= cutoff) {
+        return fib(n);
+    }
+    std::future<int64_t> left = std::async(std::launch::async, fibAsync, n - 1, cutoff);
+    const int64_t right = fibAsync(n - 2, cutoff);
+    return left.get() + right;
+}
+
+// the tasks of a pool that cannot wait inside a task: the caller posts the
+// leaves of the recursion
+void fibLeaves(int n, int cutoff, std::vector<int>* leaves) {
+    if (n <= cutoff) {
+        leaves->push_back(n);
+        return;
+    }
+    fibLeaves(n - 1, cutoff, leaves);
+    fibLeaves(n - 2, cutoff, leaves);
+}
+
+// spawn: range(0) empty tasks posted from outside and waited for
+
+void BM_SpawnThreadPool(benchmark::State& state) {
+    ThreadPool pool(threads());
+    for (auto _ : state) {
+        CountDownLatch latch(static_cast<uint32_t>(state.range(0)));
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            pool.Post([&latch] { latch.CountDown(); });
+        }
+        latch.Wait();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// posted by a task: the tasks go to the deque of its worker
+void BM_SpawnThreadPoolFromWorker(benchmark::State& state) {
+    ThreadPool pool(threads());
+    for (auto _ : state) {
+        pool.Submit([&pool, &state] {
+            TaskGroup group(&pool);
+            for (int64_t i = 0; i < state.range(0); ++i) {
+                group.Run([] {});
+            }
+            group.Wait();
+        }).get();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SpawnSimplePool(benchmark::State& state) {
+    SimplePool pool(threads());
+    for (auto _ : state) {
+        CountDownLatch latch(static_cast<uint32_t>(state.range(0)));
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            pool.Post([&latch] { latch.CountDown(); });
+        }
+        latch.Wait();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SpawnStdAsync(benchmark::State& state) {
+    std::vector<std::future<void>> futures;
+    for (auto _ : state) {
+        futures.clear();
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            futures.push_back(std::async(std::launch::async, [] {}));
+        }
+        for (auto& it : futures) {
+            it.get();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// fib(26) in tasks down to fib(range(0)): 3 ~ 60k tasks, 12 ~ 800
+
+void BM_FibSerial(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fib(26));
+    }
+}
+
+void BM_FibThreadPool(benchmark::State& state) {
+    ThreadPool pool(threads());
+    const int cutoff = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pool.Submit([&pool, cutoff] {
+            return fibTasks(&pool, 26, cutoff);
+        }).get());
+    }
+}
+
+void BM_FibSimplePool(benchmark::State& state) {
+    SimplePool pool(threads());
+    std::vector<int> leaves;
+    fibLeaves(26, static_cast<int>(state.range(0)), &leaves);
+    for (auto _ : state) {
+        std::atomic<int64_t> sum(0);
+        CountDownLatch latch(static_cast<uint32_t>(leaves.size()));
+        for (int n : leaves) {
+            pool.Post([n, &sum, &latch] {
+                sum.fetch_add(fib(n), std::memory_order_relaxed);
+                latch.CountDown();
+            });
+        }
+        latch.Wait();
+        benchmark::DoNotOptimize(sum.load());
+    }
+}
+
+void BM_FibStdAsync(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fibAsync(26, static_cast<int>(state.range(0))));
+    }
+}
+
+// sorting 1M ints: quicksort forking tasks down to range(0) elements
+
+std::vector<int> randomInts() {
+    std::vector<int> v(1 << 20);
+    std::mt19937 rng(7);
+    for (auto& it : v) {
+        it = static_cast<int>(rng());
+    }
+    return v;
+}
+
+// [begin, lo) below the middle element, [hi, end) above, never empty between
+void split(int* begin, int* end, int** lo, int** hi) {
+    const int pivot = begin[(end - begin) / 2];
+    *lo = std::partition(begin, end, [pivot](int x) { return x < pivot; });
+    *hi = std::partition(*lo, end, [pivot](int x) { return !(pivot < x); });
+}
+
+void sortTasks(ThreadPool* pool, int* begin, int* end, int64_t cutoff) {
+    if (end - begin <= cutoff) {
+        std::sort(begin, end);
+        return;
+    }
+    int* lo;
+    int* hi;
+    split(begin, end, &lo, &hi);
+    TaskGroup group(pool);
+    group.Run([pool, begin, lo, cutoff] { sortTasks(pool, begin, lo, cutoff); });
+    sortTasks(pool, hi, end, cutoff);
+    group.Wait();
+}
+
+void sortAsync(int* begin, int* end, int64_t cutoff) {
+    if (end - begin <= cutoff) {
+        std::sort(begin, end);
+        return;
+    }
+    int* lo;
+    int* hi;
+    split(begin, end, &lo, &hi);
+    std::future<void> left = std::async(std::launch::async, sortAsync, begin, lo, cutoff);
+    sortAsync(hi, end, cutoff);
+    left.get();
+}
+
+void BM_SortSerial(benchmark::State& state) {
+    const std::vector<int> input = randomInts();
+    for (auto _ : state) {
+        std::vector<int> v = input;
+        std::sort(v.begin(), v.end());
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+void BM_SortThreadPool(benchmark::State& state) {
+    ThreadPool pool(threads());
+    const std::vector<int> input = randomInts();
+    for (auto _ : state) {
+        std::vector<int> v = input;
+        int* data = v.data();
+        pool.Submit([&pool, data, &v, &state] {
+            sortTasks(&pool, data, data + v.size(), state.range(0));
+        }).get();
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+// the chunks sorted by the pool, merged by the caller
+void BM_SortSimplePool(benchmark::State& state) {
+    SimplePool pool(threads());
+    const std::vector<int> input = randomInts();
+    const std::size_t chunk = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        std::vector<int> v = input;
+        const std::size_t chunks = (v.size() + chunk - 1) / chunk;
+        CountDownLatch latch(static_cast<uint32_t>(chunks));
+        for (std::size_t i = 0; i < v.size(); i += chunk) {
+            int* begin = v.data() + i;
+            int* end = v.data() + std::min(v.size(), i + chunk);
+            pool.Post([begin, end, &latch] {
+                std::sort(begin, end);
+                latch.CountDown();
+            });
+        }
+        latch.Wait();
+        for (std::size_t width = chunk; width < v.size(); width *= 2) {
+            for (std::size_t i = 0; i + width < v.size(); i += 2 * width) {
+                std::inplace_merge(v.begin() + i, v.begin() + i + width,
+                                   v.begin() + std::min(v.size(), i + 2 * width));
+            }
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+void BM_SortStdAsync(benchmark::State& state) {
+    const std::vector<int> input = randomInts();
+    for (auto _ : state) {
+        std::vector<int> v = input;
+        sortAsync(v.data(), v.data() + v.size(), state.range(0));
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+BENCHMARK(BM_SpawnThreadPool)->Arg(1000)->UseRealTime();
+BENCHMARK(BM_SpawnThreadPoolFromWorker)->Arg(1000)->UseRealTime();
+BENCHMARK(BM_SpawnSimplePool)->Arg(1000)->UseRealTime();
+BENCHMARK(BM_SpawnStdAsync)->Arg(1000)->UseRealTime();
+
+BENCHMARK(BM_FibSerial)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FibThreadPool)->Arg(3)->Arg(12)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FibSimplePool)->Arg(3)->Arg(12)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FibStdAsync)->Arg(12)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_SortSerial)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SortThreadPool)->Arg(1 << 10)->Arg(1 << 14)->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SortSimplePool)->Arg(1 << 14)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SortStdAsync)->Arg(1 << 14)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+}  // end of anonymous namespace
+}  // end of namespace cg
@@ -0,0 +1,166 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "thread/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent/conditionvar.h"
+#include "concurrent/scop_lock.h"
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class ThreadPoolTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    static int64_t fib(ThreadPool* pool, int n) {
+        if (n < 2) {
+            return n;
+        }
+        int64_t left = 0;
+        TaskGroup group(pool);
+        group.Run([pool, n, &left] { left = fib(pool, n - 1); });
+        const int64_t right = fib(pool, n - 2);
+        group.Wait();
+        return left + right;
+    }
+};
+
+TEST_F(ThreadPoolTest, Submit) {
+    ThreadPool pool(4);
+    EXPECT_EQ(4, pool.Size());
+    EXPECT_EQ(-1, pool.CurrentWorker());
+    std::future<int> answer = pool.Submit([] { return 42; });
+    std::future<std::string> name = pool.Submit([] { return std::string("pool"); },
+                                                TASK_PRIORITY_HIGH);
+    std::future<int> worker = pool.Submit([&pool] { return pool.CurrentWorker(); });
+    std::future<void> error = pool.Submit([] { throw std::runtime_error("failed"); });
+    EXPECT_EQ(42, answer.get());
+    EXPECT_EQ("pool", name.get());
+    const int index = worker.get();
+    EXPECT_GE(index, 0);
+    EXPECT_LT(index, 4);
+    EXPECT_THROW(error.get(), std::runtime_error);
+}
+
+TEST_F(ThreadPoolTest, Post) {
+    const int kTasks = 10000;
+    std::atomic<int> ran(0);
+    {
+        ThreadPool pool(4);
+        for (int i = 0; i < kTasks; ++i) {
+            pool.Post([&ran] { ran.fetch_add(1); },
+                      static_cast<TaskPriority>(i % TASK_PRIORITY_COUNT));
+        }
+        // the destructor runs what is queued
+    }
+    EXPECT_EQ(kTasks, ran.load());
+}
+
+// A single worker busy with a task finds the high priority tasks first.
+TEST_F(ThreadPoolTest, Priority) {
+    ThreadPool pool(1);
+    Event started;
+    Event release;
+    pool.Post([&] {
+        started.Set();
+        release.Wait();
+    });
+    started.Wait();
+    std::vector<int> order;
+    Mutex mu;
+    auto record = [&order, &mu](int p) {
+        ScopLock<Mutex> guard(&mu);
+        order.push_back(p);
+    };
+    pool.Post([&] { record(2); }, TASK_PRIORITY_LOW);
+    pool.Post([&] { record(1); }, TASK_PRIORITY_NORMAL);
+    pool.Post([&] { record(0); }, TASK_PRIORITY_HIGH);
+    release.Set();
+    pool.Submit([] {}, TASK_PRIORITY_LOW).get();
+    EXPECT_EQ(std::vector<int>({0, 1, 2}), order);
+}
+
+TEST_F(ThreadPoolTest, ParallelFor) {
+    ThreadPool pool(4);
+    const int kItems = 100000;
+    std::vector<int> hits(kItems, 0);
+    pool.ParallelFor(0, kItems, [&hits](int64_t i) { ++hits[i]; });
+    EXPECT_EQ(kItems, std::count(hits.begin(), hits.end(), 1));
+
+    std::atomic<int64_t> sum(0);
+    pool.ParallelFor(10, 20, [&sum](int64_t i) { sum.fetch_add(i); }, 3);
+    EXPECT_EQ(145, sum.load());
+    pool.ParallelFor(5, 5, [&sum](int64_t) { sum.store(-1); });
+    EXPECT_EQ(145, sum.load());
+
+    // nested in a task
+    pool.Submit([&pool, &hits] {
+        pool.ParallelFor(0, static_cast<int64_t>(hits.size()), [&hits](int64_t i) { ++hits[i]; },
+                         100);
+    }).get();
+    EXPECT_EQ(kItems, std::count(hits.begin(), hits.end(), 2));
+}
+
+// Recursive tasks waiting for their children do not run out of workers.
+TEST_F(ThreadPoolTest, TaskGroup) {
+    ThreadPool pool(2);
+    EXPECT_EQ(6765, fib(&pool, 20));
+    std::future<int64_t> inside = pool.Submit([&pool] { return fib(&pool, 18); });
+    EXPECT_EQ(2584, inside.get());
+    const ThreadPoolStats stats = pool.Stats();
+    EXPECT_GT(stats.tasks, 6000U);
+}
+
+// Workers park when idle and wake for new tasks.
+TEST_F(ThreadPoolTest, Park) {
+    ThreadPool pool(3);
+    for (int round = 0; round < 20; ++round) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        EXPECT_EQ(round, pool.Submit([round] { return round; }).get());
+    }
+    EXPECT_GT(pool.Stats().parks, 0U);
+}
+
+// A task pushed while the worker announces that it parks wakes it before it
+// sleeps; the next push must still wake it once it does sleep.
+std::atomic<int> g_window_posts(0);
+std::atomic<int> g_window_ran(0);
+
+void postIntoParkWindow(ThreadPool* pool) {
+    if (g_window_posts.fetch_add(1) == 0) {
+        pool->Post([] { g_window_ran.fetch_add(1); });
+    }
+}
+
+TEST_F(ThreadPoolTest, PostWhileParking) {
+    internal::g_park_hook = &postIntoParkWindow;
+    {
+        ThreadPool pool(1);
+        while (g_window_ran.load() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        // the first park found the task without sleeping: wait for a real one
+        while (pool.Stats().parks == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        EXPECT_EQ(7, pool.Submit([] { return 7; }).get());
+    }
+    internal::g_park_hook = nullptr;
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg
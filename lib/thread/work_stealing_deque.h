@@ -0,0 +1,140 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "algorithm/bit.h"
+#include "include/atomic.h"
+
+namespace cg {
+
+// Chase-Lev deque (Le, Pop, Cohen, Zappa Nardelli, "Correct and Efficient
+// Work-Stealing for Weak Memory Models", 2013). The owner thread pushes and
+// pops at the bottom, as a stack; any thread steals from the top, the oldest
+// item. Push and Pop are plain loads and stores unless they race a thief for
+// the last item. The ring doubles when full; the rings it outgrew are kept
+// until the deque dies, a thief may still read one.
+template <typename T>
+class WorkStealingDeque {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "items are copied as words");
+
+    explicit WorkStealingDeque(int64_t capacity = 256) : top_(0), bottom_(0) {
+        const int64_t cap = static_cast<int64_t>(
+            NextPowerOfTwo(static_cast<uint64_t>(std::max<int64_t>(capacity, 1))));
+        rings_.emplace_back(new Ring(cap));
+        ring_.store(rings_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // owner only
+    void Push(T item) {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_acquire);
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+        if (b - t >= ring->capacity) {
+            ring = grow(ring, t, b);
+        }
+        ring->Put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // owner only, the item pushed last
+    bool Pop(T* item) {
+        const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        *item = ring->Get(b);
+        if (t == b) {
+            // the last item: the owner and the thieves race for it on top_
+            const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // any thread, the oldest item; false when empty or when another thread
+    // took the item first
+    bool Steal(T* item) {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) {
+            return false;
+        }
+        Ring* ring = ring_.load(std::memory_order_acquire);
+        *item = ring->Get(t);
+        return top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed);
+    }
+
+    // approximate while other threads use the deque
+    int64_t Size() const {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+
+    bool Empty() const {
+        return Size() == 0;
+    }
+
+private:
+    struct Ring {
+        const int64_t capacity;
+        const int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> items;
+
+        explicit Ring(int64_t cap) : capacity(cap), mask(cap - 1), items(new std::atomic<T>[cap]) {}
+
+        T Get(int64_t i) const {
+            return items[i & mask].load(std::memory_order_relaxed);
+        }
+
+        void Put(int64_t i, T item) {
+            items[i & mask].store(item, std::memory_order_relaxed);
+        }
+    };
+
+    Ring* grow(Ring* ring, int64_t t, int64_t b) {
+        rings_.emplace_back(new Ring(ring->capacity * 2));
+        Ring* bigger = rings_.back().get();
+        for (int64_t i = t; i < b; ++i) {
+            bigger->Put(i, ring->Get(i));
+        }
+        ring_.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+private:
+    // apart, the owner writes bottom_ and the thieves top_
+    std::atomic<int64_t> top_;
+    char pad0_[kCacheLineSize];
+    std::atomic<int64_t> bottom_;
+    std::atomic<Ring*> ring_;
+    char pad1_[kCacheLineSize];
+    std::vector<std::unique_ptr<Ring>> rings_;  // owner only
+};
+
+}  // end of namespace cg
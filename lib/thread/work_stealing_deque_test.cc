@@ -0,0 +1,91 @@
+/**
+ * Author: caoge@strivemycodelife@163.com
+ * Date: 2026-10-18
+ */
+#include "thread/work_stealing_deque.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace cg {
+namespace unittest {
+
+class WorkStealingDequeTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+
+    void TearDown() override {}
+};
+
+TEST_F(WorkStealingDequeTest, Simple) {
+    WorkStealingDeque<int> deque(2);
+    int x = 0;
+    EXPECT_FALSE(deque.Pop(&x));
+    EXPECT_FALSE(deque.Steal(&x));
+    // grows past the 2 it started with
+    for (int i = 0; i < 10; ++i) {
+        deque.Push(i);
+    }
+    EXPECT_EQ(10, deque.Size());
+    EXPECT_TRUE(deque.Steal(&x));
+    EXPECT_EQ(0, x);
+    EXPECT_TRUE(deque.Pop(&x));
+    EXPECT_EQ(9, x);
+    EXPECT_TRUE(deque.Steal(&x));
+    EXPECT_EQ(1, x);
+    for (int i = 8; i >= 2; --i) {
+        EXPECT_TRUE(deque.Pop(&x));
+        EXPECT_EQ(i, x);
+    }
+    EXPECT_TRUE(deque.Empty());
+    EXPECT_FALSE(deque.Pop(&x));
+}
+
+// Every item is taken exactly once by the owner or one of the thieves.
+TEST_F(WorkStealingDequeTest, Concurrent) {
+    const int kItems = 200000;
+    const int kThieves = 3;
+    WorkStealingDeque<int> deque(16);
+    std::vector<std::atomic<int>> taken(kItems);
+    for (auto& it : taken) {
+        it.store(0);
+    }
+    std::atomic<bool> done(false);
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < kThieves; ++i) {
+        thieves.emplace_back([&] {
+            int x;
+            while (!done.load(std::memory_order_acquire)) {
+                if (deque.Steal(&x)) {
+                    taken[x].fetch_add(1);
+                }
+            }
+        });
+    }
+    int x;
+    for (int i = 0; i < kItems; ++i) {
+        deque.Push(i);
+        // pop one in three, leave the rest for the thieves
+        if (i % 3 == 0 && deque.Pop(&x)) {
+            taken[x].fetch_add(1);
+        }
+    }
+    while (deque.Pop(&x)) {
+        taken[x].fetch_add(1);
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& it : thieves) {
+        it.join();
+    }
+    int wrong = 0;
+    for (auto& it : taken) {
+        wrong += it.load() != 1;
+    }
+    EXPECT_EQ(0, wrong);
+}
+
+}  // end of namespace unittest
+}  // end of namespace cg